@@ -1,7 +1,12 @@
 #include "Algebra.h"
 
+#include "../Buffer/Predicate.h"
+
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <iostream>
+#include <vector>
 
 
 // will return if a string can be parsed as a floating point number
@@ -25,7 +30,7 @@ bool isNumber(char *str)
 
 
 
-int Algebra::insert(char relName[ATTR_SIZE], int nAttrs, char record[][ATTR_SIZE]){
+int Algebra::insert(char relName[ATTR_SIZE], int nAttrs, char record[][ATTR_SIZE], InsertBatch *batch){
     // if relName is equal to "RELATIONCAT" or "ATTRIBUTECAT"
     // return E_NOTPERMITTED;
     if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0)
@@ -83,203 +88,1075 @@ int Algebra::insert(char relName[ATTR_SIZE], int nAttrs, char record[][ATTR_SIZE
         // let type = attrCatEntry.attrType;
         int type = attrCatEntry.attrType;
 
-        if (type == NUMBER)
+        if (type == NUMBER)
+        {
+            // if the char array record[i] can be converted to a number
+            // (check this using isNumber() function)   
+            if (isNumber(record[i]))
+            {
+                /* convert the char array to numeral and store it
+                   at recordValues[i].nVal using atof() */
+                recordValues[i].nVal = atof(record[i]);
+            }
+            // else
+            else
+            {
+                return E_ATTRTYPEMISMATCH;
+            }
+        }
+        else if (type == STRING)
+        {
+            // copy record[i] to recordValues[i].sVal
+            strcpy(recordValues[i].sVal, record[i]); 
+        }
+    }
+
+    // insert the record by calling BlockAccess::insert() function
+    // let retVal denote the return value of insert call
+    return BlockAccess::insert(relId, recordValues, batch);
+
+}
+
+/*
+Inserts the numRecords records (nAttrs values each, one record after the other
+in `records`) into relName as Algebra::insert() does, and sets *numInserted to
+the number inserted before an error (if any). The index entries of the records
+are inserted into the B+ trees of the relation at once, a leaf at a time (see
+BlockAccess::insertBegin()), rather than a record at a time.
+*/
+int Algebra::insertRecords(char relName[ATTR_SIZE], int numRecords, int nAttrs, char records[][ATTR_SIZE],
+                           int *numInserted)
+{
+    *numInserted = 0;
+
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0)
+    {
+        return E_NOTPERMITTED;
+    }
+
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN)
+    {
+        return E_RELNOTOPEN;
+    }
+
+    InsertBatch batch;
+    BlockAccess::insertBegin(&batch, relId);
+
+    int response = SUCCESS;
+    while (*numInserted < numRecords)
+    {
+        response = Algebra::insert(relName, nAttrs, records + *numInserted * nAttrs, &batch);
+        if (response != SUCCESS)
+        {
+            break;
+        }
+        (*numInserted)++;
+    }
+
+    // (the records inserted before an error are indexed all the same)
+    int flag = BlockAccess::insertEnd(&batch);
+
+    return response != SUCCESS ? response : flag;
+}
+
+/*
+Deletes the records of relName whose value of attr satisfies the condition op
+strVal, and sets *numDeleted to their number. The records are found first and
+then deleted one at a time (BlockAccess::deleteRecord() also removes their
+entries from the indexes of the relation).
+*/
+int Algebra::deleteRecords(char relName[ATTR_SIZE], char attr[ATTR_SIZE], int op, char strVal[ATTR_SIZE],
+                           int *numDeleted) {
+    *numDeleted = 0;
+
+    // the records of the catalogs can not be deleted
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, INDEXCAT_RELNAME) == 0)
+    {
+        return E_NOTPERMITTED;
+    }
+
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN)
+    {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attr, &attrCatEntry);
+    if (response != SUCCESS)
+    {
+        return E_ATTRNOTEXIST;
+    }
+
+    Attribute attrVal;
+    if (attrCatEntry.attrType == NUMBER)
+    {
+        if (!isNumber(strVal))
+        {
+            return E_ATTRTYPEMISMATCH;
+        }
+        attrVal.nVal = atof(strVal);
+    }
+    else
+    {
+        strcpy(attrVal.sVal, strVal);
+    }
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+    /* collect the record ids of the matching records before deleting any of them
+       (a block that becomes empty is released, which would end the scan) */
+    std::vector<RecId> recIds;
+
+    ScanCursor cursor;
+    BlockAccess::openScan(&cursor, relId, attr, attrVal, op);
+
+    Attribute records[relCatEntry.numSlotsPerBlk * relCatEntry.numAttrs];
+    RecId blockRecIds[relCatEntry.numSlotsPerBlk];
+    int numRecords;
+    while (BlockAccess::scanNext(&cursor, records, blockRecIds, &numRecords) == SUCCESS)
+    {
+        recIds.insert(recIds.end(), blockRecIds, blockRecIds + numRecords);
+    }
+
+    // (an index destroyed on the way is reported once all the records are deleted)
+    int flag = SUCCESS;
+    for (RecId recId : recIds)
+    {
+        response = BlockAccess::deleteRecord(relId, recId);
+        if (response == E_INDEX_BLOCKS_RELEASED)
+        {
+            flag = response;
+        }
+        else if (response != SUCCESS)
+        {
+            return response;
+        }
+        (*numDeleted)++;
+    }
+
+    return flag;
+}
+
+int Algebra::select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE], int op, char strVal[ATTR_SIZE]) {
+    // get the srcRel's rel-id (let it be srcRelid), using OpenRelTable::getRelId()
+    // if srcRel is not open in open relation table, return E_RELNOTOPEN
+
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN)
+    {
+        return E_RELNOTOPEN;
+    }
+
+    // get the attr-cat entry for attr, using AttrCacheTable::getAttrCatEntry()
+    // if getAttrcatEntry() call fails return E_ATTRNOTEXIST
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(srcRelId, attr, &attrCatEntry);
+    if (response != SUCCESS)
+    {
+        return E_ATTRNOTEXIST;
+    }
+
+
+    /*** Convert strVal to an attribute of data type NUMBER or STRING ***/
+
+    int type = attrCatEntry.attrType;
+    Attribute attrVal;
+
+    if (type == NUMBER)
+    {
+        // if the input argument strVal can be converted to a number
+        // (check this using isNumber() function)
+        if (isNumber(strVal))
+        {
+            // convert strVal to double and store it at attrVal.nVal using atof()
+            attrVal.nVal = atof(strVal);
+        }
+        // else
+        else
+        {
+            return E_ATTRTYPEMISMATCH;
+        }
+    }
+    else if (type == STRING)
+    {
+        // copy strVal to attrVal.sVal
+        strcpy(attrVal.sVal, strVal);
+    }
+
+    /*** Creating and opening the target relation ***/
+    // Prepare arguments for createRel() in the following way:
+    // get RelcatEntry of srcRel using RelCacheTable::getRelCatEntry()
+    RelCatEntry srcRelCatEntry;
+    response = RelCacheTable::getRelCatEntry(srcRelId, &srcRelCatEntry);
+    if (response != SUCCESS)
+    {
+        printf("Invalid Relation ID.\n");
+        exit(1);
+    }
+
+    /* the no. of attributes present in src relation */ ;
+    int src_nAttrs =  srcRelCatEntry.numAttrs;
+
+
+    /* let attr_names[src_nAttrs][ATTR_SIZE] be a 2D array of type char
+        (will store the attribute names of rel). */
+    char attr_names[src_nAttrs][ATTR_SIZE];
+    // let attr_types[src_nAttrs] be an array of type int
+    int attr_types[src_nAttrs];
+
+
+    /*iterate through 0 to src_nAttrs-1 :
+        get the i'th attribute's AttrCatEntry using AttrCacheTable::getAttrCatEntry()
+        fill the attr_names, attr_types arrays that we declared with the entries
+        of corresponding attributes
+    */
+    for (int i = 0; i < src_nAttrs; i++)
+    {
+        AttrCatEntry attrCatEntry;
+        response = AttrCacheTable::getAttrCatEntry(srcRelId, i, &attrCatEntry);
+        if (response != SUCCESS)
+        {
+            printf("Invalid Attribute ID.\n");
+            exit(1);
+        }
+
+        strcpy(attr_names[i], attrCatEntry.attrName);
+        attr_types[i] = attrCatEntry.attrType;
+    }
+
+
+    /* Create the relation for target relation by calling Schema::createRel()
+       by providing appropriate arguments */
+    // if the createRel returns an error code, then return that value.
+    response = Schema::createRel(targetRel, src_nAttrs, attr_names, attr_types);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+
+    /* Open the newly created target relation by calling OpenRelTable::openRel()
+       method and store the target relid */
+    int targetRelId = OpenRelTable::openRel(targetRel);
+    /* If opening fails, delete the target relation by calling Schema::deleteRel()
+       and return the error value returned from openRel() */
+    if (targetRelId < 0){
+        Schema::deleteRel(targetRel);
+        return response;
+    }
+
+    /*** Selecting and inserting records into the target relation ***/
+    /* Before calling the search function, reset the search to start from the
+       first using RelCacheTable::resetSearchIndex() */
+    RelCacheTable::resetSearchIndex(targetRelId);
+
+
+    Attribute record[src_nAttrs];
+
+    /*
+        The BlockAccess::search() function can either do a linearSearch or
+        a B+ tree search. Hence, reset the search index of the relation in the
+        relation cache using RelCacheTable::resetSearchIndex().
+        Also, reset the search index in the attribute cache for the select
+        condition attribute with name given by the argument `attr`. Use
+        AttrCacheTable::resetSearchIndex().
+        Both these calls are necessary to ensure that search begins from the
+        first record.
+    */
+
+    RelCacheTable::resetSearchIndex(srcRelId);
+    AttrCacheTable::resetSearchIndex(srcRelId, attr);
+
+    /* if there is no index on the attribute (for the operator), or a linear
+       search costs less than reading the records through the index (see
+       BlockAccess::planSearch()), scan the relation a block at a time
+       (BlockAccess::scanNext() returns the matching records of a block) */
+    AccessPlan plan;
+    BlockAccess::planSearch(srcRelId, attr, attrVal, op, &plan);
+    if (plan.method == ACCESS_LINEAR)
+    {
+        ScanCursor cursor;
+        BlockAccess::openScan(&cursor, srcRelId, attr, attrVal, op);
+
+        Attribute records[srcRelCatEntry.numSlotsPerBlk * src_nAttrs];
+        int numRecords;
+        while (BlockAccess::scanNext(&cursor, records, nullptr, &numRecords) == SUCCESS)
+        {
+            for (int i = 0; i < numRecords; i++)
+            {
+                response = BlockAccess::insert(targetRelId, records + i * src_nAttrs);
+                if (response != SUCCESS)
+                {
+                    Schema::closeRel(targetRel);
+                    Schema::deleteRel(targetRel);
+                    return response;
+                }
+            }
+        }
+
+        response = Schema::closeRel(targetRel);
+        if (response != SUCCESS)
+        {
+            printf("Invalid Relation ID.\n");
+            exit(1);
+        }
+
+        return SUCCESS;
+    }
+
+    // read every record that satisfies the condition by repeatedly calling
+    // BlockAccess::search() until there are no more records to be read
+
+    response = BlockAccess::search(srcRelId, record, attr, attrVal, op);
+    /* BlockAccess::search() returns success */
+    while (response==SUCCESS) {
+
+        // ret = BlockAccess::insert(targetRelId, record);
+        response = BlockAccess::insert(targetRelId, record);
+
+        // if (insert fails) {
+        //     close the targetrel(by calling Schema::closeRel(targetrel))
+        //     delete targetrel (by calling Schema::deleteRel(targetrel))
+        //     return ret;
+        // }
+        if (response != SUCCESS)
+        {
+            Schema::closeRel(targetRel);
+            Schema::deleteRel(targetRel);
+            return response;
+        }
+        response = BlockAccess::search(srcRelId, record, attr, attrVal, op);
+
+    }
+
+    // Close the targetRel by calling closeRel() method of schema layer
+    response = Schema::closeRel(targetRel);
+
+    if (response != SUCCESS)
+    {
+        printf("Invalid Relation ID.\n");
+        exit(1);
+    }
+
+    // return SUCCESS.
+    return SUCCESS;
+}
+
+/*
+Creates targetRel with the attributes of the relation srcRelId and opens it.
+Returns the rel-id of targetRel, or the error code (targetRel is then not left behind).
+*/
+static int createTargetRel(int srcRelId, char targetRel[ATTR_SIZE])
+{
+    RelCatEntry srcRelCatEntry;
+    int response = RelCacheTable::getRelCatEntry(srcRelId, &srcRelCatEntry);
+    if (response != SUCCESS)
+    {
+        printf("Invalid Relation ID.\n");
+        exit(1);
+    }
+
+    int src_nAttrs = srcRelCatEntry.numAttrs;
+    char attr_names[src_nAttrs][ATTR_SIZE];
+    int attr_types[src_nAttrs];
+    for (int i = 0; i < src_nAttrs; i++)
+    {
+        AttrCatEntry srcAttrCatEntry;
+        response = AttrCacheTable::getAttrCatEntry(srcRelId, i, &srcAttrCatEntry);
+        if (response != SUCCESS)
+        {
+            printf("Invalid Attribute ID.\n");
+            exit(1);
+        }
+
+        strcpy(attr_names[i], srcAttrCatEntry.attrName);
+        attr_types[i] = srcAttrCatEntry.attrType;
+    }
+
+    response = Schema::createRel(targetRel, src_nAttrs, attr_names, attr_types);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    int targetRelId = OpenRelTable::openRel(targetRel);
+    if (targetRelId < 0)
+    {
+        Schema::deleteRel(targetRel);
+    }
+    return targetRelId;
+}
+
+/*
+Creates targetRel with the attributes of the relation srcRelId and inserts the
+records found by the (opened) range scan into it.
+*/
+static int selectRangeScan(int srcRelId, char targetRel[ATTR_SIZE], RangeScanCursor *cursor)
+{
+    /*** Creating and opening the target relation (with the attributes of srcRel) ***/
+    int targetRelId = createTargetRel(srcRelId, targetRel);
+    if (targetRelId < 0)
+    {
+        return targetRelId;
+    }
+
+    RelCatEntry srcRelCatEntry;
+    RelCacheTable::getRelCatEntry(srcRelId, &srcRelCatEntry);
+    int src_nAttrs = srcRelCatEntry.numAttrs;
+    int response;
+
+    /*** Selecting and inserting records into the target relation ***/
+    // (a batch is a record block or a leaf of the B+ tree)
+    int maxRecords = std::max(srcRelCatEntry.numSlotsPerBlk, MAX_KEYS_LEAF_PACKED);
+    Attribute records[maxRecords * src_nAttrs];
+    int numRecords;
+    while (BlockAccess::rangeScanNext(cursor, records, nullptr, &numRecords) == SUCCESS)
+    {
+        for (int i = 0; i < numRecords; i++)
+        {
+            response = BlockAccess::insert(targetRelId, records + i * src_nAttrs);
+            if (response != SUCCESS)
+            {
+                Schema::closeRel(targetRel);
+                Schema::deleteRel(targetRel);
+                return response;
+            }
+        }
+    }
+
+    response = Schema::closeRel(targetRel);
+    if (response != SUCCESS)
+    {
+        printf("Invalid Relation ID.\n");
+        exit(1);
+    }
+
+    return SUCCESS;
+}
+
+/*
+Gets the access path that select() would use for the records of srcRel with
+attr op strVal (see BlockAccess::planSearch()), without selecting them. If op
+is -1, the path is that of selectRange() for the records whose value of attr
+lies between strVal and upperStr.
+*/
+int Algebra::explainSelect(char srcRel[ATTR_SIZE], char attr[ATTR_SIZE], int op, char strVal[ATTR_SIZE],
+                           char upperStr[ATTR_SIZE], AccessPlan *plan) {
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN)
+    {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(srcRelId, attr, &attrCatEntry);
+    if (response != SUCCESS)
+    {
+        return E_ATTRNOTEXIST;
+    }
+
+    /*** Convert strVal (and upperStr) to attributes of the type of attr ***/
+    Attribute attrVal, upperVal;
+    if (attrCatEntry.attrType == NUMBER)
+    {
+        if (!isNumber(strVal) || (op == -1 && !isNumber(upperStr)))
+        {
+            return E_ATTRTYPEMISMATCH;
+        }
+        attrVal.nVal = atof(strVal);
+        if (op == -1)
+        {
+            upperVal.nVal = atof(upperStr);
+        }
+    }
+    else
+    {
+        strcpy(attrVal.sVal, strVal);
+        if (op == -1)
+        {
+            strcpy(upperVal.sVal, upperStr);
+        }
+    }
+
+    if (op == -1)
+    {
+        return BlockAccess::planRangeScan(srcRelId, attr, &attrVal, true, &upperVal, true, plan);
+    }
+    return BlockAccess::planSearch(srcRelId, attr, attrVal, op, plan);
+}
+
+/*
+Selects the records of srcRel whose value of attr lies between lowerStr and
+upperStr (both inclusive) into targetRel. With a B+ tree on attr the tree is
+descended once to lowerStr and its leaves are read up to upperStr; otherwise
+the relation is scanned a block at a time.
+*/
+int Algebra::selectRange(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE],
+                         char lowerStr[ATTR_SIZE], char upperStr[ATTR_SIZE]) {
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN)
+    {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(srcRelId, attr, &attrCatEntry);
+    if (response != SUCCESS)
+    {
+        return E_ATTRNOTEXIST;
+    }
+
+    /*** Convert lowerStr and upperStr to attributes of the type of attr ***/
+    Attribute lowerVal, upperVal;
+    if (attrCatEntry.attrType == NUMBER)
+    {
+        if (!isNumber(lowerStr) || !isNumber(upperStr))
+        {
+            return E_ATTRTYPEMISMATCH;
+        }
+        lowerVal.nVal = atof(lowerStr);
+        upperVal.nVal = atof(upperStr);
+    }
+    else
+    {
+        strcpy(lowerVal.sVal, lowerStr);
+        strcpy(upperVal.sVal, upperStr);
+    }
+
+    RangeScanCursor cursor;
+    response = BlockAccess::openRangeScan(&cursor, srcRelId, attr, &lowerVal, true, &upperVal, true);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    return selectRangeScan(srcRelId, targetRel, &cursor);
+}
+
+/*
+Selects the records of srcRel with eqAttr = eqStr and with a value of attr in
+the range given by lowerStr and upperStr (a bound is absent if nullptr) into
+targetRel. With a composite index whose key starts with (eqAttr, attr) both
+conditions are answered by one descent of its B+ tree.
+*/
+int Algebra::selectPrefixRange(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char eqAttr[ATTR_SIZE],
+                               char eqStr[ATTR_SIZE], char attr[ATTR_SIZE], char *lowerStr, bool lowerInclusive,
+                               char *upperStr, bool upperInclusive) {
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN)
+    {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry eqAttrCatEntry, attrCatEntry;
+    if (AttrCacheTable::getAttrCatEntry(srcRelId, eqAttr, &eqAttrCatEntry) != SUCCESS ||
+        AttrCacheTable::getAttrCatEntry(srcRelId, attr, &attrCatEntry) != SUCCESS)
+    {
+        return E_ATTRNOTEXIST;
+    }
+
+    /*** Convert the strings to attributes of the types of eqAttr and attr ***/
+    Attribute eqVal, lowerVal, upperVal;
+    char *strs[3] = {eqStr, lowerStr, upperStr};
+    Attribute *vals[3] = {&eqVal, &lowerVal, &upperVal};
+    int types[3] = {eqAttrCatEntry.attrType, attrCatEntry.attrType, attrCatEntry.attrType};
+    for (int i = 0; i < 3; i++)
+    {
+        if (strs[i] == nullptr)
+        {
+            continue;
+        }
+        if (types[i] == NUMBER)
+        {
+            if (!isNumber(strs[i]))
+            {
+                return E_ATTRTYPEMISMATCH;
+            }
+            vals[i]->nVal = atof(strs[i]);
+        }
+        else
+        {
+            strcpy(vals[i]->sVal, strs[i]);
+        }
+    }
+
+    RangeScanCursor cursor;
+    int response = BlockAccess::openPrefixRangeScan(&cursor, srcRelId, eqAttr, eqVal, attr,
+                                                    lowerStr != nullptr ? &lowerVal : nullptr, lowerInclusive,
+                                                    upperStr != nullptr ? &upperVal : nullptr, upperInclusive);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    return selectRangeScan(srcRelId, targetRel, &cursor);
+}
+
+/*
+Selects the records of srcRel with attrs[i] = strVals[i] for every i (for some
+i if disjunction is true) into targetRel. The bitmaps of the values in the
+bitmap indexes on the attributes are combined, and only the records they leave
+are read (see BlockAccess::openEqualityScan()).
+*/
+int Algebra::selectEqualities(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int numTerms,
+                              char attrs[][ATTR_SIZE], char strVals[][ATTR_SIZE], bool disjunction) {
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN)
+    {
+        return E_RELNOTOPEN;
+    }
+
+    if (numTerms < 1 || numTerms > MAX_SELECT_TERMS)
+    {
+        return E_INVALID;
+    }
+
+    /*** Convert the strings to attributes of the types of the attributes ***/
+    Attribute attrVals[numTerms];
+    for (int i = 0; i < numTerms; i++)
+    {
+        AttrCatEntry attrCatEntry;
+        if (AttrCacheTable::getAttrCatEntry(srcRelId, attrs[i], &attrCatEntry) != SUCCESS)
+        {
+            return E_ATTRNOTEXIST;
+        }
+
+        if (attrCatEntry.attrType == NUMBER)
+        {
+            if (!isNumber(strVals[i]))
+            {
+                return E_ATTRTYPEMISMATCH;
+            }
+            attrVals[i].nVal = atof(strVals[i]);
+        }
+        else
+        {
+            strcpy(attrVals[i].sVal, strVals[i]);
+        }
+    }
+
+    RangeScanCursor cursor;
+    int response = BlockAccess::openEqualityScan(&cursor, srcRelId, numTerms, attrs, attrVals, disjunction);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    return selectRangeScan(srcRelId, targetRel, &cursor);
+}
+
+/*
+Selects the attributes tar_Attrs of the records of srcRel whose value of attr
+lies in the range given by lowerStr and upperStr (a bound is absent if nullptr)
+into targetRel, from the leaf entries of the B+ tree on attr alone. Returns
+E_NOINDEX, having done nothing, unless attr has a B+ tree and every attribute
+of tar_Attrs is attr or the attribute included in the tree (the caller then
+selects from the records instead).
+*/
+int Algebra::selectIndexOnly(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_nAttrs,
+                             char tar_Attrs[][ATTR_SIZE], char attr[ATTR_SIZE], char *lowerStr, bool lowerInclusive,
+                             char *upperStr, bool upperInclusive) {
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN)
+    {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry;
+    if (AttrCacheTable::getAttrCatEntry(srcRelId, attr, &attrCatEntry) != SUCCESS)
+    {
+        return E_ATTRNOTEXIST;
+    }
+    if (attrCatEntry.rootBlock == -1)
+    {
+        return E_NOINDEX;
+    }
+
+    /*** Checking that the index covers the attributes of target ***/
+    int attr_offset[tar_nAttrs];
+    int attr_types[tar_nAttrs];
+    for (int i = 0; i < tar_nAttrs; i++)
+    {
+        AttrCatEntry tarAttrCatEntry;
+        if (AttrCacheTable::getAttrCatEntry(srcRelId, tar_Attrs[i], &tarAttrCatEntry) != SUCCESS)
+        {
+            return E_ATTRNOTEXIST;
+        }
+        if (tarAttrCatEntry.offset != attrCatEntry.offset && tarAttrCatEntry.offset != attrCatEntry.includeOffset)
+        {
+            return E_NOINDEX;
+        }
+
+        attr_offset[i] = tarAttrCatEntry.offset;
+        attr_types[i] = tarAttrCatEntry.attrType;
+    }
+
+    /*** Convert lowerStr and upperStr to attributes of the type of attr ***/
+    Attribute lowerVal, upperVal;
+    char *strs[2] = {lowerStr, upperStr};
+    Attribute *vals[2] = {&lowerVal, &upperVal};
+    for (int i = 0; i < 2; i++)
+    {
+        if (strs[i] == nullptr)
+        {
+            continue;
+        }
+        if (attrCatEntry.attrType == NUMBER)
+        {
+            if (!isNumber(strs[i]))
+            {
+                return E_ATTRTYPEMISMATCH;
+            }
+            vals[i]->nVal = atof(strs[i]);
+        }
+        else
+        {
+            strcpy(vals[i]->sVal, strs[i]);
+        }
+    }
+
+    RangeScanCursor cursor;
+    int response = BlockAccess::openIndexOnlyScan(&cursor, srcRelId, attr,
+                                                  lowerStr != nullptr ? &lowerVal : nullptr, lowerInclusive,
+                                                  upperStr != nullptr ? &upperVal : nullptr, upperInclusive);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    /*** Creating and opening the target relation ***/
+    response = Schema::createRel(targetRel, tar_nAttrs, tar_Attrs, attr_types);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    int targetRelId = OpenRelTable::openRel(targetRel);
+    if (targetRelId < 0)
+    {
+        Schema::deleteRel(targetRel);
+        return targetRelId;
+    }
+
+    /*** Inserting projected records into the target relation ***/
+    // (the records of a leaf have only the attributes in the index set)
+    RelCatEntry srcRelCatEntry;
+    RelCacheTable::getRelCatEntry(srcRelId, &srcRelCatEntry);
+    int src_nAttrs = srcRelCatEntry.numAttrs;
+
+    Attribute records[MAX_KEYS_LEAF_PACKED * src_nAttrs];
+    int numRecords;
+    while (BlockAccess::rangeScanNext(&cursor, records, nullptr, &numRecords) == SUCCESS)
+    {
+        for (int recordIndex = 0; recordIndex < numRecords; recordIndex++)
         {
-            // if the char array record[i] can be converted to a number
-            // (check this using isNumber() function)   
-            if (isNumber(record[i]))
+            Attribute *record = records + recordIndex * src_nAttrs;
+
+            Attribute proj_record[tar_nAttrs];
+            for (int i = 0; i < tar_nAttrs; i++)
             {
-                /* convert the char array to numeral and store it
-                   at recordValues[i].nVal using atof() */
-                recordValues[i].nVal = atof(record[i]);
+                proj_record[i] = record[attr_offset[i]];
             }
-            // else
-            else
+
+            response = BlockAccess::insert(targetRelId, proj_record);
+            if (response != SUCCESS)
             {
-                return E_ATTRTYPEMISMATCH;
+                Schema::closeRel(targetRel);
+                Schema::deleteRel(targetRel);
+                return response;
             }
         }
-        else if (type == STRING)
-        {
-            // copy record[i] to recordValues[i].sVal
-            strcpy(recordValues[i].sVal, record[i]); 
-        }
     }
 
-    // insert the record by calling BlockAccess::insert() function
-    // let retVal denote the return value of insert call
-    return BlockAccess::insert(relId, recordValues);
+    response = Schema::closeRel(targetRel);
+    if (response != SUCCESS)
+    {
+        printf("Invalid Relation ID.\n");
+        exit(1);
+    }
 
+    return SUCCESS;
 }
 
-int Algebra::select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE], int op, char strVal[ATTR_SIZE]) {
-    // get the srcRel's rel-id (let it be srcRelid), using OpenRelTable::getRelId()
-    // if srcRel is not open in open relation table, return E_RELNOTOPEN
+typedef int (*FilterRecordsFunction)(Attribute *records, int numRecords, int numAttrs, int attrOffset,
+                                     const Attribute &attrVal);
+
+/*
+Moves the records (of numAttrs attributes each) that satisfy `attr op attrVal`
+to the front of `records`, keeping their order, and returns their number.
+(instantiated for every attribute type and op, see Buffer/Predicate.h)
+*/
+template <int ATTR_TYPE, int OP>
+static int filterRecords(Attribute *records, int numRecords, int numAttrs, int attrOffset, const Attribute &attrVal)
+{
+    int numKept = 0;
+    for (int i = 0; i < numRecords; i++)
+    {
+        if (Predicate<ATTR_TYPE, OP>::satisfies(records[i * numAttrs + attrOffset], attrVal))
+        {
+            if (numKept != i)
+            {
+                std::copy(records + i * numAttrs, records + (i + 1) * numAttrs, records + numKept * numAttrs);
+            }
+            numKept++;
+        }
+    }
+    return numKept;
+}
 
+static const FilterRecordsFunction filterRecordsFunctions[2][6] = PREDICATE_DISPATCH_TABLE(filterRecords);
+
+/*
+Selects the records of srcRel with attr op strVal (every record if attr is
+nullptr) into targetRel, in ascending order of orderAttr (descending if
+`descending`).
+If orderAttr has a B+ tree, its leaves are read in order (along their rblock
+chain, or their lblock chain for a descending order) and the record of every
+entry is fetched, so the records come out in order without being sorted; a
+condition on orderAttr itself (other than !=) bounds the part of the tree
+read. Otherwise the records that satisfy the condition are found with a scan
+of the relation and sorted with ExternalSort (in memory if they fit in
+SORT_MEMORY_BLOCKS blocks). Either way the records are appended to targetRel
+one after the other (see BlockAccess::insertBegin()), so they keep their order.
+The records with equal values of orderAttr are in no particular order.
+*/
+int Algebra::selectOrdered(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE], int op,
+                           char strVal[ATTR_SIZE], char orderAttr[ATTR_SIZE], bool descending) {
     int srcRelId = OpenRelTable::getRelId(srcRel);
     if (srcRelId == E_RELNOTOPEN)
     {
         return E_RELNOTOPEN;
     }
 
-    // get the attr-cat entry for attr, using AttrCacheTable::getAttrCatEntry()
-    // if getAttrcatEntry() call fails return E_ATTRNOTEXIST
-    AttrCatEntry attrCatEntry;
-    int response = AttrCacheTable::getAttrCatEntry(srcRelId, attr, &attrCatEntry);
-    if (response != SUCCESS)
+    AttrCatEntry orderAttrCatEntry;
+    if (AttrCacheTable::getAttrCatEntry(srcRelId, orderAttr, &orderAttrCatEntry) != SUCCESS)
     {
         return E_ATTRNOTEXIST;
     }
 
-
-    /*** Convert strVal to an attribute of data type NUMBER or STRING ***/
-
-    int type = attrCatEntry.attrType;
+    /*** Convert strVal to an attribute of the type of attr ***/
+    AttrCatEntry attrCatEntry;
     Attribute attrVal;
-
-    if (type == NUMBER)
+    if (attr != nullptr)
     {
-        // if the input argument strVal can be converted to a number
-        // (check this using isNumber() function)
-        if (isNumber(strVal))
+        if (AttrCacheTable::getAttrCatEntry(srcRelId, attr, &attrCatEntry) != SUCCESS)
         {
-            // convert strVal to double and store it at attrVal.nVal using atof()
+            return E_ATTRNOTEXIST;
+        }
+
+        if (attrCatEntry.attrType == NUMBER)
+        {
+            if (!isNumber(strVal))
+            {
+                return E_ATTRTYPEMISMATCH;
+            }
             attrVal.nVal = atof(strVal);
         }
-        // else
         else
         {
-            return E_ATTRTYPEMISMATCH;
+            strcpy(attrVal.sVal, strVal);
         }
     }
-    else if (type == STRING)
-    {
-        // copy strVal to attrVal.sVal
-        strcpy(attrVal.sVal, strVal);
-    }
 
-    /*** Creating and opening the target relation ***/
-    // Prepare arguments for createRel() in the following way:
-    // get RelcatEntry of srcRel using RelCacheTable::getRelCatEntry()
     RelCatEntry srcRelCatEntry;
-    response = RelCacheTable::getRelCatEntry(srcRelId, &srcRelCatEntry);
-    if (response != SUCCESS)
+    RelCacheTable::getRelCatEntry(srcRelId, &srcRelCatEntry);
+    int src_nAttrs = srcRelCatEntry.numAttrs;
+
+    /*** Reading the records in order from the B+ tree on orderAttr ***/
+    if (orderAttrCatEntry.rootBlock != -1)
     {
-        printf("Invalid Relation ID.\n");
-        exit(1);
-    }
+        // (a condition on orderAttr is a range of the tree, with one bound or with both for =)
+        bool bounded = (attr != nullptr && op != NE && attrCatEntry.offset == orderAttrCatEntry.offset);
+        Attribute *lowerVal = (bounded && (op == GT || op == GE || op == EQ)) ? &attrVal : nullptr;
+        Attribute *upperVal = (bounded && (op == LT || op == LE || op == EQ)) ? &attrVal : nullptr;
+
+        RangeScanCursor cursor;
+        int response = BlockAccess::openOrderedScan(&cursor, srcRelId, orderAttr, descending,
+                                                    lowerVal, op != GT, upperVal, op != LT);
+        if (response != SUCCESS)
+        {
+            return response;
+        }
 
-    /* the no. of attributes present in src relation */ ;
-    int src_nAttrs =  srcRelCatEntry.numAttrs;
+        int targetRelId = createTargetRel(srcRelId, targetRel);
+        if (targetRelId < 0)
+        {
+            return targetRelId;
+        }
 
+        // (any other condition is tested on the records read, as in a scan)
+        FilterRecordsFunction filterRecords =
+            (attr != nullptr && !bounded) ? filterRecordsFunctions[attrCatEntry.attrType][op] : nullptr;
 
-    /* let attr_names[src_nAttrs][ATTR_SIZE] be a 2D array of type char
-        (will store the attribute names of rel). */
-    char attr_names[src_nAttrs][ATTR_SIZE];
-    // let attr_types[src_nAttrs] be an array of type int
-    int attr_types[src_nAttrs];
+        InsertBatch batch;
+        BlockAccess::insertBegin(&batch, targetRelId);
+
+        Attribute records[std::max(srcRelCatEntry.numSlotsPerBlk, MAX_KEYS_LEAF_PACKED) * src_nAttrs];
+        int numRecords;
+        while (BlockAccess::rangeScanNext(&cursor, records, nullptr, &numRecords) == SUCCESS)
+        {
+            if (filterRecords != nullptr)
+            {
+                numRecords = filterRecords(records, numRecords, src_nAttrs, attrCatEntry.offset, attrVal);
+            }
 
+            for (int i = 0; i < numRecords; i++)
+            {
+                Attribute *record = records + i * src_nAttrs;
+                response = BlockAccess::insert(targetRelId, record, &batch);
+                if (response != SUCCESS)
+                {
+                    BlockAccess::insertEnd(&batch);
+                    Schema::closeRel(targetRel);
+                    Schema::deleteRel(targetRel);
+                    return response;
+                }
+            }
+        }
+        BlockAccess::insertEnd(&batch);
 
-    /*iterate through 0 to src_nAttrs-1 :
-        get the i'th attribute's AttrCatEntry using AttrCacheTable::getAttrCatEntry()
-        fill the attr_names, attr_types arrays that we declared with the entries
-        of corresponding attributes
-    */
-    for (int i = 0; i < src_nAttrs; i++)
-    {
-        AttrCatEntry attrCatEntry;
-        response = AttrCacheTable::getAttrCatEntry(srcRelId, i, &attrCatEntry);
+        response = Schema::closeRel(targetRel);
         if (response != SUCCESS)
         {
-            printf("Invalid Attribute ID.\n");
+            printf("Invalid Relation ID.\n");
             exit(1);
         }
 
-        strcpy(attr_names[i], attrCatEntry.attrName);
-        attr_types[i] = attrCatEntry.attrType;
+        return SUCCESS;
     }
 
-
-    /* Create the relation for target relation by calling Schema::createRel()
-       by providing appropriate arguments */
-    // if the createRel returns an error code, then return that value.
-    response = Schema::createRel(targetRel, src_nAttrs, attr_names, attr_types);
+    /*** Sorting the records that satisfy the condition ***/
+    SortState sortState;
+    int response = ExternalSort::sortBegin(&sortState, src_nAttrs, orderAttrCatEntry.offset,
+                                           orderAttrCatEntry.attrType, SORT_MEMORY_BLOCKS, descending);
     if (response != SUCCESS)
     {
         return response;
     }
 
+    ScanCursor scanCursor;
+    BlockAccess::openScan(&scanCursor, srcRelId, attr, attr != nullptr ? attrVal : Attribute(), op);
 
-    /* Open the newly created target relation by calling OpenRelTable::openRel()
-       method and store the target relid */
-    int targetRelId = OpenRelTable::openRel(targetRel);
-    /* If opening fails, delete the target relation by calling Schema::deleteRel()
-       and return the error value returned from openRel() */
-    if (targetRelId < 0){
-        Schema::deleteRel(targetRel);
+    Attribute records[srcRelCatEntry.numSlotsPerBlk * src_nAttrs];
+    int numRecords;
+    while (response == SUCCESS && BlockAccess::scanNext(&scanCursor, records, nullptr, &numRecords) == SUCCESS)
+    {
+        for (int i = 0; i < numRecords && response == SUCCESS; i++)
+        {
+            response = ExternalSort::sortAdd(&sortState, records + i * src_nAttrs);
+        }
+    }
+    if (response == SUCCESS)
+    {
+        response = ExternalSort::sortEnd(&sortState);
+    }
+    if (response != SUCCESS)
+    {
+        ExternalSort::sortClose(&sortState);
         return response;
     }
 
-    /*** Selecting and inserting records into the target relation ***/
-    /* Before calling the search function, reset the search to start from the
-       first using RelCacheTable::resetSearchIndex() */
-    RelCacheTable::resetSearchIndex(targetRelId);
+    int targetRelId = createTargetRel(srcRelId, targetRel);
+    if (targetRelId < 0)
+    {
+        ExternalSort::sortClose(&sortState);
+        return targetRelId;
+    }
 
+    InsertBatch batch;
+    BlockAccess::insertBegin(&batch, targetRelId);
 
     Attribute record[src_nAttrs];
-
-    /*
-        The BlockAccess::search() function can either do a linearSearch or
-        a B+ tree search. Hence, reset the search index of the relation in the
-        relation cache using RelCacheTable::resetSearchIndex().
-        Also, reset the search index in the attribute cache for the select
-        condition attribute with name given by the argument `attr`. Use
-        AttrCacheTable::resetSearchIndex().
-        Both these calls are necessary to ensure that search begins from the
-        first record.
-    */
-
-    RelCacheTable::resetSearchIndex(srcRelId);
-    // AttrCacheTable::resetSearchIndex(srcRelId, attr);
-
-    // read every record that satisfies the condition by repeatedly calling
-    // BlockAccess::search() until there are no more records to be read
-
-    response = BlockAccess::search(srcRelId, record, attr, attrVal, op);
-    /* BlockAccess::search() returns success */
-    while (response==SUCCESS) {
-
-        // ret = BlockAccess::insert(targetRelId, record);
-        response = BlockAccess::insert(targetRelId, record);
-
-        // if (insert fails) {
-        //     close the targetrel(by calling Schema::closeRel(targetrel))
-        //     delete targetrel (by calling Schema::deleteRel(targetrel))
-        //     return ret;
-        // }
+    while (ExternalSort::sortNext(&sortState, record) == SUCCESS)
+    {
+        response = BlockAccess::insert(targetRelId, record, &batch);
         if (response != SUCCESS)
         {
+            BlockAccess::insertEnd(&batch);
+            ExternalSort::sortClose(&sortState);
             Schema::closeRel(targetRel);
             Schema::deleteRel(targetRel);
             return response;
         }
-        response = BlockAccess::search(srcRelId, record, attr, attrVal, op);
-
     }
+    BlockAccess::insertEnd(&batch);
+    ExternalSort::sortClose(&sortState);
 
-    // Close the targetRel by calling closeRel() method of schema layer
     response = Schema::closeRel(targetRel);
-
     if (response != SUCCESS)
     {
         printf("Invalid Relation ID.\n");
         exit(1);
     }
 
-    // return SUCCESS.
     return SUCCESS;
 }
 
+/*
+Sets *value to the smallest value of attr among the records of srcRel (the
+largest if `max`), and *attrType to the type of attr. With a B+ tree on attr, it is the key of the first (last)
+entry of the tree, found with a single descent (see BPlusTree::edgeEntry());
+otherwise the relation is scanned once. Returns E_NOTFOUND if srcRel has no
+records.
+*/
+int Algebra::minMax(char srcRel[ATTR_SIZE], char attr[ATTR_SIZE], bool max, Attribute *value, int *attrType) {
+    int srcRelId = OpenRelTable::getRelId(srcRel);
+    if (srcRelId == E_RELNOTOPEN)
+    {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry;
+    if (AttrCacheTable::getAttrCatEntry(srcRelId, attr, &attrCatEntry) != SUCCESS)
+    {
+        return E_ATTRNOTEXIST;
+    }
+    *attrType = attrCatEntry.attrType;
+
+    if (attrCatEntry.rootBlock != -1)
+    {
+        Index entry;
+        int response = BPlusTree::edgeEntry(srcRelId, attr, max, &entry);
+        if (response != SUCCESS)
+        {
+            return response;
+        }
+
+        *value = entry.attrVal;
+        return SUCCESS;
+    }
+
+    RelCatEntry srcRelCatEntry;
+    RelCacheTable::getRelCatEntry(srcRelId, &srcRelCatEntry);
+    int src_nAttrs = srcRelCatEntry.numAttrs;
+
+    ScanCursor cursor;
+    BlockAccess::openScan(&cursor, srcRelId, nullptr, Attribute(), EQ);
+
+    Attribute records[srcRelCatEntry.numSlotsPerBlk * src_nAttrs];
+    int numRecords;
+    bool found = false;
+    while (BlockAccess::scanNext(&cursor, records, nullptr, &numRecords) == SUCCESS)
+    {
+        for (int i = 0; i < numRecords; i++)
+        {
+            Attribute recordVal = records[i * src_nAttrs + attrCatEntry.offset];
+            int cmpVal = found ? compareAttrs(recordVal, *value, attrCatEntry.attrType) : 0;
+            if (!found || (max ? cmpVal > 0 : cmpVal < 0))
+            {
+                *value = recordVal;
+                found = true;
+            }
+        }
+    }
+
+    return found ? SUCCESS : E_NOTFOUND;
+}
+
 int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE]) {
 
     /*srcRel's rel-id (use OpenRelTable::getRelId() function)*/
@@ -358,31 +1235,31 @@ int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE]) {
 
     /*** Inserting projected records into the target relation ***/
 
-    // Take care to reset the searchIndex before calling the project function
-    // using RelCacheTable::resetSearchIndex()
-    RelCacheTable::resetSearchIndex(srcRelId);
-
-    Attribute record[src_nAttrs];
+    // the records of the source relation are read a block at a time
+    // (the scan does not use the search index in the relation cache)
+    ScanCursor cursor;
+    BlockAccess::openScan(&cursor, srcRelId, nullptr, Attribute(), EQ);
 
-    response = BlockAccess::project(srcRelId, record);
+    Attribute records[srcRelCatEntry.numSlotsPerBlk * src_nAttrs];
+    int numRecords;
 
-    /* BlockAccess::project(srcRelId, record) returns SUCCESS */
-    while (response== SUCCESS)
+    /* BlockAccess::scanNext() returns SUCCESS */
+    while (BlockAccess::scanNext(&cursor, records, nullptr, &numRecords) == SUCCESS)
     {
-        // record will contain the next record
-
-        // ret = BlockAccess::insert(targetRelId, proj_record);
-        response = BlockAccess::insert(targetRelId, record);
-        /* insert fails */
-        if (response != SUCCESS) {
-            // close the targetrel by calling Schema::closeRel()
-            Schema::closeRel(targetRel);
-            // delete targetrel by calling Schema::deleteRel()
-            Schema::deleteRel(targetRel);
-            // return ret;
-            return response;
+        for (int i = 0; i < numRecords; i++)
+        {
+            // ret = BlockAccess::insert(targetRelId, record);
+            response = BlockAccess::insert(targetRelId, records + i * src_nAttrs);
+            /* insert fails */
+            if (response != SUCCESS) {
+                // close the targetrel by calling Schema::closeRel()
+                Schema::closeRel(targetRel);
+                // delete targetrel by calling Schema::deleteRel()
+                Schema::deleteRel(targetRel);
+                // return ret;
+                return response;
+            }
         }
-        response = BlockAccess::project(srcRelId, record);
     }
 
     // Close the targetRel by calling Schema::closeRel()
@@ -480,50 +1357,53 @@ int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_
 
     /*** Inserting projected records into the target relation ***/
 
-    // Take care to reset the searchIndex before calling the project function
-    // using RelCacheTable::resetSearchIndex()
-    RelCacheTable::resetSearchIndex(srcRelId);
+    // the records of the source relation are read a block at a time
+    // (the scan does not use the search index in the relation cache)
+    ScanCursor cursor;
+    BlockAccess::openScan(&cursor, srcRelId, nullptr, Attribute(), EQ);
 
-    Attribute record[src_nAttrs];
+    Attribute records[srcRelCatEntry.numSlotsPerBlk * src_nAttrs];
+    int numRecords;
 
-    /* BlockAccess::project(srcRelId, record) returns SUCCESS */
-    response = BlockAccess::project(srcRelId, record);
-    while (response== SUCCESS) {
-        // the variable `record` will contain the next record
+    /* BlockAccess::scanNext() returns SUCCESS */
+    while (BlockAccess::scanNext(&cursor, records, nullptr, &numRecords) == SUCCESS) {
+        for (int recordIndex = 0; recordIndex < numRecords; recordIndex++) {
+            // the records of the block are stored one after the other in `records`
+            Attribute *record = records + recordIndex * src_nAttrs;
 
-        Attribute proj_record[tar_nAttrs];
+            Attribute proj_record[tar_nAttrs];
 
-        //iterate through 0 to tar_attrs-1:
-        //    proj_record[attr_iter] = record[attr_offset[attr_iter]]
-        for (int i = 0; i < tar_nAttrs; i++)
-        {
-            proj_record[i] = record[attr_offset[i]];
-        }
+            //iterate through 0 to tar_attrs-1:
+            //    proj_record[attr_iter] = record[attr_offset[attr_iter]]
+            for (int i = 0; i < tar_nAttrs; i++)
+            {
+                proj_record[i] = record[attr_offset[i]];
+            }
 
-        // ret = BlockAccess::insert(targetRelId, proj_record);
-        response = BlockAccess::insert(targetRelId, proj_record);
+            // ret = BlockAccess::insert(targetRelId, proj_record);
+            response = BlockAccess::insert(targetRelId, proj_record);
 
-        if (response != SUCCESS) {
-            // close the targetrel by calling Schema::closeRel()
-            response = Schema::closeRel(targetRel);
+            if (response != SUCCESS) {
+                // close the targetrel by calling Schema::closeRel()
+                response = Schema::closeRel(targetRel);
 
-            if (response != SUCCESS)
-            {
-                printf("Invalid Relation ID.\n");
-                exit(1);
-            }
-            // delete targetrel by calling Schema::deleteRel()
-            response = Schema::deleteRel(targetRel);
+                if (response != SUCCESS)
+                {
+                    printf("Invalid Relation ID.\n");
+                    exit(1);
+                }
+                // delete targetrel by calling Schema::deleteRel()
+                response = Schema::deleteRel(targetRel);
 
-            if (response != SUCCESS)
-            {
-                printf("Invalid Relation ID.\n");
-                exit(1);
+                if (response != SUCCESS)
+                {
+                    printf("Invalid Relation ID.\n");
+                    exit(1);
+                }
+                // return ret;
+                return response;
             }
-            // return ret;
-            return response;
         }
-        response = BlockAccess::project(srcRelId, record);
     }
 
     // Close the targetRel by calling Schema::closeRel()
@@ -538,6 +1418,44 @@ int Algebra::project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_
     return SUCCESS;
 }
 
+/*
+Returns true if the equi-join of relId1 and relId2 (attrName2 having no index)
+is expected to be cheaper with a B+ tree built on attrName2 than with a linear
+search of relId2 for each record of relId1. The number of records each search
+finds is estimated from the statistics of the attributes (see
+Statistics::estimateJoin()), and the costs are those of BlockAccess::costPlan(),
+the B+ tree also costing a scan of relId2 and the write of its leaves to build.
+A B+ tree is built if the attributes have not been analyzed.
+*/
+static bool joinBuildsIndex(int relId1, char attrName1[ATTR_SIZE], int relId2, char attrName2[ATTR_SIZE])
+{
+    double numJoined;
+    if (Statistics::estimateJoin(relId1, attrName1, relId2, attrName2, &numJoined) != SUCCESS)
+    {
+        return true;
+    }
+
+    RelCatEntry relCatEntry1, relCatEntry2;
+    RelCacheTable::getRelCatEntry(relId1, &relCatEntry1);
+    RelCacheTable::getRelCatEntry(relId2, &relCatEntry2);
+    double numRecs1 = relCatEntry1.numRecs, numRecs2 = std::max(1, relCatEntry2.numRecs);
+
+    // (the records of relId2 found for each record of relId1)
+    double numFound = numRecs1 == 0 ? 0 : numJoined / numRecs1;
+
+    double numBlocks = std::ceil(numRecs2 / relCatEntry2.numSlotsPerBlk);
+    double linearCost = numRecs1 * (numBlocks + numFound * RECORD_COST);
+
+    // (a tree built in bulk, its leaves filled to INDEX_FILL_FACTOR percent)
+    double numLeaves = std::ceil(numRecs2 / (MAX_KEYS_LEAF_PACKED * INDEX_FILL_FACTOR / 100.0));
+    double numInternalLevels = std::ceil(std::log(numLeaves) / std::log(MAX_KEYS_INTERNAL + 1));
+    double searchCost = numInternalLevels + std::max(1.0, std::ceil(numLeaves * numFound / numRecs2)) +
+                        numFound * (RECORD_COST + FETCH_COST);
+    double indexCost = numBlocks + numLeaves + numRecs1 * searchCost;
+
+    return indexCost < linearCost;
+}
+
 int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE], char targetRelation[ATTR_SIZE], char attribute1[ATTR_SIZE], char attribute2[ATTR_SIZE]) {
 
     // get the srcRelation1's rel-id using OpenRelTable::getRelId() method
@@ -629,7 +1547,11 @@ int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE], ch
     //     if call fails, return the appropriate error code
     //     (if your implementation is correct, the only error code that will
     //      be returned here is E_DISKFULL)
-    if(attrCatEntry2.rootBlock == -1) {
+    // (a hash or bitmap index on attr2 answers the equality probes of the join by itself)
+    // (the B+ tree is not built if each record of rel1 is expected to find so many
+    //  records of rel2 that a linear search of rel2 is cheaper, see joinBuildsIndex())
+    if(attrCatEntry2.rootBlock == -1 && attrCatEntry2.hashBlock == -1 && attrCatEntry2.bitmapBlock == -1 &&
+       joinBuildsIndex(srcRelId1, attribute1, srcRelId2, attribute2)) {
         int response = BPlusTree::bPlusCreate(srcRelId2, attrCatEntry2.attrName);
         if(response != SUCCESS) {
             return response;
@@ -700,66 +1622,69 @@ int Algebra::join(char srcRelation1[ATTR_SIZE], char srcRelation2[ATTR_SIZE], ch
     }
    
 
-    Attribute record1[numOfAttributes1];
     Attribute record2[numOfAttributes2];
     Attribute targetRecord[numOfAttributesInTarget];
 
-    // reset search index srcRelId1
-    response1 = RelCacheTable::resetSearchIndex(srcRelId1);
-
-    response2 = AttrCacheTable::resetSearchIndex(srcRelId1, attribute1);
+    // the records of srcRelation1 are read a block at a time
+    ScanCursor cursor;
+    BlockAccess::openScan(&cursor, srcRelId1, nullptr, Attribute(), EQ);
 
+    Attribute records1[relCatEntry1.numSlotsPerBlk * numOfAttributes1];
+    int numRecords1;
 
     // this loop is to get every record of the srcRelation1 one by one
-    while (BlockAccess::project(srcRelId1, record1) == SUCCESS) {
-
-        // reset the search index of `srcRelation2` in the relation cache
-        // using RelCacheTable::resetSearchIndex()
-        response1 = RelCacheTable::resetSearchIndex(srcRelId2);
-
-        // reset the search index of `attribute2` in the attribute cache
-        // using AttrCacheTable::resetSearchIndex()
-        response2 = AttrCacheTable::resetSearchIndex(srcRelId2, attribute2);
-
-        // this loop is to get every record of the srcRelation2 which satisfies
-        //the following condition:
-        // record1.attribute1 = record2.attribute2 (i.e. Equi-Join condition)
-
-
-        while (BlockAccess::search(
-            srcRelId2, record2, attribute2, record1[attrCatEntry1.offset], EQ
-        ) == SUCCESS ) {
-
-            // copy srcRelation1's and srcRelation2's attribute values(except
-            // for attribute2 in rel2) from record1 and record2 to targetRecord
-            // respectively
-            int targetRelAttrIndex = 0;
-            for(int i = 0; i < numOfAttributes1; i++) {
-                targetRecord[targetRelAttrIndex] = record1[i];
-                targetRelAttrIndex++;
-            }
+    while (BlockAccess::scanNext(&cursor, records1, nullptr, &numRecords1) == SUCCESS) {
+        for (int recordIndex1 = 0; recordIndex1 < numRecords1; recordIndex1++) {
+            Attribute *record1 = records1 + recordIndex1 * numOfAttributes1;
+
+            // reset the search index of `srcRelation2` in the relation cache
+            // using RelCacheTable::resetSearchIndex()
+            response1 = RelCacheTable::resetSearchIndex(srcRelId2);
+
+            // reset the search index of `attribute2` in the attribute cache
+            // using AttrCacheTable::resetSearchIndex()
+            response2 = AttrCacheTable::resetSearchIndex(srcRelId2, attribute2);
+
+            // this loop is to get every record of the srcRelation2 which satisfies
+            //the following condition:
+            // record1.attribute1 = record2.attribute2 (i.e. Equi-Join condition)
+
+
+            while (BlockAccess::search(
+                srcRelId2, record2, attribute2, record1[attrCatEntry1.offset], EQ
+            ) == SUCCESS ) {
+
+                // copy srcRelation1's and srcRelation2's attribute values(except
+                // for attribute2 in rel2) from record1 and record2 to targetRecord
+                // respectively
+                int targetRelAttrIndex = 0;
+                for(int i = 0; i < numOfAttributes1; i++) {
+                    targetRecord[targetRelAttrIndex] = record1[i];
+                    targetRelAttrIndex++;
+                }
 
-            for(int i = 0; i < numOfAttributes2; i++) {
-                if(i == attrCatEntry2.offset) {
-                    continue;
+                for(int i = 0; i < numOfAttributes2; i++) {
+                    if(i == attrCatEntry2.offset) {
+                        continue;
+                    }
+                    targetRecord[targetRelAttrIndex] = record2[i];
+                    targetRelAttrIndex++;
                 }
-                targetRecord[targetRelAttrIndex] = record2[i];
-                targetRelAttrIndex++;
-            }
             
 
 
-            // insert the current record into the target relation by calling
-            // BlockAccess::insert()
-            response1 = BlockAccess::insert(targetRelId, targetRecord);
+                // insert the current record into the target relation by calling
+                // BlockAccess::insert()
+                response1 = BlockAccess::insert(targetRelId, targetRecord);
 
             
-            /* insert fails (insert should fail only due to DISK being FULL) */
-            if(response1 != SUCCESS) {
+                /* insert fails (insert should fail only due to DISK being FULL) */
+                if(response1 != SUCCESS) {
 
-                // close the target relation by calling OpenRelTable::closeRel()
-                // delete targetRelation (by calling Schema::deleteRel())
-                return E_DISKFULL;
+                    // close the target relation by calling OpenRelTable::closeRel()
+                    // delete targetRelation (by calling Schema::deleteRel())
+                    return E_DISKFULL;
+                }
             }
         }
     }
@@ -8,11 +8,49 @@
 class Algebra {
  public:
   // Insert
-  static int insert(char relName[ATTR_SIZE], int numberOfAttributes, char record[][ATTR_SIZE]);
+  static int insert(char relName[ATTR_SIZE], int numberOfAttributes, char record[][ATTR_SIZE],
+                    InsertBatch *batch = nullptr);
+
+  // Insert (several records, with their index entries inserted at once)
+  static int insertRecords(char relName[ATTR_SIZE], int numRecords, int numberOfAttributes,
+                           char records[][ATTR_SIZE], int *numInserted);
+
+  // Delete
+  static int deleteRecords(char relName[ATTR_SIZE], char attr[ATTR_SIZE], int op, char strVal[ATTR_SIZE],
+                           int *numDeleted);
 
   // Select
   static int select(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE], int op, char strVal[ATTR_SIZE]);
 
+  // Select (range of values)
+  static int selectRange(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE],
+                         char lowerStr[ATTR_SIZE], char upperStr[ATTR_SIZE]);
+
+  // Select (value of one attribute and range of values of another)
+  static int selectPrefixRange(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char eqAttr[ATTR_SIZE],
+                               char eqStr[ATTR_SIZE], char attr[ATTR_SIZE], char *lowerStr, bool lowerInclusive,
+                               char *upperStr, bool upperInclusive);
+
+  // Select (equalities joined by AND, or by OR)
+  static int selectEqualities(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int numTerms,
+                              char attrs[][ATTR_SIZE], char strVals[][ATTR_SIZE], bool disjunction);
+
+  // Select and project, from the leaves of a B+ tree (covering index)
+  static int selectIndexOnly(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], int tar_nAttrs,
+                             char tar_Attrs[][ATTR_SIZE], char attr[ATTR_SIZE], char *lowerStr, bool lowerInclusive,
+                             char *upperStr, bool upperInclusive);
+
+  // Select, in the order of an attribute (every record if attr is nullptr)
+  static int selectOrdered(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE], char attr[ATTR_SIZE], int op,
+                           char strVal[ATTR_SIZE], char orderAttr[ATTR_SIZE], bool descending);
+
+  // Smallest (or largest) value of an attribute
+  static int minMax(char srcRel[ATTR_SIZE], char attr[ATTR_SIZE], bool max, union Attribute *value, int *attrType);
+
+  // Access path of a select (of a range of values, if op is -1)
+  static int explainSelect(char srcRel[ATTR_SIZE], char attr[ATTR_SIZE], int op, char strVal[ATTR_SIZE],
+                           char upperStr[ATTR_SIZE], AccessPlan *plan);
+
   // Project all (Copy)
   static int project(char srcRel[ATTR_SIZE], char targetRel[ATTR_SIZE]);
 
@@ -1,6 +1,97 @@
 #include "BPlusTree.h"
+
+#include "../Buffer/BlockLatch.h"
+#include "../Buffer/NodeCache.h"
+#include "../Buffer/Predicate.h"
+
+#include <algorithm>
 #include <iostream>
 #include <cstring>
+#include <mutex>
+#include <vector>
+
+typedef int (*FindLeafEntryFunction)(const Index *entries, int numEntries, const Attribute &attrVal, int index,
+                                     bool *pastRange);
+
+/*
+Returns the first of the entries of a leaf from `index` onwards that satisfies
+`attrVal op` (the key op attrVal), -1 if there is none. pastRange is set if an
+entry shows that no later entry can satisfy the condition.
+(instantiated for every attribute type and op, see Buffer/Predicate.h)
+*/
+template <int ATTR_TYPE, int OP>
+static int findLeafEntry(const Index *entries, int numEntries, const Attribute &attrVal, int index,
+                         bool *pastRange) {
+    *pastRange = false;
+    for (; index < numEntries; index++) {
+        if (Predicate<ATTR_TYPE, OP>::satisfies(entries[index].attrVal, attrVal)) {
+            return index;
+        }
+
+        // (the keys are in ascending order; after a key greater than attrVal, none satisfies EQ, LE or LT)
+        if ((OP == EQ || OP == LE || OP == LT) && Predicate<ATTR_TYPE, GT>::satisfies(entries[index].attrVal, attrVal)) {
+            *pastRange = true;
+            return -1;
+        }
+    }
+    return -1;
+}
+
+static const FindLeafEntryFunction findLeafEntryFunctions[2][6] = PREDICATE_DISPATCH_TABLE(findLeafEntry);
+
+// held while the root block of a B+ tree is changed, or read by bPlusLookup() (in another thread)
+static std::mutex rootMutex;
+
+/*
+Returns the block number of the child of the internal node blockNum (at depth
+`level` below the root) to go down to for attrVal: the left child of the first
+key >= attrVal (> attrVal if `strict`), or the rightmost child if there is
+none; the leftmost child if attrVal is nullptr. The nodes of the upper levels
+are read from the NodeCache, the others through the buffer.
+If nextKey is not nullptr, it is set to the key to the right of that child,
+and *hasNextKey to whether there is one.
+*/
+static int childToDescend(int blockNum, int level, const Attribute *attrVal, int attrType, bool strict,
+                          Attribute *nextKey = nullptr, bool *hasNextKey = nullptr) {
+    const CachedNode *node = NodeCache::getNode(blockNum, level);
+    if (node != nullptr) {
+        int childNum = (attrVal == nullptr) ? 0 : NodeCache::searchNode(node, *attrVal, attrType, strict);
+        if (nextKey != nullptr) {
+            *hasNextKey = childNum < node->numKeys;
+            if (*hasNextKey) {
+                *nextKey = node->keys[childNum];
+            }
+        }
+        return node->children[childNum];
+    }
+
+    IndInternal internalBlk(blockNum);
+    int childNum = (attrVal == nullptr) ? 0 : internalBlk.searchEntries(*attrVal, attrType, strict);
+    if (nextKey != nullptr) {
+        HeadInfo head;
+        internalBlk.getHeader(&head);
+        *hasNextKey = childNum < head.numEntries;
+        if (*hasNextKey) {
+            InternalEntry entry;
+            internalBlk.getEntry(&entry, childNum);
+            *nextKey = entry.attrVal;
+        }
+    }
+    return internalBlk.getChild(childNum);
+}
+
+// returns the block number of the rightmost child of the internal node blockNum (see childToDescend())
+static int lastChild(int blockNum, int level) {
+    const CachedNode *node = NodeCache::getNode(blockNum, level);
+    if (node != nullptr) {
+        return node->children[node->numKeys];
+    }
+
+    IndInternal internalBlk(blockNum);
+    HeadInfo head;
+    internalBlk.getHeader(&head);
+    return internalBlk.getChild(head.numEntries);
+}
 
 RecId BPlusTree::bPlusSearch(int relId, char attrName[ATTR_SIZE], Attribute attrVal, int op) {
     // declare searchIndex which will be used to store search index for attrName.
@@ -28,8 +119,14 @@ RecId BPlusTree::bPlusSearch(int relId, char attrName[ATTR_SIZE], Attribute attr
     
 
 
+    // pick the loop to search a leaf with, for the type of the attribute and op
+    FindLeafEntryFunction findLeafEntry = findLeafEntryFunctions[attrCatEntry.attrType][op];
+
     // declare variables block and index which will be used during search
     int block, index;
+
+    // set if the search starts from the root (i.e. not from a previous search index)
+    bool searchFromRoot = false;
     /* searchIndex == {-1, -1}*/
     if (searchIndex.block == -1 || searchIndex.index == -1){
         // (search is done for the first time)
@@ -37,6 +134,7 @@ RecId BPlusTree::bPlusSearch(int relId, char attrName[ATTR_SIZE], Attribute attr
         // start the search from the first entry of root.
         block = attrCatEntry.rootBlock;
         index = 0;
+        searchFromRoot = true;
         /* attrName doesn't have a B+ tree (block == -1)*/
         if (block==-1) {
             return RecId{-1, -1};
@@ -89,19 +187,10 @@ RecId BPlusTree::bPlusSearch(int relId, char attrName[ATTR_SIZE], Attribute attr
         and the test condition in the following loop will fail)
     */
     /* block is of type IND_INTERNAL */
-    while (StaticBuffer::getStaticBlockType(block) == IND_INTERNAL){
+    // (level is the depth of block below the root)
+    for (int level = 0; StaticBuffer::getStaticBlockType(block) == IND_INTERNAL; level++){
         //use StaticBuffer::getStaticBlockType()
 
-        // load the block into internalBlk using IndInternal::IndInternal().
-        IndInternal internalBlk(block);
-
-        HeadInfo intHead;
-
-        // load the header of internalBlk into intHead using BlockBuffer::getHeader()
-        response = internalBlk.getHeader(&intHead);
-
-        // declare intEntry which will be used to store an entry of internalBlk.
-        InternalEntry intEntry;
         /* op is one of NE, LT, LE */
         if (op == NE || op == LT || op == LE) {
             /*
@@ -114,12 +203,8 @@ RecId BPlusTree::bPlusSearch(int relId, char attrName[ATTR_SIZE], Attribute attr
             always move to the left.
             */
 
-
-            // load entry in the first slot of the block into intEntry
-            // using IndInternal::getEntry().
-            response = internalBlk.getEntry (&intEntry, 0);
-
-            block = intEntry.lChild;
+            // move to the first child of the block.
+            block = childToDescend(block, level, nullptr, attrCatEntry.attrType, false);
 
         } else {
             /*
@@ -130,44 +215,21 @@ RecId BPlusTree::bPlusSearch(int relId, char attrName[ATTR_SIZE], Attribute attr
             might contain more entries that satisfy the condition)
             */
 
-
             /*
-             traverse through all entries of internalBlk and find an entry that
-             satisfies the condition.
+             binary search for the first entry of the block that satisfies the
+             condition (see childToDescend()):
              if op == EQ or GE, then intEntry.attrVal >= attrVal
              if op == GT, then intEntry.attrVal > attrVal
-             Hint: the helper function compareAttrs() can be used for comparing
+             (the index of that entry is also the number of its left child; if no
+             entry satisfies the condition, it is numEntries, the number of the right
+             child of the last entry)
             */
-           int index = 0;
-           while(index<intHead.numEntries){
-                response = internalBlk.getEntry (&intEntry, index);
-                int cmpVal = compareAttrs(intEntry.attrVal, attrVal, attrCatEntry.attrType);
-                if (((op==EQ || op==GE) && cmpVal >= 0)|| (op==GT && cmpVal > 0)){
-                     break;
-                }
-                index++;
-            }
-    
-            
-
-            /* such an entry is found*/
-            if (index < intHead.numEntries) {
-                // move to the left child of that entry
-                // left child of the entry
-                block = intEntry.lChild;  
-
-            } else {
-                // move to the right child of the last entry of the block
-                // i.e numEntries - 1 th entry of the block
-                response = internalBlk.getEntry(&intEntry, intHead.numEntries - 1);
-                if (response != SUCCESS) {
-                    printf("failed to get entry %d of block %d\n", intHead.numEntries - 1, block);
-                    exit(1);
-                }
+            block = childToDescend(block, level, &attrVal, attrCatEntry.attrType, op == GT);
+        }
 
-                 // right child of last entry
-                block =  intEntry.rChild;
-            }
+        if (block < 0) {
+            printf("failed to get a child of an internal index block\n");
+            exit(1);
         }
     }
 
@@ -176,6 +238,13 @@ RecId BPlusTree::bPlusSearch(int relId, char attrName[ATTR_SIZE], Attribute attr
     /******  Identify the first leaf index entry from the current position
                 that satisfies our condition (moving right)             ******/
 
+    /* for EQ, GE and GT, a search from the root can skip the entries of the leaf
+       that are smaller than attrVal (found using a binary search of the leaf) */
+    if (searchFromRoot && (op == EQ || op == GE || op == GT)) {
+        IndLeaf leafBlk(block);
+        index = leafBlk.searchEntries(attrVal, attrCatEntry.attrType, op == GT);
+    }
+
     while(block != -1) {
         // load the block into leafBlk using IndLeaf::IndLeaf().
         IndLeaf leafBlk(block);
@@ -184,61 +253,44 @@ RecId BPlusTree::bPlusSearch(int relId, char attrName[ATTR_SIZE], Attribute attr
         // load the header to leafHead using BlockBuffer::getHeader().
         response = leafBlk.getHeader(&leafHead);
 
-        // declare leafEntry which will be used to store an entry from leafBlk
-        Index leafEntry;
-        /*index < numEntries in leafBlk*/
-        while (index < leafHead.numEntries) {
-
-            // load entry corresponding to block and index into leafEntry
-            // using IndLeaf::getEntry().
-            response = leafBlk.getEntry(&leafEntry, index);
-
-            /* comparison between leafEntry's attribute value
-                            and input attrVal using compareAttrs()*/
-            int cmpVal = compareAttrs(leafEntry.attrVal, attrVal, attrCatEntry.attrType);
-            if (
-                (op == EQ && cmpVal == 0) ||
-                (op == LE && cmpVal <= 0) ||
-                (op == LT && cmpVal < 0) ||
-                (op == GT && cmpVal > 0) ||
-                (op == GE && cmpVal >= 0) ||
-                (op == NE && cmpVal != 0)
-            ) {
-                // (entry satisfying the condition found)
-
-                // set search index to {block, index}
-                searchIndex.block = block;
-                searchIndex.index = index;
-                response = AttrCacheTable::setSearchIndex(relId, attrName, &searchIndex);
-                if(response!=SUCCESS){
-                    printf("failed to set search index for %s\n", attrName);
-                    exit(1);
-                }
-
+        // load the entries of leafBlk from index onwards at once using IndLeaf::getEntries().
+        Index leafEntries[MAX_KEYS_LEAF_PACKED];
+        response = leafBlk.getEntries(leafEntries + index, index, leafHead.numEntries - index);
 
+        /* find the first entry from index onwards satisfying the condition (using
+           the loop specialised for the type of the attribute and op) */
+        bool pastRange;
+        index = findLeafEntry(leafEntries, leafHead.numEntries, attrVal, index, &pastRange);
 
-                // return the recId {leafEntry.block, leafEntry.slot}.
-                return RecId{leafEntry.block, leafEntry.slot};
+        if (index != -1) {
+            // (entry satisfying the condition found)
 
-            } else if ((op == EQ || op == LE || op == LT) && cmpVal > 0) {
-                /*future entries will not satisfy EQ, LE, LT since the values
-                    are arranged in ascending order in the leaves */
-
-                // return RecId {-1, -1};
-                return RecId{-1, -1};
+            // set search index to {block, index}
+            searchIndex.block = block;
+            searchIndex.index = index;
+            response = AttrCacheTable::setSearchIndex(relId, attrName, &searchIndex);
+            if(response!=SUCCESS){
+                printf("failed to set search index for %s\n", attrName);
+                exit(1);
             }
 
-            // search next index.
-            index++;
+            // return the recId {leafEntry.block, leafEntry.slot}.
+            return RecId{leafEntries[index].block, leafEntries[index].slot};
         }
 
-        /*only for NE operation do we have to check the entire linked list;
-        for all the other op it is guaranteed that the block being searched
-        will have an entry, if it exists, satisying that op. */
-        if (op != NE) {
-            break;
+        if (pastRange) {
+            /*future entries will not satisfy EQ, LE, LT since the values
+                are arranged in ascending order in the leaves */
+            return RecId{-1, -1};
         }
 
+        /* for NE the entire linked list has to be checked. for the other ops,
+        the leaf reached from the root holds the first entry satisfying the op
+        unless entries have been deleted from it, or the key of the internal
+        entry above it is a truncated STRING key (see separatorKey()); the key
+        is then only an upper bound of its left subtree, the next leaf is
+        searched in that case, and the search ends there at the latest. */
+
         // block = next block in the linked list, i.e., the rblock in leafHead.
         block = leafHead.rblock;
         // update index to 0.
@@ -250,234 +302,915 @@ RecId BPlusTree::bPlusSearch(int relId, char attrName[ATTR_SIZE], Attribute attr
     return RecId{-1, -1};
 }
 
-int BPlusTree::bPlusCreate(int relId, char attrName[ATTR_SIZE]) {
-
-    // if relId is either RELCAT_RELID or ATTRCAT_RELID:
-    //     return E_NOTPERMITTED;
-    if(relId == RELCAT_RELID || relId == ATTRCAT_RELID){
-        return E_NOTPERMITTED;
+// the root block of the B+ tree of attrName (-1 if there is none), read holding rootMutex
+static int currentRoot(int relId, char attrName[ATTR_SIZE], AttrCatEntry *attrCatEntry) {
+    std::lock_guard<std::mutex> guard(rootMutex);
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
     }
+    return attrCatEntry->rootBlock;
+}
 
-    // get the attribute catalog entry of attribute `attrName`
-    // using AttrCacheTable::getAttrCatEntry()
-    AttrCatEntry attrCatEntry;
-    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+/*
+Sets *recId to the record of the first entry of the B+ tree of the attribute
+attrName with the value attrVal. Unlike bPlusSearch(), this keeps no state (not
+even the search index of the attribute) and reads the blocks with
+StaticBuffer::readBlock() instead of loading them into the buffer, so that it
+may be called by several threads at once, along with a thread inserting into
+or deleting from the tree (see BlockLatch):
+  - every block is checked against its version after it is copied, and the
+    version of a child is taken before the version of its parent is checked
+    again; the lookup starts again from the root if a block was modified
+  - a leaf split by the writer after the lookup left its parent is handled by
+    moving right along the rblock of the leaves (as in a B-link tree): the
+    keys of a leaf only move to the leaves on its right when it is split, so a
+    leaf whose keys are all smaller than attrVal sends the lookup to the next
+Returns E_NOTFOUND if there is no such entry, E_NOINDEX if the attribute has no B+ tree.
+*/
+int BPlusTree::bPlusLookup(int relId, char attrName[ATTR_SIZE], Attribute attrVal, RecId *recId) {
+    unsigned char block[BLOCK_SIZE];
+
+    while (true) {
+        AttrCatEntry attrCatEntry;
+        int blockNum = currentRoot(relId, attrName, &attrCatEntry);
+        if (blockNum < 0) {
+            return blockNum == -1 ? E_NOINDEX : blockNum;
+        }
 
-    // if getAttrCatEntry fails
-    //     return the error code from getAttrCatEntry
-    if(response!=SUCCESS){
-        return response;
-    }
-    
-    // an index already exists for the attribute (check rootBlock field) 
-    if (attrCatEntry.rootBlock != -1) {
-        return SUCCESS;
-    }
+        // (the root may have been replaced, and its block released, before its version was taken)
+        uint32_t version = BlockLatch::readLock(blockNum);
+        if (currentRoot(relId, attrName, &attrCatEntry) != blockNum) {
+            continue;
+        }
 
-    /******Creating a new B+ Tree ******/
+        bool restart = false;
+        while (!restart) {
+            StaticBuffer::readBlock(blockNum, block);
+            if (!BlockLatch::validate(blockNum, version)) {
+                restart = true;
+                break;
+            }
 
-    // get a free leaf block using constructor 1 to allocate a new block
-    IndLeaf rootBlockBuf;
+            HeadInfo head;
+            memcpy(&head, block, HEADER_SIZE);
+
+            int nextBlock;
+            if (head.blockType == IND_INTERNAL) {
+                // the left child of the first key >= attrVal
+                int childNum = IndInternal::searchBlock(block, attrVal, attrCatEntry.attrType, false);
+                nextBlock = IndInternal::getBlockChild(block, childNum);
+            } else if (head.blockType == IND_LEAF) {
+                int index = IndLeaf::searchBlock(block, attrVal, attrCatEntry.attrType, false);
+                if (index < head.numEntries) {
+                    Index entry;
+                    IndLeaf::getBlockEntries(block, &entry, index, 1);
+                    if (compareAttrs(entry.attrVal, attrVal, attrCatEntry.attrType) != 0) {
+                        return E_NOTFOUND;
+                    }
+                    *recId = RecId{entry.block, entry.slot};
+                    return SUCCESS;
+                }
 
-    // declare rootBlock to store the blockNumber of the new leaf block
-    int rootBlock = rootBlockBuf.getBlockNum();
+                // (every key of the leaf is smaller than attrVal)
+                nextBlock = head.rblock;
+                if (nextBlock == -1) {
+                    return E_NOTFOUND;
+                }
+            } else {
+                printf("block %d of the B+ tree of %s is not an index block\n", blockNum, attrName);
+                exit(1);
+            }
 
-    // (if the block could not be allocated, the appropriate error code
-    //  will be stored in the blockNum member field of the object)
-    if (rootBlock<0) {
-        return rootBlock;
+            // lock coupling: the block still held nextBlock once its version was taken
+            uint32_t nextVersion = BlockLatch::readLock(nextBlock);
+            if (!BlockLatch::validate(blockNum, version)) {
+                restart = true;
+                break;
+            }
+            blockNum = nextBlock;
+            version = nextVersion;
+        }
     }
+}
 
+/*
+Starts a scan of the B+ tree of attrName (an attribute, or a composite index)
+for the entries whose key lies between
+lowerVal and upperVal (either bound is inclusive or exclusive; a nullptr bound
+leaves the range open on that side). The tree is descended once to the first
+entry not below the lower bound; the entries are then returned a leaf at a time
+by BPlusTree::rangeNext(). Unlike bPlusSearch(), the scan does not use the
+search index in the attribute cache.
+A descending scan returns the entries in the opposite order: the tree is
+descended to the last entry not above the upper bound (to the rightmost leaf if
+there is no upper bound), and the leaves are read along their lblock chain.
+*/
+int BPlusTree::rangeOpen(IndexRangeCursor *cursor, int relId, char attrName[ATTR_SIZE],
+                         Attribute *lowerVal, bool lowerInclusive, Attribute *upperVal, bool upperInclusive,
+                         bool descending) {
+    AttrCatEntry attrCatEntry;
+    int response = BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
 
-    // if there is no more disk space for creating an index
-    if (rootBlock == E_DISKFULL) {
-        return E_DISKFULL;
+    if (attrCatEntry.rootBlock == -1) {
+        return E_NOINDEX;
     }
 
-    // update attrCatEntry.rootBlock to rootBlock
-    attrCatEntry.rootBlock = rootBlock;
+    cursor->attrType = attrCatEntry.attrType;
+    cursor->hasUpper = (upperVal != nullptr);
+    cursor->upperInclusive = upperInclusive;
+    if (upperVal != nullptr) {
+        cursor->upperVal = *upperVal;
+    }
+    cursor->descending = descending;
+    cursor->hasLower = (lowerVal != nullptr);
+    cursor->lowerInclusive = lowerInclusive;
+    if (lowerVal != nullptr) {
+        cursor->lowerVal = *lowerVal;
+    }
 
-    // set the attrCatEntry using AttrCacheTable::setAttrCatEntry()
-    response = AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (descending) {
+        /* descend to the leaf holding the first key > upperVal (>= upperVal if
+           the bound is exclusive): the entries of the range in that leaf are
+           the ones before that key, and the rest are in the leaves to its left */
+        int block = attrCatEntry.rootBlock;
+        for (int level = 0; StaticBuffer::getStaticBlockType(block) == IND_INTERNAL; level++) {
+            if (upperVal == nullptr) {
+                block = lastChild(block, level);
+            } else {
+                block = childToDescend(block, level, upperVal, attrCatEntry.attrType, upperInclusive);
+            }
 
-    RelCatEntry relCatEntry;
+            if (block < 0) {
+                printf("failed to get a child of an internal index block\n");
+                exit(1);
+            }
+        }
 
-    // load the relation catalog entry into relCatEntry
-    // using RelCacheTable::getRelCatEntry().
-    response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
-    
-    if(response!=SUCCESS){
-        printf("failed to get relCatEntry for relId %d\n", relId);
-    }
+        // (the index is the number of entries of the leaf not above the upper bound)
+        int index = -1;
+        if (upperVal != nullptr) {
+            IndLeaf leafBlk(block);
+            index = leafBlk.searchEntries(*upperVal, attrCatEntry.attrType, upperInclusive);
+        }
 
-    /* first record block of the relation */;
-    int block = relCatEntry.firstBlk;
-    /***** Traverse all the blocks in the relation and insert them one by one into the B+ Tree *****/
-   
-    while (block != -1) {
+        cursor->block = block;
+        cursor->index = index;
 
-        // declare a RecBuffer object for `block` (using appropriate constructor)
-        RecBuffer recBuffer(block);
+        return SUCCESS;
+    }
 
-        unsigned char slotMap[relCatEntry.numSlotsPerBlk];
+    /* descend to the leaf holding the first key >= lowerVal (> lowerVal if the
+       bound is exclusive), or to the leftmost leaf if there is no lower bound */
+    int block = attrCatEntry.rootBlock;
+    for (int level = 0; StaticBuffer::getStaticBlockType(block) == IND_INTERNAL; level++) {
+        block = childToDescend(block, level, lowerVal, attrCatEntry.attrType, !lowerInclusive);
 
-        // load the slot map into slotMap using RecBuffer::getSlotMap().
-        response = recBuffer.getSlotMap(slotMap);
-        
-        if(response!=SUCCESS){
-            printf("failed to get slot map for block %d\n", block);
+        if (block < 0) {
+            printf("failed to get a child of an internal index block\n");
             exit(1);
         }
+    }
 
-        // for every occupied slot of the block
-        for(int slot =0; slot<relCatEntry.numSlotsPerBlk; slot++)
-        {
-            if(slotMap[slot]==SLOT_OCCUPIED){
+    int index = 0;
+    if (lowerVal != nullptr) {
+        IndLeaf leafBlk(block);
+        index = leafBlk.searchEntries(*lowerVal, attrCatEntry.attrType, !lowerInclusive);
+    }
 
-                Attribute record[relCatEntry.numAttrs];
-                // load the record corresponding to the slot into `record`
-                // using RecBuffer::getRecord().
-                response = recBuffer.getRecord(record, slot);
-                
-                if(response!=SUCCESS){
-                    printf("failed to get record for block %d, slot %d\n", block, slot);
-                    exit(1);
-                }
+    cursor->block = block;
+    cursor->index = index;
 
-                // RecId recId{block, slot};
-                // declare recId and store the rec-id of this record in it
-                RecId recId ={block,slot};
-                
-                // The caller is expected to ensure that
-                // the RecId passed belongs to a valid record in the same relation
+    return SUCCESS;
+}
 
+/*
+Copies the next entries of the range scan (those left in the current leaf, up to
+the upper bound) to entries, and moves the cursor to the next leaf along the
+rblock chain. Returns E_NOTFOUND once the range is exhausted.
+In a descending scan, the entries of the leaf down to the lower bound are copied
+from the largest key down, and the cursor moves to the leaf along the lblock chain.
+NOTE: this function expects the caller to allocate memory for MAX_KEYS_LEAF_PACKED entries.
+*/
+int BPlusTree::rangeNext(IndexRangeCursor *cursor, Index entries[], int *numEntries) {
+    *numEntries = 0;
 
-                // a duplicate index entry for this record does not already exist in the B+ tree. 
-                // recId actually points to the specific record that the argument attribute value belongs to
-                
+    while (cursor->block != -1) {
+        IndLeaf leafBlk(cursor->block);
+        HeadInfo leafHead;
+        int response = leafBlk.getHeader(&leafHead);
+        if (response != SUCCESS) {
+            printf("failed to get header for block %d\n", cursor->block);
+            exit(1);
+        }
 
+        if (cursor->descending) {
+            /* the entries of the leaf from the first key within the lower bound
+               (>= lowerVal if the bound is inclusive, > lowerVal otherwise) are
+               in the range; if that key is not the first of the leaf, no
+               earlier leaf has to be read */
+            int end = (cursor->index == -1) ? leafHead.numEntries : cursor->index;
+            int first = 0;
+            if (cursor->hasLower) {
+                first = leafBlk.searchEntries(cursor->lowerVal, cursor->attrType, !cursor->lowerInclusive);
+            }
+            bool lastLeaf = (first > 0);
 
-                // insert the attribute value corresponding to attrName from the record
-                // into the B+ tree using bPlusInsert.
-                response = bPlusInsert(relId, attrName, record[attrCatEntry.offset], recId);
-                // (note that bPlusInsert will destroy any existing bplus tree if
-                // insert fails i.e when disk is full)
-                // retVal = bPlusInsert(relId, attrName, attribute value, recId);
+            cursor->block = lastLeaf ? -1 : leafHead.lblock;
+            cursor->index = -1;
 
-                if (response == E_DISKFULL) {
-                    // (unable to get enough blocks to build the B+ Tree.)
-                    return E_DISKFULL;
-                }
-                
-                if(response!=SUCCESS){
-                    printf("failed to insert record for block %d, slot %d\n", block, slot);
-                    exit(1);
-                }
+            if (first >= end) {
+                continue;
             }
+
+            leafBlk.getEntries(entries, first, end - first);
+            std::reverse(entries, entries + (end - first));
+
+            *numEntries = end - first;
+            return SUCCESS;
         }
 
-        // get the header of the block using BlockBuffer::getHeader()
-        HeadInfo headInfo;
-        response = recBuffer.getHeader(&headInfo);
-        if(response!=SUCCESS){
-            printf("failed to get header for block %d\n", block);
-            exit(1);
+        /* the entries of the leaf up to the first key beyond the upper bound
+           (> upperVal if the bound is inclusive, >= upperVal otherwise) are in
+           the range; if that key is in this leaf, no later leaf has to be read */
+        int end = leafHead.numEntries;
+        bool lastLeaf = false;
+        if (cursor->hasUpper) {
+            end = leafBlk.searchEntries(cursor->upperVal, cursor->attrType, cursor->upperInclusive);
+            lastLeaf = (end < leafHead.numEntries);
         }
 
-        // set block = rblock of current block (from the header)
-        block = headInfo.rblock;
-    }
+        int first = cursor->index;
+        cursor->block = lastLeaf ? -1 : leafHead.rblock;
+        cursor->index = 0;
 
-    return SUCCESS;
-}
+        if (first >= end) {
+            continue;
+        }
 
+        leafBlk.getEntries(entries, first, end - first);
 
-int BPlusTree::bPlusDestroy(int rootBlockNum) {
-    /*rootBlockNum lies outside the valid range [0,DISK_BLOCKS-1]*/
-    if (rootBlockNum < 0 || rootBlockNum >= DISK_BLOCKS) {
-        return E_OUTOFBOUND;
+        *numEntries = end - first;
+        return SUCCESS;
     }
 
-    /* type of block (using StaticBuffer::getStaticBlockType())*/;
-    int type = StaticBuffer::getStaticBlockType(rootBlockNum);
-
-    if (type == IND_LEAF) {
-        // declare an instance of IndLeaf for rootBlockNum using appropriate
-        // constructor
-        IndLeaf leaf(rootBlockNum);
-
-        // release the block using BlockBuffer::releaseBlock().
-        leaf.releaseBlock();
+    return E_NOTFOUND;
+}
 
-        return SUCCESS;
+/*
+Sets *entry to the first entry of the B+ tree of attrName (the one with the
+smallest key), or to its last entry (the largest key) if `last`: the tree is
+descended along its leftmost (rightmost) children to a leaf, and a single entry
+of the leaf is read. Returns E_NOTFOUND if the tree has no entries, E_NOINDEX if
+the attribute has no B+ tree.
+*/
+int BPlusTree::edgeEntry(int relId, char attrName[ATTR_SIZE], bool last, Index *entry) {
+    AttrCatEntry attrCatEntry;
+    int response = BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
 
-    } else if (type == IND_INTERNAL) {
-        // declare an instance of IndInternal for rootBlockNum using appropriate
-        // constructor
-        IndInternal internalBlk(rootBlockNum);
+    if (attrCatEntry.rootBlock == -1) {
+        return E_NOINDEX;
+    }
 
-        // load the header of the block using BlockBuffer::getHeader().
-        HeadInfo headInfo;
-        int response = internalBlk.getHeader(&headInfo);
+    int block = attrCatEntry.rootBlock;
+    for (int level = 0; StaticBuffer::getStaticBlockType(block) == IND_INTERNAL; level++) {
+        block = last ? lastChild(block, level) : childToDescend(block, level, nullptr, attrCatEntry.attrType, false);
 
-        if (response != SUCCESS) {
-            printf("failed to get header for block %d\n", rootBlockNum);
+        if (block < 0) {
+            printf("failed to get a child of an internal index block\n");
             exit(1);
         }
+    }
 
-        /*iterate through all the entries of the internalBlk and destroy the lChild
-        of the first entry and rChild of all entries using BPlusTree::bPlusDestroy().
-        (the rchild of an entry is the same as the lchild of the next entry.
-         take care not to delete overlapping children more than once ) */
-        InternalEntry internalEntry;
-        response = internalBlk.getEntry(&internalEntry, 0);
-        // (destroy the lChild of the first entry)
-        response = bPlusDestroy(internalEntry.lChild);
+    // (only the root leaf is ever empty, but the next leaf is tried all the same)
+    while (block != -1) {
+        IndLeaf leafBlk(block);
+        HeadInfo leafHead;
+        leafBlk.getHeader(&leafHead);
 
+        if (leafHead.numEntries > 0) {
+            leafBlk.getEntries(entry, last ? leafHead.numEntries - 1 : 0, 1);
+            return SUCCESS;
+        }
 
-        for (int i = 0; i < headInfo.numEntries; i++) {
-            // declare an instance of InternalEntry to store the entry
-            // using IndInternal::getEntry().
-            InternalEntry internalEntry;
-            response = internalBlk.getEntry(&internalEntry, i);
+        block = last ? leafHead.lblock : leafHead.rblock;
+    }
 
-            if (response != SUCCESS) {
-                printf("failed to get entry %d of block %d\n", i, rootBlockNum);
-                exit(1);
-            }
+    return E_NOTFOUND;
+}
 
-            // (destroy the rChild of the entry)
-            response = bPlusDestroy(internalEntry.rChild);
-        }
+/*
+Returns the key of an internal node between two children: any key from the largest
+value of the left child (leftMax) to the smallest value of the right child
+(rightMin) separates them. For STRING keys the shortest beginning of rightMin that
+is not smaller than leftMax is used (suffix truncation), so that more keys fit in
+a prefix compressed node; other keys are leftMax.
+*/
+static Attribute separatorKey(Attribute leftMax, Attribute rightMin, int attrType) {
+    if (attrType != STRING) {
+        return leftMax;
+    }
 
+    Attribute separator;
+    memset(&separator, 0, sizeof(separator));
 
-        // release the block using BlockBuffer::releaseBlock().
-        internalBlk.releaseBlock();
+    int rightLen = strnlen(rightMin.sVal, ATTR_SIZE);
+    for (int len = 0; len < rightLen; len++) {
+        separator.sVal[len] = rightMin.sVal[len];
+        if (compareAttrs(separator, leftMax, STRING) >= 0) {
+            break;
+        }
+    }
 
-        return SUCCESS;
+    return separator;
+}
 
-    } else {
-        // (block is not an index block.)
-        return E_INVALIDBLOCK;
+/*
+Returns the index of the key that moves up to the parent when the numKeys keys of
+an internal node are shared between two nodes (the keys before it go to the left
+node and those after it to the right one): the key that best balances the bytes
+used by the two nodes, both of which must fit in a block. For keys of a fixed
+size this is the middle key (MIDDLE_INDEX_INTERNAL when splitting a full node).
+*/
+static int splitPoint(Attribute keys[], int numKeys, int attrType) {
+    int best = -1, bestDiff = 0;
+    for (int middle = 1; middle < numKeys - 1; middle++) {
+        int leftSize = IndInternal::getNodeSize(keys, middle, attrType);
+        int rightSize = IndInternal::getNodeSize(keys + middle + 1, numKeys - middle - 1, attrType);
+        if (leftSize > BLOCK_SIZE - HEADER_SIZE || rightSize > BLOCK_SIZE - HEADER_SIZE) {
+            continue;
+        }
+        // (of two equally good keys the later one is taken, leaving the right node the smaller)
+        if (best == -1 || abs(leftSize - rightSize) <= bestDiff) {
+            best = middle;
+            bestDiff = abs(leftSize - rightSize);
+        }
     }
+    return best;
 }
 
 /*
-The caller is expected to ensure that
+Returns true if an internal node (other than the root) with these keys is to be
+rebalanced: it has fewer than MIN_KEYS_INTERNAL keys or, if its keys are prefix
+compressed (STRING keys), uses fewer than MIN_BYTES_INTERNAL_PREFIX bytes (a third
+of a block; the two halves of a split node may each use a little less than half a
+block, and would otherwise be rebalanced on the first deletion).
+*/
+static bool internalUnderflows(Attribute keys[], int numKeys, int attrType) {
+    if (attrType == STRING) {
+        return IndInternal::getNodeSize(keys, numKeys, attrType) < MIN_BYTES_INTERNAL_PREFIX;
+    }
+    return numKeys < MIN_KEYS_INTERNAL;
+}
 
-the RecId passed belongs to a valid record in the same relation
-a duplicate index entry for this record does not already exist in the B+ tree.
-recId actually points to the specific record that the argument attribute value belongs to
-This function will add the pair (attrVal, recId) to the B+ tree without any validation on these arguments.
+/*
+Builds the B+ tree of an attribute in bulk: the (attribute value, rec-id) pairs
+of all the records are extracted in a single scan of the relation and sorted,
+the leaves are then written left to right with fillFactor percent of their
+entries used, and the internal levels are built bottom up over them.
 */
+int BPlusTree::bPlusCreate(int relId, char attrName[ATTR_SIZE], int fillFactor) {
 
-int BPlusTree::bPlusInsert(int relId, char attrName[ATTR_SIZE], Attribute attrVal, RecId recId) {
-    // get the attribute cache entry corresponding to attrName
-    // using AttrCacheTable::getAttrCatEntry().
+    // if relId is either RELCAT_RELID or ATTRCAT_RELID:
+    //     return E_NOTPERMITTED;
+    if(relId == RELCAT_RELID || relId == ATTRCAT_RELID){
+        return E_NOTPERMITTED;
+    }
+
+    if (fillFactor <= 0 || fillFactor > 100) {
+        return E_INVALID;
+    }
+
+    // get the attribute catalog entry of attribute `attrName` (or the description
+    // of the composite index `attrName`) using BPlusTree::getIndexInfo()
     AttrCatEntry attrCatEntry;
-    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    int response = BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
 
-    // if getAttrCatEntry() failed
+    // if getIndexInfo fails
+    //     return the error code from getIndexInfo
+    if(response!=SUCCESS){
+        return response;
+    }
+
+    // (the keys of a composite index are made from the values of its attributes)
+    CompositeIndexInfo compositeIndex;
+    if (attrCatEntry.attrType == COMPOSITE) {
+        RelCacheTable::getCompositeIndex(relId, attrName, &compositeIndex);
+    }
+    
+    // an index already exists for the attribute (check rootBlock field) 
+    if (attrCatEntry.rootBlock != -1) {
+        return SUCCESS;
+    }
+
+    RelCatEntry relCatEntry;
+
+    // load the relation catalog entry into relCatEntry
+    // using RelCacheTable::getRelCatEntry().
+    response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    
+    if(response!=SUCCESS){
+        printf("failed to get relCatEntry for relId %d\n", relId);
+    }
+
+    /***** Extract the (attribute value, rec-id) pairs of all the records in a single scan,
+           and sort them by attribute value (equal values stay in the order of their rec-ids) *****/
+
+    // (an Index entry is sorted as a record of two attributes: the attribute value, and the rec-id)
+    SortState sortState;
+    ExternalSort::sortBegin(&sortState, LEAF_ENTRY_SIZE / ATTR_SIZE, 0, attrCatEntry.attrType);
+
+    int numEntries = 0;
+
+    /* first record block of the relation */;
+    int block = relCatEntry.firstBlk;
+
+    while (block != -1) {
+
+        // declare a RecBuffer object for `block` (using appropriate constructor)
+        RecBuffer recBuffer(block);
+
+        // load the header, the slot map and all the records of the block using RecBuffer::getRecords().
+        HeadInfo headInfo;
+        unsigned char slotMap[relCatEntry.numSlotsPerBlk];
+        Attribute records[relCatEntry.numSlotsPerBlk * relCatEntry.numAttrs];
+        response = recBuffer.getRecords(&headInfo, slotMap, records);
+
+        if(response!=SUCCESS){
+            printf("failed to get records of block %d\n", block);
+            exit(1);
+        }
+
+        // for every occupied slot of the block
+        for(int slot =0; slot<relCatEntry.numSlotsPerBlk; slot++)
+        {
+            if(slotMap[slot]==SLOT_OCCUPIED){
+                Index entry;
+                memset(&entry, 0, sizeof(entry));
+                Attribute *record = records + slot * relCatEntry.numAttrs;
+                if (attrCatEntry.attrType == COMPOSITE) {
+                    BPlusTree::recordCompositeKey(&compositeIndex, record, &entry.attrVal);
+                } else {
+                    entry.attrVal = record[attrCatEntry.offset];
+                }
+                entry.block = block;
+                entry.slot = slot;
+                if (attrCatEntry.includeOffset != -1) {
+                    memcpy(entry.included, &record[attrCatEntry.includeOffset].nVal, sizeof(entry.included));
+                }
+
+                response = ExternalSort::sortAdd(&sortState, (Attribute *)&entry);
+                if (response != SUCCESS) {
+                    // (unable to get enough blocks for the sorted runs.)
+                    ExternalSort::sortClose(&sortState);
+                    return response;
+                }
+                numEntries++;
+            }
+        }
+
+        // set block = rblock of current block (from the header)
+        block = headInfo.rblock;
+    }
+
+    response = ExternalSort::sortEnd(&sortState);
+    if (response != SUCCESS) {
+        ExternalSort::sortClose(&sortState);
+        return response;
+    }
+
+    /***** Write the leaves, then the internal levels bottom up *****/
+
+    // (the leaves of an index without an included attribute are packed, see IndLeaf::getEntries())
+    int leafFormat = attrCatEntry.includeOffset == -1 ? IND_FORMAT_PACKED : IND_FORMAT_PLAIN;
+    int rootBlock = bulkLoad(&sortState, numEntries, attrCatEntry.attrType, leafFormat, fillFactor);
+    ExternalSort::sortClose(&sortState);
+    if (rootBlock < 0) {
+        // (unable to get enough blocks to build the B+ Tree.)
+        return rootBlock;
+    }
+
+    // update the root block of the index to the block of the root
+    // using BPlusTree::setIndexRoot()
+    // (a write, for readers of the tree in other threads; see bPlusLookup())
+    BlockLatch::WriteGuard writeGuard;
+    response = BPlusTree::setIndexRoot(relId, attrName, rootBlock);
+
+    return response;
+}
+
+/*
+Builds a B+ tree in new blocks from the numEntries sorted entries of an
+external sort: the leaves are written left to right (see bulkLoadLeaves()),
+then the internal levels bottom up until a level has a single node (the root).
+Returns the block number of the root, or E_DISKFULL (no blocks are left
+allocated).
+*/
+int BPlusTree::bulkLoad(SortState *sortedEntries, int numEntries, int attrType, int leafFormat, int fillFactor) {
+    // block numbers of the nodes of the level built last, and the keys between them
+    std::vector<int> levelBlocks(numEntries > 0 ? numEntries : 1);
+    std::vector<Attribute> levelSeparators(levelBlocks.size());
+
+    int numNodes = bulkLoadLeaves(sortedEntries, numEntries, attrType, leafFormat, fillFactor,
+                                  levelBlocks.data(), levelSeparators.data());
+    if (numNodes < 0) {
+        return numNodes;
+    }
+
+    // every block of the tree built so far (released if a level can not be built)
+    std::vector<int> treeBlocks(levelBlocks.begin(), levelBlocks.begin() + numNodes);
+
+    while (numNodes > 1) {
+        std::vector<int> parentBlocks(numNodes);
+        std::vector<Attribute> parentSeparators(numNodes);
+
+        int numParents = bulkLoadInternal(levelBlocks.data(), levelSeparators.data(), numNodes, attrType,
+                                          fillFactor, parentBlocks.data(), parentSeparators.data());
+        if (numParents < 0) {
+            releaseBlocks(treeBlocks.data(), treeBlocks.size());
+            return numParents;
+        }
+
+        treeBlocks.insert(treeBlocks.end(), parentBlocks.begin(), parentBlocks.begin() + numParents);
+        levelBlocks.swap(parentBlocks);
+        levelSeparators.swap(parentSeparators);
+        numNodes = numParents;
+    }
+
+    return levelBlocks[0];
+}
+
+/*
+Rebuilds the B+ tree of attrName (an attribute, or a composite index) in new
+blocks: the entries are read from the leaf list of the tree (in order), and
+written into leaves filled to fillFactor percent and allocated from a run of
+consecutive free blocks, so that the leaf list follows the order of the blocks
+on the disk (see StaticBuffer::findFreeRun()). The new tree then replaces the
+old one, whose blocks are released. Readers of other threads (see
+bPlusLookup()) see either tree, never a mix of the two.
+A tree grown by insertions has leaves about half full (see splitLeaf()) and
+scattered over the disk; the rebuilt tree is as the one of a CREATE INDEX.
+*/
+int BPlusTree::bPlusRebuild(int relId, char attrName[ATTR_SIZE], int fillFactor) {
+    if (relId == RELCAT_RELID || relId == ATTRCAT_RELID) {
+        return E_NOTPERMITTED;
+    }
+
+    if (fillFactor <= 0 || fillFactor > 100) {
+        return E_INVALID;
+    }
+
+    AttrCatEntry attrCatEntry;
+    int response = BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    int oldRootBlock = attrCatEntry.rootBlock;
+    if (oldRootBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    // the leftmost leaf starts the leaf list
+    int firstLeaf = oldRootBlock;
+    while (StaticBuffer::getStaticBlockType(firstLeaf) == IND_INTERNAL) {
+        firstLeaf = IndInternal(firstLeaf).getChild(0);
+    }
+
+    // count the entries, and keep the format of the leaves
+    int numEntries = 0;
+    int leafFormat = IND_FORMAT_PLAIN;
+    for (int block = firstLeaf; block != -1;) {
+        HeadInfo head;
+        BlockBuffer(block).getHeader(&head);
+        numEntries += head.numEntries;
+        leafFormat = head.numSlots;
+        block = head.rblock;
+    }
+
+    /***** Read the entries from the leaf list (already in order, so the sort is
+           given the memory to hold them all and writes no run) *****/
+
+    int entryAttrs = LEAF_ENTRY_SIZE / ATTR_SIZE;
+    int memoryBlocks = std::max(SORT_MIN_MEMORY, numEntries / RunBuffer::getMaxRecords(entryAttrs) + 1);
+    SortState sortState;
+    response = ExternalSort::sortBegin(&sortState, entryAttrs, 0, attrCatEntry.attrType, memoryBlocks);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    for (int block = firstLeaf; block != -1;) {
+        IndLeaf leaf(block);
+        HeadInfo head;
+        leaf.getHeader(&head);
+
+        Index entries[MAX_KEYS_LEAF_PACKED];
+        leaf.getEntries(entries, 0, head.numEntries);
+        for (int i = 0; i < head.numEntries; i++) {
+            ExternalSort::sortAdd(&sortState, (Attribute *)&entries[i]);
+        }
+        block = head.rblock;
+    }
+    ExternalSort::sortEnd(&sortState);
+
+    /***** Build the new tree, its leaves taken in order from a run of free blocks *****/
+
+    int entriesPerLeaf = std::max(1, IndLeaf::getMaxEntries(leafFormat) * fillFactor / 100);
+    int numLeaves = numEntries == 0 ? 1 : (numEntries + entriesPerLeaf - 1) / entriesPerLeaf;
+    StaticBuffer::setAllocationStart(StaticBuffer::findFreeRun(numLeaves));
+
+    int rootBlock = bulkLoad(&sortState, numEntries, attrCatEntry.attrType, leafFormat, fillFactor);
+    StaticBuffer::setAllocationStart(0);
+    ExternalSort::sortClose(&sortState);
+    if (rootBlock < 0) {
+        // (the old tree is left in place)
+        return rootBlock;
+    }
+
+    /***** Swap the trees *****/
+
+    BlockLatch::WriteGuard writeGuard;
+
+    response = BPlusTree::setIndexRoot(relId, attrName, rootBlock);
+    if (response != SUCCESS) {
+        bPlusDestroy(rootBlock);
+        return response;
+    }
+
+    // (a search in progress may be positioned in the old tree)
+    AttrCacheTable::resetSearchIndex(relId, attrName);
+
+    return bPlusDestroy(oldRootBlock);
+}
+
+/*
+Removes the B+ tree of attrName (an attribute, or a composite index): the tree
+is unlinked from the attribute, then its blocks are released, in one write (see
+BlockLatch), so that readers of other threads (see bPlusLookup()) never follow
+a released block.
+Returns E_NOINDEX if attrName has no B+ tree.
+*/
+int BPlusTree::bPlusDrop(int relId, char attrName[ATTR_SIZE]) {
+    AttrCatEntry attrCatEntry;
+    int response = BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    if (attrCatEntry.rootBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    BlockLatch::WriteGuard writeGuard;
+
+    response = BPlusTree::setIndexRoot(relId, attrName, -1);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    // (a search in progress may be positioned in the tree)
+    AttrCacheTable::resetSearchIndex(relId, attrName);
+
+    return bPlusDestroy(attrCatEntry.rootBlock);
+}
+
+/*
+Writes the numEntries sorted entries (read from an external sort) into new leaf
+blocks of the format leafFormat, left to right, using fillFactor
+percent of each leaf (the entries are spread evenly over the leaves, an empty
+relation gets a single empty leaf). The block numbers of the leaves are stored
+in leafBlocks, and the key between leaves i and i + 1 (see separatorKey()) in
+separators[i].
+Returns the number of leaves, or E_DISKFULL (no blocks are left allocated).
+*/
+int BPlusTree::bulkLoadLeaves(SortState *sortedEntries, int numEntries, int attrType, int leafFormat, int fillFactor,
+                              int leafBlocks[], Attribute separators[]) {
+    int entriesPerLeaf = std::max(1, IndLeaf::getMaxEntries(leafFormat) * fillFactor / 100);
+    int numLeaves = numEntries == 0 ? 1 : (numEntries + entriesPerLeaf - 1) / entriesPerLeaf;
+
+    // (largest attribute value in the previous leaf)
+    Attribute prevMaxKey;
+
+    for (int leafNum = 0; leafNum < numLeaves; leafNum++) {
+        int count = numEntries / numLeaves + (leafNum < numEntries % numLeaves ? 1 : 0);
+
+        // get a free leaf block using constructor 1 to allocate a new block
+        IndLeaf leaf;
+        int blockNum = leaf.getBlockNum();
+        if (blockNum < 0) {
+            releaseBlocks(leafBlocks, leafNum);
+            return E_DISKFULL;
+        }
+
+        HeadInfo head;
+        leaf.getHeader(&head);
+        head.numEntries = count;
+        head.lblock = leafNum == 0 ? -1 : leafBlocks[leafNum - 1];
+        head.rblock = -1;
+        head.numSlots = leafFormat;
+        leaf.setHeader(&head);
+
+        Index entries[MAX_KEYS_LEAF_PACKED];
+        for (int entryNum = 0; entryNum < count; entryNum++) {
+            ExternalSort::sortNext(sortedEntries, (Attribute *)&entries[entryNum]);
+        }
+        leaf.setEntries(entries, 0, count);
+
+        // link the previous leaf to this one
+        if (leafNum > 0) {
+            IndLeaf prevLeaf(leafBlocks[leafNum - 1]);
+            HeadInfo prevHead;
+            prevLeaf.getHeader(&prevHead);
+            prevHead.rblock = blockNum;
+            prevLeaf.setHeader(&prevHead);
+
+            separators[leafNum - 1] = separatorKey(prevMaxKey, entries[0].attrVal, attrType);
+        }
+
+        leafBlocks[leafNum] = blockNum;
+        if (count > 0) {
+            prevMaxKey = entries[count - 1].attrVal;
+        }
+    }
+
+    return numLeaves;
+}
+
+/*
+Builds a level of internal nodes over the nodes (children) of the level below,
+using fillFactor percent of each internal node, the key between children i and
+i + 1 being separators[i]. The children are spread evenly (by count) over the
+fewest nodes that hold them; as the keys of a STRING attribute are prefix
+compressed, how many fit in a node depends on the keys. The block numbers of the
+new nodes and the keys between them are stored in nodeBlocks and nodeSeparators.
+Returns the number of nodes, or E_DISKFULL (the nodes of this level are released).
+*/
+int BPlusTree::bulkLoadInternal(int childBlocks[], Attribute separators[], int numChildren, int attrType,
+                                int fillFactor, int nodeBlocks[], Attribute nodeSeparators[]) {
+    int maxSize = (BLOCK_SIZE - HEADER_SIZE) * fillFactor / 100;
+
+    // count the nodes needed when each is filled up to maxSize bytes (with at least
+    // 2 keys, so that spreading the children evenly leaves no node with a single child)
+    int numNodes = 0;
+    for (int first = 0; first < numChildren; numNodes++) {
+        int numKeys = 2;
+        while (first + numKeys + 1 < numChildren &&
+               IndInternal::getNodeSize(separators + first, numKeys + 1, attrType) <= maxSize) {
+            numKeys++;
+        }
+        first += numKeys + 1;
+    }
+
+    // (nodes with keys longer than the average may not fit; use more nodes then)
+    for (;; numNodes++) {
+        bool fits = true;
+        for (int nodeNum = 0, first = 0; nodeNum < numNodes && fits; nodeNum++) {
+            int count = numChildren / numNodes + (nodeNum < numChildren % numNodes ? 1 : 0);
+            fits = IndInternal::getNodeSize(separators + first, count - 1, attrType) <= BLOCK_SIZE - HEADER_SIZE;
+            first += count;
+        }
+        if (fits) {
+            break;
+        }
+    }
+
+    int first = 0;
+    for (int nodeNum = 0; nodeNum < numNodes; nodeNum++) {
+        int count = numChildren / numNodes + (nodeNum < numChildren % numNodes ? 1 : 0);
+
+        // get a free internal index block using constructor 1 to allocate a new block
+        IndInternal node;
+        int blockNum = node.getBlockNum();
+        if (blockNum < 0) {
+            releaseBlocks(nodeBlocks, nodeNum);
+            return E_DISKFULL;
+        }
+
+        node.setNode(childBlocks + first, separators + first, count - 1, attrType);
+
+        // set the parent of each child to the new node
+        for (int childNum = first; childNum < first + count; childNum++) {
+            BlockBuffer child(childBlocks[childNum]);
+            HeadInfo childHead;
+            child.getHeader(&childHead);
+            childHead.pblock = blockNum;
+            child.setHeader(&childHead);
+        }
+
+        nodeBlocks[nodeNum] = blockNum;
+        if (nodeNum < numNodes - 1) {
+            nodeSeparators[nodeNum] = separators[first + count - 1];
+        }
+        first += count;
+    }
+
+    return numNodes;
+}
+
+// releases the blocks of a partially built B+ tree
+void BPlusTree::releaseBlocks(int blockNums[], int count) {
+    for (int i = 0; i < count; i++) {
+        BlockBuffer blockBuffer(blockNums[i]);
+        blockBuffer.releaseBlock();
+    }
+}
+
+
+int BPlusTree::bPlusDestroy(int rootBlockNum) {
+    /*rootBlockNum lies outside the valid range [0,DISK_BLOCKS-1]*/
+    if (rootBlockNum < 0 || rootBlockNum >= DISK_BLOCKS) {
+        return E_OUTOFBOUND;
+    }
+
+    /* type of block (using StaticBuffer::getStaticBlockType())*/;
+    int type = StaticBuffer::getStaticBlockType(rootBlockNum);
+
+    if (type == IND_LEAF) {
+        // declare an instance of IndLeaf for rootBlockNum using appropriate
+        // constructor
+        IndLeaf leaf(rootBlockNum);
+
+        // release the block using BlockBuffer::releaseBlock().
+        leaf.releaseBlock();
+
+        return SUCCESS;
+
+    } else if (type == IND_INTERNAL) {
+        // declare an instance of IndInternal for rootBlockNum using appropriate
+        // constructor
+        IndInternal internalBlk(rootBlockNum);
+
+        // load the header of the block using BlockBuffer::getHeader().
+        HeadInfo headInfo;
+        int response = internalBlk.getHeader(&headInfo);
+
+        if (response != SUCCESS) {
+            printf("failed to get header for block %d\n", rootBlockNum);
+            exit(1);
+        }
+
+        /*iterate through all the entries of the internalBlk and destroy the lChild
+        of the first entry and rChild of all entries using BPlusTree::bPlusDestroy().
+        (the rchild of an entry is the same as the lchild of the next entry.
+         take care not to delete overlapping children more than once ) */
+        InternalEntry internalEntry;
+        response = internalBlk.getEntry(&internalEntry, 0);
+        // (destroy the lChild of the first entry)
+        response = bPlusDestroy(internalEntry.lChild);
+
+
+        for (int i = 0; i < headInfo.numEntries; i++) {
+            // declare an instance of InternalEntry to store the entry
+            // using IndInternal::getEntry().
+            InternalEntry internalEntry;
+            response = internalBlk.getEntry(&internalEntry, i);
+
+            if (response != SUCCESS) {
+                printf("failed to get entry %d of block %d\n", i, rootBlockNum);
+                exit(1);
+            }
+
+            // (destroy the rChild of the entry)
+            response = bPlusDestroy(internalEntry.rChild);
+        }
+
+
+        // release the block using BlockBuffer::releaseBlock().
+        internalBlk.releaseBlock();
+
+        return SUCCESS;
+
+    } else {
+        // (block is not an index block.)
+        return E_INVALIDBLOCK;
+    }
+}
+
+/*
+The caller is expected to ensure that
+
+the RecId passed belongs to a valid record in the same relation
+a duplicate index entry for this record does not already exist in the B+ tree.
+recId actually points to the specific record that the argument attribute value belongs to
+This function will add the pair (attrVal, recId) to the B+ tree without any validation on these arguments.
+*/
+
+int BPlusTree::bPlusInsert(int relId, char attrName[ATTR_SIZE], Attribute attrVal, RecId recId) {
+    // (readers in other threads see the changes to the tree as a whole; see BlockLatch)
+    BlockLatch::WriteGuard write;
+
+    // get the attribute cache entry corresponding to attrName
+    // (or the description of the composite index attrName) using BPlusTree::getIndexInfo().
+    AttrCatEntry attrCatEntry;
+    int response = BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
+
+    // if getAttrCatEntry() failed
     //     return the error code
     if (response != SUCCESS) {
         return response;
@@ -507,10 +1240,24 @@ int BPlusTree::bPlusInsert(int relId, char attrName[ATTR_SIZE], Attribute attrVa
     // slot = recId.slot to pass as argument to the function.
     // insertIntoLeaf(relId, attrName, leafBlkNum, Index entry)
     Index entry;
+    memset(&entry, 0, sizeof(entry));
     entry.attrVal = attrVal;
     entry.block = recId.block;
     entry.slot = recId.slot;
 
+    // the value of the included attribute (if any) is carried in the entry, so
+    // that selections of the two attributes need not read the record
+    // (the record has just been written, so its block is in the buffer)
+    if (attrCatEntry.includeOffset != -1) {
+        RelCatEntry relCatEntry;
+        RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+        Attribute record[relCatEntry.numAttrs];
+        RecBuffer recBuffer(recId.block);
+        recBuffer.getRecord(record, recId.slot);
+        memcpy(entry.included, &record[attrCatEntry.includeOffset].nVal, sizeof(entry.included));
+    }
+
     response = BPlusTree::insertIntoLeaf(relId, attrName, leafBlkNum, entry);
 
     // NOTE: the insertIntoLeaf() function will propagate the insertion to the
@@ -528,9 +1275,8 @@ int BPlusTree::bPlusInsert(int relId, char attrName[ATTR_SIZE], Attribute attrVa
         }
 
         // update the rootBlock of attribute catalog cache entry to -1 using
-        attrCatEntry.rootBlock=-1;
-        // AttrCacheTable::setAttrCatEntry().
-        response = AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+        // BPlusTree::setIndexRoot().
+        response = BPlusTree::setIndexRoot(relId, attrName, -1);
 
         if(response!=SUCCESS){
             printf("failed to set attrCatEntry for relId %d, attrName %s\n", relId, attrName);
@@ -543,59 +1289,165 @@ int BPlusTree::bPlusInsert(int relId, char attrName[ATTR_SIZE], Attribute attrVa
     return SUCCESS;
 }
 
-int BPlusTree::findLeafToInsert(int rootBlock, Attribute attrVal, int attrType) {
-    int blockNum = rootBlock;
-    /* block is not of type IND_LEAF */
-    // use StaticBuffer::getStaticBlockType()
-    int blockType = StaticBuffer::getStaticBlockType(blockNum);
-    while (blockType != IND_LEAF) {
+/*
+Starts a batch of entries to be inserted into the B+ tree of attrName (an
+attribute, or a composite index). The entries are added with batchAdd() and
+inserted into the tree by batchEnd(); until then the tree does not have them.
+*/
+int BPlusTree::batchBegin(IndexBatch *batch, int relId, char attrName[ATTR_SIZE]) {
+    AttrCatEntry attrCatEntry;
+    int response = BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
 
-        // declare an IndInternal object for block using appropriate constructor
-        IndInternal internalBlk(blockNum);
+    if (attrCatEntry.rootBlock == -1) {
+        return E_NOINDEX;
+    }
 
-        // get header of the block using BlockBuffer::getHeader()
-        HeadInfo headInfo;
-        int response = internalBlk.getHeader(&headInfo);
+    batch->relId = relId;
+    strcpy(batch->attrName, attrName);
+    batch->includeOffset = attrCatEntry.includeOffset;
+    batch->entries.clear();
 
-        if (response != SUCCESS) {
-            printf("failed to get header for block %d\n", blockNum);
-            exit(1);
-        }
+    return SUCCESS;
+}
+
+// adds the pair (attrVal, recId) to the batch (the caller is expected to ensure what bPlusInsert() expects)
+int BPlusTree::batchAdd(IndexBatch *batch, Attribute attrVal, RecId recId) {
+    Index entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.attrVal = attrVal;
+    entry.block = recId.block;
+    entry.slot = recId.slot;
 
+    // (as in bPlusInsert(), the value of the included attribute is read from the record)
+    if (batch->includeOffset != -1) {
+        RelCatEntry relCatEntry;
+        RelCacheTable::getRelCatEntry(batch->relId, &relCatEntry);
 
-        /* iterate through all the entries, to find the first entry whose
-             attribute value >= value to be inserted.
-             NOTE: the helper function compareAttrs() declared in BlockBuffer.h
-                   can be used to compare two Attribute values. */
+        Attribute record[relCatEntry.numAttrs];
+        RecBuffer recBuffer(recId.block);
+        recBuffer.getRecord(record, recId.slot);
+        memcpy(entry.included, &record[batch->includeOffset].nVal, sizeof(entry.included));
+    }
 
-        InternalEntry internalEntry;
-        int index = 0;
-        while(index<headInfo.numEntries){
-            response = internalBlk.getEntry(&internalEntry, index);
+    batch->entries.push_back(entry);
+
+    return SUCCESS;
+}
+
+/*
+Inserts the entries of the batch into the B+ tree in one left to right pass:
+the entries are sorted, and the tree is descended once for each leaf they go
+into (see insertRunIntoLeaf()) rather than once for each entry. The batch is
+left empty.
+If a block could not be allocated, the B+ tree is destroyed (as by bPlusInsert())
+and E_DISKFULL is returned.
+*/
+int BPlusTree::batchEnd(IndexBatch *batch) {
+    std::vector<Index> entries;
+    entries.swap(batch->entries);
 
+    AttrCatEntry attrCatEntry;
+    int response = BPlusTree::getIndexInfo(batch->relId, batch->attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    if (attrCatEntry.rootBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    int attrType = attrCatEntry.attrType;
+    auto keyLess = [attrType](const Index &entry1, const Index &entry2) {
+        return compareAttrs(entry1.attrVal, entry2.attrVal, attrType) < 0;
+    };
+    std::stable_sort(entries.begin(), entries.end(), keyLess);
+
+    int numEntries = entries.size();
+    for (int first = 0; first < numEntries;) {
+        // (readers in other threads see the insertion of each run as a whole; see BlockLatch)
+        BlockLatch::WriteGuard write;
+
+        // (the root changes as the tree grows)
+        BPlusTree::getIndexInfo(batch->relId, batch->attrName, &attrCatEntry);
+
+        // find the leaf of the next entry, and the key above the keys of that leaf (if any)
+        Index upperEntry;
+        bool hasUpper;
+        int leafBlkNum = BPlusTree::findLeafToInsert(attrCatEntry.rootBlock, entries[first].attrVal, attrType,
+                                                     &upperEntry.attrVal, &hasUpper);
+
+        // the entries below that key all go into the leaf
+        int end = numEntries;
+        if (hasUpper) {
+            end = std::lower_bound(entries.begin() + first, entries.end(), upperEntry, keyLess) - entries.begin();
+        }
+
+        response = BPlusTree::insertRunIntoLeaf(batch->relId, batch->attrName, leafBlkNum, &entries[first],
+                                                end - first);
+
+        if (response == E_DISKFULL) {
+            // destroy the B+ tree (from its current root) as bPlusInsert() does
+            BPlusTree::getIndexInfo(batch->relId, batch->attrName, &attrCatEntry);
+            response = BPlusTree::bPlusDestroy(attrCatEntry.rootBlock);
             if (response != SUCCESS) {
-                printf("failed to get entry %d of block %d\n", index, blockNum);
+                printf("failed to destroy tree after disk full error");
                 exit(1);
             }
+            BPlusTree::setIndexRoot(batch->relId, batch->attrName, -1);
 
-            if (compareAttrs(internalEntry.attrVal, attrVal, attrType) > 0){
-                break;
-            }
-            index++;
+            return E_DISKFULL;
         }
-        
 
-        /*no such entry is found*/
+        first = end;
+    }
 
-        if (index == headInfo.numEntries) {
-            // set blockNum = rChild of (nEntries-1)'th entry of the block     
-            // (i.e. rightmost child of the block)
-            blockNum = internalEntry.rChild;
+    return SUCCESS;
+}
 
-        } else {
-            // set blockNum = lChild of the entry that was found
-            blockNum = internalEntry.lChild;
+/*
+Returns the leaf of the B+ tree rooted at rootBlock that the value attrVal is to
+be inserted into. If upperVal is not nullptr, it is set to the smallest key of
+the internal nodes above the keys that lead to that leaf (*hasUpper is false if
+there is none, i.e. for the rightmost leaf): every value below it (and not below
+attrVal) leads to the same leaf.
+*/
+int BPlusTree::findLeafToInsert(int rootBlock, Attribute attrVal, int attrType, Attribute *upperVal,
+                                bool *hasUpper) {
+    if (hasUpper != nullptr) {
+        *hasUpper = false;
+    }
+
+    int blockNum = rootBlock;
+    /* block is not of type IND_LEAF */
+    // use StaticBuffer::getStaticBlockType()
+    int blockType = StaticBuffer::getStaticBlockType(blockNum);
+    for (int level = 0; blockType != IND_LEAF; level++) {
+
+        /* binary search for the first entry whose attribute value > the value
+           to be inserted (see childToDescend()), and move to its left child. if
+           there is no such entry, its index is numEntries, and the
+           (numEntries)'th child is the rChild of the last entry (i.e. rightmost
+           child of the block) */
+        Attribute nextKey;
+        bool hasNextKey;
+        int childBlock = childToDescend(blockNum, level, &attrVal, attrType, true, &nextKey, &hasNextKey);
+
+        if (childBlock < 0) {
+            printf("failed to get a child of block %d\n", blockNum);
+            exit(1);
         }
+
+        // (the key to the right of the child, if any, bounds the keys below it;
+        // the keys of a deeper node are within the bounds of its ancestors)
+        if (upperVal != nullptr && hasNextKey) {
+            *upperVal = nextKey;
+            *hasUpper = true;
+        }
+
+        blockNum = childBlock;
         blockType = StaticBuffer::getStaticBlockType(blockNum);
 
     }
@@ -605,9 +1457,9 @@ int BPlusTree::findLeafToInsert(int rootBlock, Attribute attrVal, int attrType)
 
 int BPlusTree::insertIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum, Index indexEntry) {
     // get the attribute cache entry corresponding to attrName
-    // using AttrCacheTable::getAttrCatEntry().
+    // using BPlusTree::getIndexInfo().
     AttrCatEntry attrCatEntry;
-    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    int response = BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
 
     if(response != SUCCESS){
         printf("failed to get attrCatEntry for relId %d, attrName %s\n", relId, attrName);
@@ -634,40 +1486,25 @@ int BPlusTree::insertIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum,
     Index indices[blockHeader.numEntries + 1];
 
     /*
-    Iterate through all the entries in the block and copy them to the array indices.
-    Also insert `indexEntry` at appropriate position in the indices array maintaining
-    the ascending order.
-    - use IndLeaf::getEntry() to get the entry
-    - use compareAttrs() declared in BlockBuffer.h to compare two Attribute structs
+    Copy all the entries in the block to the array indices, with `indexEntry`
+    inserted at the appropriate position maintaining the ascending order: before
+    the first entry whose attribute value is >= that of indexEntry (found by a
+    binary search of the block using IndLeaf::searchEntries()).
     */
-   int indicesArrayIndex = 0, recordEntry = 0;
-   bool inserted= false;
-   while(recordEntry<blockHeader.numEntries){
-       response = leaf.getEntry(&indices[indicesArrayIndex], recordEntry);
-       if(response!=SUCCESS){
-           printf("failed to get entry %d of block %d\n", recordEntry, blockNum);
-           exit(1);
-       }
-       if(!inserted && compareAttrs(indices[indicesArrayIndex].attrVal, indexEntry.attrVal, attrCatEntry.attrType) >= 0){
-           indices[indicesArrayIndex+1] = indices[indicesArrayIndex];
-           indices[indicesArrayIndex] = indexEntry;
-           indicesArrayIndex++;
-           inserted = true;
-       }
-       indicesArrayIndex++;
-       recordEntry++;
-    }
-    // insert `indexEntry` at appropriate position in the indices array maintaining the ascending order
-    // use compareAttrs() declared in BlockBuffer.h to compare two Attribute structs
-
- 
-    if(!inserted){
-        indices[indicesArrayIndex] = indexEntry;
+    int insertAt = leaf.searchEntries(indexEntry.attrVal, attrCatEntry.attrType, false);
+
+    response = leaf.getEntries(indices, 0, insertAt);
+    if (response == SUCCESS) {
+        response = leaf.getEntries(indices + insertAt + 1, insertAt, blockHeader.numEntries - insertAt);
     }
-    
+    if (response != SUCCESS) {
+        printf("failed to get entries of block %d\n", blockNum);
+        exit(1);
+    }
+    indices[insertAt] = indexEntry;
 
-    if (blockHeader.numEntries != MAX_KEYS_LEAF) {
-        // (leaf block has not reached max limit)
+    if (blockHeader.numEntries != IndLeaf::getMaxEntries(blockHeader.numSlots)) {
+        // (leaf block has not reached max limit of its format)
 
 
         // increment blockHeader.numEntries and update the header of block
@@ -680,14 +1517,12 @@ int BPlusTree::insertIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum,
             exit(1);
         }
 
-        // iterate through all the entries of the array `indices` and populate the
-        // entries of block with them using IndLeaf::setEntry().
-        for (int i = 0; i < blockHeader.numEntries; i++) {
-            response = leaf.setEntry(&indices[i], i);
-            if (response != SUCCESS) {
-                printf("failed to set entry %d of block %d\n", i, blockNum);
-                exit(1);
-            }
+        // populate the entries of block from the inserted entry onwards with the
+        // entries of the array `indices` using IndLeaf::setEntries().
+        response = leaf.setEntries(indices + insertAt, insertAt, blockHeader.numEntries - insertAt);
+        if (response != SUCCESS) {
+            printf("failed to set entries of block %d\n", blockNum);
+            exit(1);
         }
 
         return SUCCESS;
@@ -699,25 +1534,30 @@ int BPlusTree::insertIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum,
     // This function will return the blockNum of the newly allocated block or
     // E_DISKFULL if there are no more blocks to be allocated.
 
-    int newRightBlk = splitLeaf(blockNum, indices);
+    int newRightBlk = splitLeaf(blockNum, indices, blockHeader.numEntries + 1);
 
     // if splitLeaf() returned E_DISKFULL
     //     return E_DISKFULL
     if (newRightBlk == E_DISKFULL) {
         return E_DISKFULL;
     }
+
+    // the key between the two leaves: the last value of the left block (at index 31,
+    // given by constant MIDDLE_INDEX_LEAF, for a plain leaf), or a shorter key for a
+    // STRING attribute (see separatorKey())
+    int numLeft = (blockHeader.numEntries + 1) / 2;
+    Attribute separator = separatorKey(indices[numLeft - 1].attrVal, indices[numLeft].attrVal, attrCatEntry.attrType);
+
     /* the current leaf block was not the root */
     if (blockHeader.pblock != -1) {
         // check pblock in header
-        // insert the middle value from `indices` into the parent block using the
-        // insertIntoInternal() function. (i.e the last value of the left block)
-
-        // the middle value will be at index 31 (given by constant MIDDLE_INDEX_LEAF)
+        // insert the separator into the parent block using the
+        // insertIntoInternal() function.
 
-        // create a struct InternalEntry with attrVal = indices[MIDDLE_INDEX_LEAF].attrVal,
+        // create a struct InternalEntry with attrVal = separator,
         // lChild = currentBlock, rChild = newRightBlk and pass it as argument to
         InternalEntry internalEntry;
-        internalEntry.attrVal = indices[MIDDLE_INDEX_LEAF].attrVal;
+        internalEntry.attrVal = separator;
         internalEntry.lChild = blockNum;
         internalEntry.rChild = newRightBlk;
 
@@ -739,9 +1579,9 @@ int BPlusTree::insertIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum,
         // block needs to be allocated and made the root of the tree.
         // To do this, call the createNewRoot() function with the following arguments
 
-        // createNewRoot(relId, attrName, indices[MIDDLE_INDEX_LEAF].attrVal,
+        // createNewRoot(relId, attrName, separator,
         //               current block, new right block)
-        response = BPlusTree::createNewRoot(relId, attrName, indices[MIDDLE_INDEX_LEAF].attrVal, blockNum, newRightBlk);
+        response = BPlusTree::createNewRoot(relId, attrName, separator, blockNum, newRightBlk);
 
         if(response!=SUCCESS){
             if(response == E_DISKFULL){
@@ -758,7 +1598,12 @@ int BPlusTree::insertIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum,
     return SUCCESS;
 }
 
-int BPlusTree::splitLeaf(int leafBlockNum, Index indices[]) {
+/*
+Splits the numEntries entries in indices between the leaf leafBlockNum (the first
+half) and a new leaf of the same format (the rest), linked to its right.
+Returns the block number of the new leaf, or E_DISKFULL.
+*/
+int BPlusTree::splitLeaf(int leafBlockNum, Index indices[], int numEntries) {
   // obtain new leaf index block to be used as the right block in the splitting
   IndLeaf rightBlk;
   // assign the existing block as the left block in the splitting.
@@ -775,32 +1620,147 @@ int BPlusTree::splitLeaf(int leafBlockNum, Index indices[]) {
   leftBlk.getHeader(&leftBlkHeader);
   rightBlk.getHeader(&rightBlkHeader);
 
-  rightBlkHeader.numEntries = (MAX_KEYS_LEAF + 1) / 2;
+  // (32 entries each for a plain leaf of MAX_KEYS_LEAF entries)
+  int numLeft = numEntries / 2;
+
+  rightBlkHeader.numEntries = numEntries - numLeft;
   rightBlkHeader.rblock = leftBlkHeader.rblock;
   rightBlkHeader.pblock = leftBlkHeader.pblock;
   rightBlkHeader.lblock = leftBlkNum;
+  rightBlkHeader.numSlots = leftBlkHeader.numSlots;
   rightBlk.setHeader(&rightBlkHeader);
 
-  leftBlkHeader.numEntries = (MAX_KEYS_LEAF + 1) / 2;
+  // the leaf that was to the right of leftBlk is now to the right of newRightBlk
+  if (leftBlkHeader.rblock != -1) {
+    BlockBuffer nextBlk(leftBlkHeader.rblock);
+    HeadInfo nextBlkHeader;
+    nextBlk.getHeader(&nextBlkHeader);
+    nextBlkHeader.lblock = rightBlkNum;
+    nextBlk.setHeader(&nextBlkHeader);
+  }
+
+  leftBlkHeader.numEntries = numLeft;
   leftBlkHeader.rblock = rightBlkNum;
   leftBlk.setHeader(&leftBlkHeader);
-  // set the first 32 entries of leftBlk = the first 32 entries of indices array
-  // and set the first 32 entries of newRightBlk = the next 32 entries of
-  // indices array using IndLeaf::setEntry().
-
-  for (int i = 0; i < leftBlkHeader.numEntries; ++i) {
-    leftBlk.setEntry(indices + i, i);
-    rightBlk.setEntry(indices + MIDDLE_INDEX_LEAF + i + 1, i);
-  }
+  // set the entries of leftBlk = the first half of the indices array and the
+  // entries of newRightBlk = the rest using IndLeaf::setEntries().
+  leftBlk.setEntries(indices, 0, numLeft);
+  rightBlk.setEntries(indices + numLeft, 0, numEntries - numLeft);
 
   return rightBlkNum;
 }
 
+/*
+Inserts the runLength entries of run (sorted by key, and all within the keys
+that lead to the leaf blockNum) into the leaf. If they do not all fit, the
+entries of the leaf and of the run are spread evenly over the leaf and as many
+new leaves to its right as needed (filled up to INDEX_FILL_FACTOR percent, but at
+least half), and the key between each pair of leaves is inserted into their parent.
+Returns E_DISKFULL if a block could not be allocated (the new leaves that are not
+in the tree yet are released).
+*/
+int BPlusTree::insertRunIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum, Index run[], int runLength) {
+    AttrCatEntry attrCatEntry;
+    BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
+    int attrType = attrCatEntry.attrType;
+
+    IndLeaf leaf(blockNum);
+    HeadInfo head;
+    leaf.getHeader(&head);
+
+    // merge the entries of the leaf and the run (the entries of the run go after
+    // the entries of the leaf with the same key)
+    Index leafEntries[MAX_KEYS_LEAF_PACKED];
+    leaf.getEntries(leafEntries, 0, head.numEntries);
+
+    int total = head.numEntries + runLength;
+    std::vector<Index> entries(total);
+    std::merge(leafEntries, leafEntries + head.numEntries, run, run + runLength, entries.begin(),
+               [attrType](const Index &entry1, const Index &entry2) {
+                   return compareAttrs(entry1.attrVal, entry2.attrVal, attrType) < 0;
+               });
+
+    int capacity = IndLeaf::getMaxEntries(head.numSlots);
+    if (total <= capacity) {
+        head.numEntries = total;
+        leaf.setHeader(&head);
+        leaf.setEntries(entries.data(), 0, total);
+        return SUCCESS;
+    }
+
+    int entriesPerLeaf = std::max((capacity + 1) / 2, capacity * INDEX_FILL_FACTOR / 100);
+    int numLeaves = (total + entriesPerLeaf - 1) / entriesPerLeaf;
+
+    // the leaf, followed by the new leaves
+    std::vector<int> leafBlocks(numLeaves);
+    leafBlocks[0] = blockNum;
+    for (int leafNum = 1; leafNum < numLeaves; leafNum++) {
+        IndLeaf newLeaf;
+        leafBlocks[leafNum] = newLeaf.getBlockNum();
+        if (leafBlocks[leafNum] == E_DISKFULL) {
+            releaseBlocks(leafBlocks.data() + 1, leafNum - 1);
+            return E_DISKFULL;
+        }
+    }
+
+    // write the leaves, linked left to right (firstEntry[i] is the first entry of leaf i)
+    std::vector<int> firstEntry(numLeaves + 1, 0);
+    for (int leafNum = 0; leafNum < numLeaves; leafNum++) {
+        int count = total / numLeaves + (leafNum < total % numLeaves ? 1 : 0);
+        firstEntry[leafNum + 1] = firstEntry[leafNum] + count;
+
+        IndLeaf leafBlk(leafBlocks[leafNum]);
+        HeadInfo leafHead;
+        leafBlk.getHeader(&leafHead);
+        if (leafNum > 0) {
+            leafHead.lblock = leafBlocks[leafNum - 1];
+            leafHead.numSlots = head.numSlots;
+        }
+        leafHead.rblock = (leafNum + 1 < numLeaves) ? leafBlocks[leafNum + 1] : head.rblock;
+        leafHead.numEntries = count;
+        leafBlk.setHeader(&leafHead);
+        leafBlk.setEntries(entries.data() + firstEntry[leafNum], 0, count);
+    }
+
+    if (head.rblock != -1) {
+        BlockBuffer nextBlk(head.rblock);
+        HeadInfo nextHead;
+        nextBlk.getHeader(&nextHead);
+        nextHead.lblock = leafBlocks[numLeaves - 1];
+        nextBlk.setHeader(&nextHead);
+    }
+
+    // add the new leaves to the parent one at a time, as if the leaf to the left of
+    // each had just been split (see separatorKey() for the key between the two)
+    for (int leafNum = 1; leafNum < numLeaves; leafNum++) {
+        int first = firstEntry[leafNum];
+        Attribute separator = separatorKey(entries[first - 1].attrVal, entries[first].attrVal, attrType);
+
+        // (the parent of the left leaf changes if an earlier insertion split the parent)
+        HeadInfo leftHead, rightHead;
+        BlockBuffer(leafBlocks[leafNum - 1]).getHeader(&leftHead);
+        BlockBuffer rightBlk(leafBlocks[leafNum]);
+        rightBlk.getHeader(&rightHead);
+        rightHead.pblock = leftHead.pblock;
+        rightBlk.setHeader(&rightHead);
+
+        int response = BPlusTree::insertIntoParent(relId, attrName, leafBlocks[leafNum - 1], separator,
+                                                   leafBlocks[leafNum]);
+        if (response == E_DISKFULL) {
+            // (the leaf leafNum was released with the part of the tree that was not connected)
+            releaseBlocks(leafBlocks.data() + leafNum + 1, numLeaves - leafNum - 1);
+            return E_DISKFULL;
+        }
+    }
+
+    return SUCCESS;
+}
+
 int BPlusTree::insertIntoInternal(int relId, char attrName[ATTR_SIZE], int intBlockNum, InternalEntry intEntry) {
     // get the attribute cache entry corresponding to attrName
-    // using AttrCacheTable::getAttrCatEntry().
+    // using BPlusTree::getIndexInfo().
     AttrCatEntry attrCatEntry;
-    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    int response = BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
 
     if(response!=SUCCESS){
         printf("failed to get attrCatEntry for relId %d, attrName %s\n", relId, attrName);
@@ -811,80 +1771,53 @@ int BPlusTree::insertIntoInternal(int relId, char attrName[ATTR_SIZE], int intBl
     // corresponding to intBlockNum
     IndInternal intBlk(intBlockNum);
 
-    HeadInfo blockHeader;
-    // load blockHeader with header of intBlk using BlockBuffer::getHeader().
-    response = intBlk.getHeader(&blockHeader);
+    // the children and keys of the block, with room for the new entry
+    int children[MAX_KEYS_INTERNAL_PREFIX + 2];
+    Attribute keys[MAX_KEYS_INTERNAL_PREFIX + 1];
+    int numKeys = intBlk.getNode(children, keys);
 
-    if (response != SUCCESS) {
-        printf("failed to get header for block %d\n", intBlockNum);
+    if (numKeys < 0) {
+        printf("failed to get entries of block %d\n", intBlockNum);
         exit(1);
     }
 
-    // declare internalEntries to store all existing entries + the new entry
-    InternalEntry internalEntries[blockHeader.numEntries + 1];
-
     /*
-    Iterate through all the entries in the block and copy them to the array
-    `internalEntries`. Insert `indexEntry` at appropriate position in the
-    array maintaining the ascending order.
-        - use IndInternal::getEntry() to get the entry
-        - use compareAttrs() to compare two structs of type Attribute
-
-    Update the lChild of the internalEntry immediately following the newly added
-    entry to the rChild of the newly added entry.
+    Insert the key of `intEntry` just before the key to the right of the block
+    that was split (intEntry.lChild), and its rChild just after that block. This
+    keeps the ascending order, and unlike a search by value it puts the entry next
+    to its child when several keys are equal.
     */
-    int indicesArrayIndex = 0, recordEntry = 0;
-    bool inserted = false;
-    while (recordEntry < blockHeader.numEntries) {
-        response = intBlk.getEntry(&internalEntries[indicesArrayIndex], recordEntry);
-        if (response != SUCCESS) {
-            printf("failed to get entry %d of block %d\n", recordEntry, intBlockNum);
-            exit(1);
-        }
-        if (!inserted && compareAttrs(internalEntries[indicesArrayIndex].attrVal, intEntry.attrVal, attrCatEntry.attrType) >= 0) {
-            internalEntries[indicesArrayIndex + 1] = internalEntries[indicesArrayIndex];
-            internalEntries[indicesArrayIndex] = intEntry;
-            internalEntries[indicesArrayIndex+1].lChild = internalEntries[indicesArrayIndex].rChild;
-            indicesArrayIndex++;
-            inserted = true;
-        }
-        indicesArrayIndex++;
-        recordEntry++;
+    int childNum = 0;
+    while (childNum < numKeys && children[childNum] != intEntry.lChild) {
+        childNum++;
     }
-    if(!inserted){
-        internalEntries[indicesArrayIndex] = intEntry;
+    for (int i = numKeys; i > childNum; i--) {
+        keys[i] = keys[i - 1];
+        children[i + 1] = children[i];
     }
+    keys[childNum] = intEntry.attrVal;
+    children[childNum + 1] = intEntry.rChild;
+    numKeys++;
 
-
-    if (blockHeader.numEntries != MAX_KEYS_INTERNAL) {
-        // (internal index block has not reached max limit)
-
-        // increment blockheader.numEntries and update the header of intBlk
-        // using BlockBuffer::setHeader().
-        blockHeader.numEntries++;
-        response = intBlk.setHeader(&blockHeader);
-
-        // iterate through all entries in internalEntries array and populate the
-        // entries of intBlk with them using IndInternal::setEntry().
-        for (int i = 0; i < blockHeader.numEntries; i++) {
-            response = intBlk.setEntry(&internalEntries[i], i);
-            if (response != SUCCESS) {
-                printf("failed to set entry %d of block %d\n", i, intBlockNum);
-                exit(1);
-            }
+    if (IndInternal::getNodeSize(keys, numKeys, attrCatEntry.attrType) <= BLOCK_SIZE - HEADER_SIZE) {
+        // (the entries fit in the internal index block)
+        response = intBlk.setNode(children, keys, numKeys, attrCatEntry.attrType);
+        if (response != SUCCESS) {
+            printf("failed to set entries of block %d\n", intBlockNum);
+            exit(1);
         }
 
         return SUCCESS;
     }
 
-    // If we reached here, the `internalEntries` array has more than entries than
-    // can fit in a single internal index block. Therefore, we will need to split
-    // the entries in `internalEntries` between two internal index blocks. We do
-    // this using the splitInternal() function.
+    // If we reached here, the entries do not fit in a single internal index
+    // block. Therefore, we will need to split them between two internal index
+    // blocks. We do this using the splitInternal() function.
     // This function will return the blockNum of the newly allocated block or
     // E_DISKFULL if there are no more blocks to be allocated.
 
-    int newRightBlk = splitInternal(intBlockNum, internalEntries);
+    Attribute middleKey;
+    int newRightBlk = splitInternal(intBlockNum, children, keys, numKeys, attrCatEntry.attrType, &middleKey);
     
     /* splitInternal() returned E_DISKFULL */
     if (newRightBlk == E_DISKFULL) {
@@ -900,24 +1833,30 @@ int BPlusTree::insertIntoInternal(int relId, char attrName[ATTR_SIZE], int intBl
 
         return E_DISKFULL;
     }
-    /* the current block was not the root */
-    if (blockHeader.pblock != -1) {   // (check pblock in header)
-        // insert the middle value from `internalEntries` into the parent block
-        // using the insertIntoInternal() function (recursively).
 
+    // insert the middle key into the parent block (or a new root)
+    return BPlusTree::insertIntoParent(relId, attrName, intBlockNum, middleKey, newRightBlk);
+}
 
+/*
+Inserts the key between the block blockNum, which has just been split, and the
+new block to its right (rightBlockNum) into the parent of blockNum; if blockNum
+was the root, a new root is made with the two blocks as its children.
+Returns E_DISKFULL if a block could not be allocated.
+*/
+int BPlusTree::insertIntoParent(int relId, char attrName[ATTR_SIZE], int blockNum, Attribute attrVal, int rightBlockNum) {
+    HeadInfo blockHeader;
+    BlockBuffer(blockNum).getHeader(&blockHeader);
 
-        // the middle value will be at index 50 (given by constant MIDDLE_INDEX_INTERNAL)
-
-
-        // create a struct InternalEntry with lChild = current block, rChild = newRightBlk
-        // and attrVal = internalEntries[MIDDLE_INDEX_INTERNAL].attrVal
+    int response;
+    /* the current block was not the root */
+    if (blockHeader.pblock != -1) {   // (check pblock in header)
+        // create a struct InternalEntry with lChild = current block, rChild = new
+        // right block and attrVal = the middle key
         InternalEntry internalEntry;
-        internalEntry.lChild = intBlockNum;
-        internalEntry.rChild = newRightBlk;
-        internalEntry.attrVal = internalEntries[MIDDLE_INDEX_INTERNAL].attrVal;
-
-        // and pass it as argument to the insertIntoInternalFunction as follows
+        internalEntry.lChild = blockNum;
+        internalEntry.rChild = rightBlockNum;
+        internalEntry.attrVal = attrVal;
 
         // insertIntoInternal(relId, attrName, parent of current block, new internal entry)
         response = BPlusTree::insertIntoInternal(relId, attrName, blockHeader.pblock, internalEntry);
@@ -933,12 +1872,7 @@ int BPlusTree::insertIntoInternal(int relId, char attrName[ATTR_SIZE], int intBl
     } else {
         // the current block was the root block and is now split. a new internal index
         // block needs to be allocated and made the root of the tree.
-        // To do this, call the createNewRoot() function with the following arguments
-
-        // createNewRoot(relId, attrName,
-        //               internalEntries[MIDDLE_INDEX_INTERNAL].attrVal,
-        //               current block, new right block)
-        response = BPlusTree::createNewRoot(relId, attrName, internalEntries[MIDDLE_INDEX_INTERNAL].attrVal, intBlockNum, newRightBlk);
+        response = BPlusTree::createNewRoot(relId, attrName, attrVal, blockNum, rightBlockNum);
 
         if(response!=SUCCESS){
             if(response == E_DISKFULL){
@@ -949,13 +1883,18 @@ int BPlusTree::insertIntoInternal(int relId, char attrName[ATTR_SIZE], int intBl
         }
     }
 
-    // if either of the above calls returned an error (E_DISKFULL), then return that
-    // else return SUCCESS
     return SUCCESS;
 }
 
-
-int BPlusTree::splitInternal(int intBlockNum, InternalEntry internalEntries[]) {
+/*
+Shares the numKeys keys (and numKeys + 1 children) of an internal node that do
+not fit in one block between the block intBlockNum and a new block to its right:
+the key chosen by splitPoint() moves up (into *middleKey), the keys before it stay
+in intBlockNum and those after it go to the new block.
+Returns the block number of the new block, or E_DISKFULL.
+*/
+int BPlusTree::splitInternal(int intBlockNum, int children[], Attribute keys[], int numKeys, int attrType,
+                             Attribute *middleKey) {
     // declare rightBlk, an instance of IndInternal using constructor 1 to obtain new
     // internal index block that will be used as the right block in the splitting
     IndInternal rightBlk;
@@ -975,92 +1914,53 @@ int BPlusTree::splitInternal(int intBlockNum, InternalEntry internalEntries[]) {
         return E_DISKFULL;
     }
 
-    HeadInfo leftBlkHeader, rightBlkHeader;
-    // get the headers of left block and right block using BlockBuffer::getHeader()
-
-    int response = leftBlk.getHeader(&leftBlkHeader);
+    /*
+    - set the entries of leftBlk = keys 0 to middle - 1 (and their children)
+    - set the entries of rightBlk = keys middle + 1 to numKeys - 1
+      (the key at index middle will be moving to the parent internal index block)
+    */
+    int middle = splitPoint(keys, numKeys, attrType);
 
+    int response = leftBlk.setNode(children, keys, middle, attrType);
     if (response != SUCCESS) {
-        printf("failed to get header for block %d\n", leftBlkNum);
+        printf("failed to set entries of block %d\n", leftBlkNum);
         exit(1);
     }
 
-    response = rightBlk.getHeader(&rightBlkHeader);
-
+    response = rightBlk.setNode(children + middle + 1, keys + middle + 1, numKeys - middle - 1, attrType);
     if (response != SUCCESS) {
-        printf("failed to get header for block %d\n", rightBlkNum);
+        printf("failed to set entries of block %d\n", rightBlkNum);
         exit(1);
     }
 
-    // set rightBlkHeader with the following values
-    // - number of entries = (MAX_KEYS_INTERNAL)/2 = 50
-    // - pblock = pblock of leftBlk
-    // and update the header of rightBlk using BlockBuffer::setHeader()
-
-    rightBlkHeader.numEntries = (MAX_KEYS_INTERNAL)/2;
-    rightBlkHeader.pblock = leftBlkHeader.pblock;
-
-    response = rightBlk.setHeader(&rightBlkHeader);
+    *middleKey = keys[middle];
 
-    if (response != SUCCESS) {
-        printf("failed to set header for block %d\n", rightBlkNum);
-        exit(1);
-    }
+    HeadInfo leftBlkHeader, rightBlkHeader;
+    // get the headers of left block and right block using BlockBuffer::getHeader()
+    leftBlk.getHeader(&leftBlkHeader);
+    rightBlk.getHeader(&rightBlkHeader);
 
-    // set leftBlkHeader with the following values
-    // - number of entries = (MAX_KEYS_INTERNAL)/2 = 50
-    // - rblock = rightBlkNum
-    // and update the header using BlockBuffer::setHeader()
+    // set the pblock of rightBlk to the pblock of leftBlk, and link the two blocks
+    // using BlockBuffer::setHeader()
+    rightBlkHeader.pblock = leftBlkHeader.pblock;
+    rightBlkHeader.rblock = leftBlkHeader.rblock;
+    rightBlk.setHeader(&rightBlkHeader);
 
-    leftBlkHeader.numEntries = (MAX_KEYS_INTERNAL)/2;
     leftBlkHeader.rblock = rightBlkNum;
+    leftBlk.setHeader(&leftBlkHeader);
 
-    response = leftBlk.setHeader(&leftBlkHeader);
-
-    if (response != SUCCESS) {
-        printf("failed to set header for block %d\n", leftBlkNum);
-        exit(1);
-    }
-
-
-    /*
-    - set the first 50 entries of leftBlk = index 0 to 49 of internalEntries
-      array
-    - set the first 50 entries of newRightBlk = entries from index 51 to 100
-      of internalEntries array using IndInternal::setEntry().
-      (index 50 will be moving to the parent internal index block)
-    */
-
-    for (int i = 0; i < (MAX_KEYS_INTERNAL)/2; i++) {
-        response = leftBlk.setEntry(&internalEntries[i], i);
-        if (response != SUCCESS) {
-            printf("failed to set entry %d of block %d\n", i, leftBlkNum);
-            exit(1);
-        }
-
-        response = rightBlk.setEntry(&internalEntries[i + (MAX_KEYS_INTERNAL)/2+1], i);
-        if (response != SUCCESS) {
-            printf("failed to set entry %d of block %d\n", i, rightBlkNum);
-            exit(1);
-        }
-    }
-
-
-    /* block type of a child of any entry of the internalEntries array */;
-    //            (use StaticBuffer::getStaticBlockType())
-    int type = StaticBuffer::getStaticBlockType(internalEntries[0].rChild);
     /* each child block of the new right block */
-    for (int internalBlkEntryIndex = (MAX_KEYS_INTERNAL)/2 ; internalBlkEntryIndex <= MAX_KEYS_INTERNAL; internalBlkEntryIndex++) {
+    for (int childNum = middle + 1; childNum <= numKeys; childNum++) {
         // declare an instance of BlockBuffer to access the child block using
         // constructor 2
-        BlockBuffer childBlk(internalEntries[internalBlkEntryIndex].rChild);
+        BlockBuffer childBlk(children[childNum]);
 
         // update pblock of the block to rightBlkNum using BlockBuffer::getHeader()
         HeadInfo childHeadInfo;
         response = childBlk.getHeader(&childHeadInfo);
 
         if (response != SUCCESS) {
-            printf("failed to get header for block %d\n", internalEntries[internalBlkEntryIndex].lChild);
+            printf("failed to get header for block %d\n", children[childNum]);
             exit(1);
         }
         // and BlockBuffer::setHeader().
@@ -1075,9 +1975,9 @@ int BPlusTree::splitInternal(int intBlockNum, InternalEntry internalEntries[]) {
 
 int BPlusTree::createNewRoot(int relId, char attrName[ATTR_SIZE], Attribute attrVal, int lChild, int rChild) {
     // get the attribute cache entry corresponding to attrName
-    // using AttrCacheTable::getAttrCatEntry().
+    // using BPlusTree::getIndexInfo().
     AttrCatEntry attrCatEntry;
-    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    int response = BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
 
     if(response!=SUCCESS){
         printf("failed to get attrCatEntry for relId %d, attrName %s\n", relId, attrName);
@@ -1103,29 +2003,16 @@ int BPlusTree::createNewRoot(int relId, char attrName[ATTR_SIZE], Attribute attr
         return E_DISKFULL;
     }
 
-    // update the header of the new block with numEntries = 1 using
-    // BlockBuffer::getHeader() and BlockBuffer::setHeader()
-    HeadInfo headInfo;
-    response = newRootBlk.getHeader(&headInfo);
+    // set the only entry of newRootBlk (lChild, attrVal and rChild from the
+    // arguments) using IndInternal::setNode()
+    int children[2] = {lChild, rChild};
+    response = newRootBlk.setNode(children, &attrVal, 1, attrCatEntry.attrType);
 
     if (response != SUCCESS) {
-        printf("failed to get header for block %d\n", newRootBlkNum);
+        printf("failed to set entries of block %d\n", newRootBlkNum);
         exit(1);
     }
 
-    headInfo.numEntries = 1;
-
-    response = newRootBlk.setHeader(&headInfo);
-
-    // create a struct InternalEntry with lChild, attrVal and rChild from the
-    // arguments and set it as the first entry in newRootBlk using IndInternal::setEntry()
-    InternalEntry internalEntry;
-    internalEntry.lChild = lChild;
-    internalEntry.attrVal = attrVal;
-    internalEntry.rChild = rChild;
-
-    response = newRootBlk.setEntry(&internalEntry, 0);
-
     // declare BlockBuffer instances for the `lChild` and `rChild` blocks using
     // appropriate constructor and update the pblock of those blocks to `newRootBlkNum`
     // using BlockBuffer::getHeader() and BlockBuffer::setHeader()
@@ -1166,11 +2053,8 @@ int BPlusTree::createNewRoot(int relId, char attrName[ATTR_SIZE], Attribute attr
     }
 
     // update rootBlock = newRootBlkNum for the entry corresponding to `attrName`
-    // in the attribute cache using AttrCacheTable::setAttrCatEntry().
-
-    attrCatEntry.rootBlock = newRootBlkNum;
-
-    response = AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+    // in the attribute cache (or for the composite index) using BPlusTree::setIndexRoot().
+    response = BPlusTree::setIndexRoot(relId, attrName, newRootBlkNum);
 
     if(response!=SUCCESS){
         printf("failed to set attrCatEntry for relId %d, attrName %s\n", relId, attrName);
@@ -1180,3 +2064,593 @@ int BPlusTree::createNewRoot(int relId, char attrName[ATTR_SIZE], Attribute attr
     return SUCCESS;
 }
 
+// sets the parent (pblock) of an index block
+static void setParent(int blockNum, int parentBlockNum) {
+    BlockBuffer block(blockNum);
+    HeadInfo header;
+    block.getHeader(&header);
+    header.pblock = parentBlockNum;
+    block.setHeader(&header);
+}
+
+// returns the index of the child `childBlockNum` in the internal index block `parentBlockNum`
+static int findChild(int parentBlockNum, int childBlockNum) {
+    IndInternal parentBlk(parentBlockNum);
+    HeadInfo header;
+    parentBlk.getHeader(&header);
+
+    for (int childNum = 0; childNum <= header.numEntries; childNum++) {
+        if (parentBlk.getChild(childNum) == childBlockNum) {
+            return childNum;
+        }
+    }
+
+    printf("block %d is not a child of its parent block %d\n", childBlockNum, parentBlockNum);
+    exit(1);
+}
+
+/*
+Writes the numKeys keys (and numKeys + 1 children) of an internal node into the
+block blockNum, which they replace; if they do not fit, the node is split as
+in insertIntoInternal(). Returns E_DISKFULL if a block could not be allocated.
+*/
+int BPlusTree::storeInternal(int relId, char attrName[ATTR_SIZE], int blockNum, int children[], Attribute keys[],
+                             int numKeys, int attrType) {
+    if (IndInternal::getNodeSize(keys, numKeys, attrType) <= BLOCK_SIZE - HEADER_SIZE) {
+        return IndInternal(blockNum).setNode(children, keys, numKeys, attrType);
+    }
+
+    Attribute middleKey;
+    int rightBlockNum = BPlusTree::splitInternal(blockNum, children, keys, numKeys, attrType, &middleKey);
+    if (rightBlockNum == E_DISKFULL) {
+        return E_DISKFULL;
+    }
+
+    return BPlusTree::insertIntoParent(relId, attrName, blockNum, middleKey, rightBlockNum);
+}
+
+/*
+Removes the entry of the record at recId, whose value of the attribute (or key
+of the composite index) attrName is attrVal, from the B+ tree of attrName.
+A leaf (or internal node) that falls below half full borrows entries from a
+sibling, or is merged with it if they fit in one node. When the root is left
+with a single child, that child becomes the root.
+A separator key that moves to a prefix compressed node may not fit there, and
+the node is then split; if no block is left for it, the B+ tree is destroyed
+(as by bPlusInsert()) and E_DISKFULL is returned.
+*/
+int BPlusTree::bPlusDelete(int relId, char attrName[ATTR_SIZE], Attribute attrVal, RecId recId) {
+    // (readers in other threads see the changes to the tree as a whole; see BlockLatch)
+    BlockLatch::WriteGuard write;
+
+    AttrCatEntry attrCatEntry;
+    int response = BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    int rootBlock = attrCatEntry.rootBlock;
+    if (rootBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    // go down to the leftmost leaf that may hold attrVal
+    // (the key of an internal entry is not smaller than the values of its left subtree)
+    int blockNum = rootBlock;
+    for (int level = 0; StaticBuffer::getStaticBlockType(blockNum) == IND_INTERNAL; level++) {
+        blockNum = childToDescend(blockNum, level, &attrVal, attrCatEntry.attrType, false);
+    }
+
+    // the entries with value attrVal start there and may run on into the next
+    // leaves; find the one of the record
+    IndLeaf leafBlk(blockNum);
+    int index = leafBlk.searchEntries(attrVal, attrCatEntry.attrType, false);
+    while (true) {
+        HeadInfo leafHead;
+        leafBlk.getHeader(&leafHead);
+
+        if (index >= leafHead.numEntries) {
+            if (leafHead.rblock == -1) {
+                return E_NOTFOUND;
+            }
+            leafBlk = IndLeaf(leafHead.rblock);
+            index = 0;
+            continue;
+        }
+
+        Index entry;
+        leafBlk.getEntry(&entry, index);
+        if (compareAttrs(entry.attrVal, attrVal, attrCatEntry.attrType) != 0) {
+            return E_NOTFOUND;
+        }
+        if (entry.block == recId.block && entry.slot == recId.slot) {
+            break;
+        }
+        index++;
+    }
+
+    // shift the entries after the deleted one to the left
+    int leafBlockNum = leafBlk.getBlockNum();
+    HeadInfo leafHead;
+    leafBlk.getHeader(&leafHead);
+
+    Index entries[MAX_KEYS_LEAF_PACKED];
+    int numAfter = leafHead.numEntries - index - 1;
+    leafBlk.getEntries(entries, index + 1, numAfter);
+    leafBlk.setEntries(entries, index, numAfter);
+
+    leafHead.numEntries--;
+    leafBlk.setHeader(&leafHead);
+
+    // (the root may have any number of entries, down to none; other leaves are kept
+    // at least half full: MIN_KEYS_LEAF entries for a plain leaf)
+    int minEntries = (IndLeaf::getMaxEntries(leafHead.numSlots) + 1) / 2;
+    if (leafHead.pblock != -1 && leafHead.numEntries < minEntries) {
+        response = BPlusTree::rebalanceLeaf(relId, attrName, leafBlockNum);
+
+        if (response == E_DISKFULL) {
+            response = BPlusTree::bPlusDestroy(rootBlock);
+            if (response != SUCCESS) {
+                printf("failed to destroy tree after disk full error");
+                exit(1);
+            }
+            BPlusTree::setIndexRoot(relId, attrName, -1);
+            return E_DISKFULL;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/*
+Brings the leaf leafBlockNum, which has fallen below half of the entries of its
+format (MIN_KEYS_LEAF for a plain leaf), back to at least that many. The leaf is paired with its left sibling (its right
+sibling if it is the first child of its parent):
+  - if the entries of both fit in one leaf, the right leaf of the pair is merged
+    into the left one and removed from the parent
+  - otherwise the entries are shared evenly between the two and the key of the
+    parent between them is set to separate the two leaves again (see separatorKey())
+*/
+int BPlusTree::rebalanceLeaf(int relId, char attrName[ATTR_SIZE], int leafBlockNum) {
+    AttrCatEntry attrCatEntry;
+    BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
+
+    HeadInfo head;
+    BlockBuffer(leafBlockNum).getHeader(&head);
+    int parentBlockNum = head.pblock;
+
+    // (the pair is the children leftNum and leftNum + 1 of the parent)
+    int childNum = findChild(parentBlockNum, leafBlockNum);
+    int leftNum = (childNum == 0) ? 0 : childNum - 1;
+
+    IndInternal parentBlk(parentBlockNum);
+    IndLeaf leftBlk(parentBlk.getChild(leftNum));
+    IndLeaf rightBlk(parentBlk.getChild(leftNum + 1));
+    int leftBlockNum = leftBlk.getBlockNum();
+
+    HeadInfo leftHead, rightHead;
+    leftBlk.getHeader(&leftHead);
+    rightBlk.getHeader(&rightHead);
+
+    Index entries[2 * MAX_KEYS_LEAF_PACKED];
+    int total = leftHead.numEntries + rightHead.numEntries;
+    leftBlk.getEntries(entries, 0, leftHead.numEntries);
+    rightBlk.getEntries(entries + leftHead.numEntries, 0, rightHead.numEntries);
+
+    // (the leaves of a tree are all of the same format)
+    if (total <= IndLeaf::getMaxEntries(leftHead.numSlots)) {
+        // merge the right leaf into the left one and unlink it from the leaves
+        leftBlk.setEntries(entries, 0, total);
+        leftHead.numEntries = total;
+        leftHead.rblock = rightHead.rblock;
+        leftBlk.setHeader(&leftHead);
+
+        if (rightHead.rblock != -1) {
+            BlockBuffer nextBlk(rightHead.rblock);
+            HeadInfo nextHead;
+            nextBlk.getHeader(&nextHead);
+            nextHead.lblock = leftBlockNum;
+            nextBlk.setHeader(&nextHead);
+        }
+
+        rightBlk.releaseBlock();
+
+        return BPlusTree::removeFromInternal(relId, attrName, parentBlockNum, leftNum);
+    }
+
+    // share the entries between the two leaves
+    int numLeft = total / 2;
+    leftBlk.setEntries(entries, 0, numLeft);
+    rightBlk.setEntries(entries + numLeft, 0, total - numLeft);
+
+    leftHead.numEntries = numLeft;
+    leftBlk.setHeader(&leftHead);
+    rightHead.numEntries = total - numLeft;
+    rightBlk.setHeader(&rightHead);
+
+    // (a longer separator may not fit in a prefix compressed parent)
+    int children[MAX_KEYS_INTERNAL_PREFIX + 2];
+    Attribute keys[MAX_KEYS_INTERNAL_PREFIX + 1];
+    int numKeys = parentBlk.getNode(children, keys);
+    keys[leftNum] = separatorKey(entries[numLeft - 1].attrVal, entries[numLeft].attrVal, attrCatEntry.attrType);
+
+    return BPlusTree::storeInternal(relId, attrName, parentBlockNum, children, keys, numKeys, attrCatEntry.attrType);
+}
+
+/*
+Removes the keyNum'th key of the internal index block blockNum, along with the
+child to its right (a child that has been merged into its left sibling).
+*/
+int BPlusTree::removeFromInternal(int relId, char attrName[ATTR_SIZE], int blockNum, int keyNum) {
+    AttrCatEntry attrCatEntry;
+    BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
+
+    int children[MAX_KEYS_INTERNAL_PREFIX + 1];
+    Attribute keys[MAX_KEYS_INTERNAL_PREFIX];
+    int numKeys = IndInternal(blockNum).getNode(children, keys);
+
+    for (int i = keyNum; i < numKeys - 1; i++) {
+        keys[i] = keys[i + 1];
+        children[i + 1] = children[i + 2];
+    }
+    numKeys--;
+
+    HeadInfo head;
+    BlockBuffer(blockNum).getHeader(&head);
+
+    if (head.pblock == -1 && numKeys == 0) {
+        // the root is left with a single child, which becomes the root
+        setParent(children[0], -1);
+        IndInternal(blockNum).releaseBlock();
+
+        int response = BPlusTree::setIndexRoot(relId, attrName, children[0]);
+        if (response != SUCCESS) {
+            printf("failed to set the root of the index %s of relId %d\n", attrName, relId);
+            exit(1);
+        }
+        return SUCCESS;
+    }
+
+    // (a node with a key less uses fewer bytes, and fits)
+    IndInternal(blockNum).setNode(children, keys, numKeys, attrCatEntry.attrType);
+
+    if (head.pblock != -1 && internalUnderflows(keys, numKeys, attrCatEntry.attrType)) {
+        return BPlusTree::rebalanceInternal(relId, attrName, blockNum);
+    }
+
+    return SUCCESS;
+}
+
+/*
+Brings the internal index block blockNum, which has fallen below half full (see
+internalUnderflows()), back to at least that. As in rebalanceLeaf(), the block is
+paired with a sibling; the key of the parent between the two moves down between
+their keys, and either the pair is merged into the left block if it fits, or the
+keys are shared evenly (by the bytes they use) and the middle one moves up to the
+parent.
+*/
+int BPlusTree::rebalanceInternal(int relId, char attrName[ATTR_SIZE], int blockNum) {
+    AttrCatEntry attrCatEntry;
+    BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
+    int attrType = attrCatEntry.attrType;
+
+    HeadInfo head;
+    BlockBuffer(blockNum).getHeader(&head);
+    int parentBlockNum = head.pblock;
+
+    int childNum = findChild(parentBlockNum, blockNum);
+    int leftNum = (childNum == 0) ? 0 : childNum - 1;
+
+    int parentChildren[MAX_KEYS_INTERNAL_PREFIX + 2];
+    Attribute parentKeys[MAX_KEYS_INTERNAL_PREFIX + 1];
+    int numParentKeys = IndInternal(parentBlockNum).getNode(parentChildren, parentKeys);
+    int leftBlockNum = parentChildren[leftNum];
+    int rightBlockNum = parentChildren[leftNum + 1];
+
+    // keys of the left block, the key of the parent and the keys of the right block
+    int children[2 * MAX_KEYS_INTERNAL_PREFIX + 2];
+    Attribute keys[2 * MAX_KEYS_INTERNAL_PREFIX + 1];
+    int numLeftKeys = IndInternal(leftBlockNum).getNode(children, keys);
+    keys[numLeftKeys] = parentKeys[leftNum];
+    int numRightKeys = IndInternal(rightBlockNum).getNode(children + numLeftKeys + 1, keys + numLeftKeys + 1);
+    int total = numLeftKeys + 1 + numRightKeys;
+
+    if (IndInternal::getNodeSize(keys, total, attrType) <= BLOCK_SIZE - HEADER_SIZE) {
+        // merge the right block into the left one
+        IndInternal(leftBlockNum).setNode(children, keys, total, attrType);
+        for (int i = numLeftKeys + 1; i <= total; i++) {
+            setParent(children[i], leftBlockNum);
+        }
+
+        HeadInfo leftHead, rightHead;
+        BlockBuffer leftBlk(leftBlockNum);
+        BlockBuffer rightBlk(rightBlockNum);
+        leftBlk.getHeader(&leftHead);
+        rightBlk.getHeader(&rightHead);
+        leftHead.rblock = rightHead.rblock;
+        leftBlk.setHeader(&leftHead);
+        rightBlk.releaseBlock();
+
+        return BPlusTree::removeFromInternal(relId, attrName, parentBlockNum, leftNum);
+    }
+
+    // share the keys, the numLeft'th one moving up to the parent
+    int numLeft = splitPoint(keys, total, attrType);
+    IndInternal(leftBlockNum).setNode(children, keys, numLeft, attrType);
+    IndInternal(rightBlockNum).setNode(children + numLeft + 1, keys + numLeft + 1, total - numLeft - 1, attrType);
+
+    // (the children that changed blocks)
+    if (numLeft < numLeftKeys) {
+        for (int i = numLeft + 1; i <= numLeftKeys; i++) {
+            setParent(children[i], rightBlockNum);
+        }
+    } else {
+        for (int i = numLeftKeys + 1; i <= numLeft; i++) {
+            setParent(children[i], leftBlockNum);
+        }
+    }
+
+    // (a longer separator may not fit in a prefix compressed parent)
+    parentKeys[leftNum] = keys[numLeft];
+    return BPlusTree::storeInternal(relId, attrName, parentBlockNum, parentChildren, parentKeys, numParentKeys,
+                                    attrType);
+}
+
+/*
+Checks the subtree of the B+ tree rooted at blockNum, whose keys must lie
+between lowerVal and upperVal (either bound may be absent), and adds its nodes
+to stats. The leaves are expected in the order of the leaf list, the next one
+being *nextLeaf, each one linked back (lblock) to the leaf before it, *prevLeaf.
+Returns false (having printed the problem) if the subtree is
+not well formed.
+*/
+static bool checkSubtree(int blockNum, int parentBlockNum, int depth, int attrType, Attribute *lowerVal,
+                         Attribute *upperVal, int *prevLeaf, int *nextLeaf, IndexStats *stats) {
+    HeadInfo head;
+    BlockBuffer(blockNum).getHeader(&head);
+
+    if (head.pblock != parentBlockNum) {
+        printf("block %d: parent is %d, expected %d\n", blockNum, head.pblock, parentBlockNum);
+        return false;
+    }
+
+    if (StaticBuffer::getStaticBlockType(blockNum) == IND_LEAF) {
+        if (stats->height == 0) {
+            stats->height = depth;
+        } else if (depth != stats->height) {
+            printf("leaf %d: at depth %d, other leaves at depth %d\n", blockNum, depth, stats->height);
+            return false;
+        }
+        if (blockNum != *nextLeaf) {
+            printf("leaf %d: leaf list reaches block %d instead\n", blockNum, *nextLeaf);
+            return false;
+        }
+        if (head.lblock != *prevLeaf) {
+            printf("leaf %d: linked back to block %d instead of %d\n", blockNum, head.lblock, *prevLeaf);
+            return false;
+        }
+        *nextLeaf = head.rblock;
+
+        // (the leaves of a tree are all of the same format)
+        int leafCapacity = IndLeaf::getMaxEntries(head.numSlots);
+        if (stats->leafCapacity == 0) {
+            stats->leafCapacity = leafCapacity;
+        } else if (leafCapacity != stats->leafCapacity) {
+            printf("leaf %d: holds %d entries, other leaves hold %d\n", blockNum, leafCapacity, stats->leafCapacity);
+            return false;
+        }
+
+        IndLeaf leafBlk(blockNum);
+        Index entries[MAX_KEYS_LEAF_PACKED];
+        leafBlk.getEntries(entries, 0, head.numEntries);
+        for (int i = 0; i < head.numEntries; i++) {
+            Attribute key = entries[i].attrVal;
+            if ((lowerVal != nullptr && compareAttrs(key, *lowerVal, attrType) < 0) ||
+                (upperVal != nullptr && compareAttrs(key, *upperVal, attrType) > 0) ||
+                (i > 0 && compareAttrs(entries[i - 1].attrVal, key, attrType) > 0)) {
+                printf("leaf %d: entry %d out of order\n", blockNum, i);
+                return false;
+            }
+        }
+
+        // (a leaf not in the block after the previous leaf starts a run)
+        if (*prevLeaf == -1 || *prevLeaf + 1 != blockNum) {
+            stats->numLeafRuns++;
+        }
+        *prevLeaf = blockNum;
+        stats->numLeaves++;
+        stats->numEntries += head.numEntries;
+        if (parentBlockNum != -1 && head.numEntries < stats->minLeafEntries) {
+            stats->minLeafEntries = head.numEntries;
+        }
+        return true;
+    }
+
+    int children[MAX_KEYS_INTERNAL_PREFIX + 1];
+    Attribute keys[MAX_KEYS_INTERNAL_PREFIX];
+    int numKeys = IndInternal(blockNum).getNode(children, keys);
+    for (int i = 0; i < numKeys; i++) {
+        if ((lowerVal != nullptr && compareAttrs(keys[i], *lowerVal, attrType) < 0) ||
+            (upperVal != nullptr && compareAttrs(keys[i], *upperVal, attrType) > 0) ||
+            (i > 0 && compareAttrs(keys[i - 1], keys[i], attrType) > 0)) {
+            printf("internal block %d: key %d out of order\n", blockNum, i);
+            return false;
+        }
+    }
+
+    stats->numInternal++;
+    stats->numInternalKeys += numKeys;
+    if (parentBlockNum != -1 && numKeys < stats->minInternalKeys) {
+        stats->minInternalKeys = numKeys;
+    }
+
+    // (the keys of child i lie between keys i - 1 and i)
+    for (int i = 0; i <= numKeys; i++) {
+        Attribute *childLower = (i == 0) ? lowerVal : &keys[i - 1];
+        Attribute *childUpper = (i == numKeys) ? upperVal : &keys[i];
+        if (!checkSubtree(children[i], blockNum, depth + 1, attrType, childLower, childUpper, prevLeaf, nextLeaf, stats)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+Checks that the B+ tree of attrName (an attribute, or a composite index) is well
+formed: the keys are in order and within the bounds set by the keys of the
+internal nodes, every node points to its parent, the leaves are all at the same
+depth, of the same format and are listed left to right. Fills stats with the height of the tree, the
+number of nodes and entries, the smallest number of entries of a node other
+than the root, and how many runs of consecutive blocks the leaf list is made
+of. Returns FAILURE if the tree is not well formed.
+*/
+int BPlusTree::bPlusCheck(int relId, char attrName[ATTR_SIZE], IndexStats *stats) {
+    AttrCatEntry attrCatEntry;
+    int response = BPlusTree::getIndexInfo(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    if (attrCatEntry.rootBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    stats->height = 0;
+    stats->numLeaves = 0;
+    stats->numInternal = 0;
+    stats->numInternalKeys = 0;
+    stats->numEntries = 0;
+    stats->minLeafEntries = MAX_KEYS_LEAF_PACKED;
+    stats->leafCapacity = 0;
+    stats->minInternalKeys = MAX_KEYS_INTERNAL_PREFIX;
+    stats->numLeafRuns = 0;
+
+    // the leftmost leaf starts the leaf list
+    int firstLeaf = attrCatEntry.rootBlock;
+    while (StaticBuffer::getStaticBlockType(firstLeaf) == IND_INTERNAL) {
+        firstLeaf = IndInternal(firstLeaf).getChild(0);
+    }
+
+    int prevLeaf = -1, nextLeaf = firstLeaf;
+    if (!checkSubtree(attrCatEntry.rootBlock, -1, 1, attrCatEntry.attrType, nullptr, nullptr, &prevLeaf, &nextLeaf,
+                      stats)) {
+        return FAILURE;
+    }
+    if (nextLeaf != -1) {
+        printf("leaf list continues past the last leaf to block %d\n", nextLeaf);
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/*
+Gets the attribute cache entry of the attribute attrName of the relation, whose
+B+ tree is the index of that name. If the relation has no such attribute, the
+composite index named attrName is described instead as an attribute of type
+COMPOSITE (with its root block, and an offset of -1).
+*/
+int BPlusTree::getIndexInfo(int relId, char attrName[ATTR_SIZE], AttrCatEntry *attrCatEntry) {
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, attrCatEntry);
+    if (response != E_ATTRNOTEXIST) {
+        return response;
+    }
+
+    CompositeIndexInfo compositeIndex;
+    if (RelCacheTable::getCompositeIndex(relId, attrName, &compositeIndex) != SUCCESS) {
+        return E_ATTRNOTEXIST;
+    }
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+    strcpy(attrCatEntry->relName, relCatEntry.relName);
+    strcpy(attrCatEntry->attrName, attrName);
+    attrCatEntry->attrType = COMPOSITE;
+    attrCatEntry->primaryFlag = false;
+    attrCatEntry->rootBlock = compositeIndex.rootBlock;
+    attrCatEntry->offset = -1;
+    attrCatEntry->bloomBlock = -1;
+    attrCatEntry->includeOffset = -1;
+    attrCatEntry->hashBlock = -1;
+    attrCatEntry->bitmapBlock = -1;
+    attrCatEntry->statsBlock = -1;
+
+    return SUCCESS;
+}
+
+// sets the root block of the index named attrName (see BPlusTree::getIndexInfo())
+int BPlusTree::setIndexRoot(int relId, char attrName[ATTR_SIZE], int rootBlock) {
+    std::lock_guard<std::mutex> guard(rootMutex);
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response == SUCCESS) {
+        attrCatEntry.rootBlock = rootBlock;
+        return AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+    }
+
+    CompositeIndexInfo compositeIndex;
+    response = RelCacheTable::getCompositeIndex(relId, attrName, &compositeIndex);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    compositeIndex.rootBlock = rootBlock;
+    return RelCacheTable::setCompositeIndex(relId, &compositeIndex);
+}
+
+/*
+Makes the key of a composite index from the values of the first numVals of its
+attributes (keyVals). The key is a byte string of ATTR_SIZE bytes split evenly
+between the attributes of the index, each value being encoded so that memcmp()
+orders keys the way the values compare:
+  - a NUMBER is the bit pattern of the double with its sign bit flipped (all
+    the bits flipped if it is negative), most significant byte first
+  - a STRING is its characters, padded with zeros
+and cut to the bytes of its attribute. The bytes of the attributes without a
+value are filled with 0x00 (the smallest key with those values) or with 0xff if
+`upper` is set (the largest key with those values).
+NOTE: cutting a value makes the key only ordered like the values (keys of
+      different values may be equal), so an index search has to test the values
+      of the records it finds.
+*/
+void BPlusTree::makeCompositeKey(CompositeIndexInfo *index, Attribute keyVals[], int numVals, bool upper,
+                                 Attribute *key) {
+    unsigned char *keyBytes = (unsigned char *)key->sVal;
+    memset(keyBytes, upper ? 0xff : 0x00, ATTR_SIZE);
+
+    for (int keyNum = 0; keyNum < numVals; keyNum++) {
+        // (the bytes of the keyNum'th attribute)
+        int first = ATTR_SIZE * keyNum / index->numKeys;
+        int width = ATTR_SIZE * (keyNum + 1) / index->numKeys - first;
+
+        unsigned char valBytes[ATTR_SIZE];
+        memset(valBytes, 0, ATTR_SIZE);
+        if (index->keyTypes[keyNum] == NUMBER) {
+            // (-0.0 is encoded as 0.0, to which it is equal)
+            double nVal = keyVals[keyNum].nVal == 0 ? 0.0 : keyVals[keyNum].nVal;
+            uint64_t bits;
+            memcpy(&bits, &nVal, sizeof(bits));
+            bits = (bits >> 63) ? ~bits : (bits | (1ULL << 63));
+            for (int i = 0; i < 8; i++) {
+                valBytes[i] = (unsigned char)(bits >> (56 - 8 * i));
+            }
+        } else {
+            // (the characters up to the terminating null, the rest stays zeroed)
+            memcpy(valBytes, keyVals[keyNum].sVal, strnlen(keyVals[keyNum].sVal, ATTR_SIZE));
+        }
+
+        memcpy(keyBytes + first, valBytes, width);
+    }
+}
+
+// makes the key of a composite index for a record of the relation (see BPlusTree::makeCompositeKey())
+void BPlusTree::recordCompositeKey(CompositeIndexInfo *index, Attribute *record, Attribute *key) {
+    Attribute keyVals[MAX_INDEX_KEYS];
+    for (int keyNum = 0; keyNum < index->numKeys; keyNum++) {
+        keyVals[keyNum] = record[index->keyOffsets[keyNum]];
+    }
+    BPlusTree::makeCompositeKey(index, keyVals, index->numKeys, false, key);
+}
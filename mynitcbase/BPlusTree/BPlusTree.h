@@ -1,26 +1,99 @@
 #ifndef NITCBASE_BPLUSTREE_H
 #define NITCBASE_BPLUSTREE_H
 
+#include <vector>
+
 #include "../Buffer/BlockBuffer.h"
 #include "../Buffer/StaticBuffer.h"
-#include "../Cache/OpenRelTable.h"
+#include "../Cache/AttrCacheTable.h"
+#include "../Cache/RelCacheTable.h"
+#include "../Sort/ExternalSort.h"
 #include "../define/constants.h"
 #include "../define/id.h"
 
+// State of a range scan of a B+ tree (see BPlusTree::rangeOpen())
+typedef struct IndexRangeCursor {
+  int attrType;
+  int block;  // leaf holding the next entry to be returned (-1 once the range is exhausted)
+  int index;  // index of that entry in the leaf (in a descending scan, the number of entries of the leaf
+              // left to be returned, -1 for all of them)
+  bool hasUpper;  // if false, the range has no upper bound
+  bool upperInclusive;
+  union Attribute upperVal;
+  bool descending;  // if true, the entries are returned from the largest key down, along the lblock chain
+  bool hasLower;    // (the bound a descending scan stops at)
+  bool lowerInclusive;
+  union Attribute lowerVal;
+} IndexRangeCursor;
+
+// Entries held back to be inserted into a B+ tree in one pass (see BPlusTree::batchBegin())
+typedef struct IndexBatch {
+  int relId;
+  char attrName[ATTR_SIZE];  // attribute, or composite index
+  int includeOffset;         // offset of the included attribute, -1 if none
+  std::vector<Index> entries;
+} IndexBatch;
+
+// Shape of a B+ tree (see BPlusTree::bPlusCheck())
+typedef struct IndexStats {
+  int height;  // number of levels, including the leaves
+  int numLeaves;
+  int numInternal;
+  int numInternalKeys;
+  int numEntries;
+  int minLeafEntries;   // fewest entries in a leaf other than the root
+  int leafCapacity;     // number of entries a leaf holds (see IndLeaf::getMaxEntries())
+  int minInternalKeys;  // fewest keys in an internal node other than the root
+  int numLeafRuns;      // runs of leaves in consecutive blocks, along the leaf list (1 if all are)
+} IndexStats;
+
 class BPlusTree {
  private:
-  static int findLeafToInsert(int rootBlock, Attribute attrVal, int attrType);
+  static int findLeafToInsert(int rootBlock, Attribute attrVal, int attrType, Attribute *upperVal = nullptr,
+                              bool *hasUpper = nullptr);
   static int insertIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum, Index entry);
-  static int splitLeaf(int leafBlockNum, Index indices[]);
+  static int splitLeaf(int leafBlockNum, Index indices[], int numEntries);
+  static int insertRunIntoLeaf(int relId, char attrName[ATTR_SIZE], int blockNum, Index run[], int runLength);
   static int insertIntoInternal(int relId, char attrName[ATTR_SIZE], int intBlockNum, InternalEntry entry);
-  static int splitInternal(int intBlockNum, InternalEntry internalEntries[]);
+  static int splitInternal(int intBlockNum, int children[], Attribute keys[], int numKeys, int attrType,
+                           Attribute *middleKey);
+  static int insertIntoParent(int relId, char attrName[ATTR_SIZE], int blockNum, Attribute attrVal, int rightBlockNum);
+  static int storeInternal(int relId, char attrName[ATTR_SIZE], int blockNum, int children[], Attribute keys[],
+                           int numKeys, int attrType);
   static int createNewRoot(int relId, char attrName[ATTR_SIZE], Attribute attrVal, int lChild, int rChild);
+  static int rebalanceLeaf(int relId, char attrName[ATTR_SIZE], int leafBlockNum);
+  static int removeFromInternal(int relId, char attrName[ATTR_SIZE], int blockNum, int keyNum);
+  static int rebalanceInternal(int relId, char attrName[ATTR_SIZE], int blockNum);
+  static int bulkLoad(SortState *sortedEntries, int numEntries, int attrType, int leafFormat, int fillFactor);
+  static int bulkLoadLeaves(SortState *sortedEntries, int numEntries, int attrType, int leafFormat, int fillFactor,
+                            int leafBlocks[], Attribute separators[]);
+  static int bulkLoadInternal(int childBlocks[], Attribute separators[], int numChildren, int attrType, int fillFactor,
+                              int nodeBlocks[], Attribute nodeSeparators[]);
+  static void releaseBlocks(int blockNums[], int count);
+  static int getIndexInfo(int relId, char attrName[ATTR_SIZE], AttrCatEntry *attrCatEntry);
+  static int setIndexRoot(int relId, char attrName[ATTR_SIZE], int rootBlock);
 
  public:
-  static int bPlusCreate(int relId, char attrName[ATTR_SIZE]);
+  static int bPlusCreate(int relId, char attrName[ATTR_SIZE], int fillFactor = INDEX_FILL_FACTOR);
   static int bPlusInsert(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, RecId recordId);
+  static int bPlusDelete(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, RecId recId);
+  static int batchBegin(IndexBatch *batch, int relId, char attrName[ATTR_SIZE]);
+  static int batchAdd(IndexBatch *batch, union Attribute attrVal, RecId recId);
+  static int batchEnd(IndexBatch *batch);
   static RecId bPlusSearch(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, int op);
+  static int bPlusLookup(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, RecId *recId);
   static int bPlusDestroy(int rootBlockNum);
+  static int bPlusRebuild(int relId, char attrName[ATTR_SIZE], int fillFactor = INDEX_FILL_FACTOR);
+  static int bPlusDrop(int relId, char attrName[ATTR_SIZE]);
+  static int bPlusCheck(int relId, char attrName[ATTR_SIZE], IndexStats *stats);
+  static int rangeOpen(IndexRangeCursor *cursor, int relId, char attrName[ATTR_SIZE],
+                       union Attribute *lowerVal, bool lowerInclusive, union Attribute *upperVal, bool upperInclusive,
+                       bool descending = false);
+  static int rangeNext(IndexRangeCursor *cursor, Index entries[], int *numEntries);
+  static int edgeEntry(int relId, char attrName[ATTR_SIZE], bool last, Index *entry);
+  static void makeCompositeKey(CompositeIndexInfo *index, union Attribute keyVals[], int numVals, bool upper,
+                               union Attribute *key);
+  static void recordCompositeKey(CompositeIndexInfo *index, union Attribute *record, union Attribute *key);
 };
 
 #endif  // NITCBASE_BPLUSTREE_H
@@ -0,0 +1,783 @@
+#include "BitmapIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// number of bits in the selection bitmap of an entry (a search index is entryNum * ENTRY_BITS + slot)
+static const int ENTRY_BITS = SELECTION_BITMAP_WORDS * 64;
+
+// returns the first slot, from `slot` on, whose bit is set in `words` (-1 if there is none)
+static int nextSlot(const uint64_t words[SELECTION_BITMAP_WORDS], int slot) {
+    for (int word = slot / 64; word < SELECTION_BITMAP_WORDS; word++) {
+        uint64_t bits = words[word];
+        if (word == slot / 64) {
+            bits &= ~0ULL << (slot % 64);
+        }
+        if (bits != 0) {
+            return word * 64 + __builtin_ctzll(bits);
+        }
+    }
+
+    return -1;
+}
+
+static bool isEmpty(const uint64_t words[SELECTION_BITMAP_WORDS]) {
+    for (int word = 0; word < SELECTION_BITMAP_WORDS; word++) {
+        if (words[word] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+Finds the value attrVal in the directory of the bitmap index rooted at
+headBlockNum: sets the directory block holding it and its index in the block.
+Returns E_NOTFOUND if the value is not in the index.
+*/
+int BitmapIndex::findValue(int headBlockNum, Attribute attrVal, int attrType, int *dirBlockNum, int *valueNum) {
+    int block = headBlockNum;
+    while (block != -1) {
+        BitmapBuffer dirBuffer(block);
+        int index = dirBuffer.findValue(attrVal, attrType);
+        if (index >= 0) {
+            *dirBlockNum = block;
+            *valueNum = index;
+            return SUCCESS;
+        }
+
+        HeadInfo dirHead;
+        dirBuffer.getHeader(&dirHead);
+        block = dirHead.rblock;
+    }
+
+    return E_NOTFOUND;
+}
+
+/*
+Adds the value to the first directory block with room, chaining a new directory
+block after the last one if all are full
+*/
+int BitmapIndex::addValue(int headBlockNum, BitmapValue *value) {
+    int block = headBlockNum;
+    while (true) {
+        BitmapBuffer dirBuffer(block);
+        HeadInfo dirHead;
+        dirBuffer.getHeader(&dirHead);
+
+        if (dirHead.numEntries < BITMAP_DIR_VALUES) {
+            dirBuffer.setValues(value, dirHead.numEntries, 1);
+            dirHead.numEntries++;
+            return dirBuffer.setHeader(&dirHead);
+        }
+
+        if (dirHead.rblock == -1) {
+            BitmapBuffer newBuffer;
+            int newBlock = newBuffer.getBlockNum();
+            if (newBlock == E_DISKFULL) {
+                return E_DISKFULL;
+            }
+
+            HeadInfo newHead;
+            newBuffer.getHeader(&newHead);
+            newHead.pblock = headBlockNum;
+            newHead.numEntries = 0;
+            newBuffer.setHeader(&newHead);
+
+            dirHead.rblock = newBlock;
+            dirBuffer.setHeader(&dirHead);
+        }
+
+        block = dirHead.rblock;
+    }
+}
+
+/*
+Removes the valueNum'th value of the directory block dirBlockNum; the last value
+of the block takes its place. A directory block other than the head block is
+released when it becomes empty.
+*/
+int BitmapIndex::removeValue(int headBlockNum, int dirBlockNum, int valueNum) {
+    BitmapBuffer dirBuffer(dirBlockNum);
+    HeadInfo dirHead;
+    dirBuffer.getHeader(&dirHead);
+
+    dirHead.numEntries--;
+    if (valueNum != dirHead.numEntries) {
+        BitmapValue last;
+        dirBuffer.getValues(&last, dirHead.numEntries, 1);
+        dirBuffer.setValues(&last, valueNum, 1);
+    }
+    dirBuffer.setHeader(&dirHead);
+
+    if (dirHead.numEntries > 0 || dirBlockNum == headBlockNum) {
+        return SUCCESS;
+    }
+
+    // unlink the block from the chain of directory blocks and release it
+    int prevBlock = headBlockNum;
+    while (true) {
+        BitmapBuffer prevBuffer(prevBlock);
+        HeadInfo prevHead;
+        prevBuffer.getHeader(&prevHead);
+        if (prevHead.rblock == dirBlockNum) {
+            prevHead.rblock = dirHead.rblock;
+            prevBuffer.setHeader(&prevHead);
+            break;
+        }
+        prevBlock = prevHead.rblock;
+    }
+
+    dirBuffer.releaseBlock();
+    return SUCCESS;
+}
+
+/*
+Returns the block of the bitmap starting at firstBlockNum that the entry of the
+record block recBlockNum is (or belongs) in: the first block whose last entry
+is not below recBlockNum, or the last block. Sets prevBlockNum to the block
+before it (-1 for the first block).
+*/
+int BitmapIndex::findBlock(int firstBlockNum, int recBlockNum, int *prevBlockNum) {
+    int prevBlock = -1;
+    int block = firstBlockNum;
+    while (true) {
+        BitmapBuffer blockBuffer(block);
+        HeadInfo blockHead;
+        blockBuffer.getHeader(&blockHead);
+
+        if (blockHead.rblock == -1) {
+            break;
+        }
+
+        // (the first block of a bitmap is kept even if it is empty)
+        if (blockHead.numEntries > 0) {
+            BitmapEntry last;
+            blockBuffer.getEntries(&last, blockHead.numEntries - 1, 1);
+            if (recBlockNum <= last.block) {
+                break;
+            }
+        }
+
+        prevBlock = block;
+        block = blockHead.rblock;
+    }
+
+    *prevBlockNum = prevBlock;
+    return block;
+}
+
+/*
+Sets the bits of the entry in the bitmap starting at firstBlockNum: they are
+or-ed into the entry of the same record block, if there is one, else the entry
+is inserted in its place. A full block is split; an entry past the last one of
+the bitmap goes to a new block alone (record blocks are mostly added in
+increasing order), otherwise the upper half of the entries moves to the new
+block.
+*/
+int BitmapIndex::addEntry(int firstBlockNum, BitmapEntry *entry) {
+    int prevBlock;
+    int block = BitmapIndex::findBlock(firstBlockNum, entry->block, &prevBlock);
+
+    BitmapBuffer blockBuffer(block);
+    HeadInfo blockHead;
+    blockBuffer.getHeader(&blockHead);
+
+    BitmapEntry entries[BITMAP_BLOCK_ENTRIES + 1];
+    blockBuffer.getEntries(entries, 0, blockHead.numEntries);
+
+    int pos = 0;
+    while (pos < blockHead.numEntries && entries[pos].block < entry->block) {
+        pos++;
+    }
+
+    if (pos < blockHead.numEntries && entries[pos].block == entry->block) {
+        for (int word = 0; word < SELECTION_BITMAP_WORDS; word++) {
+            entries[pos].words[word] |= entry->words[word];
+        }
+        return blockBuffer.setEntries(&entries[pos], pos, 1);
+    }
+
+    if (blockHead.numEntries < BITMAP_BLOCK_ENTRIES) {
+        memmove(&entries[pos + 1], &entries[pos], (blockHead.numEntries - pos) * sizeof(BitmapEntry));
+        entries[pos] = *entry;
+        blockHead.numEntries++;
+        blockBuffer.setEntries(&entries[pos], pos, blockHead.numEntries - pos);
+        return blockBuffer.setHeader(&blockHead);
+    }
+
+    // split the block
+    BitmapBuffer newBuffer;
+    int newBlock = newBuffer.getBlockNum();
+    if (newBlock == E_DISKFULL) {
+        return E_DISKFULL;
+    }
+
+    int keep = (pos == blockHead.numEntries && blockHead.rblock == -1) ? blockHead.numEntries
+                                                                         : blockHead.numEntries / 2;
+
+    HeadInfo newHead;
+    newBuffer.getHeader(&newHead);
+    newHead.numEntries = blockHead.numEntries - keep;
+    newHead.rblock = blockHead.rblock;
+    if (newHead.numEntries > 0) {
+        newBuffer.setEntries(&entries[keep], 0, newHead.numEntries);
+    }
+    newBuffer.setHeader(&newHead);
+
+    blockHead.numEntries = keep;
+    blockHead.rblock = newBlock;
+    blockBuffer.setHeader(&blockHead);
+
+    // (one of the two blocks has room for the entry now)
+    return BitmapIndex::addEntry(firstBlockNum, entry);
+}
+
+/*
+Clears the bit of recId in the bitmap starting at firstBlockNum. An entry whose
+bits are all cleared is removed, and a block other than the first that becomes
+empty is released. Returns E_NOTFOUND if the bit is not set.
+*/
+int BitmapIndex::clearBit(int firstBlockNum, RecId recId) {
+    int prevBlock;
+    int block = BitmapIndex::findBlock(firstBlockNum, recId.block, &prevBlock);
+
+    BitmapBuffer blockBuffer(block);
+    HeadInfo blockHead;
+    blockBuffer.getHeader(&blockHead);
+
+    BitmapEntry entries[BITMAP_BLOCK_ENTRIES];
+    blockBuffer.getEntries(entries, 0, blockHead.numEntries);
+
+    int pos = 0;
+    while (pos < blockHead.numEntries && entries[pos].block < recId.block) {
+        pos++;
+    }
+
+    uint64_t bit = 1ULL << (recId.slot % 64);
+    if (pos == blockHead.numEntries || entries[pos].block != recId.block ||
+        (entries[pos].words[recId.slot / 64] & bit) == 0) {
+        return E_NOTFOUND;
+    }
+
+    entries[pos].words[recId.slot / 64] &= ~bit;
+    if (!isEmpty(entries[pos].words)) {
+        return blockBuffer.setEntries(&entries[pos], pos, 1);
+    }
+
+    // remove the entry, moving the entries after it one place to the left
+    blockHead.numEntries--;
+    if (pos < blockHead.numEntries) {
+        blockBuffer.setEntries(&entries[pos + 1], pos, blockHead.numEntries - pos);
+    }
+    blockBuffer.setHeader(&blockHead);
+
+    if (blockHead.numEntries == 0 && prevBlock != -1) {
+        BitmapBuffer prevBuffer(prevBlock);
+        HeadInfo prevHead;
+        prevBuffer.getHeader(&prevHead);
+        prevHead.rblock = blockHead.rblock;
+        prevBuffer.setHeader(&prevHead);
+
+        blockBuffer.releaseBlock();
+    }
+
+    return SUCCESS;
+}
+
+/*
+Adds the bits of the entry (count of them) to the bitmap of attrVal in the index
+rooted at headBlockNum, adding the value to the directory if it is not there
+*/
+int BitmapIndex::addToValue(int headBlockNum, Attribute attrVal, int attrType, BitmapEntry *entry, int count) {
+    int dirBlock, valueNum;
+    if (BitmapIndex::findValue(headBlockNum, attrVal, attrType, &dirBlock, &valueNum) == SUCCESS) {
+        BitmapBuffer dirBuffer(dirBlock);
+        BitmapValue value;
+        dirBuffer.getValues(&value, valueNum, 1);
+
+        int response = BitmapIndex::addEntry(value.block, entry);
+        if (response != SUCCESS) {
+            return response;
+        }
+
+        value.count += count;
+        return dirBuffer.setValues(&value, valueNum, 1);
+    }
+
+    // a new value: its bitmap is the one entry
+    BitmapBuffer bitmapBuffer;
+    int bitmapBlock = bitmapBuffer.getBlockNum();
+    if (bitmapBlock == E_DISKFULL) {
+        return E_DISKFULL;
+    }
+
+    HeadInfo bitmapHead;
+    bitmapBuffer.getHeader(&bitmapHead);
+    bitmapHead.pblock = headBlockNum;
+    bitmapHead.numEntries = 1;
+    bitmapBuffer.setHeader(&bitmapHead);
+    bitmapBuffer.setEntries(entry, 0, 1);
+
+    BitmapValue value;
+    value.attrVal = attrVal;
+    value.block = bitmapBlock;
+    value.count = count;
+    int response = BitmapIndex::addValue(headBlockNum, &value);
+    if (response != SUCCESS) {
+        bitmapBuffer.releaseBlock();
+        return response;
+    }
+
+    return SUCCESS;
+}
+
+// releases the blocks of the bitmap starting at firstBlockNum
+void BitmapIndex::releaseBitmap(int firstBlockNum) {
+    int block = firstBlockNum;
+    while (block != -1) {
+        BitmapBuffer blockBuffer(block);
+        HeadInfo blockHead;
+        blockBuffer.getHeader(&blockHead);
+        blockBuffer.releaseBlock();
+        block = blockHead.rblock;
+    }
+}
+
+int BitmapIndex::bitmapCreate(int relId, char attrName[ATTR_SIZE]) {
+
+    // (the catalogs are always searched in full)
+    if (relId == RELCAT_RELID || relId == ATTRCAT_RELID || relId == INDEXCAT_RELID) {
+        return E_NOTPERMITTED;
+    }
+
+    // get the attribute catalog entry of attribute `attrName`
+    // using AttrCacheTable::getAttrCatEntry()
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    // an index already exists for the attribute
+    if (attrCatEntry.bitmapBlock != -1) {
+        return SUCCESS;
+    }
+
+    RelCatEntry relCatEntry;
+    response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    // get a free block for the head block (an empty directory)
+    BitmapBuffer headBuffer;
+    int headBlock = headBuffer.getBlockNum();
+    if (headBlock == E_DISKFULL) {
+        return E_DISKFULL;
+    }
+
+    HeadInfo head;
+    headBuffer.getHeader(&head);
+    head.numEntries = 0;
+    head.rblock = -1;
+    headBuffer.setHeader(&head);
+
+    // update the bitmapBlock field of the attribute cache entry
+    attrCatEntry.bitmapBlock = headBlock;
+    response = AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    /***** Traverse all the blocks in the relation, and add the slots of each
+           value in a block to its bitmap at once *****/
+    int block = relCatEntry.firstBlk;
+    while (block != -1) {
+        RecBuffer recBuffer(block);
+
+        HeadInfo recHead;
+        recBuffer.getHeader(&recHead);
+
+        unsigned char slotMap[recHead.numSlots];
+        recBuffer.getSlotMap(slotMap);
+
+        // the values of the block, the entry of each for the block and its number of records
+        std::vector<Attribute> values;
+        std::vector<BitmapEntry> entries;
+        std::vector<int> counts;
+        for (int slot = 0; slot < recHead.numSlots; slot++) {
+            if (slotMap[slot] == SLOT_UNOCCUPIED) {
+                continue;
+            }
+
+            Attribute record[relCatEntry.numAttrs];
+            recBuffer.getRecord(record, slot);
+
+            int valueNum = 0;
+            while (valueNum < (int)values.size() &&
+                   compareAttrs(values[valueNum], record[attrCatEntry.offset], attrCatEntry.attrType) != 0) {
+                valueNum++;
+            }
+            if (valueNum == (int)values.size()) {
+                BitmapEntry entry;
+                entry.block = block;
+                memset(entry.words, 0, sizeof(entry.words));
+                values.push_back(record[attrCatEntry.offset]);
+                entries.push_back(entry);
+                counts.push_back(0);
+            }
+
+            entries[valueNum].words[slot / 64] |= 1ULL << (slot % 64);
+            counts[valueNum]++;
+        }
+
+        for (int valueNum = 0; valueNum < (int)values.size(); valueNum++) {
+            response = BitmapIndex::addToValue(headBlock, values[valueNum], attrCatEntry.attrType,
+                                               &entries[valueNum], counts[valueNum]);
+            if (response == E_DISKFULL) {
+                // destroy the index and update the attribute cache entry
+                BitmapIndex::bitmapDestroy(headBlock);
+                attrCatEntry.bitmapBlock = -1;
+                AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+                return E_DISKFULL;
+            }
+        }
+
+        block = recHead.rblock;
+    }
+
+    return SUCCESS;
+}
+
+/*
+Sets the bit of recId in the bitmap of attrVal in the bitmap index on the
+attribute. If the disk is full, the index is destroyed and E_DISKFULL is
+returned (the caller removes its index catalog entry).
+*/
+int BitmapIndex::bitmapInsert(int relId, char attrName[ATTR_SIZE], Attribute attrVal, RecId recId) {
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    // the attribute does not have a bitmap index
+    if (attrCatEntry.bitmapBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    BitmapEntry entry;
+    entry.block = recId.block;
+    memset(entry.words, 0, sizeof(entry.words));
+    entry.words[recId.slot / 64] = 1ULL << (recId.slot % 64);
+
+    response = BitmapIndex::addToValue(attrCatEntry.bitmapBlock, attrVal, attrCatEntry.attrType, &entry, 1);
+    if (response == E_DISKFULL) {
+        // destroy the index and update the attribute cache entry
+        BitmapIndex::bitmapDestroy(attrCatEntry.bitmapBlock);
+        attrCatEntry.bitmapBlock = -1;
+        AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+        return E_DISKFULL;
+    }
+
+    return response;
+}
+
+/*
+Returns the record id of the next record whose value of the attribute equals
+attrVal, continuing from the search index of the attribute (as
+BPlusTree::bPlusSearch() does for EQ). Returns {-1, -1} if there is none.
+The records are found in increasing order of (block, slot).
+*/
+RecId BitmapIndex::bitmapSearch(int relId, char attrName[ATTR_SIZE], Attribute attrVal) {
+    IndexId searchIndex;
+    int response = AttrCacheTable::getSearchIndex(relId, attrName, &searchIndex);
+    if (response != SUCCESS) {
+        printf("failed to get search index for %s\n", attrName);
+        exit(1);
+    }
+
+    AttrCatEntry attrCatEntry;
+    response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        printf("failed to get attrCatEntry for %s\n", attrName);
+        exit(1);
+    }
+
+    if (attrCatEntry.bitmapBlock == -1) {
+        return RecId{-1, -1};
+    }
+
+    int block, entryNum, slot;
+    if (searchIndex.block == -1 || searchIndex.index == -1) {
+        // (search is done for the first time: start from the bitmap of the value)
+        int dirBlock, valueNum;
+        if (BitmapIndex::findValue(attrCatEntry.bitmapBlock, attrVal, attrCatEntry.attrType, &dirBlock,
+                                   &valueNum) != SUCCESS) {
+            return RecId{-1, -1};
+        }
+
+        BitmapBuffer dirBuffer(dirBlock);
+        BitmapValue value;
+        dirBuffer.getValues(&value, valueNum, 1);
+
+        block = value.block;
+        entryNum = 0;
+        slot = 0;
+    } else {
+        // (the search is resumed from the slot after the one found last)
+        block = searchIndex.block;
+        entryNum = searchIndex.index / ENTRY_BITS;
+        slot = searchIndex.index % ENTRY_BITS + 1;
+    }
+
+    // look for the next set bit in the blocks of the bitmap
+    while (block != -1) {
+        BitmapBuffer blockBuffer(block);
+        HeadInfo blockHead;
+        blockBuffer.getHeader(&blockHead);
+
+        for (; entryNum < blockHead.numEntries; entryNum++, slot = 0) {
+            BitmapEntry entry;
+            blockBuffer.getEntries(&entry, entryNum, 1);
+
+            slot = nextSlot(entry.words, slot);
+            if (slot != -1) {
+                searchIndex = IndexId{block, entryNum * ENTRY_BITS + slot};
+                AttrCacheTable::setSearchIndex(relId, attrName, &searchIndex);
+
+                return RecId{entry.block, slot};
+            }
+        }
+
+        block = blockHead.rblock;
+        entryNum = 0;
+        slot = 0;
+    }
+
+    return RecId{-1, -1};
+}
+
+/*
+Clears the bit of recId in the bitmap of attrVal in the bitmap index on the
+attribute. A value with no records left is removed from the directory and its
+bitmap released.
+*/
+int BitmapIndex::bitmapDelete(int relId, char attrName[ATTR_SIZE], Attribute attrVal, RecId recId) {
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    if (attrCatEntry.bitmapBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    int dirBlock, valueNum;
+    response = BitmapIndex::findValue(attrCatEntry.bitmapBlock, attrVal, attrCatEntry.attrType, &dirBlock, &valueNum);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    BitmapBuffer dirBuffer(dirBlock);
+    BitmapValue value;
+    dirBuffer.getValues(&value, valueNum, 1);
+
+    response = BitmapIndex::clearBit(value.block, recId);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    value.count--;
+    if (value.count > 0) {
+        return dirBuffer.setValues(&value, valueNum, 1);
+    }
+
+    BitmapIndex::releaseBitmap(value.block);
+    return BitmapIndex::removeValue(attrCatEntry.bitmapBlock, dirBlock, valueNum);
+}
+
+/*
+Reads the bitmap of attrVal in the bitmap index on the attribute into `bitmap`
+(left empty if no record has the value). Returns E_NOINDEX if the attribute
+does not have a bitmap index.
+*/
+int BitmapIndex::getBitmap(int relId, char attrName[ATTR_SIZE], Attribute attrVal, std::vector<BitmapEntry> &bitmap) {
+    bitmap.clear();
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    if (attrCatEntry.bitmapBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    int dirBlock, valueNum;
+    if (BitmapIndex::findValue(attrCatEntry.bitmapBlock, attrVal, attrCatEntry.attrType, &dirBlock, &valueNum) !=
+        SUCCESS) {
+        return SUCCESS;
+    }
+
+    BitmapBuffer dirBuffer(dirBlock);
+    BitmapValue value;
+    dirBuffer.getValues(&value, valueNum, 1);
+
+    int block = value.block;
+    while (block != -1) {
+        BitmapBuffer blockBuffer(block);
+        HeadInfo blockHead;
+        blockBuffer.getHeader(&blockHead);
+
+        int size = bitmap.size();
+        bitmap.resize(size + blockHead.numEntries);
+        blockBuffer.getEntries(bitmap.data() + size, 0, blockHead.numEntries);
+
+        block = blockHead.rblock;
+    }
+
+    return SUCCESS;
+}
+
+/*
+Intersects `bitmap` with `other` (both in increasing order of record block): the
+entries of the record blocks in both are and-ed a word at a time, and the
+entries left with no bit set are dropped.
+*/
+void BitmapIndex::bitmapAnd(std::vector<BitmapEntry> &bitmap, std::vector<BitmapEntry> &other) {
+    int count = 0;
+    int j = 0;
+    for (int i = 0; i < (int)bitmap.size(); i++) {
+        while (j < (int)other.size() && other[j].block < bitmap[i].block) {
+            j++;
+        }
+        if (j == (int)other.size()) {
+            break;
+        }
+        if (other[j].block != bitmap[i].block) {
+            continue;
+        }
+
+        BitmapEntry entry = bitmap[i];
+        for (int word = 0; word < SELECTION_BITMAP_WORDS; word++) {
+            entry.words[word] &= other[j].words[word];
+        }
+        if (!isEmpty(entry.words)) {
+            bitmap[count++] = entry;
+        }
+    }
+
+    bitmap.resize(count);
+}
+
+/*
+Unites `bitmap` with `other` (both in increasing order of record block): the
+entries of the record blocks in both are or-ed a word at a time, and the others
+are kept as they are.
+*/
+void BitmapIndex::bitmapOr(std::vector<BitmapEntry> &bitmap, std::vector<BitmapEntry> &other) {
+    std::vector<BitmapEntry> result;
+    result.reserve(bitmap.size() + other.size());
+
+    int i = 0, j = 0;
+    while (i < (int)bitmap.size() || j < (int)other.size()) {
+        if (j == (int)other.size() || (i < (int)bitmap.size() && bitmap[i].block < other[j].block)) {
+            result.push_back(bitmap[i++]);
+        } else if (i == (int)bitmap.size() || other[j].block < bitmap[i].block) {
+            result.push_back(other[j++]);
+        } else {
+            BitmapEntry entry = bitmap[i++];
+            for (int word = 0; word < SELECTION_BITMAP_WORDS; word++) {
+                entry.words[word] |= other[j].words[word];
+            }
+            result.push_back(entry);
+            j++;
+        }
+    }
+
+    bitmap.swap(result);
+}
+
+int BitmapIndex::bitmapDestroy(int headBlockNum) {
+    /*headBlockNum lies outside the valid range [0,DISK_BLOCKS-1]*/
+    if (headBlockNum < 0 || headBlockNum >= DISK_BLOCKS) {
+        return E_OUTOFBOUND;
+    }
+
+    if (StaticBuffer::getStaticBlockType(headBlockNum) != BITMAP_INDEX) {
+        return E_INVALIDBLOCK;
+    }
+
+    // release the bitmap of every value, then the directory block holding it
+    int block = headBlockNum;
+    while (block != -1) {
+        BitmapBuffer dirBuffer(block);
+        HeadInfo dirHead;
+        dirBuffer.getHeader(&dirHead);
+
+        BitmapValue values[BITMAP_DIR_VALUES];
+        dirBuffer.getValues(values, 0, dirHead.numEntries);
+        for (int i = 0; i < dirHead.numEntries; i++) {
+            BitmapIndex::releaseBitmap(values[i].block);
+        }
+
+        dirBuffer.releaseBlock();
+        block = dirHead.rblock;
+    }
+
+    return SUCCESS;
+}
+
+/*
+Fills `info` with the size of the bitmap index rooted at headBlockNum
+*/
+int BitmapIndex::bitmapInfo(int headBlockNum, BitmapIndexInfo *info) {
+    if (headBlockNum < 0 || headBlockNum >= DISK_BLOCKS) {
+        return E_OUTOFBOUND;
+    }
+
+    if (StaticBuffer::getStaticBlockType(headBlockNum) != BITMAP_INDEX) {
+        return E_INVALIDBLOCK;
+    }
+
+    info->numValues = 0;
+    info->numDirBlocks = 0;
+    info->numBitmapBlocks = 0;
+    info->numEntries = 0;
+    info->numRecords = 0;
+
+    int dirBlock = headBlockNum;
+    while (dirBlock != -1) {
+        BitmapBuffer dirBuffer(dirBlock);
+        HeadInfo dirHead;
+        dirBuffer.getHeader(&dirHead);
+
+        BitmapValue values[BITMAP_DIR_VALUES];
+        dirBuffer.getValues(values, 0, dirHead.numEntries);
+        for (int i = 0; i < dirHead.numEntries; i++) {
+            info->numRecords += values[i].count;
+
+            int block = values[i].block;
+            while (block != -1) {
+                BitmapBuffer blockBuffer(block);
+                HeadInfo blockHead;
+                blockBuffer.getHeader(&blockHead);
+                info->numBitmapBlocks++;
+                info->numEntries += blockHead.numEntries;
+                block = blockHead.rblock;
+            }
+        }
+
+        info->numValues += dirHead.numEntries;
+        info->numDirBlocks++;
+        dirBlock = dirHead.rblock;
+    }
+
+    return SUCCESS;
+}
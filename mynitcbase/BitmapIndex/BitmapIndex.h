@@ -0,0 +1,54 @@
+#ifndef NITCBASE_BITMAPINDEX_H
+#define NITCBASE_BITMAPINDEX_H
+
+#include <vector>
+
+#include "../Buffer/BlockBuffer.h"
+#include "../Buffer/StaticBuffer.h"
+#include "../Cache/AttrCacheTable.h"
+#include "../Cache/RelCacheTable.h"
+#include "../define/constants.h"
+#include "../define/id.h"
+
+typedef struct BitmapIndexInfo {
+  int numValues;        // number of distinct values in the index
+  int numDirBlocks;     // number of directory blocks (the head block is the first)
+  int numBitmapBlocks;  // number of bitmap blocks of all the values
+  int numEntries;       // number of (value, record block) entries of all the bitmaps
+  int numRecords;       // number of records in the index
+} BitmapIndexInfo;
+
+/*
+A bitmap index on an attribute with few distinct values. Every distinct value
+has a bitmap of the (block, slot) positions of the relation holding it, stored
+as the list of the record blocks that hold the value, each with the selection
+bitmap of its slots (record blocks without the value take no space). The list
+is in increasing order of record block, in a chain of bitmap blocks (rblock)
+that is split when a block is full. The distinct values are in a chain of
+directory blocks starting at the head block (rblock), with the first block of
+the bitmap of each and its number of records.
+*/
+class BitmapIndex {
+ private:
+  static int findValue(int headBlockNum, union Attribute attrVal, int attrType, int *dirBlockNum, int *valueNum);
+  static int addValue(int headBlockNum, BitmapValue *value);
+  static int removeValue(int headBlockNum, int dirBlockNum, int valueNum);
+  static int findBlock(int firstBlockNum, int recBlockNum, int *prevBlockNum);
+  static int addEntry(int firstBlockNum, BitmapEntry *entry);
+  static int clearBit(int firstBlockNum, RecId recId);
+  static int addToValue(int headBlockNum, union Attribute attrVal, int attrType, BitmapEntry *entry, int count);
+  static void releaseBitmap(int firstBlockNum);
+
+ public:
+  static int bitmapCreate(int relId, char attrName[ATTR_SIZE]);
+  static int bitmapInsert(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, RecId recId);
+  static RecId bitmapSearch(int relId, char attrName[ATTR_SIZE], union Attribute attrVal);
+  static int bitmapDelete(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, RecId recId);
+  static int getBitmap(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, std::vector<BitmapEntry> &bitmap);
+  static void bitmapAnd(std::vector<BitmapEntry> &bitmap, std::vector<BitmapEntry> &other);
+  static void bitmapOr(std::vector<BitmapEntry> &bitmap, std::vector<BitmapEntry> &other);
+  static int bitmapDestroy(int headBlockNum);
+  static int bitmapInfo(int headBlockNum, BitmapIndexInfo *info);
+};
+
+#endif  // NITCBASE_BITMAPINDEX_H
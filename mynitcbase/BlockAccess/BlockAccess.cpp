@@ -1,8 +1,37 @@
 #include "BlockAccess.h"
 
+#include "../Buffer/Predicate.h"
+
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <iostream>
 
+typedef int (*FindRecordFunction)(const Attribute *records, const unsigned char *slotMap, int numSlots,
+                                  int numAttrs, int attrOffset, const Attribute &attrVal, int slot);
+
+/*
+Returns the first occupied slot from `slot` onwards of a block (given its slot
+map and records) whose record satisfies `attr op attrVal`, -1 if there is none.
+(instantiated for every attribute type and op, see Buffer/Predicate.h)
+*/
+template <int ATTR_TYPE, int OP>
+static int findRecord(const Attribute *records, const unsigned char *slotMap, int numSlots, int numAttrs,
+                      int attrOffset, const Attribute &attrVal, int slot)
+{
+    for (; slot < numSlots; slot++)
+    {
+        if (slotMap[slot] == SLOT_OCCUPIED &&
+            Predicate<ATTR_TYPE, OP>::satisfies(records[slot * numAttrs + attrOffset], attrVal))
+        {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+static const FindRecordFunction findRecordFunctions[2][6] = PREDICATE_DISPATCH_TABLE(findRecord);
+
 RecId BlockAccess::linearSearch(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, int op)
 {
     // get the previous search index of the relation relId from the relation cache
@@ -67,6 +96,26 @@ RecId BlockAccess::linearSearch(int relId, char attrName[ATTR_SIZE], union Attri
         }
     }
 
+    /*
+        get the attribute offset for the attrName attribute from the attribute
+        cache entry of the relation using AttrCacheTable::getAttrCatEntry()
+    */
+    AttrCatEntry attrCatEntry;
+    response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS)
+    {
+        // TODO Make it linked list if needed
+        printf("Attribute Catalogue Entry Not found.\n");
+        exit(1);
+    }
+
+    // pick the loop to search a block with, for the type of the attribute and op
+    FindRecordFunction findRecord = findRecordFunctions[attrCatEntry.attrType][op];
+
+    /* zoneBlock and zoneEntry locate the zone map entry summarising `block`
+       (both are -1 if the entry is not known yet or the block has none) */
+    int zoneBlock = -1, zoneEntry = -1;
+
     /* The following code searches for the next record in the relation
        that satisfies the given condition
        We start from the record id (block, slot) and iterate over the remaining
@@ -74,20 +123,44 @@ RecId BlockAccess::linearSearch(int relId, char attrName[ATTR_SIZE], union Attri
     */
     while (block != -1)
     {
-        /* create a RecBuffer object for block (use RecBuffer Constructor for
-           existing block) */
-        RecBuffer recBuffer(block);
+        /* on entering a block that is summarised by a zone map entry, check
+           whether any value in the [min, max] range of the attribute in this
+           block can satisfy the condition. if none can, skip the whole block
+           without reading it and move on to the block summarised by the next entry. */
+        if (zoneBlock != -1 && slot == 0)
+        {
+            ZoneMapBuffer zoneBuffer(zoneBlock);
+            Attribute minVal, maxVal;
+            response = zoneBuffer.getRange(&minVal, &maxVal, attrCatEntry.offset, zoneEntry);
+            if (response != SUCCESS)
+            {
+                printf("Zone map entry not found.\n");
+                exit(1);
+            }
 
-        // get the record with id (block, slot) using RecBuffer::getRecord()
-        Attribute recordEntry[relCatEntry.numAttrs];
-        response = recBuffer.getRecord(recordEntry, slot);
+            if (BlockAccess::zoneExcludes(minVal, maxVal, attrVal, attrCatEntry.attrType, op))
+            {
+                int nextBlock = BlockAccess::nextZoneEntry(&zoneBlock, &zoneEntry);
 
-        if (response != SUCCESS)
-        {
-            printf("Record not found.\n");
-            exit(1);
+                // (no more entries in the zone map, follow the record block list instead)
+                if (nextBlock == -1 && block != relCatEntry.lastBlk)
+                {
+                    RecBuffer recBuffer(block);
+                    struct HeadInfo head;
+                    recBuffer.getHeader(&head);
+                    nextBlock = head.rblock;
+                }
+
+                block = nextBlock;
+                slot = 0;
+                continue;
+            }
         }
 
+        /* create a RecBuffer object for block (use RecBuffer Constructor for
+           existing block) */
+        RecBuffer recBuffer(block);
+
         // get header of the block using RecBuffer::getHeader() function
         struct HeadInfo head;
         response = recBuffer.getHeader(&head);
@@ -96,13 +169,25 @@ RecId BlockAccess::linearSearch(int relId, char attrName[ATTR_SIZE], union Attri
             printf("Header not found.\n");
             exit(1);
         }
-        // get slot map of the block using RecBuffer::getSlotMap() function
-        unsigned char slotMap[head.numSlots];
-        response = recBuffer.getSlotMap(slotMap);
-        if (response != SUCCESS)
+
+        /* if the zone map entry of the block is not known yet, look it up using
+           the pblock field of the header (which points to the zone map block
+           summarising a record block) */
+        if (zoneBlock == -1 && head.pblock != -1)
         {
-            printf("Slotmap not found.\n");
-            exit(1);
+            ZoneMapBuffer zoneBuffer(head.pblock);
+            int entryNum = zoneBuffer.findEntry(block);
+            if (entryNum >= 0)
+            {
+                zoneBlock = head.pblock;
+                zoneEntry = entryNum;
+
+                // (check the entry before scanning a block from its first slot)
+                if (slot == 0)
+                {
+                    continue;
+                }
+            }
         }
 
         // If slot >= the number of slots per block(i.e. no more slots in this block)
@@ -112,55 +197,32 @@ RecId BlockAccess::linearSearch(int relId, char attrName[ATTR_SIZE], union Attri
             block = head.rblock;
             // update slot = 0
             slot = 0;
-            continue;
-        }
 
-        // if slot is free skip the loop
-        // (i.e. check if slot'th entry in slot map of block contains SLOT_UNOCCUPIED)
-        if (slotMap[slot] == SLOT_UNOCCUPIED)
-        {
-            // increment slot and continue to the next record slot
-            slot++;
+            // move to the zone map entry of the next block as well
+            if (zoneBlock != -1 && BlockAccess::nextZoneEntry(&zoneBlock, &zoneEntry) != block)
+            {
+                zoneBlock = -1;
+                zoneEntry = -1;
+            }
             continue;
         }
 
-        // compare record's attribute value to the the given attrVal as below:
-        /*
-            firstly get the attribute offset for the attrName attribute
-            from the attribute cache entry of the relation using
-            AttrCacheTable::getAttrCatEntry()
-        */
-        AttrCatEntry attrCatEntry;
-        response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+        // get the slot map and all the records of the block at once using RecBuffer::getRecords()
+        unsigned char slotMap[head.numSlots];
+        Attribute records[head.numSlots * head.numAttrs];
+        response = recBuffer.getRecords(&head, slotMap, records);
         if (response != SUCCESS)
         {
-            // TODO Make it linked list if needed
-            printf("Attribute Catalogue Entry Not found.\n");
+            printf("Record not found.\n");
             exit(1);
         }
-        // get the attribute offset
 
-        /* use the attribute offset to get the value of the attribute from
-           current record */
-        Attribute currRecordAttr = recordEntry[attrCatEntry.offset];
+        /* find the first record of the block from `slot` onwards that satisfies
+           the condition (using the loop specialised for the type of the attribute
+           and op) */
+        slot = findRecord(records, slotMap, head.numSlots, head.numAttrs, attrCatEntry.offset, attrVal, slot);
 
-        int cmpVal; // will store the difference between the attributes
-        // set cmpVal using compareAttrs()
-        cmpVal = compareAttrs(currRecordAttr, attrVal, attrCatEntry.attrType);
-
-        /* Next task is to check whether this record satisfies the given condition.
-           It is determined based on the output of previous comparison and
-           the op value received.
-           The following code sets the cond variable if the condition is satisfied.
-        */
-        if (
-            (op == NE && cmpVal != 0) || // if op is "not equal to"
-            (op == LT && cmpVal < 0) ||  // if op is "less than"
-            (op == LE && cmpVal <= 0) || // if op is "less than or equal to"
-            (op == EQ && cmpVal == 0) || // if op is "equal to"
-            (op == GT && cmpVal > 0) ||  // if op is "greater than"
-            (op == GE && cmpVal >= 0)    // if op is "greater than or equal to"
-        )
+        if (slot != -1)
         {
             /*
             set the search index in the relation cache as
@@ -173,7 +235,8 @@ RecId BlockAccess::linearSearch(int relId, char attrName[ATTR_SIZE], union Attri
             return recId;
         }
 
-        slot++;
+        // (no record in the rest of the block satisfies the condition; move to the next block)
+        slot = head.numSlots;
     }
 
     // no record in the relation with Id relid satisfies the given condition
@@ -279,6 +342,36 @@ int BlockAccess::renameRelation(char oldName[ATTR_SIZE], char newName[ATTR_SIZE]
         }
     }
 
+    /*
+    update all the index catalog entries corresponding to the relation (if the
+    index catalog exists, it is open)
+    */
+    RelCatEntry indexCatEntry;
+    if (RelCacheTable::getRelCatEntry(INDEXCAT_RELID, &indexCatEntry) == SUCCESS)
+    {
+        RelCacheTable::resetSearchIndex(INDEXCAT_RELID);
+        char indexcatAttrName[] = INDEXCAT_ATTR_RELNAME;
+        while (true)
+        {
+            recId = BlockAccess::linearSearch(INDEXCAT_RELID, indexcatAttrName, oldRelationName, EQ);
+            if (recId.block == -1 && recId.slot == -1)
+            {
+                break;
+            }
+
+            Attribute indexCatRecord[INDEXCAT_NO_ATTRS];
+            RecBuffer indexCatBuffer(recId.block);
+            indexCatBuffer.getRecord(indexCatRecord, recId.slot);
+            strcpy(indexCatRecord[INDEXCAT_REL_NAME_INDEX].sVal, newName);
+            response = indexCatBuffer.setRecord(indexCatRecord, recId.slot);
+            if (response != SUCCESS)
+            {
+                printf("Record not saved successfully.\n");
+                exit(1);
+            }
+        }
+    }
+
     return SUCCESS;
 }
 
@@ -380,10 +473,63 @@ int BlockAccess::renameAttribute(char relName[ATTR_SIZE], char oldName[ATTR_SIZE
         exit(1);
     }
 
+    // update the attribute name in the index catalog entries on the attribute
+    // (if the index catalog exists, it is open)
+    RelCatEntry indexCatEntry;
+    if (RelCacheTable::getRelCatEntry(INDEXCAT_RELID, &indexCatEntry) == SUCCESS)
+    {
+        RelCacheTable::resetSearchIndex(INDEXCAT_RELID);
+        char indexcatAttrName[] = INDEXCAT_ATTR_RELNAME;
+        while (true)
+        {
+            recId = BlockAccess::linearSearch(INDEXCAT_RELID, indexcatAttrName, relNameAttr, EQ);
+            if (recId.block == -1 && recId.slot == -1)
+            {
+                break;
+            }
+
+            Attribute indexCatRecord[INDEXCAT_NO_ATTRS];
+            RecBuffer indexCatBuffer(recId.block);
+            indexCatBuffer.getRecord(indexCatRecord, recId.slot);
+            // (a bloom filter, a hash or bitmap index, the statistics and the included attribute of a B+ tree are named after the attribute)
+            int indexType = (int)indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal;
+            bool namedAfter = (indexType == INDEX_BLOOM || indexType == INDEX_HASH || indexType == INDEX_BITMAP ||
+                               indexType == INDEX_INCLUDE || indexType == INDEX_STATS) &&
+                              strcmp(indexCatRecord[INDEXCAT_INDEX_NAME_INDEX].sVal, oldName) == 0;
+            bool onAttr = strcmp(indexCatRecord[INDEXCAT_ATTR_NAME_INDEX].sVal, oldName) == 0;
+            if (!namedAfter && !onAttr)
+            {
+                continue;
+            }
+
+            if (onAttr)
+            {
+                strcpy(indexCatRecord[INDEXCAT_ATTR_NAME_INDEX].sVal, newName);
+            }
+            if (namedAfter)
+            {
+                strcpy(indexCatRecord[INDEXCAT_INDEX_NAME_INDEX].sVal, newName);
+            }
+
+            response = indexCatBuffer.setRecord(indexCatRecord, recId.slot);
+            if (response != SUCCESS)
+            {
+                printf("Record not saved successfully.\n");
+                exit(1);
+            }
+        }
+    }
+
     return SUCCESS;
 }
 
-int BlockAccess::insert(int relId, Attribute *record)
+/*
+Inserts the record into the relation, and its values into the B+ trees, bloom
+filters, hash and bitmap indexes of the relation. If batch is not nullptr (see
+insertBegin()), the index entries are added to the batch instead of the B+ trees
+(the hash and bitmap indexes are updated as the records are inserted).
+*/
+int BlockAccess::insert(int relId, Attribute *record, InsertBatch *batch)
 {
     // get the relation catalog entry from relation cache
     // ( use RelCacheTable::getRelCatEntry() of Cache Layer)
@@ -397,6 +543,12 @@ int BlockAccess::insert(int relId, Attribute *record)
     /* first record block of the relation (from the rel-cat entry)*/;
     int blockNum = relCatEntry.firstBlk;
 
+    // (in a batch, the blocks before that of the last record inserted have no free slot)
+    if (batch != nullptr && batch->lastBlock != -1)
+    {
+        blockNum = batch->lastBlock;
+    }
+
     // recId will be used to store where the new record will be inserted
     RecId recId = {-1, -1};
 
@@ -642,9 +794,26 @@ int BlockAccess::insert(int relId, Attribute *record)
     relCatEntry.numRecs++;
     response = RelCacheTable::setRelCatEntry(relId, &relCatEntry);
 
+    // widen the zone map entry of the block to include the new record
+    response = BlockAccess::updateZoneMap(relId, recId.block, record);
+    if (response != SUCCESS)
+    {
+        printf("Zone map not updated successfully.\n");
+        exit(1);
+    }
+
+    if (batch != nullptr)
+    {
+        batch->lastBlock = recId.block;
+    }
+
     /* B+ Tree Insertions */
     // (the following section is only relevant once indexing has been implemented)
 
+    // (in a batch, the index entries are added to the batches of the indexes, in
+    // the order of insertBegin())
+    int numBatched = 0;
+
     int flag = SUCCESS;
     // Iterate over all the attributes of the relation
     // (let attrOffset be iterator ranging from 0 to numOfAttributes-1)
@@ -669,8 +838,15 @@ int BlockAccess::insert(int relId, Attribute *record)
         {
             /* insert the new record into the attribute's bplus tree using
              BPlusTree::bPlusInsert()*/
-            response = BPlusTree::bPlusInsert(relId, attrCatEntry.attrName,
-                                                record[attrOffset], recId);
+            if (batch != nullptr)
+            {
+                response = BPlusTree::batchAdd(&batch->indexes[numBatched++], record[attrOffset], recId);
+            }
+            else
+            {
+                response = BPlusTree::bPlusInsert(relId, attrCatEntry.attrName,
+                                                    record[attrOffset], recId);
+            }
 
             if (response == E_DISKFULL) {
                 //(index for this attribute has been destroyed)
@@ -678,12 +854,144 @@ int BlockAccess::insert(int relId, Attribute *record)
                 flag = E_INDEX_BLOCKS_RELEASED;
             }
         }
+
+        // if a bloom filter exists for the attribute, add the value to it
+        if (attrCatEntry.bloomBlock != -1)
+        {
+            response = BloomFilter::bloomInsert(relId, attrCatEntry.attrName, record[attrOffset]);
+            if (response != SUCCESS)
+            {
+                printf("Bloom filter not updated successfully.\n");
+                exit(1);
+            }
+        }
+
+        // if a hash index exists for the attribute, add the entry to it
+        if (attrCatEntry.hashBlock != -1)
+        {
+            response = HashIndex::hashInsert(relId, attrCatEntry.attrName, record[attrOffset], recId);
+            if (response == E_DISKFULL)
+            {
+                // (the index has been destroyed, its index catalog entry goes with it)
+                BlockAccess::deleteIndexCatEntry(relCatEntry.relName, attrCatEntry.attrName, INDEX_HASH);
+                flag = E_INDEX_BLOCKS_RELEASED;
+            }
+            else if (response != SUCCESS)
+            {
+                printf("Hash index not updated successfully.\n");
+                exit(1);
+            }
+        }
+
+        // if a bitmap index exists for the attribute, set the bit of the record in it
+        if (attrCatEntry.bitmapBlock != -1)
+        {
+            response = BitmapIndex::bitmapInsert(relId, attrCatEntry.attrName, record[attrOffset], recId);
+            if (response == E_DISKFULL)
+            {
+                // (the index has been destroyed, its index catalog entry goes with it)
+                BlockAccess::deleteIndexCatEntry(relCatEntry.relName, attrCatEntry.attrName, INDEX_BITMAP);
+                flag = E_INDEX_BLOCKS_RELEASED;
+            }
+            else if (response != SUCCESS)
+            {
+                printf("Bitmap index not updated successfully.\n");
+                exit(1);
+            }
+        }
+    }
+
+    // insert the key of the record into every composite index of the relation
+    CompositeIndexInfo compositeIndex;
+    for (int indexNum = 0; RelCacheTable::getCompositeIndex(relId, indexNum, &compositeIndex) == SUCCESS; indexNum++)
+    {
+        if (compositeIndex.rootBlock == -1)
+        {
+            continue;
+        }
+
+        Attribute key;
+        BPlusTree::recordCompositeKey(&compositeIndex, record, &key);
+        if (batch != nullptr)
+        {
+            response = BPlusTree::batchAdd(&batch->indexes[numBatched++], key, recId);
+        }
+        else
+        {
+            response = BPlusTree::bPlusInsert(relId, compositeIndex.indexName, key, recId);
+        }
+        if (response == E_DISKFULL)
+        {
+            flag = E_INDEX_BLOCKS_RELEASED;
+        }
     }
 
     return flag;
 
 }
 
+/*
+Starts a batch of insertions into the relation (see BlockAccess::insert()), with
+a batch of index entries for each B+ tree of the relation. No other operation on
+the relation may take place until insertEnd().
+*/
+int BlockAccess::insertBegin(InsertBatch *batch, int relId)
+{
+    RelCatEntry relCatEntry;
+    int response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    batch->relId = relId;
+    batch->lastBlock = -1;
+    batch->indexes.clear();
+
+    for (int attrOffset = 0; attrOffset < relCatEntry.numAttrs; attrOffset++)
+    {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
+        if (attrCatEntry.rootBlock != -1)
+        {
+            batch->indexes.emplace_back();
+            BPlusTree::batchBegin(&batch->indexes.back(), relId, attrCatEntry.attrName);
+        }
+    }
+
+    CompositeIndexInfo compositeIndex;
+    for (int indexNum = 0; RelCacheTable::getCompositeIndex(relId, indexNum, &compositeIndex) == SUCCESS; indexNum++)
+    {
+        if (compositeIndex.rootBlock != -1)
+        {
+            batch->indexes.emplace_back();
+            BPlusTree::batchBegin(&batch->indexes.back(), relId, compositeIndex.indexName);
+        }
+    }
+
+    return SUCCESS;
+}
+
+/*
+Ends a batch of insertions: the index entries of the records inserted are
+inserted into the B+ trees (see BPlusTree::batchEnd()).
+Returns E_INDEX_BLOCKS_RELEASED if a B+ tree was destroyed for want of blocks.
+*/
+int BlockAccess::insertEnd(InsertBatch *batch)
+{
+    int flag = SUCCESS;
+    for (IndexBatch &indexBatch : batch->indexes)
+    {
+        if (BPlusTree::batchEnd(&indexBatch) == E_DISKFULL)
+        {
+            flag = E_INDEX_BLOCKS_RELEASED;
+        }
+    }
+    batch->indexes.clear();
+
+    return flag;
+}
+
 
 int BlockAccess::deleteRelation(char relName[ATTR_SIZE])
 {
@@ -752,6 +1060,15 @@ int BlockAccess::deleteRelation(char relName[ATTR_SIZE])
         recBlockNum = header.rblock;
         //     release the block using BlockBuffer.releaseBlock
         recBuffer.releaseBlock();
+
+        //     release the zone map block summarising it (if any). consecutive
+        //     record blocks share a zone map block, releaseBlock() does nothing
+        //     for a block that has already been released.
+        if (header.pblock != -1 && StaticBuffer::getStaticBlockType(header.pblock) == ZONE_MAP)
+        {
+            ZoneMapBuffer zoneBuffer(header.pblock);
+            zoneBuffer.releaseBlock();
+        }
         //
         //     Hint: to know if we reached the end, check if nextBlock = -1
     }
@@ -921,47 +1238,134 @@ int BlockAccess::deleteRelation(char relName[ATTR_SIZE])
         }
     }
 
-    /*** Delete the entry corresponding to the relation from relation catalog ***/
-    // Fetch the header of Relcat block
-    HeadInfo relCatHeader;
-    response = relCatRecBuffer.getHeader(&relCatHeader);
-
-    /* Decrement the numEntries in the header of the block corresponding to the
-       relation catalog entry and set it back */
-    relCatHeader.numEntries--;
-    relCatRecBuffer.setHeader(&relCatHeader);
-
-    /* Get the slotmap in relation catalog, update it by marking the slot as
-       free(SLOT_UNOCCUPIED) and set it back. */
-    unsigned char relCatSlotMap[relCatHeader.numSlots];
-    response = relCatRecBuffer.getSlotMap(relCatSlotMap);
-    if (response != SUCCESS)
-    {
-        printf("Slotmap not found.\n");
-        exit(1);
-    }
-    relCatSlotMap[relCatRecId.slot] = SLOT_UNOCCUPIED;
-    response = relCatRecBuffer.setSlotMap(relCatSlotMap);
-    if (response != SUCCESS)
+    /*** Deleting the index catalog entries of the relation and the structures they record ***/
+    // (the index catalog is open whenever it exists)
+    RelCatEntry indexCatEntry;
+    if (RelCacheTable::getRelCatEntry(INDEXCAT_RELID, &indexCatEntry) == SUCCESS)
     {
-        printf("Slotmap not saved successfully.\n");
-        exit(1);
-    }
+        char indexCatRelNameConst[] = INDEXCAT_ATTR_RELNAME;
+        while (true)
+        {
+            // (deleting a record may release the block of the search index)
+            RelCacheTable::resetSearchIndex(INDEXCAT_RELID);
+            RecId indexCatRecId = BlockAccess::linearSearch(INDEXCAT_RELID, indexCatRelNameConst, relNameAttr, EQ);
+            if (indexCatRecId.block == -1 && indexCatRecId.slot == -1)
+            {
+                break;
+            }
 
+            RecBuffer indexCatBuffer(indexCatRecId.block);
+            Attribute indexCatRecord[INDEXCAT_NO_ATTRS];
+            response = indexCatBuffer.getRecord(indexCatRecord, indexCatRecId.slot);
+            if (response != SUCCESS)
+            {
+                printf("Record not found.\n");
+                exit(1);
+            }
 
-    /*** Updating the Relation Cache Table ***/
+            if ((int)indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal == INDEX_BLOOM)
+            {
+                response = BloomFilter::bloomDestroy((int)indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal);
+                if (response != SUCCESS)
+                {
+                    printf("Failed to destroy bloom filter.\n");
+                    exit(1);
+                }
+            }
 
-    /** Update relation catalog record entry (number of records in relation
-        catalog is decreased by 1) **/
-    // Get the entry corresponding to relation catalog from the relation
-    // cache and update the number of records and set it back
-    // (using RelCacheTable::setRelCatEntry() function)
-    RelCatEntry relCatEntry;
-    response = RelCacheTable::getRelCatEntry(RELCAT_RELID, &relCatEntry);
-    if (response != SUCCESS)
-    {
-        printf("Failed to get relation catalogue entry.\n");
-        exit(1);
+            if ((int)indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal == INDEX_HASH)
+            {
+                response = HashIndex::hashDestroy((int)indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal);
+                if (response != SUCCESS)
+                {
+                    printf("Failed to destroy hash index.\n");
+                    exit(1);
+                }
+            }
+
+            if ((int)indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal == INDEX_BITMAP)
+            {
+                response = BitmapIndex::bitmapDestroy((int)indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal);
+                if (response != SUCCESS)
+                {
+                    printf("Failed to destroy bitmap index.\n");
+                    exit(1);
+                }
+            }
+
+            if ((int)indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal == INDEX_STATS)
+            {
+                response = Statistics::statsDestroy((int)indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal);
+                if (response != SUCCESS)
+                {
+                    printf("Failed to destroy statistics.\n");
+                    exit(1);
+                }
+            }
+
+            // (the entries of a composite index all record its root; the tree is destroyed once)
+            int rootBlock = (int)indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal;
+            if ((int)indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal == INDEX_COMPOSITE &&
+                (int)indexCatRecord[INDEXCAT_KEY_NUM_INDEX].nVal == 0 && rootBlock != -1)
+            {
+                response = BPlusTree::bPlusDestroy(rootBlock);
+                if (response != SUCCESS)
+                {
+                    printf("Failed to destroy B+ tree.\n");
+                    exit(1);
+                }
+            }
+
+            response = BlockAccess::deleteRecord(INDEXCAT_RELID, indexCatRecId);
+            if (response != SUCCESS)
+            {
+                printf("Failed to delete index catalogue entry.\n");
+                exit(1);
+            }
+        }
+    }
+
+    /*** Delete the entry corresponding to the relation from relation catalog ***/
+    // Fetch the header of Relcat block
+    HeadInfo relCatHeader;
+    response = relCatRecBuffer.getHeader(&relCatHeader);
+
+    /* Decrement the numEntries in the header of the block corresponding to the
+       relation catalog entry and set it back */
+    relCatHeader.numEntries--;
+    relCatRecBuffer.setHeader(&relCatHeader);
+
+    /* Get the slotmap in relation catalog, update it by marking the slot as
+       free(SLOT_UNOCCUPIED) and set it back. */
+    unsigned char relCatSlotMap[relCatHeader.numSlots];
+    response = relCatRecBuffer.getSlotMap(relCatSlotMap);
+    if (response != SUCCESS)
+    {
+        printf("Slotmap not found.\n");
+        exit(1);
+    }
+    relCatSlotMap[relCatRecId.slot] = SLOT_UNOCCUPIED;
+    response = relCatRecBuffer.setSlotMap(relCatSlotMap);
+    if (response != SUCCESS)
+    {
+        printf("Slotmap not saved successfully.\n");
+        exit(1);
+    }
+
+
+    /*** Updating the Relation Cache Table ***/
+
+    /** Update relation catalog record entry (number of records in relation
+        catalog is decreased by 1) **/
+    // Get the entry corresponding to relation catalog from the relation
+    // cache and update the number of records and set it back
+    // (using RelCacheTable::setRelCatEntry() function)
+    RelCatEntry relCatEntry;
+    response = RelCacheTable::getRelCatEntry(RELCAT_RELID, &relCatEntry);
+    if (response != SUCCESS)
+    {
+        printf("Failed to get relation catalogue entry.\n");
+        exit(1);
     }
     relCatEntry.numRecs--;
     response = RelCacheTable::setRelCatEntry(RELCAT_RELID, &relCatEntry);
@@ -1125,10 +1529,32 @@ int BlockAccess::search(int relId, Attribute *record, char attrName[ATTR_SIZE],
         return response;
     }
 
+    /* if a bloom filter exists for the attribute and it rules the value out,
+       no record can be equal to it (the relation need not be searched) */
+    if (op == EQ && attrCatEntry.bloomBlock != -1 &&
+        BloomFilter::bloomSearch(relId, attrName, attrVal) == E_NOTFOUND)
+    {
+        return E_NOTFOUND;
+    }
+
     // get rootBlock from the attribute catalog entry
     int rootBlock = attrCatEntry.rootBlock;
+
+    /* an equality search on an attribute with a bitmap index reads the set bits
+       of the bitmap of the value, and one with a hash index reads the bucket of
+       the value alone (other operators use the B+ tree or a linear search) */
+    if (op == EQ && attrCatEntry.bitmapBlock != -1)
+    {
+        recId = BitmapIndex::bitmapSearch(relId, attrName, attrVal);
+    }
+
+    else if (op == EQ && attrCatEntry.hashBlock != -1)
+    {
+        recId = HashIndex::hashSearch(relId, attrName, attrVal);
+    }
+
     /* if Index does not exist for the attribute (check rootBlock == -1) */ 
-    if(rootBlock == -1)
+    else if(rootBlock == -1)
     {
         /* search for the record id (recid) corresponding to the attribute with
            attribute name attrName, with value attrval and satisfying the
@@ -1141,10 +1567,43 @@ int BlockAccess::search(int relId, Attribute *record, char attrName[ATTR_SIZE],
     else {
         // (index exists for the attribute)
 
+        /* a search in progress goes on the way it started: the path is chosen
+           by the cost of each (see planSearch()) only when the search starts,
+           i.e. when both the search index of the relation (used by linearSearch())
+           and that of the attribute (used by bPlusSearch()) are reset */
+        RecId relSearchIndex;
+        IndexId attrSearchIndex;
+        RelCacheTable::getSearchIndex(relId, &relSearchIndex);
+        AttrCacheTable::getSearchIndex(relId, attrName, &attrSearchIndex);
+
+        bool useIndex;
+        if (relSearchIndex.block != -1)
+        {
+            useIndex = false;
+        }
+        else if (attrSearchIndex.block != -1)
+        {
+            useIndex = true;
+        }
+        else
+        {
+            AccessPlan plan;
+            BlockAccess::planSearch(relId, attrName, attrVal, op, &plan);
+            useIndex = plan.method == ACCESS_BPLUS;
+        }
+
         /* search for the record id (recid) correspoding to the attribute with
         attribute name attrName and with value attrval and satisfying the
-        condition op using BPlusTree::bPlusSearch() */
-        recId = BPlusTree::bPlusSearch(relId, attrName, attrVal, op);
+        condition op using BPlusTree::bPlusSearch() (or linearSearch(), if
+        reading the records found through the index costs more) */
+        if (useIndex)
+        {
+            recId = BPlusTree::bPlusSearch(relId, attrName, attrVal, op);
+        }
+        else
+        {
+            recId = BlockAccess::linearSearch(relId, attrName, attrVal, op);
+        }
     }
 
 
@@ -1169,4 +1628,1346 @@ int BlockAccess::search(int relId, Attribute *record, char attrName[ATTR_SIZE],
     
 
     return SUCCESS;
-}
\ No newline at end of file
+}
+
+// if false, a B+ tree is always used when there is one (see BlockAccess::setCostBased())
+static bool costBased = true;
+
+/*
+Turns the choice of the access paths by their cost on or off (off, a search
+uses the B+ tree on the attribute whenever there is one, as it did before the
+costs were compared; see FUNCTION access_plan).
+*/
+void BlockAccess::setCostBased(bool enable)
+{
+    costBased = enable;
+}
+
+/*
+Chooses the access path for the records of the relation relId satisfying
+attrName op attrVal, by comparing the blocks read by a linear search with those
+read by a search of the B+ tree on the attribute (if it has one). The number of
+records found is estimated from the statistics of the attribute (see
+Statistics::selectivity()) if it was analyzed, else from default selectivities.
+An equality on an attribute with a bitmap or hash index always uses it.
+*/
+int BlockAccess::planSearch(int relId, char attrName[ATTR_SIZE], Attribute attrVal, int op, AccessPlan *plan)
+{
+    RelCatEntry relCatEntry;
+    int response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    AttrCatEntry attrCatEntry;
+    response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    double selectivity;
+    AttrStats stats;
+    plan->fromStats = Statistics::getStats(relId, attrName, &stats) == SUCCESS;
+    if (plan->fromStats)
+    {
+        selectivity = Statistics::selectivity(&stats, op, attrVal);
+    }
+    else
+    {
+        selectivity = op == EQ ? DEFAULT_EQ_SELECTIVITY
+                    : op == NE ? 1 - DEFAULT_EQ_SELECTIVITY
+                               : DEFAULT_INEQ_SELECTIVITY;
+    }
+    plan->numRecords = relCatEntry.numRecs * selectivity;
+
+    /* bPlusSearch() reads every leaf for NE; for the other operators it reads
+       the leaves holding the entries found (and, for LT and LE, starts from the
+       leftmost leaf, which holds the first of them) */
+    BlockAccess::costPlan(&relCatEntry, &attrCatEntry, op == NE ? 1 : selectivity, plan);
+
+    if (op == EQ && attrCatEntry.bitmapBlock != -1)
+    {
+        plan->method = ACCESS_BITMAP;
+    }
+    else if (op == EQ && attrCatEntry.hashBlock != -1)
+    {
+        plan->method = ACCESS_HASH;
+    }
+
+    return SUCCESS;
+}
+
+/*
+planSearch() for the records of the relation relId whose value of attrName
+lies between lowerVal and upperVal (see openRangeScan(); either bound may be
+nullptr).
+*/
+int BlockAccess::planRangeScan(int relId, char attrName[ATTR_SIZE], Attribute *lowerVal, bool lowerInclusive,
+                               Attribute *upperVal, bool upperInclusive, AccessPlan *plan)
+{
+    RelCatEntry relCatEntry;
+    int response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    AttrCatEntry attrCatEntry;
+    response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    double selectivity = 1;
+    AttrStats stats;
+    plan->fromStats = Statistics::getStats(relId, attrName, &stats) == SUCCESS;
+    if (plan->fromStats)
+    {
+        // (the records in the range are those neither below nor above it)
+        if (lowerVal != nullptr)
+        {
+            selectivity -= Statistics::selectivity(&stats, lowerInclusive ? LT : LE, *lowerVal);
+        }
+        if (upperVal != nullptr)
+        {
+            selectivity -= Statistics::selectivity(&stats, upperInclusive ? GT : GE, *upperVal);
+        }
+        selectivity = std::max(0.0, selectivity);
+    }
+    else if (lowerVal != nullptr && upperVal != nullptr)
+    {
+        selectivity = DEFAULT_RANGE_SELECTIVITY;
+    }
+    else if (lowerVal != nullptr || upperVal != nullptr)
+    {
+        selectivity = DEFAULT_INEQ_SELECTIVITY;
+    }
+    plan->numRecords = relCatEntry.numRecs * selectivity;
+
+    // (a range scan of the B+ tree reads the leaves from the lower bound to the upper bound)
+    BlockAccess::costPlan(&relCatEntry, &attrCatEntry, selectivity, plan);
+
+    return SUCCESS;
+}
+
+/*
+Sets the costs of a plan for plan->numRecords records found (see AccessPlan),
+the B+ tree search reading leafFraction of the leaves, and picks the cheaper of
+the linear search and the B+ tree search. The height of the tree is found by
+descending to its leftmost leaf; its number of leaves is estimated from the
+number of records and the capacity of the leaves.
+The costs are relative to the read of a block and the test of its records: a
+record returned costs RECORD_COST of it, and reading the record of an index
+entry FETCH_COST more (the blocks are in memory, and a record is read out of
+its block alone), so the B+ tree is cheaper up to about 1 / FETCH_COST records
+per record block of the relation (as measured with FUNCTION bench_search).
+*/
+void BlockAccess::costPlan(RelCatEntry *relCatEntry, AttrCatEntry *attrCatEntry, double leafFraction,
+                           AccessPlan *plan)
+{
+    int numSlots = relCatEntry->numSlotsPerBlk;
+    plan->linearCost = (relCatEntry->numRecs + numSlots - 1) / numSlots + plan->numRecords * RECORD_COST;
+    plan->method = ACCESS_LINEAR;
+    plan->indexCost = -1;
+    plan->indexHeight = 0;
+    plan->numLeaves = 0;
+
+    if (attrCatEntry->rootBlock == -1)
+    {
+        return;
+    }
+
+    int block = attrCatEntry->rootBlock;
+    plan->indexHeight = 1;
+    while (StaticBuffer::getStaticBlockType(block) == IND_INTERNAL)
+    {
+        block = IndInternal(block).getChild(0);
+        plan->indexHeight++;
+    }
+
+    HeadInfo leafHead;
+    IndLeaf(block).getHeader(&leafHead);
+    double leafEntries = IndLeaf::getMaxEntries(leafHead.numSlots) * LEAF_OCCUPANCY;
+    plan->numLeaves = std::max(1.0, std::ceil(relCatEntry->numRecs / leafEntries));
+
+    plan->indexCost = (plan->indexHeight - 1) + std::max(1.0, std::ceil(plan->numLeaves * leafFraction)) +
+                      plan->numRecords * (RECORD_COST + FETCH_COST);
+    if (plan->indexCost < plan->linearCost || !costBased)
+    {
+        plan->method = ACCESS_BPLUS;
+    }
+}
+
+/*
+Starts a scan of the relation relId for the records satisfying attrName op
+attrVal (every record if attrName is nullptr). The records are returned a block
+at a time by BlockAccess::scanNext(). Unlike linearSearch() and project(), the
+scan does not use the search index in the relation cache.
+*/
+int BlockAccess::openScan(ScanCursor *cursor, int relId, char *attrName, Attribute attrVal, int op)
+{
+    RelCatEntry relCatEntry;
+    int response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    cursor->relId = relId;
+    cursor->numAttrs = relCatEntry.numAttrs;
+    cursor->numSlots = relCatEntry.numSlotsPerBlk;
+    cursor->block = relCatEntry.firstBlk;
+    cursor->zoneBlock = -1;
+    cursor->zoneEntry = -1;
+    cursor->hasCondition = false;
+
+    if (attrName == nullptr)
+    {
+        return SUCCESS;
+    }
+
+    AttrCatEntry attrCatEntry;
+    response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    cursor->hasCondition = true;
+    cursor->attrOffset = attrCatEntry.offset;
+    cursor->attrType = attrCatEntry.attrType;
+    cursor->op = op;
+    cursor->attrVal = attrVal;
+
+    // if the bloom filter on the attribute rules the value out, there is nothing to scan
+    if (op == EQ && attrCatEntry.bloomBlock != -1 &&
+        BloomFilter::bloomSearch(relId, attrName, attrVal) == E_NOTFOUND)
+    {
+        cursor->block = -1;
+        return SUCCESS;
+    }
+
+    // find the zone map entry of the first block (if any) so that blocks can be
+    // skipped without being read
+    if (cursor->block != -1)
+    {
+        RecBuffer recBuffer(cursor->block);
+        HeadInfo head;
+        recBuffer.getHeader(&head);
+        if (head.pblock != -1)
+        {
+            ZoneMapBuffer zoneBuffer(head.pblock);
+            int entryNum = zoneBuffer.findEntry(cursor->block);
+            if (entryNum >= 0)
+            {
+                cursor->zoneBlock = head.pblock;
+                cursor->zoneEntry = entryNum;
+            }
+        }
+    }
+
+    return SUCCESS;
+}
+
+/*
+Scans the next record block of the relation (skipping the blocks which have no
+matching record) and copies the records in it that satisfy the condition of the
+scan to `records`, and their record ids to `recIds` (if it is not nullptr).
+Returns E_NOTFOUND once all the blocks have been scanned.
+NOTE: this function expects the caller to allocate memory for numSlotsPerBlk
+      records (and record ids) of the relation.
+*/
+int BlockAccess::scanNext(ScanCursor *cursor, Attribute *records, RecId *recIds, int *numRecords)
+{
+    int numAttrs = cursor->numAttrs;
+    *numRecords = 0;
+
+    while (cursor->block != -1)
+    {
+        int block = cursor->block;
+
+        /* skip the block if its zone map entry shows that no record in it can
+           satisfy the condition */
+        if (cursor->hasCondition && cursor->zoneBlock != -1)
+        {
+            ZoneMapBuffer zoneBuffer(cursor->zoneBlock);
+            Attribute minVal, maxVal;
+            zoneBuffer.getRange(&minVal, &maxVal, cursor->attrOffset, cursor->zoneEntry);
+
+            if (BlockAccess::zoneExcludes(minVal, maxVal, cursor->attrVal, cursor->attrType, cursor->op))
+            {
+                int nextBlock = BlockAccess::nextZoneEntry(&cursor->zoneBlock, &cursor->zoneEntry);
+
+                // (no more entries in the zone map, follow the record block list instead)
+                if (nextBlock == -1)
+                {
+                    RecBuffer recBuffer(block);
+                    HeadInfo head;
+                    recBuffer.getHeader(&head);
+                    nextBlock = head.rblock;
+                }
+
+                cursor->block = nextBlock;
+                continue;
+            }
+        }
+
+        /* read the whole block once. the records are read into `records` and
+           the ones that satisfy the condition are moved to the front */
+        RecBuffer recBuffer(block);
+        HeadInfo head;
+        unsigned char slotMap[cursor->numSlots];
+        int response = recBuffer.getRecords(&head, slotMap, records);
+        if (response != SUCCESS)
+        {
+            printf("Block not found.\n");
+            exit(1);
+        }
+
+        /* evaluate the condition on all the records of the block at once
+           (bit i of `selection` is set if the record in slot i satisfies it) */
+        uint64_t selection[SELECTION_BITMAP_WORDS];
+        if (cursor->hasCondition)
+        {
+            PredicateKernels::select(records, head.numSlots, numAttrs, cursor->attrOffset,
+                                     cursor->attrType, cursor->attrVal, cursor->op, selection);
+        }
+
+        int count = 0;
+        for (int slot = 0; slot < head.numSlots; slot++)
+        {
+            if (slotMap[slot] == SLOT_UNOCCUPIED)
+            {
+                continue;
+            }
+
+            if (cursor->hasCondition && !((selection[slot >> 6] >> (slot & 63)) & 1))
+            {
+                continue;
+            }
+
+            Attribute *record = records + slot * numAttrs;
+
+            // (count <= slot, so the record is never overwritten before it is moved)
+            if (count != slot)
+            {
+                memcpy(records + count * numAttrs, record, numAttrs * sizeof(Attribute));
+            }
+            if (recIds != nullptr)
+            {
+                recIds[count] = RecId{block, slot};
+            }
+            count++;
+        }
+
+        // move on to the next block (and its zone map entry)
+        cursor->block = head.rblock;
+        if (cursor->zoneBlock != -1 && BlockAccess::nextZoneEntry(&cursor->zoneBlock, &cursor->zoneEntry) != cursor->block)
+        {
+            cursor->zoneBlock = -1;
+            cursor->zoneEntry = -1;
+        }
+
+        if (count > 0)
+        {
+            *numRecords = count;
+            return SUCCESS;
+        }
+    }
+
+    return E_NOTFOUND;
+}
+
+/*
+Starts a scan of the relation relId for the records whose value of attrName lies
+between lowerVal and upperVal (either bound is inclusive or exclusive; a nullptr
+bound leaves the range open on that side). The records are returned in batches
+by BlockAccess::rangeScanNext(); with a B+ tree on the attribute they come in
+ascending order of the attribute, a leaf of the tree at a time.
+*/
+int BlockAccess::openRangeScan(RangeScanCursor *cursor, int relId, char *attrName, Attribute *lowerVal,
+                               bool lowerInclusive, Attribute *upperVal, bool upperInclusive)
+{
+    RelCatEntry relCatEntry;
+    int response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    AttrCatEntry attrCatEntry;
+    response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    cursor->indexOnly = false;
+    cursor->useBitmap = false;
+    cursor->numAttrs = relCatEntry.numAttrs;
+    cursor->numChecks = 0;
+    cursor->anyCheck = false;
+
+    /* if the attribute has a B+ tree and reading the records in the range
+       through it costs less than a scan (see planRangeScan()), seek to the
+       lower bound in it */
+    AccessPlan plan;
+    BlockAccess::planRangeScan(relId, attrName, lowerVal, lowerInclusive, upperVal, upperInclusive, &plan);
+    if (plan.method == ACCESS_BPLUS)
+    {
+        cursor->useIndex = true;
+        return BPlusTree::rangeOpen(&cursor->indexCursor, relId, attrName,
+                                    lowerVal, lowerInclusive, upperVal, upperInclusive);
+    }
+
+    /* else scan the relation for one of the bounds (so that zone maps can skip
+       blocks), and test the range on the records found if both are given */
+    cursor->useIndex = false;
+    if (lowerVal != nullptr && upperVal != nullptr)
+    {
+        RangeCondition *check = &cursor->checks[cursor->numChecks++];
+        check->attrOffset = attrCatEntry.offset;
+        check->attrType = attrCatEntry.attrType;
+        check->hasLower = true;
+        check->lowerInclusive = lowerInclusive;
+        check->lowerVal = *lowerVal;
+        check->hasUpper = true;
+        check->upperInclusive = upperInclusive;
+        check->upperVal = *upperVal;
+    }
+
+    if (lowerVal != nullptr)
+    {
+        return BlockAccess::openScan(&cursor->scanCursor, relId, attrName, *lowerVal, lowerInclusive ? GE : GT);
+    }
+    if (upperVal != nullptr)
+    {
+        return BlockAccess::openScan(&cursor->scanCursor, relId, attrName, *upperVal, upperInclusive ? LE : LT);
+    }
+    return BlockAccess::openScan(&cursor->scanCursor, relId, nullptr, Attribute(), EQ);
+}
+
+/*
+Starts a scan of the B+ tree on attrName for the entries in the range (as in
+openRangeScan()) that does not read the records: the records returned by
+BlockAccess::rangeScanNext() have only attrName and the attribute included in
+the leaf entries of the tree (if any) set. Returns E_NOINDEX if the attribute
+has no B+ tree.
+*/
+int BlockAccess::openIndexOnlyScan(RangeScanCursor *cursor, int relId, char *attrName, Attribute *lowerVal,
+                                   bool lowerInclusive, Attribute *upperVal, bool upperInclusive)
+{
+    RelCatEntry relCatEntry;
+    int response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    AttrCatEntry attrCatEntry;
+    response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    if (attrCatEntry.rootBlock == -1)
+    {
+        return E_NOINDEX;
+    }
+
+    cursor->useIndex = true;
+    cursor->indexOnly = true;
+    cursor->useBitmap = false;
+    cursor->keyOffset = attrCatEntry.offset;
+    cursor->includeOffset = attrCatEntry.includeOffset;
+    cursor->numAttrs = relCatEntry.numAttrs;
+    cursor->numChecks = 0;
+    cursor->anyCheck = false;
+
+    return BPlusTree::rangeOpen(&cursor->indexCursor, relId, attrName,
+                                lowerVal, lowerInclusive, upperVal, upperInclusive);
+}
+
+/*
+Starts a scan of the B+ tree on attrName for the records in the range (as in
+openRangeScan()), whatever it costs against a scan of the relation, so that the
+records are returned in the order of the attribute: ascending, or descending if
+`descending` (see BPlusTree::rangeOpen()). Returns E_NOINDEX if the attribute
+has no B+ tree.
+*/
+int BlockAccess::openOrderedScan(RangeScanCursor *cursor, int relId, char *attrName, bool descending,
+                                 Attribute *lowerVal, bool lowerInclusive, Attribute *upperVal, bool upperInclusive)
+{
+    RelCatEntry relCatEntry;
+    int response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    AttrCatEntry attrCatEntry;
+    response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    if (attrCatEntry.rootBlock == -1)
+    {
+        return E_NOINDEX;
+    }
+
+    cursor->useIndex = true;
+    cursor->indexOnly = false;
+    cursor->useBitmap = false;
+    cursor->numAttrs = relCatEntry.numAttrs;
+    cursor->numChecks = 0;
+    cursor->anyCheck = false;
+
+    return BPlusTree::rangeOpen(&cursor->indexCursor, relId, attrName,
+                                lowerVal, lowerInclusive, upperVal, upperInclusive, descending);
+}
+
+/*
+Starts a scan of the relation relId for the records with eqAttrName = eqVal
+whose value of attrName lies between lowerVal and upperVal (as in
+openRangeScan()). If a composite index on the relation has eqAttrName and
+attrName as the first two attributes of its key, the records are found with a
+single seek in its B+ tree; otherwise the records with eqAttrName = eqVal are
+scanned and the range is tested on them.
+*/
+int BlockAccess::openPrefixRangeScan(RangeScanCursor *cursor, int relId, char *eqAttrName, Attribute eqVal,
+                                     char *attrName, Attribute *lowerVal, bool lowerInclusive, Attribute *upperVal,
+                                     bool upperInclusive)
+{
+    AttrCatEntry eqAttrCatEntry, attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, eqAttrName, &eqAttrCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+    response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    // the condition on attrName (tested on the records found in either case)
+    RangeCondition range;
+    range.attrOffset = attrCatEntry.offset;
+    range.attrType = attrCatEntry.attrType;
+    range.hasLower = (lowerVal != nullptr);
+    range.lowerInclusive = lowerInclusive;
+    range.hasUpper = (upperVal != nullptr);
+    range.upperInclusive = upperInclusive;
+    if (lowerVal != nullptr)
+    {
+        range.lowerVal = *lowerVal;
+    }
+    if (upperVal != nullptr)
+    {
+        range.upperVal = *upperVal;
+    }
+
+    // find a composite index whose key starts with (eqAttrName, attrName)
+    CompositeIndexInfo compositeIndex;
+    int indexNum = 0;
+    while (RelCacheTable::getCompositeIndex(relId, indexNum, &compositeIndex) == SUCCESS)
+    {
+        if (compositeIndex.rootBlock != -1 && compositeIndex.keyOffsets[0] == eqAttrCatEntry.offset &&
+            compositeIndex.keyOffsets[1] == attrCatEntry.offset)
+        {
+            break;
+        }
+        indexNum++;
+    }
+
+    /* (no such index) with a bitmap index on eqAttrName, or an equality on
+       attrName that has one, the records are found from the bitmaps */
+    bool isEquality = lowerVal != nullptr && upperVal != nullptr && lowerInclusive && upperInclusive &&
+                      compareAttrs(*lowerVal, *upperVal, attrCatEntry.attrType) == 0;
+    if (RelCacheTable::getCompositeIndex(relId, indexNum, &compositeIndex) != SUCCESS &&
+        (eqAttrCatEntry.bitmapBlock != -1 || (isEquality && attrCatEntry.bitmapBlock != -1)))
+    {
+        char attrNames[2][ATTR_SIZE];
+        strcpy(attrNames[0], eqAttrName);
+        strcpy(attrNames[1], attrName);
+        Attribute attrVals[2] = {eqVal, isEquality ? *lowerVal : Attribute()};
+
+        response = BlockAccess::openEqualityScan(cursor, relId, isEquality ? 2 : 1, attrNames, attrVals, false);
+        if (response == SUCCESS && !isEquality)
+        {
+            cursor->checks[cursor->numChecks++] = range;
+        }
+        return response;
+    }
+
+    if (RelCacheTable::getCompositeIndex(relId, indexNum, &compositeIndex) != SUCCESS)
+    {
+        // (no such index) scan for eqAttrName = eqVal, and test the range on the records found
+        response = BlockAccess::openRangeScan(cursor, relId, eqAttrName, &eqVal, true, &eqVal, true);
+        if (response == SUCCESS)
+        {
+            cursor->checks[cursor->numChecks++] = range;
+        }
+        return response;
+    }
+
+    /* the keys of the records in the range are between the smallest key with
+       (eqVal, lowerVal) and the largest key with (eqVal, upperVal); keys only
+       order the records (see BPlusTree::makeCompositeKey()), so the entries
+       between them are candidates, and both conditions are tested on them */
+    Attribute keyVals[2] = {eqVal, Attribute()};
+    Attribute lowerKey, upperKey;
+    if (lowerVal != nullptr)
+    {
+        keyVals[1] = *lowerVal;
+    }
+    BPlusTree::makeCompositeKey(&compositeIndex, keyVals, lowerVal != nullptr ? 2 : 1, false, &lowerKey);
+    if (upperVal != nullptr)
+    {
+        keyVals[1] = *upperVal;
+    }
+    BPlusTree::makeCompositeKey(&compositeIndex, keyVals, upperVal != nullptr ? 2 : 1, true, &upperKey);
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+    cursor->useIndex = true;
+    cursor->indexOnly = false;
+    cursor->useBitmap = false;
+    cursor->numAttrs = relCatEntry.numAttrs;
+    cursor->numChecks = 0;
+    cursor->anyCheck = false;
+
+    RangeCondition *check = &cursor->checks[cursor->numChecks++];
+    check->attrOffset = eqAttrCatEntry.offset;
+    check->attrType = eqAttrCatEntry.attrType;
+    check->hasLower = check->hasUpper = true;
+    check->lowerInclusive = check->upperInclusive = true;
+    check->lowerVal = check->upperVal = eqVal;
+    cursor->checks[cursor->numChecks++] = range;
+
+    return BPlusTree::rangeOpen(&cursor->indexCursor, relId, compositeIndex.indexName,
+                                &lowerKey, true, &upperKey, true);
+}
+
+/*
+Starts a scan of the relation relId for the records satisfying the equalities
+attrNames[i] = attrVals[i], all of them (any of them if disjunction is true).
+The bitmaps of the values are read from the bitmap indexes on the attributes
+and and-ed (or or-ed) a word at a time; BlockAccess::rangeScanNext() then reads
+only the slots left set. The equalities of a conjunction on attributes without
+a bitmap index are tested on the records read. If no attribute has a bitmap
+index (for a disjunction, if any attribute has none), the relation is scanned
+and the equalities are tested on every record.
+*/
+int BlockAccess::openEqualityScan(RangeScanCursor *cursor, int relId, int numTerms, char attrNames[][ATTR_SIZE],
+                                  Attribute *attrVals, bool disjunction)
+{
+    if (numTerms < 1 || numTerms > MAX_SELECT_TERMS)
+    {
+        return E_INVALID;
+    }
+
+    RelCatEntry relCatEntry;
+    int response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    AttrCatEntry attrCatEntries[numTerms];
+    int numBitmaps = 0;
+    for (int i = 0; i < numTerms; i++)
+    {
+        response = AttrCacheTable::getAttrCatEntry(relId, attrNames[i], &attrCatEntries[i]);
+        if (response != SUCCESS)
+        {
+            return response;
+        }
+        if (attrCatEntries[i].bitmapBlock != -1)
+        {
+            numBitmaps++;
+        }
+    }
+
+    cursor->useIndex = false;
+    cursor->indexOnly = false;
+    cursor->useBitmap = disjunction ? numBitmaps == numTerms : numBitmaps > 0;
+    cursor->numAttrs = relCatEntry.numAttrs;
+    cursor->numChecks = 0;
+    cursor->anyCheck = disjunction;
+
+    std::vector<BitmapEntry> bitmap;
+    bool first = true;
+    for (int i = 0; i < numTerms; i++)
+    {
+        // the equalities that are not answered from a bitmap are tested on the records
+        // (but for the first of a conjunction that is scanned for)
+        if (!cursor->useBitmap || attrCatEntries[i].bitmapBlock == -1)
+        {
+            if (cursor->useBitmap || disjunction || i > 0)
+            {
+                RangeCondition *check = &cursor->checks[cursor->numChecks++];
+                check->attrOffset = attrCatEntries[i].offset;
+                check->attrType = attrCatEntries[i].attrType;
+                check->hasLower = check->hasUpper = true;
+                check->lowerInclusive = check->upperInclusive = true;
+                check->lowerVal = check->upperVal = attrVals[i];
+            }
+            continue;
+        }
+
+        if (first)
+        {
+            BitmapIndex::getBitmap(relId, attrNames[i], attrVals[i], cursor->bitmap);
+            first = false;
+        }
+        else
+        {
+            BitmapIndex::getBitmap(relId, attrNames[i], attrVals[i], bitmap);
+            if (disjunction)
+            {
+                BitmapIndex::bitmapOr(cursor->bitmap, bitmap);
+            }
+            else
+            {
+                BitmapIndex::bitmapAnd(cursor->bitmap, bitmap);
+            }
+        }
+    }
+
+    if (cursor->useBitmap)
+    {
+        cursor->bitmapPos = 0;
+        return SUCCESS;
+    }
+
+    /* a conjunction is scanned for its first equality (so that zone maps can
+       skip blocks), a disjunction for every record */
+    if (disjunction)
+    {
+        return BlockAccess::openScan(&cursor->scanCursor, relId, nullptr, Attribute(), EQ);
+    }
+    return BlockAccess::openScan(&cursor->scanCursor, relId, attrNames[0], attrVals[0], EQ);
+}
+
+/*
+Copies the next batch of records of the range scan to `records` (and their
+record ids to `recIds`, if it is not nullptr): the records of the next leaf of
+the B+ tree, or of the next record block, that lie in the range.
+Returns E_NOTFOUND once the range is exhausted.
+NOTE: this function expects the caller to allocate memory for
+      max(numSlotsPerBlk, MAX_KEYS_LEAF_PACKED) records (and record ids) of the relation.
+*/
+int BlockAccess::rangeScanNext(RangeScanCursor *cursor, Attribute *records, RecId *recIds, int *numRecords)
+{
+    int numAttrs = cursor->numAttrs;
+
+    while (true)
+    {
+        int response;
+        if (cursor->useIndex)
+        {
+            Index leafEntries[MAX_KEYS_LEAF_PACKED];
+            response = BPlusTree::rangeNext(&cursor->indexCursor, leafEntries, numRecords);
+
+            // fetch the records the index entries point to (or, for an index-only
+            // scan, take the attribute values from the entries)
+            for (int i = 0; response == SUCCESS && i < *numRecords; i++)
+            {
+                Attribute *record = records + i * numAttrs;
+                if (cursor->indexOnly)
+                {
+                    record[cursor->keyOffset] = leafEntries[i].attrVal;
+                    if (cursor->includeOffset != -1)
+                    {
+                        memcpy(&record[cursor->includeOffset].nVal, leafEntries[i].included,
+                               sizeof(leafEntries[i].included));
+                    }
+                }
+                else
+                {
+                    RecBuffer recBuffer(leafEntries[i].block);
+                    if (recBuffer.getRecord(record, leafEntries[i].slot) != SUCCESS)
+                    {
+                        printf("Record not found.\n");
+                        exit(1);
+                    }
+                }
+                if (recIds != nullptr)
+                {
+                    recIds[i] = RecId{leafEntries[i].block, leafEntries[i].slot};
+                }
+            }
+        }
+        else if (cursor->useBitmap)
+        {
+            // read the records at the slots of the next entry of the bitmap
+            response = E_NOTFOUND;
+            if (cursor->bitmapPos < (int)cursor->bitmap.size())
+            {
+                BitmapEntry *entry = &cursor->bitmap[cursor->bitmapPos++];
+                RecBuffer recBuffer(entry->block);
+
+                *numRecords = 0;
+                for (int word = 0; word < SELECTION_BITMAP_WORDS; word++)
+                {
+                    for (uint64_t bits = entry->words[word]; bits != 0; bits &= bits - 1)
+                    {
+                        int slot = word * 64 + __builtin_ctzll(bits);
+                        if (recBuffer.getRecord(records + *numRecords * numAttrs, slot) != SUCCESS)
+                        {
+                            printf("Record not found.\n");
+                            exit(1);
+                        }
+                        if (recIds != nullptr)
+                        {
+                            recIds[*numRecords] = RecId{entry->block, slot};
+                        }
+                        (*numRecords)++;
+                    }
+                }
+                response = SUCCESS;
+            }
+        }
+        else
+        {
+            response = BlockAccess::scanNext(&cursor->scanCursor, records, recIds, numRecords);
+        }
+
+        if (response != SUCCESS)
+        {
+            *numRecords = 0;
+            return E_NOTFOUND;
+        }
+
+        if (cursor->numChecks == 0)
+        {
+            return SUCCESS;
+        }
+
+        // keep the records that satisfy the conditions to be tested (moving them to the front)
+        int count = 0;
+        for (int i = 0; i < *numRecords; i++)
+        {
+            Attribute *record = records + i * numAttrs;
+
+            bool satisfies = !cursor->anyCheck;
+            for (int checkNum = 0; satisfies != cursor->anyCheck && checkNum < cursor->numChecks; checkNum++)
+            {
+                satisfies = BlockAccess::satisfiesRange(record, &cursor->checks[checkNum]);
+            }
+            if (!satisfies)
+            {
+                continue;
+            }
+
+            if (count != i)
+            {
+                memcpy(records + count * numAttrs, record, numAttrs * sizeof(Attribute));
+                if (recIds != nullptr)
+                {
+                    recIds[count] = recIds[i];
+                }
+            }
+            count++;
+        }
+
+        if (count > 0)
+        {
+            *numRecords = count;
+            return SUCCESS;
+        }
+    }
+}
+
+// returns true if the value of the attribute of the condition in the record is in its range
+bool BlockAccess::satisfiesRange(Attribute *record, RangeCondition *condition)
+{
+    Attribute value = record[condition->attrOffset];
+
+    if (condition->hasLower)
+    {
+        int cmpVal = compareAttrs(value, condition->lowerVal, condition->attrType);
+        if (cmpVal < 0 || (cmpVal == 0 && !condition->lowerInclusive))
+        {
+            return false;
+        }
+    }
+
+    if (condition->hasUpper)
+    {
+        int cmpVal = compareAttrs(value, condition->upperVal, condition->attrType);
+        if (cmpVal > 0 || (cmpVal == 0 && !condition->upperInclusive))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+Deletes the record at recId from the relation relId, and its entries from the
+B+ trees, hash and bitmap indexes on the attributes and the composite indexes of
+the relation. If the block of the record becomes empty, it is removed from the list
+of record blocks of the relation and released, unless it is summarised in a zone map (the entries
+of a zone map follow the list of blocks, so the empty block is kept in the list).
+NOTE: the bloom filters and the zone map are not narrowed; a deleted value may
+      still pass them, which only costs a scan of its block.
+Returns E_INDEX_BLOCKS_RELEASED if an index had to be destroyed (see
+BPlusTree::bPlusDelete()), the record being deleted all the same.
+*/
+int BlockAccess::deleteRecord(int relId, RecId recId)
+{
+    RelCatEntry relCatEntry;
+    int response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    RecBuffer recBuffer(recId.block);
+    HeadInfo header;
+    response = recBuffer.getHeader(&header);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    if (recId.slot < 0 || recId.slot >= header.numSlots)
+    {
+        return E_OUTOFBOUND;
+    }
+
+    // mark the slot as free in the slotmap
+    unsigned char slotMap[header.numSlots];
+    recBuffer.getSlotMap(slotMap);
+    if (slotMap[recId.slot] == SLOT_UNOCCUPIED)
+    {
+        return E_FREESLOT;
+    }
+
+    /* B+ Tree Deletions */
+    int flag = SUCCESS;
+
+    // (the record is read before its slot is freed, for the keys of its entries)
+    Attribute record[relCatEntry.numAttrs];
+    recBuffer.getRecord(record, recId.slot);
+
+    for (int attrOffset = 0; attrOffset < relCatEntry.numAttrs; attrOffset++)
+    {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
+        if (attrCatEntry.rootBlock == -1)
+        {
+            continue;
+        }
+
+        response = BPlusTree::bPlusDelete(relId, attrCatEntry.attrName, record[attrOffset], recId);
+        if (response == E_DISKFULL)
+        {
+            // (index for this attribute has been destroyed)
+            flag = E_INDEX_BLOCKS_RELEASED;
+        }
+        else if (response != SUCCESS)
+        {
+            printf("Index entry of attribute %s not deleted successfully.\n", attrCatEntry.attrName);
+            exit(1);
+        }
+    }
+
+    // remove the entries of the record from the hash indexes, and its bits from the bitmap indexes
+    for (int attrOffset = 0; attrOffset < relCatEntry.numAttrs; attrOffset++)
+    {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
+        if (attrCatEntry.hashBlock != -1)
+        {
+            response = HashIndex::hashDelete(relId, attrCatEntry.attrName, record[attrOffset], recId);
+            if (response != SUCCESS)
+            {
+                printf("Hash index entry of attribute %s not deleted successfully.\n", attrCatEntry.attrName);
+                exit(1);
+            }
+        }
+
+        if (attrCatEntry.bitmapBlock != -1)
+        {
+            response = BitmapIndex::bitmapDelete(relId, attrCatEntry.attrName, record[attrOffset], recId);
+            if (response != SUCCESS)
+            {
+                printf("Bitmap index entry of attribute %s not deleted successfully.\n", attrCatEntry.attrName);
+                exit(1);
+            }
+        }
+    }
+
+    CompositeIndexInfo compositeIndex;
+    for (int indexNum = 0; RelCacheTable::getCompositeIndex(relId, indexNum, &compositeIndex) == SUCCESS; indexNum++)
+    {
+        if (compositeIndex.rootBlock == -1)
+        {
+            continue;
+        }
+
+        Attribute key;
+        BPlusTree::recordCompositeKey(&compositeIndex, record, &key);
+        response = BPlusTree::bPlusDelete(relId, compositeIndex.indexName, key, recId);
+        if (response == E_DISKFULL)
+        {
+            flag = E_INDEX_BLOCKS_RELEASED;
+        }
+        else if (response != SUCCESS)
+        {
+            printf("Entry of composite index %s not deleted successfully.\n", compositeIndex.indexName);
+            exit(1);
+        }
+    }
+
+    slotMap[recId.slot] = SLOT_UNOCCUPIED;
+    recBuffer.setSlotMap(slotMap);
+
+    // decrement the number of entries in the block
+    header.numEntries--;
+    recBuffer.setHeader(&header);
+
+    /* If number of entries become 0 (and the block has no zone map entry),
+       releaseBlock is called after fixing the linked list (and the first/last
+       block of the relation).
+    */
+    if (header.numEntries == 0 && header.pblock == -1)
+    {
+        if (header.lblock != -1)
+        {
+            RecBuffer leftBlockRecBuffer(header.lblock);
+            HeadInfo leftBlockHeader;
+            leftBlockRecBuffer.getHeader(&leftBlockHeader);
+            leftBlockHeader.rblock = header.rblock;
+            leftBlockRecBuffer.setHeader(&leftBlockHeader);
+        }
+        else
+        {
+            relCatEntry.firstBlk = header.rblock;
+        }
+
+        if (header.rblock != -1)
+        {
+            RecBuffer rightBlockRecBuffer(header.rblock);
+            HeadInfo rightBlockHeader;
+            rightBlockRecBuffer.getHeader(&rightBlockHeader);
+            rightBlockHeader.lblock = header.lblock;
+            rightBlockRecBuffer.setHeader(&rightBlockHeader);
+        }
+        else
+        {
+            relCatEntry.lastBlk = header.lblock;
+        }
+
+        recBuffer.releaseBlock();
+    }
+
+    // decrement the number of records of the relation
+    relCatEntry.numRecs--;
+    response = RelCacheTable::setRelCatEntry(relId, &relCatEntry);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    return flag;
+}
+
+/*
+Widens the zone map entry of the record block `recBlockNum` to include the
+values of `record`. If the block is not summarised yet, an entry covering all
+the records in the block is appended after the entry of the previous block of
+the relation (a new zone map block is allocated when the previous one is full).
+NOTE: the zone map is an optimisation only. If there is no space for a new zone
+      map block, the record block is left unsummarised and is always scanned.
+*/
+int BlockAccess::updateZoneMap(int relId, int recBlockNum, union Attribute *record)
+{
+    // the catalogs are always scanned in full, their blocks are not summarised
+    if (relId == RELCAT_RELID || relId == ATTRCAT_RELID || relId == INDEXCAT_RELID)
+    {
+        return SUCCESS;
+    }
+
+    RecBuffer recBuffer(recBlockNum);
+    HeadInfo head;
+    int response = recBuffer.getHeader(&head);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+
+    int numAttrs = head.numAttrs;
+
+    // (an entry for a relation with this many attributes does not fit in a block)
+    int maxEntries = ZoneMapBuffer::getMaxEntries(numAttrs);
+    if (maxEntries == 0)
+    {
+        return SUCCESS;
+    }
+
+    // get the type of every attribute from the attribute cache
+    int attrTypes[numAttrs];
+    for (int attrOffset = 0; attrOffset < numAttrs; attrOffset++)
+    {
+        AttrCatEntry attrCatEntry;
+        response = AttrCacheTable::getAttrCatEntry(relId, attrOffset, &attrCatEntry);
+        if (response != SUCCESS)
+        {
+            return response;
+        }
+        attrTypes[attrOffset] = attrCatEntry.attrType;
+    }
+
+    Attribute minVals[numAttrs], maxVals[numAttrs];
+
+    // if the block is already summarised, widen its entry to include the record
+    if (head.pblock != -1)
+    {
+        ZoneMapBuffer zoneBuffer(head.pblock);
+        int entryNum = zoneBuffer.findEntry(recBlockNum);
+
+        if (entryNum < 0)
+        {
+            // (the summary can not be trusted anymore, always scan the block)
+            head.pblock = -1;
+            return recBuffer.setHeader(&head);
+        }
+
+        int entryBlockNum;
+        zoneBuffer.getEntry(&entryBlockNum, minVals, maxVals, entryNum);
+
+        for (int attrOffset = 0; attrOffset < numAttrs; attrOffset++)
+        {
+            if (compareAttrs(record[attrOffset], minVals[attrOffset], attrTypes[attrOffset]) < 0)
+            {
+                minVals[attrOffset] = record[attrOffset];
+            }
+            if (compareAttrs(record[attrOffset], maxVals[attrOffset], attrTypes[attrOffset]) > 0)
+            {
+                maxVals[attrOffset] = record[attrOffset];
+            }
+        }
+
+        return zoneBuffer.setEntry(recBlockNum, minVals, maxVals, entryNum);
+    }
+
+    /* the block is not summarised yet, compute the range of every attribute
+       over all the records in the block (the new record included) */
+    unsigned char slotMap[head.numSlots];
+    recBuffer.getSlotMap(slotMap);
+
+    bool first = true;
+    for (int slot = 0; slot < head.numSlots; slot++)
+    {
+        if (slotMap[slot] == SLOT_UNOCCUPIED)
+        {
+            continue;
+        }
+
+        Attribute blockRecord[numAttrs];
+        recBuffer.getRecord(blockRecord, slot);
+
+        for (int attrOffset = 0; attrOffset < numAttrs; attrOffset++)
+        {
+            if (first || compareAttrs(blockRecord[attrOffset], minVals[attrOffset], attrTypes[attrOffset]) < 0)
+            {
+                minVals[attrOffset] = blockRecord[attrOffset];
+            }
+            if (first || compareAttrs(blockRecord[attrOffset], maxVals[attrOffset], attrTypes[attrOffset]) > 0)
+            {
+                maxVals[attrOffset] = blockRecord[attrOffset];
+            }
+        }
+        first = false;
+    }
+
+    /* the entry goes right after the entry of the previous record block, so
+       that the entries of a zone map list are in the order of the record
+       blocks. find the zone map block holding the entry of the previous block */
+    int prevZoneBlock = -1;
+    if (head.lblock != -1)
+    {
+        RecBuffer prevBuffer(head.lblock);
+        HeadInfo prevHead;
+        prevBuffer.getHeader(&prevHead);
+        prevZoneBlock = prevHead.pblock;
+    }
+
+    int zoneBlock = -1;
+    HeadInfo zoneHead;
+
+    if (prevZoneBlock != -1)
+    {
+        ZoneMapBuffer prevZoneBuffer(prevZoneBlock);
+        prevZoneBuffer.getHeader(&zoneHead);
+
+        if (zoneHead.numEntries < zoneHead.numSlots)
+        {
+            zoneBlock = prevZoneBlock;
+        }
+    }
+
+    // allocate a new zone map block if there is no block with space for the entry
+    if (zoneBlock == -1)
+    {
+        ZoneMapBuffer zoneBuffer;
+        zoneBlock = zoneBuffer.getBlockNum();
+        if (zoneBlock == E_DISKFULL)
+        {
+            return SUCCESS;
+        }
+
+        zoneHead.blockType = ZONE_MAP;
+        zoneHead.pblock = -1;
+        zoneHead.lblock = prevZoneBlock;
+        zoneHead.rblock = -1;
+        zoneHead.numEntries = 0;
+        zoneHead.numAttrs = numAttrs;
+        zoneHead.numSlots = maxEntries;
+        zoneBuffer.setHeader(&zoneHead);
+
+        // link the new block after the zone map block of the previous record block
+        if (prevZoneBlock != -1)
+        {
+            ZoneMapBuffer prevZoneBuffer(prevZoneBlock);
+            HeadInfo prevZoneHead;
+            prevZoneBuffer.getHeader(&prevZoneHead);
+            prevZoneHead.rblock = zoneBlock;
+            prevZoneBuffer.setHeader(&prevZoneHead);
+        }
+    }
+
+    // append the entry to the zone map block and increment its numEntries
+    ZoneMapBuffer zoneBuffer(zoneBlock);
+    response = zoneBuffer.setEntry(recBlockNum, minVals, maxVals, zoneHead.numEntries);
+    if (response != SUCCESS)
+    {
+        return response;
+    }
+    zoneHead.numEntries++;
+    zoneBuffer.setHeader(&zoneHead);
+
+    // point the record block to the zone map block summarising it
+    head.pblock = zoneBlock;
+    return recBuffer.setHeader(&head);
+}
+
+/*
+Moves (zoneBlock, zoneEntry) to the next entry of the zone map and returns the
+record block it summarises. Returns -1 (and sets both to -1) if there are no
+more entries.
+*/
+int BlockAccess::nextZoneEntry(int *zoneBlock, int *zoneEntry)
+{
+    ZoneMapBuffer zoneBuffer(*zoneBlock);
+    HeadInfo zoneHead;
+    zoneBuffer.getHeader(&zoneHead);
+
+    // move to the first entry of the next zone map block if this one is exhausted
+    if (*zoneEntry + 1 >= zoneHead.numEntries)
+    {
+        if (zoneHead.rblock == -1)
+        {
+            *zoneBlock = -1;
+            *zoneEntry = -1;
+            return -1;
+        }
+
+        *zoneBlock = zoneHead.rblock;
+        *zoneEntry = 0;
+    }
+    else
+    {
+        *zoneEntry = *zoneEntry + 1;
+    }
+
+    ZoneMapBuffer nextZoneBuffer(*zoneBlock);
+    int recBlockNum;
+    if (nextZoneBuffer.getEntry(&recBlockNum, nullptr, nullptr, *zoneEntry) != SUCCESS)
+    {
+        *zoneBlock = -1;
+        *zoneEntry = -1;
+        return -1;
+    }
+
+    return recBlockNum;
+}
+
+/*
+Returns true if no value in the range [minVal, maxVal] satisfies the condition
+`op` with attrVal (i.e. a block whose values lie in that range has no match).
+*/
+bool BlockAccess::zoneExcludes(Attribute minVal, Attribute maxVal, Attribute attrVal, int attrType, int op)
+{
+    int cmpMin = compareAttrs(minVal, attrVal, attrType);
+    int cmpMax = compareAttrs(maxVal, attrVal, attrType);
+
+    switch (op)
+    {
+    case EQ:
+        return cmpMin > 0 || cmpMax < 0;
+    case LT:
+        return cmpMin >= 0;
+    case LE:
+        return cmpMin > 0;
+    case GT:
+        return cmpMax <= 0;
+    case GE:
+        return cmpMax < 0;
+    case NE:
+        return cmpMin == 0 && cmpMax == 0;
+    }
+
+    return false;
+}
+
+/*
+Deletes the index catalog entry of type indexType named indexName on the
+relation relName (if there is one). Used when an index that is recorded in the
+index catalog is destroyed for lack of disk space.
+*/
+int BlockAccess::deleteIndexCatEntry(char relName[ATTR_SIZE], char indexName[ATTR_SIZE], int indexType)
+{
+    // (the index catalog is open whenever it exists)
+    RelCatEntry indexCatEntry;
+    if (RelCacheTable::getRelCatEntry(INDEXCAT_RELID, &indexCatEntry) != SUCCESS)
+    {
+        return E_NOTFOUND;
+    }
+
+    Attribute relNameAttr;
+    strcpy(relNameAttr.sVal, relName);
+    char indexCatRelNameConst[] = INDEXCAT_ATTR_RELNAME;
+
+    RelCacheTable::resetSearchIndex(INDEXCAT_RELID);
+    while (true)
+    {
+        RecId recId = BlockAccess::linearSearch(INDEXCAT_RELID, indexCatRelNameConst, relNameAttr, EQ);
+        if (recId.block == -1 && recId.slot == -1)
+        {
+            return E_NOTFOUND;
+        }
+
+        Attribute indexCatRecord[INDEXCAT_NO_ATTRS];
+        RecBuffer indexCatBuffer(recId.block);
+        indexCatBuffer.getRecord(indexCatRecord, recId.slot);
+
+        if (strcmp(indexCatRecord[INDEXCAT_INDEX_NAME_INDEX].sVal, indexName) == 0 &&
+            (int)indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal == indexType)
+        {
+            return BlockAccess::deleteRecord(INDEXCAT_RELID, recId);
+        }
+    }
+}
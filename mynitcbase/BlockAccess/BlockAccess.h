@@ -2,17 +2,110 @@
 #define NITCBASE_BLOCKACCESS_H
 
 #include "../BPlusTree/BPlusTree.h"
+#include "../BitmapIndex/BitmapIndex.h"
+#include "../BloomFilter/BloomFilter.h"
 #include "../Buffer/BlockBuffer.h"
 #include "../Cache/AttrCacheTable.h"
 #include "../Cache/RelCacheTable.h"
+#include "../HashIndex/HashIndex.h"
+#include "../Statistics/Statistics.h"
 #include "../define/constants.h"
 #include "../define/id.h"
+#include "PredicateKernels.h"
+
+// State of a block at a time scan of a relation (see BlockAccess::openScan())
+typedef struct ScanCursor {
+  int relId;
+  int numAttrs;
+  int numSlots;
+  int block;      // next record block to be scanned (-1 once all blocks are scanned)
+  int zoneBlock;  // zone map entry summarising `block` (both -1 if not known)
+  int zoneEntry;
+  bool hasCondition;  // if false, every record of the relation is returned
+  int attrOffset;
+  int attrType;
+  int op;
+  union Attribute attrVal;
+} ScanCursor;
+
+// A condition lowerVal <= attr <= upperVal (either bound is inclusive or exclusive, or absent)
+typedef struct RangeCondition {
+  int attrOffset;
+  int attrType;
+  bool hasLower;
+  bool lowerInclusive;
+  union Attribute lowerVal;
+  bool hasUpper;
+  bool upperInclusive;
+  union Attribute upperVal;
+} RangeCondition;
+
+/*
+State of a scan of a relation for the records whose attribute values lie in
+given ranges (see BlockAccess::openRangeScan()). A B+ tree is used if there is
+one on the attribute(s); otherwise the relation is scanned a block at a time.
+The conditions that neither test exactly are tested on every record found.
+An index-only scan (see BlockAccess::openIndexOnlyScan()) returns records with
+only the indexed and the included attribute set, read from the leaf entries.
+An ordered scan (see BlockAccess::openOrderedScan()) always reads the B+ tree,
+in ascending or descending order of the attribute.
+A bitmap scan (see BlockAccess::openEqualityScan()) reads the slots set in a
+bitmap combined from bitmap indexes, a record block at a time.
+*/
+typedef struct RangeScanCursor {
+  bool useIndex;
+  bool indexOnly;
+  int keyOffset;      // (index-only scans) offset of the indexed attribute
+  int includeOffset;  // (index-only scans) offset of the included attribute, -1 if none
+  IndexRangeCursor indexCursor;
+  bool useBitmap;
+  std::vector<BitmapEntry> bitmap;  // (bitmap scans) the record blocks to be read, and their slots
+  int bitmapPos;                    // (bitmap scans) next entry of bitmap
+  ScanCursor scanCursor;
+  int numAttrs;
+  int numChecks;
+  bool anyCheck;  // a record is found if it satisfies any of the checks (else all of them)
+  RangeCondition checks[MAX_SELECT_TERMS];
+} RangeScanCursor;
+
+/*
+The access path chosen for a search (see BlockAccess::planSearch()) and the
+costs it was chosen on, in reads of a block: a linear search reads every record
+block; a B+ tree search reads a node per level down to the first leaf, the
+leaves holding the entries found and, for each entry, the block of its record.
+Both then return each record found (see BlockAccess::costPlan()).
+*/
+typedef struct AccessPlan {
+  int method;          // AccessMethod
+  bool fromStats;      // if false, numRecords is estimated from the default selectivities
+  double numRecords;   // records expected to satisfy the condition
+  double linearCost;
+  double indexCost;    // -1 if the attribute has no B+ tree
+  int indexHeight;     // levels of the B+ tree, including the leaves
+  double numLeaves;    // leaves of the B+ tree (estimated)
+} AccessPlan;
+
+/*
+Records inserted one after the other (see BlockAccess::insertBegin()): their
+index entries are held back, to be inserted into each B+ tree of the relation
+in one pass, and the search for a free slot resumes from the block of the last
+record inserted.
+*/
+typedef struct InsertBatch {
+  int relId;
+  int lastBlock;  // record block of the last record inserted (-1 if none)
+  std::vector<IndexBatch> indexes;  // the indexed attributes, then the composite indexes
+} InsertBatch;
 
 class BlockAccess {
  public:
   static int search(int relId, Attribute *record, char *attrName, Attribute attrVal, int op);
 
-  static int insert(int relId, union Attribute *record);
+  static int insert(int relId, union Attribute *record, InsertBatch *batch = nullptr);
+
+  static int insertBegin(InsertBatch *batch, int relId);
+
+  static int insertEnd(InsertBatch *batch);
 
   static int renameRelation(char *oldName, char *newName);
 
@@ -22,7 +115,51 @@ class BlockAccess {
 
   static RecId linearSearch(int relId, char *attrName, Attribute attrVal, int op);
 
+  static int planSearch(int relId, char *attrName, Attribute attrVal, int op, AccessPlan *plan);
+
+  static int planRangeScan(int relId, char *attrName, Attribute *lowerVal, bool lowerInclusive, Attribute *upperVal,
+                           bool upperInclusive, AccessPlan *plan);
+
+  static void setCostBased(bool enable);
+
   static int project(int relId, Attribute *record);
+
+  static int openScan(ScanCursor *cursor, int relId, char *attrName, Attribute attrVal, int op);
+
+  static int scanNext(ScanCursor *cursor, Attribute *records, RecId *recIds, int *numRecords);
+
+  static int openRangeScan(RangeScanCursor *cursor, int relId, char *attrName, Attribute *lowerVal,
+                           bool lowerInclusive, Attribute *upperVal, bool upperInclusive);
+
+  static int openIndexOnlyScan(RangeScanCursor *cursor, int relId, char *attrName, Attribute *lowerVal,
+                               bool lowerInclusive, Attribute *upperVal, bool upperInclusive);
+
+  static int openOrderedScan(RangeScanCursor *cursor, int relId, char *attrName, bool descending,
+                             Attribute *lowerVal, bool lowerInclusive, Attribute *upperVal, bool upperInclusive);
+
+  static int openPrefixRangeScan(RangeScanCursor *cursor, int relId, char *eqAttrName, Attribute eqVal,
+                                 char *attrName, Attribute *lowerVal, bool lowerInclusive, Attribute *upperVal,
+                                 bool upperInclusive);
+
+  static int openEqualityScan(RangeScanCursor *cursor, int relId, int numTerms, char attrNames[][ATTR_SIZE],
+                              Attribute *attrVals, bool disjunction);
+
+  static int rangeScanNext(RangeScanCursor *cursor, Attribute *records, RecId *recIds, int *numRecords);
+
+  static int deleteRecord(int relId, RecId recId);
+
+ private:
+  static int updateZoneMap(int relId, int recBlockNum, union Attribute *record);
+
+  static int nextZoneEntry(int *zoneBlock, int *zoneEntry);
+
+  static bool satisfiesRange(Attribute *record, RangeCondition *condition);
+
+  static bool zoneExcludes(Attribute minVal, Attribute maxVal, Attribute attrVal, int attrType, int op);
+
+  static int deleteIndexCatEntry(char *relName, char *indexName, int indexType);
+
+  static void costPlan(RelCatEntry *relCatEntry, AttrCatEntry *attrCatEntry, double leafFraction, AccessPlan *plan);
 };
 
 #endif  // NITCBASE_BLOCKACCESS_H
\ No newline at end of file
@@ -0,0 +1,376 @@
+// (the kernels are built with optimisations even in builds without them)
+#pragma GCC optimize("O3")
+
+#include "PredicateKernels.h"
+
+#include "../Buffer/Predicate.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <immintrin.h>
+
+// (-1 until the first call, when the level supported by the CPU is chosen)
+int PredicateKernels::level = -1;
+
+/*
+The records of a block are stored one after the other, numAttrs attributes of
+ATTR_SIZE bytes each. The kernels below read the attribute at attrOffset of
+every record, i.e. every (numAttrs * ATTR_SIZE)'th byte starting at the first
+record's attribute.
+*/
+
+/*
+Every kernel computes the bitmap 64 slots (one word of the bitmap) at a time.
+*/
+
+/************ Scalar kernels ************/
+
+template <int OP>
+static void numberKernelScalar(const Attribute *records, int numSlots, int numAttrs, int attrOffset,
+                               double value, uint64_t *bitmap) {
+  const Attribute *attr = records + attrOffset;
+  for (int first = 0; first < numSlots; first += 64) {
+    int count = numSlots - first < 64 ? numSlots - first : 64;
+    uint64_t word = 0;
+    for (int i = 0; i < count; i++, attr += numAttrs) {
+      word |= (uint64_t)OperatorTest<OP>::test(attr->nVal, value) << i;
+    }
+    bitmap[first >> 6] = word;
+  }
+}
+
+/*
+Strings are compared up to and including the terminating null character of the
+value (the bytes of a record after its terminating null character are not
+significant). cmpBytes is that length, at most ATTR_SIZE.
+*/
+static void stringEqualsScalar(const Attribute *records, int numSlots, int numAttrs, int attrOffset,
+                               const char *value, int cmpBytes, uint64_t *bitmap) {
+  const Attribute *attr = records + attrOffset;
+  for (int first = 0; first < numSlots; first += 64) {
+    int count = numSlots - first < 64 ? numSlots - first : 64;
+    uint64_t word = 0;
+    for (int i = 0; i < count; i++, attr += numAttrs) {
+      word |= (uint64_t)(memcmp(attr->sVal, value, cmpBytes) == 0) << i;
+    }
+    bitmap[first >> 6] = word;
+  }
+}
+
+// (ordered comparisons of strings have no vector kernel)
+template <int OP>
+static void stringCompareScalar(const Attribute *records, int numSlots, int numAttrs, int attrOffset,
+                                Attribute value, uint64_t *bitmap) {
+  const Attribute *attr = records + attrOffset;
+  for (int first = 0; first < numSlots; first += 64) {
+    int count = numSlots - first < 64 ? numSlots - first : 64;
+    uint64_t word = 0;
+    for (int i = 0; i < count; i++, attr += numAttrs) {
+      word |= (uint64_t)Predicate<STRING, OP>::satisfies(*attr, value) << i;
+    }
+    bitmap[first >> 6] = word;
+  }
+}
+
+/************ SSE4.2 kernels (2 numbers / 1 string per compare) ************/
+
+template <int OP>
+__attribute__((target("sse4.2"))) static inline __m128d compareNumbersSSE(__m128d attrVals, __m128d value) {
+  switch (OP) {
+    case EQ: return _mm_cmpeq_pd(attrVals, value);
+    case LT: return _mm_cmplt_pd(attrVals, value);
+    case LE: return _mm_cmple_pd(attrVals, value);
+    case GT: return _mm_cmpgt_pd(attrVals, value);
+    case GE: return _mm_cmpge_pd(attrVals, value);
+    default: return _mm_cmpneq_pd(attrVals, value);
+  }
+}
+
+template <int OP>
+__attribute__((target("sse4.2"))) static void numberKernelSSE(const Attribute *records, int numSlots, int numAttrs,
+                                                              int attrOffset, double value, uint64_t *bitmap) {
+  const double *attr = &records[attrOffset].nVal;
+  const int stride = numAttrs * (ATTR_SIZE / sizeof(double));
+  __m128d valueVec = _mm_set1_pd(value);
+
+  for (int first = 0; first < numSlots; first += 64) {
+    int count = numSlots - first < 64 ? numSlots - first : 64;
+    uint64_t word = 0;
+
+    int i = 0;
+    for (; i + 2 <= count; i += 2, attr += 2 * stride) {
+      __m128d attrVals = _mm_loadh_pd(_mm_load_sd(attr), attr + stride);
+      word |= (uint64_t)_mm_movemask_pd(compareNumbersSSE<OP>(attrVals, valueVec)) << i;
+    }
+    for (; i < count; i++, attr += stride) {
+      word |= (uint64_t)OperatorTest<OP>::test(*attr, value) << i;
+    }
+
+    bitmap[first >> 6] = word;
+  }
+}
+
+__attribute__((target("sse4.2"))) static void stringEqualsSSE(const Attribute *records, int numSlots, int numAttrs,
+                                                              int attrOffset, const char *value, int cmpBytes,
+                                                              uint64_t *bitmap) {
+  const Attribute *attr = records + attrOffset;
+  __m128i valueVec = _mm_loadu_si128((const __m128i *)value);
+  int byteMask = cmpBytes == ATTR_SIZE ? 0xFFFF : (1 << cmpBytes) - 1;
+
+  for (int first = 0; first < numSlots; first += 64) {
+    int count = numSlots - first < 64 ? numSlots - first : 64;
+    uint64_t word = 0;
+    for (int i = 0; i < count; i++, attr += numAttrs) {
+      __m128i attrVec = _mm_loadu_si128((const __m128i *)attr->sVal);
+      int equalBytes = _mm_movemask_epi8(_mm_cmpeq_epi8(attrVec, valueVec));
+      word |= (uint64_t)((equalBytes & byteMask) == byteMask) << i;
+    }
+    bitmap[first >> 6] = word;
+  }
+}
+
+/************ AVX2 kernels (4 numbers / 2 strings per compare) ************/
+
+template <int OP>
+__attribute__((target("avx2"))) static inline __m256d compareNumbersAVX(__m256d attrVals, __m256d value) {
+  switch (OP) {
+    case EQ: return _mm256_cmp_pd(attrVals, value, _CMP_EQ_OQ);
+    case LT: return _mm256_cmp_pd(attrVals, value, _CMP_LT_OQ);
+    case LE: return _mm256_cmp_pd(attrVals, value, _CMP_LE_OQ);
+    case GT: return _mm256_cmp_pd(attrVals, value, _CMP_GT_OQ);
+    case GE: return _mm256_cmp_pd(attrVals, value, _CMP_GE_OQ);
+    default: return _mm256_cmp_pd(attrVals, value, _CMP_NEQ_UQ);
+  }
+}
+
+template <int OP>
+__attribute__((target("avx2"))) static void numberKernelAVX(const Attribute *records, int numSlots, int numAttrs,
+                                                             int attrOffset, double value, uint64_t *bitmap) {
+  const double *attr = &records[attrOffset].nVal;
+  const long long stride = numAttrs * (ATTR_SIZE / sizeof(double));
+  __m256i gatherIndex = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+  __m256d valueVec = _mm256_set1_pd(value);
+
+  for (int first = 0; first < numSlots; first += 64) {
+    int count = numSlots - first < 64 ? numSlots - first : 64;
+    uint64_t word = 0;
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4, attr += 4 * stride) {
+      __m256d attrVals = _mm256_i64gather_pd(attr, gatherIndex, sizeof(double));
+      word |= (uint64_t)_mm256_movemask_pd(compareNumbersAVX<OP>(attrVals, valueVec)) << i;
+    }
+    for (; i < count; i++, attr += stride) {
+      word |= (uint64_t)OperatorTest<OP>::test(*attr, value) << i;
+    }
+
+    bitmap[first >> 6] = word;
+  }
+}
+
+__attribute__((target("avx2"))) static void stringEqualsAVX(const Attribute *records, int numSlots, int numAttrs,
+                                                            int attrOffset, const char *value, int cmpBytes,
+                                                            uint64_t *bitmap) {
+  const Attribute *attr = records + attrOffset;
+  __m128i value128 = _mm_loadu_si128((const __m128i *)value);
+  __m256i valueVec = _mm256_inserti128_si256(_mm256_castsi128_si256(value128), value128, 1);
+  uint32_t byteMask = cmpBytes == ATTR_SIZE ? 0xFFFF : (1u << cmpBytes) - 1;
+
+  for (int first = 0; first < numSlots; first += 64) {
+    int count = numSlots - first < 64 ? numSlots - first : 64;
+    uint64_t word = 0;
+
+    int i = 0;
+    for (; i + 2 <= count; i += 2, attr += 2 * numAttrs) {
+      __m256i attrVec = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)attr->sVal)),
+          _mm_loadu_si128((const __m128i *)(attr + numAttrs)->sVal), 1);
+      uint32_t equalBytes = _mm256_movemask_epi8(_mm256_cmpeq_epi8(attrVec, valueVec));
+
+      uint64_t pair = ((equalBytes & byteMask) == byteMask) | ((((equalBytes >> 16) & byteMask) == byteMask) << 1);
+      word |= pair << i;
+    }
+    for (; i < count; i++, attr += numAttrs) {
+      word |= (uint64_t)(memcmp(attr->sVal, value, cmpBytes) == 0) << i;
+    }
+
+    bitmap[first >> 6] = word;
+  }
+}
+
+/************ Dispatch ************/
+
+typedef void (*NumberKernel)(const Attribute *, int, int, int, double, uint64_t *);
+
+// kernels for EQ, LE, LT, GE, GT, NE (in the order of ConditionalOperators) at every level
+static const NumberKernel numberKernels[3][6] = {
+    {numberKernelScalar<EQ>, numberKernelScalar<LE>, numberKernelScalar<LT>,
+     numberKernelScalar<GE>, numberKernelScalar<GT>, numberKernelScalar<NE>},
+    {numberKernelSSE<EQ>, numberKernelSSE<LE>, numberKernelSSE<LT>,
+     numberKernelSSE<GE>, numberKernelSSE<GT>, numberKernelSSE<NE>},
+    {numberKernelAVX<EQ>, numberKernelAVX<LE>, numberKernelAVX<LT>,
+     numberKernelAVX<GE>, numberKernelAVX<GT>, numberKernelAVX<NE>},
+};
+
+typedef void (*StringKernel)(const Attribute *, int, int, int, const char *, int, uint64_t *);
+
+static const StringKernel stringEqualsKernels[3] = {stringEqualsScalar, stringEqualsSSE, stringEqualsAVX};
+
+typedef void (*StringCompareKernel)(const Attribute *, int, int, int, Attribute, uint64_t *);
+
+static const StringCompareKernel stringCompareKernels[6] = {
+    stringCompareScalar<EQ>, stringCompareScalar<LE>, stringCompareScalar<LT>,
+    stringCompareScalar<GE>, stringCompareScalar<GT>, stringCompareScalar<NE>};
+
+// the widest kernels supported by the CPU (checked using CPUID)
+int PredicateKernels::getSupportedLevel() {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return KERNEL_AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return KERNEL_SSE42;
+  }
+  return KERNEL_SCALAR;
+}
+
+int PredicateKernels::getLevel() {
+  if (level == -1) {
+    level = getSupportedLevel();
+  }
+  return level;
+}
+
+// Used to force the kernels of a level (for benchmarks). Fails if the CPU does not support it.
+int PredicateKernels::setLevel(int newLevel) {
+  if (newLevel < KERNEL_SCALAR || newLevel > getSupportedLevel()) {
+    return E_NOTPERMITTED;
+  }
+  level = newLevel;
+  return SUCCESS;
+}
+
+const char *PredicateKernels::getLevelName(int kernelLevel) {
+  switch (kernelLevel) {
+    case KERNEL_AVX2: return "avx2";
+    case KERNEL_SSE42: return "sse4.2";
+    default: return "scalar";
+  }
+}
+
+void PredicateKernels::select(const Attribute *records, int numSlots, int numAttrs, int attrOffset, int attrType,
+                              Attribute value, int op, uint64_t bitmap[SELECTION_BITMAP_WORDS]) {
+  memset(bitmap, 0, SELECTION_BITMAP_WORDS * sizeof(uint64_t));
+
+  int kernelLevel = getLevel();
+
+  if (attrType == NUMBER) {
+    numberKernels[kernelLevel][op](records, numSlots, numAttrs, attrOffset, value.nVal, bitmap);
+    return;
+  }
+
+  if (op != EQ && op != NE) {
+    stringCompareKernels[op](records, numSlots, numAttrs, attrOffset, value, bitmap);
+    return;
+  }
+
+  // (the bytes of the value after its terminating null character are zeroed,
+  //  so the vector kernels can load all ATTR_SIZE bytes of it)
+  char valueBytes[ATTR_SIZE] = {0};
+  int length = strnlen(value.sVal, ATTR_SIZE);
+  memcpy(valueBytes, value.sVal, length);
+  int cmpBytes = length < ATTR_SIZE ? length + 1 : ATTR_SIZE;
+
+  stringEqualsKernels[kernelLevel](records, numSlots, numAttrs, attrOffset, valueBytes, cmpBytes, bitmap);
+
+  // (a record is not equal to the value iff it is not selected by EQ)
+  if (op == NE) {
+    for (int word = 0; word < SELECTION_BITMAP_WORDS; word++) {
+      bitmap[word] = ~bitmap[word];
+    }
+  }
+}
+
+/*
+Micro-benchmark of the kernels of every level supported by the CPU, on blocks of
+relations with 1 and 3 attributes (run using FUNCTION bench_kernels).
+*/
+void PredicateKernels::benchmark() {
+  const int iterations = 200000;
+  const char *opNames[] = {"=", "<=", "<", ">=", ">", "!="};
+  int supportedLevel = getSupportedLevel();
+  int savedLevel = getLevel();
+
+  for (int numAttrs = 1; numAttrs <= 3; numAttrs += 2) {
+    int numSlots = (BLOCK_SIZE - HEADER_SIZE) / (ATTR_SIZE * numAttrs + 1);
+    Attribute records[numSlots * numAttrs];
+
+    // a block of pseudo random numbers in [0, 1000) and strings of 4 letters
+    uint32_t seed = 12345;
+    for (int i = 0; i < numSlots * numAttrs; i++) {
+      seed = seed * 1103515245 + 12345;
+      if (i % numAttrs == 0) {
+        records[i].nVal = (seed >> 8) % 1000;
+      } else {
+        memset(records[i].sVal, 0, ATTR_SIZE);
+        for (int j = 0; j < 4; j++) {
+          records[i].sVal[j] = 'a' + (seed >> (8 + 3 * j)) % 4;
+        }
+      }
+    }
+
+    printf("Relation with %d attribute(s), %d records per block (ns per record)\n", numAttrs, numSlots);
+    printf("%-12s", "condition");
+    for (int l = KERNEL_SCALAR; l <= supportedLevel; l++) {
+      printf("%10s", getLevelName(l));
+    }
+    printf("\n");
+
+    for (int op = EQ; op <= NE + 1; op++) {
+      // (the last row is string equality, on the second attribute)
+      bool isString = op == NE + 1;
+      if (isString && numAttrs == 1) {
+        continue;
+      }
+
+      Attribute value;
+      if (isString) {
+        memset(value.sVal, 0, ATTR_SIZE);
+        strcpy(value.sVal, "abca");
+      } else {
+        value.nVal = 500;
+      }
+
+      char condition[16];
+      snprintf(condition, sizeof(condition), isString ? "str =" : "num %s", isString ? "" : opNames[op]);
+      printf("%-12s", condition);
+
+      for (int l = KERNEL_SCALAR; l <= supportedLevel; l++) {
+        level = l;
+        uint64_t bitmap[SELECTION_BITMAP_WORDS];
+        uint64_t checksum = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int it = 0; it < iterations; it++) {
+          select(records, numSlots, numAttrs, isString ? 1 : 0, isString ? STRING : NUMBER, value,
+                 isString ? EQ : op, bitmap);
+          checksum += bitmap[0];
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+        printf("%10.3f", nanoseconds / ((double)iterations * numSlots));
+
+        // (keeps the compiler from dropping the loop)
+        if (checksum == 1) {
+          printf("*");
+        }
+      }
+      printf("\n");
+    }
+    printf("\n");
+  }
+
+  level = savedLevel;
+}
@@ -0,0 +1,31 @@
+#ifndef NITCBASE_PREDICATEKERNELS_H
+#define NITCBASE_PREDICATEKERNELS_H
+
+#include <cstdint>
+
+#include "../Buffer/BlockBuffer.h"
+#include "../define/constants.h"
+
+/*
+Kernels that evaluate a condition `attribute op value` on all the records of a
+block and produce a selection bitmap (bit i of the bitmap is set if the record
+at slot i satisfies the condition, whether the slot is occupied or not).
+The widest implementation supported by the CPU is chosen at runtime.
+*/
+class PredicateKernels {
+ public:
+  static void select(const Attribute *records, int numSlots, int numAttrs, int attrOffset,
+                     int attrType, Attribute value, int op, uint64_t bitmap[SELECTION_BITMAP_WORDS]);
+
+  static int getLevel();
+  static int setLevel(int level);
+  static const char *getLevelName(int level);
+
+  static void benchmark();
+
+ private:
+  static int level;
+  static int getSupportedLevel();
+};
+
+#endif  // NITCBASE_PREDICATEKERNELS_H
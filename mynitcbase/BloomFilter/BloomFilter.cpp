@@ -0,0 +1,278 @@
+#include "BloomFilter.h"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+/*
+Computes the block of the filter (blockIndex, an index into the block numbers
+stored in the head block) and the BLOOM_NUM_HASHES bits in that block that
+represent attrVal. All the bits of a value are in one block, so that inserting
+or looking up a value touches only one block of the filter.
+*/
+void BloomFilter::getBitNums(Attribute attrVal, int attrType, int numBlocks, int *blockIndex, int bitNums[BLOOM_NUM_HASHES]) {
+    // (the bits of the hash depend on every byte of the value)
+    uint64_t hash = hashAttr(attrVal, attrType);
+
+    // the block is chosen by the low bits, the bits in the block are chosen by
+    // double hashing on the high bits
+    *blockIndex = (int)((hash & 0xffff) % numBlocks);
+
+    uint32_t h1 = (uint32_t)(hash >> 16);
+    uint32_t h2 = (uint32_t)(hash >> 40) | 1;
+    for (int i = 0; i < BLOOM_NUM_HASHES; i++) {
+        bitNums[i] = (int)((h1 + i * h2) % BLOOM_BLOCK_BITS);
+    }
+}
+
+int BloomFilter::bloomCreate(int relId, char attrName[ATTR_SIZE]) {
+
+    // (the catalogs are always searched in full)
+    if (relId == RELCAT_RELID || relId == ATTRCAT_RELID || relId == INDEXCAT_RELID) {
+        return E_NOTPERMITTED;
+    }
+
+    // get the attribute catalog entry of attribute `attrName`
+    // using AttrCacheTable::getAttrCatEntry()
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    // a filter already exists for the attribute
+    if (attrCatEntry.bloomBlock != -1) {
+        return SUCCESS;
+    }
+
+    RelCatEntry relCatEntry;
+    response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    /* size the filter for the records currently in the relation, with at least
+       BLOOM_BITS_PER_KEY bits per key (the filter has to be rebuilt to be resized) */
+    int numKeys = relCatEntry.numRecs > BLOOM_MIN_KEYS ? relCatEntry.numRecs : BLOOM_MIN_KEYS;
+    int numBlocks = (numKeys * BLOOM_BITS_PER_KEY + BLOOM_BLOCK_BITS - 1) / BLOOM_BLOCK_BITS;
+    if (numBlocks > BLOOM_MAX_BLOCKS) {
+        numBlocks = BLOOM_MAX_BLOCKS;
+    }
+
+    // get a free block for the head block of the filter
+    BloomBuffer headBuffer;
+    int headBlock = headBuffer.getBlockNum();
+    if (headBlock == E_DISKFULL) {
+        return E_DISKFULL;
+    }
+
+    // get free blocks for the bit arrays and clear them
+    int32_t blockNums[numBlocks];
+    for (int i = 0; i < numBlocks; i++) {
+        BloomBuffer bitBuffer;
+        blockNums[i] = bitBuffer.getBlockNum();
+
+        // if there is no more disk space, release the blocks allocated so far
+        if (blockNums[i] == E_DISKFULL) {
+            for (int j = 0; j < i; j++) {
+                BloomBuffer allocatedBuffer(blockNums[j]);
+                allocatedBuffer.releaseBlock();
+            }
+            headBuffer.releaseBlock();
+            return E_DISKFULL;
+        }
+
+        HeadInfo bitHead;
+        bitBuffer.getHeader(&bitHead);
+        bitHead.pblock = headBlock;
+        bitBuffer.setHeader(&bitHead);
+        bitBuffer.clearBits();
+    }
+
+    /* the head block stores the number of keys inserted (numEntries), the
+       number of bits set per key (numAttrs), the number of bit array blocks
+       (numSlots) and their block numbers */
+    HeadInfo head;
+    headBuffer.getHeader(&head);
+    head.numEntries = 0;
+    head.numAttrs = BLOOM_NUM_HASHES;
+    head.numSlots = numBlocks;
+    headBuffer.setHeader(&head);
+    headBuffer.setBlockNums(blockNums, numBlocks);
+
+    // update the bloomBlock field of the attribute cache entry
+    attrCatEntry.bloomBlock = headBlock;
+    response = AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    /***** Traverse all the blocks in the relation and insert every value into the filter *****/
+    int block = relCatEntry.firstBlk;
+    while (block != -1) {
+        RecBuffer recBuffer(block);
+
+        HeadInfo recHead;
+        recBuffer.getHeader(&recHead);
+
+        unsigned char slotMap[recHead.numSlots];
+        recBuffer.getSlotMap(slotMap);
+
+        for (int slot = 0; slot < recHead.numSlots; slot++) {
+            if (slotMap[slot] == SLOT_UNOCCUPIED) {
+                continue;
+            }
+
+            Attribute record[relCatEntry.numAttrs];
+            recBuffer.getRecord(record, slot);
+
+            response = BloomFilter::bloomInsert(relId, attrName, record[attrCatEntry.offset]);
+            if (response != SUCCESS) {
+                return response;
+            }
+        }
+
+        block = recHead.rblock;
+    }
+
+    return SUCCESS;
+}
+
+int BloomFilter::bloomInsert(int relId, char attrName[ATTR_SIZE], Attribute attrVal) {
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    // the attribute does not have a filter
+    if (attrCatEntry.bloomBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    BloomBuffer headBuffer(attrCatEntry.bloomBlock);
+    HeadInfo head;
+    headBuffer.getHeader(&head);
+
+    // find the block and the bits representing the value and set them
+    int blockIndex, bitNums[BLOOM_NUM_HASHES];
+    BloomFilter::getBitNums(attrVal, attrCatEntry.attrType, head.numSlots, &blockIndex, bitNums);
+
+    int32_t bitBlock;
+    headBuffer.getBlockNums(&bitBlock, blockIndex, 1);
+
+    BloomBuffer bitBuffer(bitBlock);
+    response = bitBuffer.setBits(bitNums, BLOOM_NUM_HASHES);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    // increment the number of keys inserted into the filter
+    head.numEntries++;
+    return headBuffer.setHeader(&head);
+}
+
+/*
+Returns SUCCESS if attrVal may be present in the attribute of the relation,
+E_NOTFOUND if it is definitely not present and E_NOINDEX if the attribute does
+not have a filter.
+*/
+int BloomFilter::bloomSearch(int relId, char attrName[ATTR_SIZE], Attribute attrVal) {
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    if (attrCatEntry.bloomBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    BloomBuffer headBuffer(attrCatEntry.bloomBlock);
+    HeadInfo head;
+    headBuffer.getHeader(&head);
+
+    int blockIndex, bitNums[BLOOM_NUM_HASHES];
+    BloomFilter::getBitNums(attrVal, attrCatEntry.attrType, head.numSlots, &blockIndex, bitNums);
+
+    int32_t bitBlock;
+    headBuffer.getBlockNums(&bitBlock, blockIndex, 1);
+
+    // (if any of the bits is not set, the value was never inserted)
+    BloomBuffer bitBuffer(bitBlock);
+    if (!bitBuffer.testBits(bitNums, BLOOM_NUM_HASHES)) {
+        return E_NOTFOUND;
+    }
+
+    return SUCCESS;
+}
+
+int BloomFilter::bloomDestroy(int headBlockNum) {
+    /*headBlockNum lies outside the valid range [0,DISK_BLOCKS-1]*/
+    if (headBlockNum < 0 || headBlockNum >= DISK_BLOCKS) {
+        return E_OUTOFBOUND;
+    }
+
+    if (StaticBuffer::getStaticBlockType(headBlockNum) != BLOOM_FILTER) {
+        return E_INVALIDBLOCK;
+    }
+
+    BloomBuffer headBuffer(headBlockNum);
+    HeadInfo head;
+    headBuffer.getHeader(&head);
+
+    // release the bit array blocks and then the head block
+    int32_t blockNums[head.numSlots];
+    headBuffer.getBlockNums(blockNums, 0, head.numSlots);
+    for (int i = 0; i < head.numSlots; i++) {
+        BloomBuffer bitBuffer(blockNums[i]);
+        bitBuffer.releaseBlock();
+    }
+
+    headBuffer.releaseBlock();
+
+    return SUCCESS;
+}
+
+/*
+Fills `info` with the size of the filter rooted at headBlockNum and its
+false positive rate, estimated from the fraction of bits set in every block
+(a lookup of an absent value in a block with fraction f of its bits set is a
+false positive with probability f^BLOOM_NUM_HASHES).
+*/
+int BloomFilter::bloomInfo(int headBlockNum, BloomFilterInfo *info) {
+    if (headBlockNum < 0 || headBlockNum >= DISK_BLOCKS) {
+        return E_OUTOFBOUND;
+    }
+
+    if (StaticBuffer::getStaticBlockType(headBlockNum) != BLOOM_FILTER) {
+        return E_INVALIDBLOCK;
+    }
+
+    BloomBuffer headBuffer(headBlockNum);
+    HeadInfo head;
+    headBuffer.getHeader(&head);
+
+    int32_t blockNums[head.numSlots];
+    headBuffer.getBlockNums(blockNums, 0, head.numSlots);
+
+    info->numBlocks = head.numSlots;
+    info->numBits = head.numSlots * BLOOM_BLOCK_BITS;
+    info->numHashes = head.numAttrs;
+    info->numKeys = head.numEntries;
+    info->numSetBits = 0;
+    info->falsePositiveRate = 0;
+
+    for (int i = 0; i < head.numSlots; i++) {
+        BloomBuffer bitBuffer(blockNums[i]);
+        int setBitsCount = bitBuffer.countBits();
+
+        info->numSetBits += setBitsCount;
+        // (every block is equally likely to be chosen for a value)
+        info->falsePositiveRate += pow((double)setBitsCount / BLOOM_BLOCK_BITS, head.numAttrs) / head.numSlots;
+    }
+
+    return SUCCESS;
+}
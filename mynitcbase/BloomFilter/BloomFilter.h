@@ -0,0 +1,32 @@
+#ifndef NITCBASE_BLOOMFILTER_H
+#define NITCBASE_BLOOMFILTER_H
+
+#include "../Buffer/BlockBuffer.h"
+#include "../Buffer/StaticBuffer.h"
+#include "../Cache/AttrCacheTable.h"
+#include "../Cache/RelCacheTable.h"
+#include "../define/constants.h"
+#include "../define/id.h"
+
+typedef struct BloomFilterInfo {
+  int numBlocks;             // number of bit array blocks
+  int numBits;               // total number of bits
+  int numHashes;             // number of bits set per key
+  int numKeys;               // number of keys inserted
+  int numSetBits;            // number of bits that are set
+  double falsePositiveRate;  // estimated from the number of bits set in every block
+} BloomFilterInfo;
+
+class BloomFilter {
+ private:
+  static void getBitNums(Attribute attrVal, int attrType, int numBlocks, int *blockIndex, int bitNums[BLOOM_NUM_HASHES]);
+
+ public:
+  static int bloomCreate(int relId, char attrName[ATTR_SIZE]);
+  static int bloomInsert(int relId, char attrName[ATTR_SIZE], union Attribute attrVal);
+  static int bloomSearch(int relId, char attrName[ATTR_SIZE], union Attribute attrVal);
+  static int bloomDestroy(int headBlockNum);
+  static int bloomInfo(int headBlockNum, BloomFilterInfo *info);
+};
+
+#endif  // NITCBASE_BLOOMFILTER_H
@@ -1,5 +1,9 @@
 #include "BlockBuffer.h"
 
+#include "BlockLatch.h"
+#include "NodeCache.h"
+
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
@@ -22,6 +26,24 @@ BlockBuffer::BlockBuffer(char blockType){
     else if(blockType=='L'){
         blockTypeInt = IND_LEAF;
     }
+    else if(blockType=='Z'){
+        blockTypeInt = ZONE_MAP;
+    }
+    else if(blockType=='B'){
+        blockTypeInt = BLOOM_FILTER;
+    }
+    else if(blockType=='S'){
+        blockTypeInt = SORT_RUN;
+    }
+    else if(blockType=='H'){
+        blockTypeInt = HASH_INDEX;
+    }
+    else if(blockType=='M'){
+        blockTypeInt = BITMAP_INDEX;
+    }
+    else if(blockType=='T'){
+        blockTypeInt = STATISTICS;
+    }
     else{
         printf("Invalid block type.\n");
         exit(1);
@@ -121,6 +143,32 @@ int RecBuffer::getRecord(union Attribute *rec, int slotNum)
     return SUCCESS;
 }
 
+/*
+Used to get the header, the slot map and all the records (occupied or not) of
+the block with a single load of the block. The record at slot i is stored at
+records + i * head->numAttrs.
+NOTE: this function expects the caller to allocate memory for `slotMap` and
+      `records` (numSlots and numSlots * numAttrs entries of the relation)
+*/
+int RecBuffer::getRecords(struct HeadInfo *head, unsigned char *slotMap, union Attribute *records)
+{
+    unsigned char *bufferPtr;
+    int ret = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+
+    memcpy(head, bufferPtr, sizeof(struct HeadInfo));
+
+    // the slot map follows the header and the records follow the slot map
+    memcpy(slotMap, bufferPtr + HEADER_SIZE, head->numSlots);
+    memcpy(records, bufferPtr + HEADER_SIZE + head->numSlots,
+           head->numSlots * head->numAttrs * ATTR_SIZE);
+
+    return SUCCESS;
+}
+
 int RecBuffer::setRecord(union Attribute *rec, int slotNum) {
     unsigned char *bufferPtr;
     /* get the starting address of the buffer containing the block
@@ -202,6 +250,9 @@ int BlockBuffer::loadBlockAndGetBufferPtr(unsigned char **buffPtr)
 
     if (bufferNum == E_BLOCKNOTINBUFFER)
     {
+        // (readers in other threads look for blocks in the buffer; see StaticBuffer::readBlock())
+        std::lock_guard<std::mutex> guard(StaticBuffer::bufferMutex);
+
         // get a free buffer using StaticBuffer.getFreeBuffer()
 
         bufferNum = StaticBuffer::getFreeBuffer(this->blockNum);
@@ -279,6 +330,11 @@ int compareAttrs(union Attribute attr1, union Attribute attr2, int attrType)
     {
         diff = strcmp(attr1.sVal, attr2.sVal);
     }
+    else if (attrType == COMPOSITE)
+    {
+        // (composite index keys are byte strings; all ATTR_SIZE bytes are compared)
+        diff = memcmp(attr1.sVal, attr2.sVal, ATTR_SIZE);
+    }
     else
     {
         diff = attr1.nVal - attr2.nVal;
@@ -303,6 +359,43 @@ int compareAttrs(union Attribute attr1, union Attribute attr2, int attrType)
     }
 }
 
+/*
+Returns a 64 bit hash of the value, equal for values that compareAttrs() finds
+equal (FNV-1a over the significant bytes, mixed by the splitmix64 finaliser so
+that every bit depends on every byte)
+*/
+uint64_t hashAttr(union Attribute attrVal, int attrType)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    if (attrType == NUMBER)
+    {
+        // (0.0 and -0.0 are equal values, hash them alike)
+        double value = attrVal.nVal == 0 ? 0 : attrVal.nVal;
+        unsigned char bytes[sizeof(double)];
+        memcpy(bytes, &value, sizeof(double));
+        for (int i = 0; i < (int)sizeof(double); i++)
+        {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+    }
+    else
+    {
+        // (only the bytes up to the terminating null character are significant)
+        for (int i = 0; i < ATTR_SIZE && attrVal.sVal[i] != '\0'; i++)
+        {
+            hash = (hash ^ (unsigned char)attrVal.sVal[i]) * 1099511628211ULL;
+        }
+    }
+
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+
+    return hash;
+}
+
 int BlockBuffer::setHeader(struct HeadInfo *head){
 
     unsigned char *bufferPtr;
@@ -316,6 +409,9 @@ int BlockBuffer::setHeader(struct HeadInfo *head){
         return response;
     }
 
+    // latch the block for the write in progress, if any (see BlockLatch)
+    BlockLatch::latch(this->blockNum);
+
 
     // cast bufferPtr to type HeadInfo*
     struct HeadInfo *bufferHeader = (struct HeadInfo *)bufferPtr;
@@ -382,8 +478,10 @@ int BlockBuffer::getFreeBlock(int blockType){
 
     // iterate through the StaticBuffer::blockAllocMap and find the block number
     // of a free block in the disk.
+    // (from StaticBuffer::allocationStart, see StaticBuffer::setAllocationStart())
     int freeBlock = -1;
-    for (int blockNum = 0; blockNum < DISK_BLOCKS; blockNum++){
+    for (int i = 0; i < DISK_BLOCKS; i++){
+        int blockNum = (StaticBuffer::allocationStart + i) % DISK_BLOCKS;
         int blockTypeInMap = (int32_t) StaticBuffer::blockAllocMap[blockNum];
         if (blockTypeInMap == UNUSED_BLK){
             freeBlock = blockNum;
@@ -400,7 +498,11 @@ int BlockBuffer::getFreeBlock(int blockType){
     this->blockNum = freeBlock;
 
     // find a free buffer using StaticBuffer::getFreeBuffer() .
-    int bufferNum = StaticBuffer::getFreeBuffer(freeBlock);
+    // (readers in other threads look for blocks in the buffer; see StaticBuffer::readBlock())
+    {
+        std::lock_guard<std::mutex> guard(StaticBuffer::bufferMutex);
+        StaticBuffer::getFreeBuffer(freeBlock);
+    }
 
     // initialize the header of the block passing a struct HeadInfo with values
     // pblock: -1, lblock: -1, rblock: -1, numEntries: 0, numAttrs: 0, numSlots: 0
@@ -488,6 +590,9 @@ void BlockBuffer::releaseBlock(){
     }
 
     // else
+        // (readers in other threads holding the block number see that the block changed)
+        BlockLatch::latch(this->blockNum);
+
         /* get the buffer number of the buffer assigned to the block
            using StaticBuffer::getBufferNum().
            (this function return E_BLOCKNOTINBUFFER if the block is not
@@ -500,9 +605,13 @@ void BlockBuffer::releaseBlock(){
         // by setting the free flag of its StaticBuffer::tableMetaInfo entry
         // to true.
         if (bufferNum != E_BLOCKNOTINBUFFER){
+            std::lock_guard<std::mutex> guard(StaticBuffer::bufferMutex);
             StaticBuffer::metainfo[bufferNum].free = true;
         }
 
+        // drop the block from the index node cache (if it is an internal node held there)
+        NodeCache::invalidate(this->blockNum);
+
         // free the block in disk by setting the data type of the entry
         // corresponding to the block number in StaticBuffer::blockAllocMap
         // to UNUSED_BLK.
@@ -525,132 +634,434 @@ IndInternal::IndInternal() : IndBuffer('I'){}
 // call the corresponding parent constructor
 IndInternal::IndInternal(int blockNum) : IndBuffer(blockNum){}
 
-// this is the way to call parent non-default constructor.
-// 'L' used to denote IndLeaf.
-IndLeaf::IndLeaf() : IndBuffer('L'){} 
+// method of the searches of the keys of index blocks (see IndBuffer::setSearchMethod())
+static int searchMethod = NODE_SEARCH_INTERPOLATION;
 
-//this is the way to call parent non-default constructor.
-IndLeaf::IndLeaf(int blockNum) : IndBuffer(blockNum){}
+/*
+Sets the method used to search the keys of the (plain format) index blocks:
+NODE_SEARCH_LINEAR, NODE_SEARCH_BINARY, or NODE_SEARCH_INTERPOLATION (which is
+the binary search for keys other than NUMBER). All find the same entry; they
+are compared by FUNCTION bench_keysearch.
+*/
+int IndBuffer::setSearchMethod(int method) {
+    if (method < NODE_SEARCH_LINEAR || method > NODE_SEARCH_INTERPOLATION) {
+        return E_INVALID;
+    }
+    searchMethod = method;
+    return SUCCESS;
+}
 
-int IndInternal::getEntry(void *ptr, int indexNum) {
-    // if the indexNum is not in the valid range of [0, MAX_KEYS_INTERNAL-1]
-    //     return E_OUTOFBOUND.
-    if (indexNum < 0 || indexNum >= MAX_KEYS_INTERNAL){
+int IndBuffer::getSearchMethod() {
+    return searchMethod;
+}
+
+/*
+Interpolation search over the sorted NUMBER keys of an index block (see
+searchKeys()). The keys of an index on IDs or timestamps are close to evenly
+spread between the first and the last key of a block, so the position of val
+is predicted from them; the prediction is then corrected by a search that
+doubles its step away from the predicted position until the answer is
+bracketed, followed by a binary search of the bracket (i.e. a search bounded
+by the logarithm of the error of the prediction rather than of numEntries).
+*/
+static int interpolateKeys(unsigned char *bufferPtr, int keyOffset, int entrySize, double val, bool strict) {
+    int numEntries = ((struct HeadInfo *)bufferPtr)->numEntries;
+    if (numEntries == 0) {
+        return 0;
+    }
+
+    // (keys are not aligned in the block; copy them out)
+    auto keyAt = [&](int i) {
+        double key;
+        memcpy(&key, bufferPtr + keyOffset + i * entrySize, sizeof(double));
+        return key;
+    };
+    // (true for the key at the answer and every key after it)
+    auto reached = [&](int i) {
+        double key = keyAt(i);
+        return key > val || (key == val && !strict);
+    };
+
+    double first = keyAt(0), last = keyAt(numEntries - 1);
+    if (!reached(numEntries - 1)) {
+        return numEntries;
+    }
+    if (reached(0)) {
+        return 0;
+    }
+
+    // (the answer is in (0, numEntries - 1], and first < val <= last)
+    int predicted = (int)((val - first) / (last - first) * (numEntries - 1));
+    predicted = std::max(1, std::min(predicted, numEntries - 1));
+
+    // bracket the answer in [low, high], with reached(high) and !reached(low - 1)
+    int low, high;
+    if (reached(predicted)) {
+        high = predicted;
+        int step = 1;
+        low = predicted - step;
+        while (low > 0 && reached(low)) {
+            high = low;
+            step *= 2;
+            low = predicted - step;
+        }
+        low = std::max(low + 1, 1);
+    } else {
+        low = predicted + 1;
+        int step = 1;
+        high = predicted + step;
+        while (high < numEntries - 1 && !reached(high)) {
+            low = high + 1;
+            step *= 2;
+            high = predicted + step;
+        }
+        high = std::min(high, numEntries - 1);
+    }
+
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (reached(mid)) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    return low;
+}
+
+/*
+Search over the sorted keys of an index block in the buffer: returns the index
+of the first key >= attrVal (> attrVal if `strict`), or numEntries if there is
+none. The key of the i'th entry is at keyOffset + i * entrySize. The keys are
+searched by the method set with IndBuffer::setSearchMethod().
+*/
+static int searchKeys(unsigned char *bufferPtr, int keyOffset, int entrySize, union Attribute attrVal,
+                      int attrType, bool strict) {
+    int numEntries = ((struct HeadInfo *)bufferPtr)->numEntries;
+
+    if (searchMethod == NODE_SEARCH_INTERPOLATION && attrType == NUMBER) {
+        return interpolateKeys(bufferPtr, keyOffset, entrySize, attrVal.nVal, strict);
+    }
+
+    if (searchMethod == NODE_SEARCH_LINEAR) {
+        for (int i = 0; i < numEntries; i++) {
+            union Attribute key;
+            memcpy(&key, bufferPtr + keyOffset + i * entrySize, ATTR_SIZE);
+
+            int cmpVal = compareAttrs(key, attrVal, attrType);
+            if (cmpVal > 0 || (cmpVal == 0 && !strict)) {
+                return i;
+            }
+        }
+        return numEntries;
+    }
+
+    // (the answer is in [low, high])
+    int low = 0, high = numEntries;
+    while (low < high) {
+        int mid = (low + high) / 2;
+
+        // (keys of internal entries are not aligned; copy them out)
+        union Attribute key;
+        memcpy(&key, bufferPtr + keyOffset + mid * entrySize, ATTR_SIZE);
+
+        int cmpVal = compareAttrs(key, attrVal, attrType);
+        if (cmpVal > 0 || (cmpVal == 0 && !strict)) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    return low;
+}
+
+/*
+A prefix compressed internal index block (format IND_FORMAT_PREFIX, for STRING
+keys) stores the bytes the keys of the block have in common once, and only the
+rest of each key (its suffix, without the padding) after it:
+
+    header | prefix (numAttrs bytes) | offsets[0..n] | child 0 | suffix 0 | child 1 | ... | child n
+
+where n = numEntries. offsets[i] is the offset (from the start of the block) of
+the i'th suffix, whose child (to its left) is in the 4 bytes before it; offsets[n]
+is the end of the entries, so that the i'th suffix ends 4 bytes before offsets[i+1].
+*/
+
+// offset of the i'th entry of the offset table of a prefix compressed block
+static int prefixOffset(unsigned char *bufferPtr, int i) {
+    int prefixLen = ((struct HeadInfo *)bufferPtr)->numAttrs;
+    uint16_t offset;
+    memcpy(&offset, bufferPtr + HEADER_SIZE + prefixLen + i * sizeof(uint16_t), sizeof(uint16_t));
+    return offset;
+}
+
+// compares two byte strings (a shorter string is smaller than the longer ones it begins)
+static int compareBytes(const unsigned char *a, int aLen, const unsigned char *b, int bLen) {
+    int cmpVal = memcmp(a, b, std::min(aLen, bLen));
+    if (cmpVal != 0) {
+        return cmpVal;
+    }
+    return aLen - bLen;
+}
+
+/*
+searchKeys() for a prefix compressed block: the prefix is compared with attrVal
+once, and only the suffixes of the keys in the binary search.
+*/
+static int searchPrefixKeys(unsigned char *bufferPtr, union Attribute attrVal, bool strict) {
+    int numEntries = ((struct HeadInfo *)bufferPtr)->numEntries;
+    int prefixLen = ((struct HeadInfo *)bufferPtr)->numAttrs;
+
+    const unsigned char *val = (const unsigned char *)attrVal.sVal;
+    int valLen = strnlen(attrVal.sVal, ATTR_SIZE);
+
+    // (a value that does not begin with the prefix is smaller, or larger, than every key)
+    int cmpVal = compareBytes(val, std::min(valLen, prefixLen), bufferPtr + HEADER_SIZE, prefixLen);
+    if (cmpVal < 0) {
+        return 0;
+    }
+    if (cmpVal > 0) {
+        return numEntries;
+    }
+
+    int low = 0, high = numEntries;
+    while (low < high) {
+        int mid = (low + high) / 2;
+
+        int suffixOffset = prefixOffset(bufferPtr, mid);
+        int suffixLen = prefixOffset(bufferPtr, mid + 1) - sizeof(int32_t) - suffixOffset;
+
+        cmpVal = compareBytes(bufferPtr + suffixOffset, suffixLen, val + prefixLen, valLen - prefixLen);
+        if (cmpVal > 0 || (cmpVal == 0 && !strict)) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    return low;
+}
+
+/*
+Returns the block number of the childNum'th child of the block (the lChild of the
+childNum'th entry, or the rChild of the last entry if childNum = numEntries)
+*/
+int IndInternal::getChild(int childNum) {
+    if (childNum < 0 || childNum > MAX_KEYS_INTERNAL_PREFIX){
         return E_OUTOFBOUND;
     }
 
     unsigned char *bufferPtr;
-    /* get the starting address of the buffer containing the block
-       using loadBlockAndGetBufferPtr(&bufferPtr). */
     int response = loadBlockAndGetBufferPtr(&bufferPtr);
-
-    // if loadBlockAndGetBufferPtr(&bufferPtr) != SUCCESS
-    //     return the value returned by the call.
     if (response != SUCCESS){
         return response;
     }
 
-    // typecast the void pointer to an internal entry pointer
-    struct InternalEntry *internalEntry = (struct InternalEntry *)ptr;
+    return getBlockChild(bufferPtr, childNum);
+}
 
-    /*
-    - copy the entries from the indexNum`th entry to *internalEntry
-    - make sure that each field is copied individually as in the following code
-    - the lChild and rChild fields of InternalEntry are of type int32_t
-    - int32_t is a type of int that is guaranteed to be 4 bytes across every
-      C++ implementation. sizeof(int32_t) = 4
-    */
+/*
+getChild() for a copy of the block (see StaticBuffer::readBlock()), also used by getChild()
+*/
+int IndInternal::getBlockChild(unsigned char *bufferPtr, int childNum) {
+    if (childNum < 0 || childNum > MAX_KEYS_INTERNAL_PREFIX){
+        return E_OUTOFBOUND;
+    }
 
+    struct HeadInfo *head = (struct HeadInfo *)bufferPtr;
 
+    int32_t child;
+    if (head->numSlots == IND_FORMAT_PREFIX) {
+        if (childNum > head->numEntries) {
+            return E_OUTOFBOUND;
+        }
+        // (the child is in the 4 bytes before the suffix)
+        memcpy(&child, bufferPtr + prefixOffset(bufferPtr, childNum) - sizeof(int32_t), sizeof(int32_t));
+        return child;
+    }
 
-    /* the indexNum'th entry will begin at an offset of
-       HEADER_SIZE + (indexNum * (sizeof(int) + ATTR_SIZE) )         [why?]
-       from bufferPtr */
-    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + (indexNum * 20);
+    if (childNum > MAX_KEYS_INTERNAL) {
+        return E_OUTOFBOUND;
+    }
 
-    memcpy(&(internalEntry->lChild), entryPtr, sizeof(int32_t));
-    memcpy(&(internalEntry->attrVal), entryPtr + 4, sizeof(Attribute));
-    memcpy(&(internalEntry->rChild), entryPtr + 20, 4);
+    // (the rChild of an entry is the lChild of the next one; children are 20 bytes apart)
+    memcpy(&child, bufferPtr + HEADER_SIZE + childNum * 20, sizeof(int32_t));
+    return child;
+}
 
-    // return SUCCESS.
-    return SUCCESS;
+/*
+Returns the index of the first entry of the block whose attribute value is >=
+attrVal (> attrVal if `strict`), or numEntries if there is none
+*/
+int IndInternal::searchEntries(union Attribute attrVal, int attrType, bool strict) {
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    return searchBlock(bufferPtr, attrVal, attrType, strict);
 }
 
-int IndLeaf::getEntry(void *ptr, int indexNum) {
+// searchEntries() for a copy of the block (see StaticBuffer::readBlock())
+int IndInternal::searchBlock(unsigned char *bufferPtr, union Attribute attrVal, int attrType, bool strict) {
+    if (((struct HeadInfo *)bufferPtr)->numSlots == IND_FORMAT_PREFIX) {
+        return searchPrefixKeys(bufferPtr, attrVal, strict);
+    }
 
-    // if the indexNum is not in the valid range of [0, MAX_KEYS_LEAF-1]
-    //     return E_OUTOFBOUND.
-    if (indexNum < 0 || indexNum >= MAX_KEYS_LEAF){
-        return E_OUTOFBOUND;
+    // (the attribute value of an entry follows its lChild)
+    return searchKeys(bufferPtr, HEADER_SIZE + sizeof(int32_t), 20, attrVal, attrType, strict);
+}
+
+// length of the common prefix of the STRING keys (0 if there are none)
+static int commonPrefixLength(union Attribute keys[], int numKeys) {
+    if (numKeys == 0) {
+        return 0;
+    }
+
+    int prefixLen = strnlen(keys[0].sVal, ATTR_SIZE);
+    for (int i = 1; i < numKeys && prefixLen > 0; i++) {
+        int len = 0;
+        while (len < prefixLen && keys[i].sVal[len] == keys[0].sVal[len]) {
+            len++;
+        }
+        prefixLen = len;
+    }
+    return prefixLen;
+}
+
+/*
+Returns the number of bytes (after the header) an internal index block needs to
+hold the numKeys keys (and numKeys + 1 children). STRING keys are prefix
+compressed; the node fits in a block if this is at most BLOCK_SIZE - HEADER_SIZE.
+*/
+int IndInternal::getNodeSize(union Attribute keys[], int numKeys, int attrType) {
+    if (attrType != STRING) {
+        return sizeof(int32_t) + numKeys * (sizeof(int32_t) + ATTR_SIZE);
     }
 
+    int prefixLen = commonPrefixLength(keys, numKeys);
+
+    int size = prefixLen + (numKeys + 1) * (sizeof(uint16_t) + sizeof(int32_t));
+    for (int i = 0; i < numKeys; i++) {
+        size += strnlen(keys[i].sVal, ATTR_SIZE) - prefixLen;
+    }
+    return size;
+}
+
+/*
+Used to get all the children and keys of the block (in either format).
+Returns the number of keys.
+NOTE: this function expects the caller to allocate memory for MAX_KEYS_INTERNAL_PREFIX
+keys and one more child
+*/
+int IndInternal::getNode(int children[], union Attribute keys[]) {
     unsigned char *bufferPtr;
-    /* get the starting address of the buffer containing the block
-       using loadBlockAndGetBufferPtr(&bufferPtr). */
     int response = loadBlockAndGetBufferPtr(&bufferPtr);
-    
-
-    // if loadBlockAndGetBufferPtr(&bufferPtr) != SUCCESS
-    //     return the value returned by the call.
     if (response != SUCCESS){
         return response;
     }
 
-    // copy the indexNum'th Index entry in buffer to memory ptr using memcpy
+    struct HeadInfo *head = (struct HeadInfo *)bufferPtr;
+    int numKeys = head->numEntries;
 
-    /* the indexNum'th entry will begin at an offset of
-       HEADER_SIZE + (indexNum * LEAF_ENTRY_SIZE)  from bufferPtr */
-    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + (indexNum * LEAF_ENTRY_SIZE);
-    memcpy((struct Index *)ptr, entryPtr, LEAF_ENTRY_SIZE);
+    if (head->numSlots != IND_FORMAT_PREFIX) {
+        for (int i = 0; i < numKeys; i++) {
+            memcpy(&children[i], bufferPtr + HEADER_SIZE + i * 20, sizeof(int32_t));
+            memcpy(&keys[i], bufferPtr + HEADER_SIZE + i * 20 + 4, ATTR_SIZE);
+        }
+        memcpy(&children[numKeys], bufferPtr + HEADER_SIZE + numKeys * 20, sizeof(int32_t));
+        return numKeys;
+    }
 
-    // return SUCCESS
-    return SUCCESS;
-}
+    // every key is the prefix followed by its suffix (padded with zeros)
+    int prefixLen = head->numAttrs;
+    for (int i = 0; i <= numKeys; i++) {
+        int suffixOffset = prefixOffset(bufferPtr, i);
+        memcpy(&children[i], bufferPtr + suffixOffset - sizeof(int32_t), sizeof(int32_t));
+
+        if (i < numKeys) {
+            int suffixLen = prefixOffset(bufferPtr, i + 1) - sizeof(int32_t) - suffixOffset;
+            memset(&keys[i], 0, ATTR_SIZE);
+            memcpy(keys[i].sVal, bufferPtr + HEADER_SIZE, prefixLen);
+            memcpy(keys[i].sVal + prefixLen, bufferPtr + suffixOffset, suffixLen);
+        }
+    }
 
-int IndLeaf::setEntry(void *ptr, int indexNum) {
+    return numKeys;
+}
 
-    // if the indexNum is not in the valid range of [0, MAX_KEYS_LEAF-1]
-    //     return E_OUTOFBOUND.
-    if(indexNum < 0 || indexNum >= MAX_KEYS_LEAF){
+/*
+Used to replace the entries of the block with the numKeys keys and numKeys + 1
+children (the keys of an attribute of type attrType). The entries of a STRING
+attribute are stored prefix compressed, all others in the plain format.
+Returns E_OUTOFBOUND (leaving the block as it is) if they do not fit in the block.
+*/
+int IndInternal::setNode(int children[], union Attribute keys[], int numKeys, int attrType) {
+    if (numKeys < 0 || getNodeSize(keys, numKeys, attrType) > BLOCK_SIZE - HEADER_SIZE) {
         return E_OUTOFBOUND;
     }
 
     unsigned char *bufferPtr;
-    /* get the starting address of the buffer containing the block
-       using loadBlockAndGetBufferPtr(&bufferPtr). */
-
     int response = loadBlockAndGetBufferPtr(&bufferPtr);
-
-    // if loadBlockAndGetBufferPtr(&bufferPtr) != SUCCESS
-    //     return the value returned by the call.
-    if(response != SUCCESS){
+    if (response != SUCCESS){
         return response;
     }
 
-    // copy the Index at ptr to indexNum'th entry in the buffer using memcpy
+    BlockLatch::latch(this->blockNum);
 
+    struct HeadInfo *head = (struct HeadInfo *)bufferPtr;
+    head->numEntries = numKeys;
 
-    /* the indexNum'th entry will begin at an offset of
-       HEADER_SIZE + (indexNum * LEAF_ENTRY_SIZE)  from bufferPtr */
-    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + (indexNum * LEAF_ENTRY_SIZE);
-    memcpy(entryPtr, (struct Index *)ptr, LEAF_ENTRY_SIZE);
+    if (attrType != STRING) {
+        head->numAttrs = 0;
+        head->numSlots = IND_FORMAT_PLAIN;
+        for (int i = 0; i < numKeys; i++) {
+            memcpy(bufferPtr + HEADER_SIZE + i * 20, &children[i], sizeof(int32_t));
+            memcpy(bufferPtr + HEADER_SIZE + i * 20 + 4, &keys[i], ATTR_SIZE);
+        }
+        memcpy(bufferPtr + HEADER_SIZE + numKeys * 20, &children[numKeys], sizeof(int32_t));
+        return StaticBuffer::setDirtyBit(this->blockNum);
+    }
 
-    // update dirty bit using setDirtyBit()
-    response = StaticBuffer::setDirtyBit(this->blockNum);
-    // if setDirtyBit failed, return the value returned by the call
-    if(response != SUCCESS){
-        return response;
+    int prefixLen = commonPrefixLength(keys, numKeys);
+    head->numAttrs = prefixLen;
+    head->numSlots = IND_FORMAT_PREFIX;
+    memcpy(bufferPtr + HEADER_SIZE, keys[0].sVal, prefixLen);
+
+    // the children and suffixes follow the offset table
+    unsigned char *offsetTable = bufferPtr + HEADER_SIZE + prefixLen;
+    int offset = HEADER_SIZE + prefixLen + (numKeys + 1) * sizeof(uint16_t);
+    for (int i = 0; i <= numKeys; i++) {
+        memcpy(bufferPtr + offset, &children[i], sizeof(int32_t));
+        offset += sizeof(int32_t);
+
+        uint16_t suffixOffset = offset;
+        memcpy(offsetTable + i * sizeof(uint16_t), &suffixOffset, sizeof(uint16_t));
+
+        if (i < numKeys) {
+            int suffixLen = strnlen(keys[i].sVal, ATTR_SIZE) - prefixLen;
+            memcpy(bufferPtr + offset, keys[i].sVal + prefixLen, suffixLen);
+            offset += suffixLen;
+        }
     }
 
-    //return SUCCESS
-    return SUCCESS;
+    return StaticBuffer::setDirtyBit(this->blockNum);
 }
 
+// this is the way to call parent non-default constructor.
+// 'L' used to denote IndLeaf.
+IndLeaf::IndLeaf() : IndBuffer('L'){} 
+
+//this is the way to call parent non-default constructor.
+IndLeaf::IndLeaf(int blockNum) : IndBuffer(blockNum){}
 
-int IndInternal::setEntry(void *ptr, int indexNum) {
+int IndInternal::getEntry(void *ptr, int indexNum) {
     // if the indexNum is not in the valid range of [0, MAX_KEYS_INTERNAL-1]
     //     return E_OUTOFBOUND.
-    if(indexNum < 0 || indexNum >= MAX_KEYS_INTERNAL){
+    if (indexNum < 0 || indexNum >= MAX_KEYS_INTERNAL_PREFIX){
         return E_OUTOFBOUND;
     }
 
@@ -661,34 +1072,244 @@ int IndInternal::setEntry(void *ptr, int indexNum) {
 
     // if loadBlockAndGetBufferPtr(&bufferPtr) != SUCCESS
     //     return the value returned by the call.
-    if(response != SUCCESS){
+    if (response != SUCCESS){
         return response;
     }
 
     // typecast the void pointer to an internal entry pointer
     struct InternalEntry *internalEntry = (struct InternalEntry *)ptr;
 
+    // (the entries of a prefix compressed block are decoded from the whole node)
+    if (((struct HeadInfo *)bufferPtr)->numSlots == IND_FORMAT_PREFIX) {
+        int children[MAX_KEYS_INTERNAL_PREFIX + 1];
+        union Attribute keys[MAX_KEYS_INTERNAL_PREFIX];
+        if (indexNum >= getNode(children, keys)) {
+            return E_OUTOFBOUND;
+        }
+        internalEntry->lChild = children[indexNum];
+        internalEntry->attrVal = keys[indexNum];
+        internalEntry->rChild = children[indexNum + 1];
+        return SUCCESS;
+    }
+
+    if (indexNum >= MAX_KEYS_INTERNAL){
+        return E_OUTOFBOUND;
+    }
+
     /*
-    - copy the entries from *internalEntry to the indexNum`th entry
+    - copy the entries from the indexNum`th entry to *internalEntry
     - make sure that each field is copied individually as in the following code
     - the lChild and rChild fields of InternalEntry are of type int32_t
     - int32_t is a type of int that is guaranteed to be 4 bytes across every
       C++ implementation. sizeof(int32_t) = 4
     */
 
+
+
     /* the indexNum'th entry will begin at an offset of
        HEADER_SIZE + (indexNum * (sizeof(int) + ATTR_SIZE) )         [why?]
        from bufferPtr */
-
     unsigned char *entryPtr = bufferPtr + HEADER_SIZE + (indexNum * 20);
 
-    memcpy(entryPtr, &(internalEntry->lChild), 4);
-    memcpy(entryPtr + 4, &(internalEntry->attrVal), ATTR_SIZE);
-    memcpy(entryPtr + 20, &(internalEntry->rChild), 4);
+    memcpy(&(internalEntry->lChild), entryPtr, sizeof(int32_t));
+    memcpy(&(internalEntry->attrVal), entryPtr + 4, sizeof(Attribute));
+    memcpy(&(internalEntry->rChild), entryPtr + 20, 4);
 
+    // return SUCCESS.
+    return SUCCESS;
+}
 
-    // update dirty bit using setDirtyBit()
-    response = StaticBuffer::setDirtyBit(this->blockNum);
+/*
+A packed leaf index block (format IND_FORMAT_PACKED) stores the entries without
+the included value (a packed leaf belongs to an index without an included
+attribute) and with a 2 byte slot number:
+
+    attrVal (ATTR_SIZE bytes) | block (4 bytes) | slot (2 bytes)
+
+The entries are read and written as struct Index in either format.
+*/
+
+// size of an entry of the leaf index block in the buffer
+static int leafEntrySize(unsigned char *bufferPtr) {
+    return ((struct HeadInfo *)bufferPtr)->numSlots == IND_FORMAT_PACKED ? LEAF_ENTRY_SIZE_PACKED : LEAF_ENTRY_SIZE;
+}
+
+/*
+Returns the number of entries that fit in a leaf index block of the format
+(IND_FORMAT_PLAIN or IND_FORMAT_PACKED)
+*/
+int IndLeaf::getMaxEntries(int format) {
+    return format == IND_FORMAT_PACKED ? MAX_KEYS_LEAF_PACKED : MAX_KEYS_LEAF;
+}
+
+int IndLeaf::getEntry(void *ptr, int indexNum) {
+    // (the index is checked against the number of entries of the format of the block)
+    return getEntries((struct Index *)ptr, indexNum, 1);
+}
+
+/*
+Returns the index of the first entry of the block whose attribute value is >=
+attrVal (> attrVal if `strict`), or numEntries if there is none
+*/
+int IndLeaf::searchEntries(union Attribute attrVal, int attrType, bool strict) {
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    return searchBlock(bufferPtr, attrVal, attrType, strict);
+}
+
+// searchEntries() for a copy of the block (see StaticBuffer::readBlock())
+int IndLeaf::searchBlock(unsigned char *bufferPtr, union Attribute attrVal, int attrType, bool strict) {
+    return searchKeys(bufferPtr, HEADER_SIZE, leafEntrySize(bufferPtr), attrVal, attrType, strict);
+}
+
+/*
+Used to get `count` Index entries, starting from the first'th one, of a leaf
+index block (with a single load of the block)
+NOTE: this function expects the caller to allocate memory for `entries`
+*/
+int IndLeaf::getEntries(struct Index *entries, int first, int count) {
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    return getBlockEntries(bufferPtr, entries, first, count);
+}
+
+// getEntries() for a copy of the block (see StaticBuffer::readBlock())
+int IndLeaf::getBlockEntries(unsigned char *bufferPtr, struct Index *entries, int first, int count) {
+    int format = ((struct HeadInfo *)bufferPtr)->numSlots;
+    if (first < 0 || count < 0 || first + count > getMaxEntries(format)){
+        return E_OUTOFBOUND;
+    }
+
+    // the entries are stored one after the other after the header
+    if (format != IND_FORMAT_PACKED) {
+        memcpy(entries, bufferPtr + HEADER_SIZE + first * LEAF_ENTRY_SIZE, count * LEAF_ENTRY_SIZE);
+        return SUCCESS;
+    }
+
+    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + first * LEAF_ENTRY_SIZE_PACKED;
+    for (int i = 0; i < count; i++, entryPtr += LEAF_ENTRY_SIZE_PACKED) {
+        int16_t slot;
+        memcpy(&entries[i].attrVal, entryPtr, ATTR_SIZE);
+        memcpy(&entries[i].block, entryPtr + ATTR_SIZE, sizeof(int32_t));
+        memcpy(&slot, entryPtr + ATTR_SIZE + sizeof(int32_t), sizeof(int16_t));
+        entries[i].slot = slot;
+        memset(entries[i].included, 0, sizeof(entries[i].included));
+    }
+
+    return SUCCESS;
+}
+
+/*
+Used to store `count` Index entries, starting from the first'th one, of a leaf
+index block (with a single load of the block)
+*/
+int IndLeaf::setEntries(struct Index *entries, int first, int count) {
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    BlockLatch::latch(this->blockNum);
+
+    int format = ((struct HeadInfo *)bufferPtr)->numSlots;
+    if (first < 0 || count < 0 || first + count > getMaxEntries(format)){
+        return E_OUTOFBOUND;
+    }
+
+    if (format != IND_FORMAT_PACKED) {
+        memcpy(bufferPtr + HEADER_SIZE + first * LEAF_ENTRY_SIZE, entries, count * LEAF_ENTRY_SIZE);
+        return StaticBuffer::setDirtyBit(this->blockNum);
+    }
+
+    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + first * LEAF_ENTRY_SIZE_PACKED;
+    for (int i = 0; i < count; i++, entryPtr += LEAF_ENTRY_SIZE_PACKED) {
+        int16_t slot = entries[i].slot;
+        memcpy(entryPtr, &entries[i].attrVal, ATTR_SIZE);
+        memcpy(entryPtr + ATTR_SIZE, &entries[i].block, sizeof(int32_t));
+        memcpy(entryPtr + ATTR_SIZE + sizeof(int32_t), &slot, sizeof(int16_t));
+    }
+
+    return StaticBuffer::setDirtyBit(this->blockNum);
+}
+
+int IndLeaf::setEntry(void *ptr, int indexNum) {
+    // (the index is checked against the number of entries of the format of the block)
+    return setEntries((struct Index *)ptr, indexNum, 1);
+}
+
+
+int IndInternal::setEntry(void *ptr, int indexNum) {
+    // if the indexNum is not in the valid range of [0, MAX_KEYS_INTERNAL-1]
+    //     return E_OUTOFBOUND.
+    if(indexNum < 0 || indexNum >= MAX_KEYS_INTERNAL_PREFIX){
+        return E_OUTOFBOUND;
+    }
+
+    unsigned char *bufferPtr;
+    /* get the starting address of the buffer containing the block
+       using loadBlockAndGetBufferPtr(&bufferPtr). */
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+
+    // if loadBlockAndGetBufferPtr(&bufferPtr) != SUCCESS
+    //     return the value returned by the call.
+    if(response != SUCCESS){
+        return response;
+    }
+
+    // typecast the void pointer to an internal entry pointer
+    struct InternalEntry *internalEntry = (struct InternalEntry *)ptr;
+
+    // (an entry of a prefix compressed block is replaced by writing the whole node
+    // again, as the prefix and the offsets of the other entries may change)
+    if (((struct HeadInfo *)bufferPtr)->numSlots == IND_FORMAT_PREFIX) {
+        int children[MAX_KEYS_INTERNAL_PREFIX + 1];
+        union Attribute keys[MAX_KEYS_INTERNAL_PREFIX];
+        int numKeys = getNode(children, keys);
+        if (indexNum >= numKeys) {
+            return E_OUTOFBOUND;
+        }
+        children[indexNum] = internalEntry->lChild;
+        keys[indexNum] = internalEntry->attrVal;
+        children[indexNum + 1] = internalEntry->rChild;
+        return setNode(children, keys, numKeys, STRING);
+    }
+
+    if (indexNum >= MAX_KEYS_INTERNAL){
+        return E_OUTOFBOUND;
+    }
+
+    BlockLatch::latch(this->blockNum);
+
+    /*
+    - copy the entries from *internalEntry to the indexNum`th entry
+    - make sure that each field is copied individually as in the following code
+    - the lChild and rChild fields of InternalEntry are of type int32_t
+    - int32_t is a type of int that is guaranteed to be 4 bytes across every
+      C++ implementation. sizeof(int32_t) = 4
+    */
+
+    /* the indexNum'th entry will begin at an offset of
+       HEADER_SIZE + (indexNum * (sizeof(int) + ATTR_SIZE) )         [why?]
+       from bufferPtr */
+
+    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + (indexNum * 20);
+
+    memcpy(entryPtr, &(internalEntry->lChild), 4);
+    memcpy(entryPtr + 4, &(internalEntry->attrVal), ATTR_SIZE);
+    memcpy(entryPtr + 20, &(internalEntry->rChild), 4);
+
+
+    // update dirty bit using setDirtyBit()
+    response = StaticBuffer::setDirtyBit(this->blockNum);
     // if setDirtyBit failed, return the value returned by the call
     if(response != SUCCESS){
         return response;
@@ -696,4 +1317,634 @@ int IndInternal::setEntry(void *ptr, int indexNum) {
 
     // return SUCCESS
     return SUCCESS;
-}
\ No newline at end of file
+}
+// call parent non-default constructor with 'Z' denoting zone map block.
+ZoneMapBuffer::ZoneMapBuffer() : BlockBuffer('Z'){}
+
+// calls the parent class constructor
+ZoneMapBuffer::ZoneMapBuffer(int blockNum) : BlockBuffer(blockNum){}
+
+/*
+Returns the number of zone map entries that fit in a block for a relation
+with `numAttrs` attributes. (0 if a single entry does not fit in a block)
+*/
+int ZoneMapBuffer::getMaxEntries(int numAttrs){
+    // every entry stores the record block number and two values per attribute
+    int entrySize = ZONE_ENTRY_HEADER_SIZE + 2 * numAttrs * ATTR_SIZE;
+    return (BLOCK_SIZE - HEADER_SIZE) / entrySize;
+}
+
+/*
+Used to get the entryNum'th entry of the block. Either of `minVals` and
+`maxVals` may be nullptr if only the record block number is required.
+NOTE: this function expects the caller to allocate memory for the arguments
+*/
+int ZoneMapBuffer::getEntry(int *recBlockNum, union Attribute *minVals, union Attribute *maxVals, int entryNum){
+
+    unsigned char *bufferPtr;
+    /* get the starting address of the buffer containing the block
+       using loadBlockAndGetBufferPtr(&bufferPtr). */
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    struct HeadInfo head;
+    BlockBuffer::getHeader(&head);
+
+    // if the entryNum is not in the valid range of [0, numEntries-1]
+    //     return E_OUTOFBOUND.
+    if (entryNum < 0 || entryNum >= head.numEntries){
+        return E_OUTOFBOUND;
+    }
+
+    /* the entryNum'th entry will begin at an offset of
+       HEADER_SIZE + (entryNum * entrySize) from bufferPtr and contains the
+       record block number, numAttrs minimum values and numAttrs maximum values */
+    int valuesSize = head.numAttrs * ATTR_SIZE;
+    int entrySize = ZONE_ENTRY_HEADER_SIZE + 2 * valuesSize;
+    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + (entryNum * entrySize);
+
+    memcpy(recBlockNum, entryPtr, ZONE_ENTRY_HEADER_SIZE);
+    if (minVals != nullptr){
+        memcpy(minVals, entryPtr + ZONE_ENTRY_HEADER_SIZE, valuesSize);
+    }
+    if (maxVals != nullptr){
+        memcpy(maxVals, entryPtr + ZONE_ENTRY_HEADER_SIZE + valuesSize, valuesSize);
+    }
+
+    return SUCCESS;
+}
+
+/*
+Used to set the entryNum'th entry of the block. The entry may be at most one
+past the last entry of the block (i.e. the block grows by appending entries);
+the caller is expected to update numEntries in the header in that case.
+*/
+int ZoneMapBuffer::setEntry(int recBlockNum, union Attribute *minVals, union Attribute *maxVals, int entryNum){
+
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    struct HeadInfo head;
+    BlockBuffer::getHeader(&head);
+
+    // if the entryNum is not in the valid range of [0, numSlots-1]
+    //     return E_OUTOFBOUND.
+    if (entryNum < 0 || entryNum >= head.numSlots){
+        return E_OUTOFBOUND;
+    }
+
+    int valuesSize = head.numAttrs * ATTR_SIZE;
+    int entrySize = ZONE_ENTRY_HEADER_SIZE + 2 * valuesSize;
+    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + (entryNum * entrySize);
+
+    memcpy(entryPtr, &recBlockNum, ZONE_ENTRY_HEADER_SIZE);
+    memcpy(entryPtr + ZONE_ENTRY_HEADER_SIZE, minVals, valuesSize);
+    memcpy(entryPtr + ZONE_ENTRY_HEADER_SIZE + valuesSize, maxVals, valuesSize);
+
+    // update dirty bit using setDirtyBit()
+    return StaticBuffer::setDirtyBit(this->blockNum);
+}
+
+/*
+Used to get the minimum and maximum value of the attribute at `attrOffset`
+stored in the entryNum'th entry of the block.
+*/
+int ZoneMapBuffer::getRange(union Attribute *minVal, union Attribute *maxVal, int attrOffset, int entryNum){
+
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    struct HeadInfo head;
+    BlockBuffer::getHeader(&head);
+
+    if (entryNum < 0 || entryNum >= head.numEntries || attrOffset < 0 || attrOffset >= head.numAttrs){
+        return E_OUTOFBOUND;
+    }
+
+    int valuesSize = head.numAttrs * ATTR_SIZE;
+    int entrySize = ZONE_ENTRY_HEADER_SIZE + 2 * valuesSize;
+    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + (entryNum * entrySize) + ZONE_ENTRY_HEADER_SIZE;
+
+    memcpy(minVal, entryPtr + attrOffset * ATTR_SIZE, ATTR_SIZE);
+    memcpy(maxVal, entryPtr + valuesSize + attrOffset * ATTR_SIZE, ATTR_SIZE);
+
+    return SUCCESS;
+}
+
+/*
+Returns the index of the entry summarising the record block `recBlockNum`,
+or E_NOTFOUND if the block has no entry in this zone map block (or the error
+code of getEntry() if an entry could not be read).
+*/
+int ZoneMapBuffer::findEntry(int recBlockNum){
+
+    struct HeadInfo head;
+    int response = BlockBuffer::getHeader(&head);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    for (int entryNum = 0; entryNum < head.numEntries; entryNum++){
+        int entryBlockNum;
+        response = getEntry(&entryBlockNum, nullptr, nullptr, entryNum);
+        if (response != SUCCESS){
+            return response;
+        }
+        if (entryBlockNum == recBlockNum){
+            return entryNum;
+        }
+    }
+
+    return E_NOTFOUND;
+}
+
+// call parent non-default constructor with 'B' denoting bloom filter block.
+BloomBuffer::BloomBuffer() : BlockBuffer('B'){}
+
+// calls the parent class constructor
+BloomBuffer::BloomBuffer(int blockNum) : BlockBuffer(blockNum){}
+
+/*
+Used to get `count` block numbers, starting from the first'th one, stored in a
+head block of a filter
+NOTE: this function expects the caller to allocate memory for `blockNums`
+*/
+int BloomBuffer::getBlockNums(int32_t *blockNums, int first, int count){
+    if (first < 0 || count < 0 || first + count > BLOOM_MAX_BLOCKS){
+        return E_OUTOFBOUND;
+    }
+
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    // the block numbers are stored one after the other after the header
+    memcpy(blockNums, bufferPtr + HEADER_SIZE + first * sizeof(int32_t), count * sizeof(int32_t));
+
+    return SUCCESS;
+}
+
+/*
+Used to store `count` block numbers in a head block of a filter
+*/
+int BloomBuffer::setBlockNums(int32_t *blockNums, int count){
+    if (count < 0 || count > BLOOM_MAX_BLOCKS){
+        return E_OUTOFBOUND;
+    }
+
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    memcpy(bufferPtr + HEADER_SIZE, blockNums, count * sizeof(int32_t));
+
+    // update dirty bit using setDirtyBit()
+    return StaticBuffer::setDirtyBit(this->blockNum);
+}
+
+/*
+Used to reset all the bits of a bit array block of a filter
+*/
+int BloomBuffer::clearBits(){
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    memset(bufferPtr + HEADER_SIZE, 0, BLOCK_SIZE - HEADER_SIZE);
+
+    return StaticBuffer::setDirtyBit(this->blockNum);
+}
+
+/*
+Used to set the bits numbered bitNums[0..count-1] of a bit array block
+(bit i is bit (i % 8) of the (i / 8)th byte after the header)
+*/
+int BloomBuffer::setBits(int *bitNums, int count){
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    unsigned char *bits = bufferPtr + HEADER_SIZE;
+    for (int i = 0; i < count; i++){
+        bits[bitNums[i] / 8] |= (unsigned char)(1 << (bitNums[i] % 8));
+    }
+
+    return StaticBuffer::setDirtyBit(this->blockNum);
+}
+
+/*
+Returns true if all the bits numbered bitNums[0..count-1] of a bit array block are set
+*/
+bool BloomBuffer::testBits(int *bitNums, int count){
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        // (an unreadable filter can not rule anything out)
+        return true;
+    }
+
+    unsigned char *bits = bufferPtr + HEADER_SIZE;
+    for (int i = 0; i < count; i++){
+        if ((bits[bitNums[i] / 8] & (1 << (bitNums[i] % 8))) == 0){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+Returns the number of bits set in a bit array block
+*/
+int BloomBuffer::countBits(){
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    int setBitsCount = 0;
+    for (int i = HEADER_SIZE; i < BLOCK_SIZE; i++){
+        setBitsCount += __builtin_popcount(bufferPtr[i]);
+    }
+
+    return setBitsCount;
+}
+
+// call parent non-default constructor with 'H' denoting hash index block.
+HashBuffer::HashBuffer() : BlockBuffer('H'){}
+
+// calls the parent class constructor
+HashBuffer::HashBuffer(int blockNum) : BlockBuffer(blockNum){}
+
+/*
+Used to get `count` block numbers, starting from the first'th one, stored in a
+head or directory block of a hash index
+NOTE: this function expects the caller to allocate memory for `blockNums`
+*/
+int HashBuffer::getBlockNums(int32_t *blockNums, int first, int count){
+    if (first < 0 || count < 0 || first + count > HASH_BLOCK_NUMS){
+        return E_OUTOFBOUND;
+    }
+
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    memcpy(blockNums, bufferPtr + HEADER_SIZE + first * sizeof(int32_t), count * sizeof(int32_t));
+
+    return SUCCESS;
+}
+
+/*
+Used to store `count` block numbers, starting from the first'th one, in a head
+or directory block of a hash index
+*/
+int HashBuffer::setBlockNums(int32_t *blockNums, int first, int count){
+    if (first < 0 || count < 0 || first + count > HASH_BLOCK_NUMS){
+        return E_OUTOFBOUND;
+    }
+
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    memcpy(bufferPtr + HEADER_SIZE + first * sizeof(int32_t), blockNums, count * sizeof(int32_t));
+
+    return StaticBuffer::setDirtyBit(this->blockNum);
+}
+
+/*
+Used to get `count` entries, starting from the first'th one, of a bucket block
+(the included field of the entries is cleared)
+NOTE: this function expects the caller to allocate memory for `entries`
+*/
+int HashBuffer::getEntries(struct Index *entries, int first, int count){
+    if (first < 0 || count < 0 || first + count > HASH_BUCKET_ENTRIES){
+        return E_OUTOFBOUND;
+    }
+
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + first * LEAF_ENTRY_SIZE_PACKED;
+    for (int i = 0; i < count; i++, entryPtr += LEAF_ENTRY_SIZE_PACKED){
+        int16_t slot;
+        memcpy(&entries[i].attrVal, entryPtr, ATTR_SIZE);
+        memcpy(&entries[i].block, entryPtr + ATTR_SIZE, sizeof(int32_t));
+        memcpy(&slot, entryPtr + ATTR_SIZE + sizeof(int32_t), sizeof(int16_t));
+        entries[i].slot = slot;
+        memset(entries[i].included, 0, sizeof(entries[i].included));
+    }
+
+    return SUCCESS;
+}
+
+/*
+Used to store `count` entries, starting from the first'th one, in a bucket block
+*/
+int HashBuffer::setEntries(struct Index *entries, int first, int count){
+    if (first < 0 || count < 0 || first + count > HASH_BUCKET_ENTRIES){
+        return E_OUTOFBOUND;
+    }
+
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + first * LEAF_ENTRY_SIZE_PACKED;
+    for (int i = 0; i < count; i++, entryPtr += LEAF_ENTRY_SIZE_PACKED){
+        int16_t slot = (int16_t)entries[i].slot;
+        memcpy(entryPtr, &entries[i].attrVal, ATTR_SIZE);
+        memcpy(entryPtr + ATTR_SIZE, &entries[i].block, sizeof(int32_t));
+        memcpy(entryPtr + ATTR_SIZE + sizeof(int32_t), &slot, sizeof(int16_t));
+    }
+
+    return StaticBuffer::setDirtyBit(this->blockNum);
+}
+
+/*
+Returns the index of the first entry of a bucket block, from the first'th one
+on, whose key is equal to attrVal (E_NOTFOUND if there is none)
+*/
+int HashBuffer::findEntry(union Attribute attrVal, int attrType, int first){
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    int numEntries = ((struct HeadInfo *)bufferPtr)->numEntries;
+    for (int i = first; i < numEntries; i++){
+        // (the keys are compared in place)
+        Attribute key;
+        memcpy(&key, bufferPtr + HEADER_SIZE + i * LEAF_ENTRY_SIZE_PACKED, ATTR_SIZE);
+        if (compareAttrs(key, attrVal, attrType) == 0){
+            return i;
+        }
+    }
+
+    return E_NOTFOUND;
+}
+
+// call parent non-default constructor with 'M' denoting bitmap index block.
+BitmapBuffer::BitmapBuffer() : BlockBuffer('M'){}
+
+// calls the parent class constructor
+BitmapBuffer::BitmapBuffer(int blockNum) : BlockBuffer(blockNum){}
+
+/*
+Used to get `count` values, starting from the first'th one, of a directory block
+NOTE: this function expects the caller to allocate memory for `values`
+*/
+int BitmapBuffer::getValues(struct BitmapValue *values, int first, int count){
+    if (first < 0 || count < 0 || first + count > BITMAP_DIR_VALUES){
+        return E_OUTOFBOUND;
+    }
+
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    unsigned char *valuePtr = bufferPtr + HEADER_SIZE + first * BITMAP_VALUE_SIZE;
+    for (int i = 0; i < count; i++, valuePtr += BITMAP_VALUE_SIZE){
+        memcpy(&values[i].attrVal, valuePtr, ATTR_SIZE);
+        memcpy(&values[i].block, valuePtr + ATTR_SIZE, sizeof(int32_t));
+        memcpy(&values[i].count, valuePtr + ATTR_SIZE + sizeof(int32_t), sizeof(int32_t));
+    }
+
+    return SUCCESS;
+}
+
+/*
+Used to store `count` values, starting from the first'th one, in a directory block
+*/
+int BitmapBuffer::setValues(struct BitmapValue *values, int first, int count){
+    if (first < 0 || count < 0 || first + count > BITMAP_DIR_VALUES){
+        return E_OUTOFBOUND;
+    }
+
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    unsigned char *valuePtr = bufferPtr + HEADER_SIZE + first * BITMAP_VALUE_SIZE;
+    for (int i = 0; i < count; i++, valuePtr += BITMAP_VALUE_SIZE){
+        memcpy(valuePtr, &values[i].attrVal, ATTR_SIZE);
+        memcpy(valuePtr + ATTR_SIZE, &values[i].block, sizeof(int32_t));
+        memcpy(valuePtr + ATTR_SIZE + sizeof(int32_t), &values[i].count, sizeof(int32_t));
+    }
+
+    return StaticBuffer::setDirtyBit(this->blockNum);
+}
+
+/*
+Returns the index of the value of a directory block that is equal to attrVal
+(E_NOTFOUND if there is none)
+*/
+int BitmapBuffer::findValue(union Attribute attrVal, int attrType){
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    int numEntries = ((struct HeadInfo *)bufferPtr)->numEntries;
+    for (int i = 0; i < numEntries; i++){
+        // (the values are compared in place)
+        Attribute value;
+        memcpy(&value, bufferPtr + HEADER_SIZE + i * BITMAP_VALUE_SIZE, ATTR_SIZE);
+        if (compareAttrs(value, attrVal, attrType) == 0){
+            return i;
+        }
+    }
+
+    return E_NOTFOUND;
+}
+
+/*
+Used to get `count` entries, starting from the first'th one, of a bitmap block
+NOTE: this function expects the caller to allocate memory for `entries`
+*/
+int BitmapBuffer::getEntries(struct BitmapEntry *entries, int first, int count){
+    if (first < 0 || count < 0 || first + count > BITMAP_BLOCK_ENTRIES){
+        return E_OUTOFBOUND;
+    }
+
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + first * BITMAP_ENTRY_SIZE;
+    for (int i = 0; i < count; i++, entryPtr += BITMAP_ENTRY_SIZE){
+        memcpy(&entries[i].block, entryPtr, sizeof(int32_t));
+        memcpy(entries[i].words, entryPtr + sizeof(int32_t), sizeof(entries[i].words));
+    }
+
+    return SUCCESS;
+}
+
+/*
+Used to store `count` entries, starting from the first'th one, in a bitmap block
+*/
+int BitmapBuffer::setEntries(struct BitmapEntry *entries, int first, int count){
+    if (first < 0 || count < 0 || first + count > BITMAP_BLOCK_ENTRIES){
+        return E_OUTOFBOUND;
+    }
+
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + first * BITMAP_ENTRY_SIZE;
+    for (int i = 0; i < count; i++, entryPtr += BITMAP_ENTRY_SIZE){
+        memcpy(entryPtr, &entries[i].block, sizeof(int32_t));
+        memcpy(entryPtr + sizeof(int32_t), entries[i].words, sizeof(entries[i].words));
+    }
+
+    return StaticBuffer::setDirtyBit(this->blockNum);
+}
+
+// call parent non-default constructor with 'T' denoting statistics block.
+StatsBuffer::StatsBuffer() : BlockBuffer('T'){}
+
+// calls the parent class constructor
+StatsBuffer::StatsBuffer(int blockNum) : BlockBuffer(blockNum){}
+
+/*
+Used to get `count` entries, starting from the first'th one, of a statistics block
+NOTE: this function expects the caller to allocate memory for `entries`
+*/
+int StatsBuffer::getEntries(struct StatsEntry *entries, int first, int count){
+    if (first < 0 || count < 0 || first + count > STATS_BLOCK_ENTRIES){
+        return E_OUTOFBOUND;
+    }
+
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + first * STATS_ENTRY_SIZE;
+    for (int i = 0; i < count; i++, entryPtr += STATS_ENTRY_SIZE){
+        memcpy(&entries[i].attrVal, entryPtr, ATTR_SIZE);
+        memcpy(&entries[i].count, entryPtr + ATTR_SIZE, sizeof(double));
+        memcpy(&entries[i].distinct, entryPtr + ATTR_SIZE + sizeof(double), sizeof(double));
+        memcpy(&entries[i].valueCount, entryPtr + ATTR_SIZE + 2 * sizeof(double), sizeof(double));
+    }
+
+    return SUCCESS;
+}
+
+/*
+Used to store `count` entries, starting from the first'th one, in a statistics block
+*/
+int StatsBuffer::setEntries(struct StatsEntry *entries, int first, int count){
+    if (first < 0 || count < 0 || first + count > STATS_BLOCK_ENTRIES){
+        return E_OUTOFBOUND;
+    }
+
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    unsigned char *entryPtr = bufferPtr + HEADER_SIZE + first * STATS_ENTRY_SIZE;
+    for (int i = 0; i < count; i++, entryPtr += STATS_ENTRY_SIZE){
+        memcpy(entryPtr, &entries[i].attrVal, ATTR_SIZE);
+        memcpy(entryPtr + ATTR_SIZE, &entries[i].count, sizeof(double));
+        memcpy(entryPtr + ATTR_SIZE + sizeof(double), &entries[i].distinct, sizeof(double));
+        memcpy(entryPtr + ATTR_SIZE + 2 * sizeof(double), &entries[i].valueCount, sizeof(double));
+    }
+
+    return StaticBuffer::setDirtyBit(this->blockNum);
+}
+
+// call parent non-default constructor with 'S' denoting sorted run block.
+RunBuffer::RunBuffer() : BlockBuffer('S'){}
+
+// calls the parent class constructor
+RunBuffer::RunBuffer(int blockNum) : BlockBuffer(blockNum){}
+
+// number of records of numAttrs attributes that fit in a block of a run
+int RunBuffer::getMaxRecords(int numAttrs){
+    return (BLOCK_SIZE - HEADER_SIZE) / (numAttrs * ATTR_SIZE);
+}
+
+/*
+Used to get the first `count` records of the block (count is at most the
+numEntries field of the header)
+NOTE: this function expects the caller to allocate memory for `records`
+*/
+int RunBuffer::getRecords(union Attribute *records, int count){
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    struct HeadInfo *head = (struct HeadInfo *)bufferPtr;
+    if (count < 0 || count > head->numEntries){
+        return E_OUTOFBOUND;
+    }
+
+    memcpy(records, bufferPtr + HEADER_SIZE, count * head->numAttrs * ATTR_SIZE);
+
+    return SUCCESS;
+}
+
+/*
+Used to store `count` records in the block (the numEntries and numAttrs fields
+of the header must be set first)
+*/
+int RunBuffer::setRecords(union Attribute *records, int count){
+    unsigned char *bufferPtr;
+    int response = loadBlockAndGetBufferPtr(&bufferPtr);
+    if (response != SUCCESS){
+        return response;
+    }
+
+    struct HeadInfo *head = (struct HeadInfo *)bufferPtr;
+    if (count < 0 || count > getMaxRecords(head->numAttrs)){
+        return E_OUTOFBOUND;
+    }
+
+    memcpy(bufferPtr + HEADER_SIZE, records, count * head->numAttrs * ATTR_SIZE);
+
+    return StaticBuffer::setDirtyBit(this->blockNum);
+}
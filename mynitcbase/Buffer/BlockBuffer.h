@@ -25,6 +25,7 @@ typedef union Attribute {
 } Attribute;
 
 int compareAttrs(Attribute attr1, Attribute attr2, int attrType);
+uint64_t hashAttr(Attribute attrVal, int attrType);
 
 struct InternalEntry {
   int32_t lChild;
@@ -36,7 +37,34 @@ struct Index {
   union Attribute attrVal;
   int32_t block;
   int32_t slot;
-  unsigned char unused[8];
+  unsigned char included[8];  // value of the included attribute of the index, if any (see BPlusTree::bPlusInsert())
+};
+
+// A distinct value of a bitmap index and the first block of its bitmap
+struct BitmapValue {
+  union Attribute attrVal;
+  int32_t block;
+  int32_t count;  // number of records with the value
+};
+
+/*
+An entry of a statistics block (see Statistics/Statistics.h): the summary of
+the attribute (its smallest value, the number of records and of distinct
+values) or a bucket of its histogram (the largest value of the bucket, the
+number of records and of distinct values in it, and the number of records
+equal to its largest value)
+*/
+struct StatsEntry {
+  union Attribute attrVal;
+  double count;
+  double distinct;
+  double valueCount;
+};
+
+// The slots of a record block that hold a value of a bitmap index (bit i of words is set if slot i does)
+struct BitmapEntry {
+  int32_t block;
+  uint64_t words[SELECTION_BITMAP_WORDS];
 };
 
 class BlockBuffer {
@@ -68,6 +96,7 @@ class RecBuffer : public BlockBuffer {
   int setSlotMap(unsigned char *slotMap);
   int getRecord(union Attribute *rec, int slotNum);
   int setRecord(union Attribute *rec, int slotNum);
+  int getRecords(struct HeadInfo *head, unsigned char *slotMap, union Attribute *records);
 };
 
 class IndBuffer : public BlockBuffer {
@@ -76,6 +105,8 @@ class IndBuffer : public BlockBuffer {
   IndBuffer(char blockType);
   virtual int getEntry(void *ptr, int indexNum) = 0;
   virtual int setEntry(void *ptr, int indexNum) = 0;
+  static int setSearchMethod(int method);
+  static int getSearchMethod();
 };
 
 class IndInternal : public IndBuffer {
@@ -84,14 +115,120 @@ class IndInternal : public IndBuffer {
   IndInternal(int blockNum);
   int getEntry(void *ptr, int indexNum);
   int setEntry(void *ptr, int indexNum);
+  int getChild(int childNum);
+  int searchEntries(union Attribute attrVal, int attrType, bool strict);
+  int getNode(int children[], union Attribute keys[]);
+  int setNode(int children[], union Attribute keys[], int numKeys, int attrType);
+  static int getNodeSize(union Attribute keys[], int numKeys, int attrType);
+  static int getBlockChild(unsigned char *block, int childNum);
+  static int searchBlock(unsigned char *block, union Attribute attrVal, int attrType, bool strict);
 };
 
 class IndLeaf : public IndBuffer {
  public:
   IndLeaf();
   IndLeaf(int blockNum);
+  static int getMaxEntries(int format);
   int getEntry(void *ptr, int indexNum);
+  int getEntries(struct Index *entries, int first, int count);
+  int setEntries(struct Index *entries, int first, int count);
   int setEntry(void *ptr, int indexNum);
+  int searchEntries(union Attribute attrVal, int attrType, bool strict);
+  static int getBlockEntries(unsigned char *block, struct Index *entries, int first, int count);
+  static int searchBlock(unsigned char *block, union Attribute attrVal, int attrType, bool strict);
+};
+
+/*
+A zone map block summarises consecutive record blocks of a relation. Entry i
+holds the block number of a record block followed by the minimum and the
+maximum value of every attribute over the records of that block.
+*/
+class ZoneMapBuffer : public BlockBuffer {
+ public:
+  ZoneMapBuffer();
+  ZoneMapBuffer(int blockNum);
+  static int getMaxEntries(int numAttrs);
+  int getEntry(int *recBlockNum, union Attribute *minVals, union Attribute *maxVals, int entryNum);
+  int setEntry(int recBlockNum, union Attribute *minVals, union Attribute *maxVals, int entryNum);
+  int getRange(union Attribute *minVal, union Attribute *maxVal, int attrOffset, int entryNum);
+  int findEntry(int recBlockNum);
+};
+
+/*
+The head block of a bloom filter holds the block numbers of the blocks of the
+filter. Every other block of the filter is a bit array of BLOOM_BLOCK_BITS bits.
+*/
+class BloomBuffer : public BlockBuffer {
+ public:
+  BloomBuffer();
+  BloomBuffer(int blockNum);
+  int getBlockNums(int32_t *blockNums, int first, int count);
+  int setBlockNums(int32_t *blockNums, int count);
+  int clearBits();
+  int setBits(int *bitNums, int count);
+  bool testBits(int *bitNums, int count);
+  int countBits();
+};
+
+/*
+A block of a hash index (see HashIndex/HashIndex.h). The head block and the
+directory blocks hold block numbers after the header: the head those of the
+directory blocks, a directory block those of the buckets. A bucket block holds
+up to HASH_BUCKET_ENTRIES entries packed like those of a packed leaf.
+*/
+class HashBuffer : public BlockBuffer {
+ public:
+  HashBuffer();
+  HashBuffer(int blockNum);
+  int getBlockNums(int32_t *blockNums, int first, int count);
+  int setBlockNums(int32_t *blockNums, int first, int count);
+  int getEntries(struct Index *entries, int first, int count);
+  int setEntries(struct Index *entries, int first, int count);
+  int findEntry(union Attribute attrVal, int attrType, int first);
+};
+
+/*
+A block of a bitmap index (see BitmapIndex/BitmapIndex.h). A directory block
+holds up to BITMAP_DIR_VALUES values after the header, a bitmap block up to
+BITMAP_BLOCK_ENTRIES entries in increasing order of their record block.
+*/
+class BitmapBuffer : public BlockBuffer {
+ public:
+  BitmapBuffer();
+  BitmapBuffer(int blockNum);
+  int getValues(struct BitmapValue *values, int first, int count);
+  int setValues(struct BitmapValue *values, int first, int count);
+  int findValue(union Attribute attrVal, int attrType);
+  int getEntries(struct BitmapEntry *entries, int first, int count);
+  int setEntries(struct BitmapEntry *entries, int first, int count);
+};
+
+/*
+A statistics block of an attribute (see Statistics/Statistics.h). It holds
+numEntries entries after the header: the summary of the attribute, then the
+buckets of its histogram in increasing order of value.
+*/
+class StatsBuffer : public BlockBuffer {
+ public:
+  StatsBuffer();
+  StatsBuffer(int blockNum);
+  int getEntries(struct StatsEntry *entries, int first, int count);
+  int setEntries(struct StatsEntry *entries, int first, int count);
+};
+
+/*
+A block of a sorted run of the external sort (see Sort/ExternalSort.h). The
+header holds the number of records in the block (numEntries) and the number of
+attributes of a record (numAttrs); the records are stored one after the other
+after the header.
+*/
+class RunBuffer : public BlockBuffer {
+ public:
+  RunBuffer();
+  RunBuffer(int blockNum);
+  static int getMaxRecords(int numAttrs);
+  int getRecords(union Attribute *records, int count);
+  int setRecords(union Attribute *records, int count);
 };
 
 #endif  // NITCBASE_BLOCKBUFFER_H
\ No newline at end of file
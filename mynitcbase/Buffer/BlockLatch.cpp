@@ -0,0 +1,63 @@
+#include "BlockLatch.h"
+
+#include <thread>
+
+// the declarations for this class can be found at "BlockLatch.h"
+
+std::atomic<uint32_t> BlockLatch::versions[DISK_BLOCKS];
+std::recursive_mutex BlockLatch::writerMutex;
+int BlockLatch::writeDepth = 0;
+std::vector<int> BlockLatch::latched;
+
+/*
+Starts a write (waiting for the write of another thread, if any, to end).
+Writes may be nested; the blocks are released by the outermost endWrite().
+*/
+void BlockLatch::beginWrite() {
+    writerMutex.lock();
+    writeDepth++;
+}
+
+// ends a write, releasing the latches of the blocks it modified
+void BlockLatch::endWrite() {
+    writeDepth--;
+    if (writeDepth == 0) {
+        for (int blockNum : latched) {
+            versions[blockNum].fetch_add(1, std::memory_order_release);
+        }
+        latched.clear();
+    }
+    writerMutex.unlock();
+}
+
+/*
+Latches the block for the rest of the write (if a write is in progress and the
+block is not latched yet): its version becomes odd, and readers wait for the
+end of the write to read the block.
+*/
+void BlockLatch::latch(int blockNum) {
+    if (writeDepth == 0 || blockNum < 0 || blockNum >= DISK_BLOCKS) {
+        return;
+    }
+
+    if ((versions[blockNum].load(std::memory_order_relaxed) & 1) == 0) {
+        versions[blockNum].fetch_add(1, std::memory_order_acq_rel);
+        latched.push_back(blockNum);
+    }
+}
+
+// returns the version of the block, once no writer is modifying it
+uint32_t BlockLatch::readLock(int blockNum) {
+    uint32_t version = versions[blockNum].load(std::memory_order_acquire);
+    while (version & 1) {
+        std::this_thread::yield();
+        version = versions[blockNum].load(std::memory_order_acquire);
+    }
+    return version;
+}
+
+// returns true if the block has not been modified since readLock() returned version
+bool BlockLatch::validate(int blockNum, uint32_t version) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return versions[blockNum].load(std::memory_order_relaxed) == version;
+}
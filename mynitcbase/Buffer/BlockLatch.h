@@ -0,0 +1,53 @@
+#ifndef NITCBASE_BLOCKLATCH_H
+#define NITCBASE_BLOCKLATCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "../define/constants.h"
+
+/*
+Version latches of the index blocks, for readers of the B+ trees running in
+other threads alongside a writer (see BPlusTree::bPlusLookup()).
+
+Every block has a version, odd while a writer is modifying the block. A writer
+runs between beginWrite() and endWrite() (one writer at a time); the first
+modification of an index block in between makes its version odd (see latch(),
+called by the methods of BlockBuffer that modify a block), and endWrite() makes
+the versions of all the blocks modified even again. A node split or merge thus
+appears to readers as a whole, never half done.
+
+A reader takes the version of a block (waiting while it is odd) before copying
+the block (see StaticBuffer::readBlock()), and checks after the copy that the
+version is still the same (the copy may be torn otherwise, and is discarded).
+Going down from a node to a child, the reader takes the version of the child
+before checking the version of the node again (lock coupling), so the child
+was in the tree when its version was taken.
+Writes outside of beginWrite() and endWrite() do not latch blocks; they may
+not run along with readers.
+*/
+class BlockLatch {
+ private:
+  static std::atomic<uint32_t> versions[DISK_BLOCKS];
+  static std::recursive_mutex writerMutex;
+  static int writeDepth;
+  static std::vector<int> latched;
+
+ public:
+  // a write from the construction of the object to its destruction (see beginWrite())
+  class WriteGuard {
+   public:
+    WriteGuard() { BlockLatch::beginWrite(); }
+    ~WriteGuard() { BlockLatch::endWrite(); }
+  };
+
+  static void beginWrite();
+  static void endWrite();
+  static void latch(int blockNum);
+  static uint32_t readLock(int blockNum);
+  static bool validate(int blockNum, uint32_t version);
+};
+
+#endif  // NITCBASE_BLOCKLATCH_H
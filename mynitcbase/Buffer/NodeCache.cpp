@@ -0,0 +1,113 @@
+#include "NodeCache.h"
+
+// the declarations for this class can be found at "NodeCache.h"
+
+struct CachedNode NodeCache::nodes[NODE_CACHE_CAPACITY];
+int NodeCache::clock = 0;
+bool NodeCache::enabled = true;
+
+/*
+Returns the internal node blockNum, at depth `level` below the root of its B+
+tree, from the cache (decoding it into the cache if it is not there yet).
+Returns nullptr if the node is not to be cached (level >= NODE_CACHE_LEVELS, or
+the cache is disabled); the caller then reads the block through the buffer.
+NOTE: the node returned is only valid until the next call of a function of the
+cache or a modification of an index block.
+*/
+const struct CachedNode *NodeCache::getNode(int blockNum, int level) {
+    if (!enabled || level >= NODE_CACHE_LEVELS) {
+        return nullptr;
+    }
+
+    clock++;
+
+    // find the node, or else the entry to replace with it: a free entry, or
+    // the least recently used of the nodes of the deepest level
+    int victim = -1;
+    for (int i = 0; i < NODE_CACHE_CAPACITY; i++) {
+        if (nodes[i].blockNum == blockNum) {
+            nodes[i].level = level;
+            nodes[i].lastUsed = clock;
+            return &nodes[i];
+        }
+
+        if (victim != -1 && nodes[victim].blockNum == -1) {
+            continue;
+        }
+        if (victim == -1 || nodes[i].blockNum == -1 || nodes[i].level > nodes[victim].level ||
+            (nodes[i].level == nodes[victim].level && nodes[i].lastUsed < nodes[victim].lastUsed)) {
+            victim = i;
+        }
+    }
+
+    // (a node is not cached in place of one closer to the root)
+    if (nodes[victim].blockNum != -1 && nodes[victim].level < level) {
+        return nullptr;
+    }
+
+    struct CachedNode *node = &nodes[victim];
+    node->blockNum = -1;
+
+    IndInternal internalBlk(blockNum);
+    int numKeys = internalBlk.getNode(node->children, node->keys);
+    if (numKeys < 0) {
+        return nullptr;
+    }
+
+    node->blockNum = blockNum;
+    node->level = level;
+    node->lastUsed = clock;
+    node->numKeys = numKeys;
+
+    return node;
+}
+
+/*
+IndInternal::searchEntries() for a cached node: returns the index of the first
+key of the node >= attrVal (> attrVal if `strict`), or numKeys if there is none
+*/
+int NodeCache::searchNode(const struct CachedNode *node, union Attribute attrVal, int attrType, bool strict) {
+    int low = 0, high = node->numKeys;
+    while (low < high) {
+        int mid = (low + high) / 2;
+
+        int cmpVal = compareAttrs(node->keys[mid], attrVal, attrType);
+        if (cmpVal > 0 || (cmpVal == 0 && !strict)) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    return low;
+}
+
+// drops the node blockNum from the cache (if it is there)
+void NodeCache::invalidate(int blockNum) {
+    for (int i = 0; i < NODE_CACHE_CAPACITY; i++) {
+        if (nodes[i].blockNum == blockNum) {
+            nodes[i].blockNum = -1;
+            return;
+        }
+    }
+}
+
+// empties the cache
+void NodeCache::clear() {
+    for (int i = 0; i < NODE_CACHE_CAPACITY; i++) {
+        nodes[i].blockNum = -1;
+    }
+}
+
+/*
+Turns the cache on or off (used to compare the descents of the B+ trees with
+and without it; see FUNCTION index_cache). A disabled cache is emptied.
+*/
+void NodeCache::setEnabled(bool enable) {
+    enabled = enable;
+    clear();
+}
+
+bool NodeCache::isEnabled() {
+    return enabled;
+}
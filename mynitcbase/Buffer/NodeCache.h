@@ -0,0 +1,43 @@
+#ifndef NITCBASE_NODECACHE_H
+#define NITCBASE_NODECACHE_H
+
+#include "BlockBuffer.h"
+#include "../define/constants.h"
+
+// An internal node of a B+ tree, decoded (the keys of a prefix compressed node in full)
+struct CachedNode {
+  int blockNum;  // -1 if the entry is free
+  int level;     // depth of the node below the root when it was last used (0 for the root)
+  int lastUsed;  // value of NodeCache::clock when the node was last used
+  int numKeys;
+  int children[MAX_KEYS_INTERNAL_PREFIX + 1];
+  union Attribute keys[MAX_KEYS_INTERNAL_PREFIX];
+};
+
+/*
+Holds the internal nodes of the top NODE_CACHE_LEVELS levels of the B+ trees
+decoded in memory, apart from the blocks of the StaticBuffer, so that a descent
+from the root reads the upper levels without going through the buffer (where
+the scans of relations keep evicting them). When the cache is full, the least
+recently used of the deepest nodes is replaced; the roots, used by every
+descent, stay resident.
+A node is dropped from the cache whenever its block is modified (see
+StaticBuffer::setDirtyBit()) or released, so the cache never holds a node that
+differs from its block.
+*/
+class NodeCache {
+ private:
+  static struct CachedNode nodes[NODE_CACHE_CAPACITY];
+  static int clock;
+  static bool enabled;
+
+ public:
+  static const struct CachedNode *getNode(int blockNum, int level);
+  static int searchNode(const struct CachedNode *node, union Attribute attrVal, int attrType, bool strict);
+  static void invalidate(int blockNum);
+  static void clear();
+  static void setEnabled(bool enable);
+  static bool isEnabled();
+};
+
+#endif  // NITCBASE_NODECACHE_H
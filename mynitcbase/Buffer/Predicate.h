@@ -0,0 +1,89 @@
+#ifndef NITCBASE_PREDICATE_H
+#define NITCBASE_PREDICATE_H
+
+#include <cstring>
+
+#include "../define/constants.h"
+#include "BlockBuffer.h"
+
+/*
+Conditions `attr op value` specialised at compile time for each attribute type
+and conditional operator.
+
+compareAttrs() takes the attribute type at run time and its result is then
+tested against op; in a loop over many records or index entries both are the
+same in every iteration. Loops over records / index entries are instead written
+as templates on <ATTR_TYPE, OP> using Predicate<ATTR_TYPE, OP>::satisfies(), and
+the instantiation for a search is picked once (see PREDICATE_DISPATCH_TABLE).
+*/
+
+// lhs op rhs, for each conditional operator
+template <int OP>
+struct OperatorTest;
+
+template <>
+struct OperatorTest<EQ> {
+  template <typename T>
+  static inline bool test(T lhs, T rhs) { return lhs == rhs; }
+};
+
+template <>
+struct OperatorTest<LE> {
+  template <typename T>
+  static inline bool test(T lhs, T rhs) { return lhs <= rhs; }
+};
+
+template <>
+struct OperatorTest<LT> {
+  template <typename T>
+  static inline bool test(T lhs, T rhs) { return lhs < rhs; }
+};
+
+template <>
+struct OperatorTest<GE> {
+  template <typename T>
+  static inline bool test(T lhs, T rhs) { return lhs >= rhs; }
+};
+
+template <>
+struct OperatorTest<GT> {
+  template <typename T>
+  static inline bool test(T lhs, T rhs) { return lhs > rhs; }
+};
+
+template <>
+struct OperatorTest<NE> {
+  template <typename T>
+  static inline bool test(T lhs, T rhs) { return lhs != rhs; }
+};
+
+// attr op value, for each attribute type and conditional operator
+template <int ATTR_TYPE, int OP>
+struct Predicate;
+
+template <int OP>
+struct Predicate<NUMBER, OP> {
+  static inline bool satisfies(const Attribute &attr, const Attribute &value) {
+    return OperatorTest<OP>::test(attr.nVal, value.nVal);
+  }
+};
+
+template <int OP>
+struct Predicate<STRING, OP> {
+  static inline bool satisfies(const Attribute &attr, const Attribute &value) {
+    return OperatorTest<OP>::test(strcmp(attr.sVal, value.sVal), 0);
+  }
+};
+
+/*
+Initializer of a table of the instantiations FUNC<ATTR_TYPE, OP> of a function
+template, indexed as table[attrType][op].
+eg: static FindFunction findFunctions[2][6] = PREDICATE_DISPATCH_TABLE(findFirst);
+*/
+#define PREDICATE_DISPATCH_TABLE(FUNC)                                                                       \
+  {                                                                                                          \
+    {FUNC<NUMBER, EQ>, FUNC<NUMBER, LE>, FUNC<NUMBER, LT>, FUNC<NUMBER, GE>, FUNC<NUMBER, GT>, FUNC<NUMBER, NE>}, \
+    {FUNC<STRING, EQ>, FUNC<STRING, LE>, FUNC<STRING, LT>, FUNC<STRING, GE>, FUNC<STRING, GT>, FUNC<STRING, NE>}  \
+  }
+
+#endif  // NITCBASE_PREDICATE_H
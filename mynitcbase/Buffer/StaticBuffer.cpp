@@ -1,11 +1,17 @@
 #include "StaticBuffer.h"
 
+#include "NodeCache.h"
+
+#include <cstring>
+
 // the declarations for this class can be found at "StaticBuffer.h"
 
 unsigned char StaticBuffer::blocks[BUFFER_CAPACITY][BLOCK_SIZE];
 struct BufferMetaInfo StaticBuffer::metainfo[BUFFER_CAPACITY];
 // declare the blockAllocMap array
 unsigned char StaticBuffer::blockAllocMap[DISK_BLOCKS];
+std::mutex StaticBuffer::bufferMutex;
+int StaticBuffer::allocationStart = 0;
 
 StaticBuffer::StaticBuffer() {
   // copy blockAllocMap blocks from disk to buffer (using readblock() of disk)
@@ -24,6 +30,9 @@ StaticBuffer::StaticBuffer() {
     metainfo[bufferIndex].blockNum = -1;
 
   }
+
+  // no index node is cached yet
+  NodeCache::clear();
 }
 
 // write back all modified blocks on system exit
@@ -90,8 +99,12 @@ int StaticBuffer::getFreeBuffer(int blockNum) {
   }
   
 
+  // (the buffer now holds an unmodified copy of the block, which is the
+  //  most recently used one)
   metainfo[allocatedBuffer].free = false;
+  metainfo[allocatedBuffer].dirty = false;
   metainfo[allocatedBuffer].blockNum = blockNum;
+  metainfo[allocatedBuffer].timeStamp = 0;
 
   return allocatedBuffer;
 
@@ -121,6 +134,11 @@ int StaticBuffer::getBufferNum(int blockNum) {
 }
 
 int StaticBuffer::setDirtyBit(int blockNum){
+    // (a modified internal index block no longer matches its decoded copy, if any)
+    if (blockNum >= 0 && blockNum < DISK_BLOCKS && blockAllocMap[blockNum] == IND_INTERNAL) {
+        NodeCache::invalidate(blockNum);
+    }
+
     // find the buffer index corresponding to the block using getBufferNum().
     int bufferNum = StaticBuffer::getBufferNum(blockNum);
 
@@ -145,6 +163,77 @@ int StaticBuffer::setDirtyBit(int blockNum){
     return SUCCESS;
 }
 
+/*
+Copies the block to `block`: from its buffer if the block is in the buffer,
+from the disk otherwise (without assigning a buffer to it). Unlike the methods
+of BlockBuffer, this may be called by several threads along with a writer; the
+block is looked up and copied holding bufferMutex, which the writer holds while
+it assigns a buffer to a block or frees one. The writer may still be modifying
+the block, or may write it to the disk while it is read; the caller uses the
+version of the block to detect it (see BlockLatch).
+*/
+int StaticBuffer::readBlock(int blockNum, unsigned char *block){
+    if (blockNum < 0 || blockNum >= DISK_BLOCKS) {
+        return E_OUTOFBOUND;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(bufferMutex);
+        for (int bufferIndex = 0; bufferIndex < BUFFER_CAPACITY; bufferIndex++) {
+            if (!metainfo[bufferIndex].free && metainfo[bufferIndex].blockNum == blockNum) {
+                memcpy(block, blocks[bufferIndex], BLOCK_SIZE);
+                return SUCCESS;
+            }
+        }
+    }
+
+    return Disk::readBlock(block, blockNum);
+}
+
+/*
+Returns the first block of the first run of numBlocks consecutive free blocks
+of the disk, or of the longest run of free blocks if there is no such run
+(E_DISKFULL if no block is free).
+*/
+int StaticBuffer::findFreeRun(int numBlocks){
+    int longestStart = E_DISKFULL, longestLength = 0;
+
+    int runStart = -1;
+    for (int blockNum = 0; blockNum < DISK_BLOCKS; blockNum++) {
+        if (blockAllocMap[blockNum] != UNUSED_BLK) {
+            runStart = -1;
+            continue;
+        }
+
+        if (runStart == -1) {
+            runStart = blockNum;
+        }
+        int length = blockNum - runStart + 1;
+        if (length >= numBlocks) {
+            return runStart;
+        }
+        if (length > longestLength) {
+            longestStart = runStart;
+            longestLength = length;
+        }
+    }
+
+    return longestStart;
+}
+
+/*
+Makes BlockBuffer::getFreeBlock() look for free blocks from blockNum onwards
+(wrapping around to block 0), so that the blocks allocated next are taken in
+order from a run of free blocks (see findFreeRun()). The blocks are looked for
+from block 0 again after setAllocationStart(0).
+*/
+void StaticBuffer::setAllocationStart(int blockNum){
+    if (blockNum < 0 || blockNum >= DISK_BLOCKS) {
+        blockNum = 0;
+    }
+    allocationStart = blockNum;
+}
+
 int StaticBuffer::getStaticBlockType(int blockNum){
     // Check if blockNum is valid (non zero and less than number of disk blocks)
     // and return E_OUTOFBOUND if not valid.
@@ -1,6 +1,8 @@
 #ifndef NITCBASE_STATICBUFFER_H
 #define NITCBASE_STATICBUFFER_H
 
+#include <mutex>
+
 #include "../Disk_Class/Disk.h"
 #include "../define/constants.h"
 
@@ -19,6 +21,8 @@ class StaticBuffer {
   static unsigned char blocks[BUFFER_CAPACITY][BLOCK_SIZE];
   static struct BufferMetaInfo metainfo[BUFFER_CAPACITY];
   static unsigned char blockAllocMap[DISK_BLOCKS];
+  static std::mutex bufferMutex;  // held while a buffer is assigned to a block or freed (see readBlock())
+  static int allocationStart;     // block from which free blocks are looked for (see setAllocationStart())
 
   // methods
   static int getFreeBuffer(int blockNum);
@@ -28,6 +32,9 @@ class StaticBuffer {
   // methods
   static int getStaticBlockType(int blockNum);
   static int setDirtyBit(int blockNum);
+  static int readBlock(int blockNum, unsigned char *block);
+  static int findFreeRun(int numBlocks);
+  static void setAllocationStart(int blockNum);
   StaticBuffer();
   ~StaticBuffer();
 };
@@ -52,6 +52,14 @@ void AttrCacheTable::recordToAttrCatEntry(union Attribute record[ATTRCAT_NO_ATTR
     attrCatEntry->rootBlock = (int)record[ATTRCAT_ROOT_BLOCK_INDEX].nVal;
     attrCatEntry->offset = (int)record[ATTRCAT_OFFSET_INDEX].nVal;
 
+    // (the bloom filter, the included attribute, the hash and bitmap indexes and the statistics are not
+    //  recorded in the attribute catalog, they are set from the index catalog when the relation is opened)
+    attrCatEntry->bloomBlock = -1;
+    attrCatEntry->includeOffset = -1;
+    attrCatEntry->hashBlock = -1;
+    attrCatEntry->bitmapBlock = -1;
+    attrCatEntry->statsBlock = -1;
+
 }
 
 /* returns the attribute with name `attrName` for the relation corresponding to relId
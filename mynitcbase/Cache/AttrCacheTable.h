@@ -12,6 +12,11 @@ typedef struct AttrCatEntry {
   bool primaryFlag;
   int rootBlock;
   int offset;
+  int bloomBlock;  // head block of the bloom filter on the attribute (from the index catalog, -1 if none)
+  int includeOffset;  // offset of the attribute included in the leaf entries of its B+ tree (from the index catalog, -1 if none)
+  int hashBlock;  // head block of the hash index on the attribute (from the index catalog, -1 if none)
+  int bitmapBlock;  // head block of the bitmap index on the attribute (from the index catalog, -1 if none)
+  int statsBlock;  // block of the statistics of the attribute (from the index catalog, -1 if not analyzed)
 
 } AttrCatEntry;
 
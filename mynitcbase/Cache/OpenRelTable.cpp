@@ -1,5 +1,6 @@
 #include "OpenRelTable.h"
 #include <iostream>
+#include <algorithm>
 #include <cstring>
 
 OpenRelTableMetaInfo OpenRelTable::tableMetaInfo[MAX_OPEN];
@@ -30,6 +31,7 @@ OpenRelTable::OpenRelTable()
   relCacheEntry->recId.slot = RELCAT_SLOTNUM_FOR_RELCAT;
   relCacheEntry->dirty = false;
   relCacheEntry->searchIndex = {-1, -1};
+  relCacheEntry->numCompositeIndexes = 0;
 
   // allocate this on the heap because we want it to persist outside this function
   RelCacheTable::relCache[RELCAT_RELID] = relCacheEntry;
@@ -47,6 +49,7 @@ OpenRelTable::OpenRelTable()
   relCacheEntry->recId.slot = RELCAT_SLOTNUM_FOR_ATTRCAT;
   relCacheEntry->dirty = false;
   relCacheEntry->searchIndex = {-1, -1};
+  relCacheEntry->numCompositeIndexes = 0;
 
   // set the value at RelCacheTable::relCache[ATTRCAT_RELID]
   // allocate this on the heap because we want it to persist outside this function
@@ -81,6 +84,7 @@ OpenRelTable::OpenRelTable()
     currAttrCacheEntry->searchIndex = {-1, -1};
     currAttrCacheEntry->dirty = false;
   }
+  currAttrCacheEntry->next = nullptr;
   AttrCacheTable::attrCache[RELCAT_RELID] = attrLinkedListHead; // head of the linked list
   attrLinkedListHead = nullptr;
 
@@ -104,6 +108,7 @@ OpenRelTable::OpenRelTable()
     currAttrCacheEntry->searchIndex = {-1, -1};
     currAttrCacheEntry->dirty = false;
   }
+  currAttrCacheEntry->next = nullptr;
   AttrCacheTable::attrCache[ATTRCAT_RELID] = attrLinkedListHead; // head of the linked list
   attrLinkedListHead = nullptr;
 
@@ -123,18 +128,30 @@ OpenRelTable::OpenRelTable()
     tableMetaInfo[i].free = true;
     tableMetaInfo[i].relName[0] = '\0';
   }
+
+  /************ Opening the Index Catalog ************/
+  // (the index catalog is created when the first index structure recorded in
+  //  it is created. if it exists, it is kept open at INDEXCAT_RELID so that
+  //  openRel() can find the structures on the attributes of a relation)
+  char indexCatName[] = INDEXCAT_RELNAME;
+  OpenRelTable::openRel(indexCatName);
 }
 
 OpenRelTable::~OpenRelTable()
 {
   // close all open relations (from rel-id = 2 onwards. Why?)
-  for (int i = 2; i < MAX_OPEN; ++i)
+  // (the index catalog is closed last: closing a relation may update its entries)
+  for (int i = INDEXCAT_RELID + 1; i < MAX_OPEN; ++i)
   {
     if (!tableMetaInfo[i].free)
     {
       OpenRelTable::closeRel(i); // we will implement this function later
     }
   }
+  if (!tableMetaInfo[INDEXCAT_RELID].free)
+  {
+    OpenRelTable::closeRel(INDEXCAT_RELID);
+  }
   /**** Closing the catalog relations in the relation cache ****/
 
   // releasing the relation cache entry of the attribute catalog
@@ -221,7 +238,8 @@ int OpenRelTable::getFreeOpenRelTableEntry()
   /* traverse through the tableMetaInfo array,
     find a free entry in the Open Relation Table.*/
 
-  for (int i = 2; i < MAX_OPEN; ++i)
+  // (INDEXCAT_RELID is reserved for the index catalog)
+  for (int i = INDEXCAT_RELID + 1; i < MAX_OPEN; ++i)
   {
     if (tableMetaInfo[i].free)
     {
@@ -267,6 +285,12 @@ int OpenRelTable::openRel(char relName[ATTR_SIZE])
      using OpenRelTable::getFreeOpenRelTableEntry(). */
   relId = getFreeOpenRelTableEntry();
 
+  // the index catalog always uses its reserved slot
+  if (strcmp(relName, INDEXCAT_RELNAME) == 0)
+  {
+    relId = INDEXCAT_RELID;
+  }
+
   if (relId == E_CACHEFULL)
   { /* free slot not available */
     return E_CACHEFULL;
@@ -301,6 +325,7 @@ int OpenRelTable::openRel(char relName[ATTR_SIZE])
   relCacheEntry->recId.slot = recId.slot;
   relCacheEntry->dirty = false;
   relCacheEntry->searchIndex = {-1, -1};
+  relCacheEntry->numCompositeIndexes = 0;
 
   // allocate this on the heap because we want it to persist outside this function
   RelCacheTable::relCache[relId] = relCacheEntry;
@@ -344,8 +369,109 @@ int OpenRelTable::openRel(char relName[ATTR_SIZE])
     recId = BlockAccess::linearSearch(ATTRCAT_RELID, relNameAttrConst, relNameAttr, EQ);
   }
 
+  if (attrLinkedListHead != nullptr)
+  {
+    currAttrCacheEntry->next = nullptr;
+  }
   AttrCacheTable::attrCache[relId] = attrLinkedListHead; // head of the linked list
 
+  /**** setting the bloom filters, hash and bitmap indexes on the attributes and the composite indexes
+        of the relation from the Index Catalog ****/
+  if (relId != INDEXCAT_RELID && !tableMetaInfo[INDEXCAT_RELID].free)
+  {
+    char indexCatRelNameConst[] = INDEXCAT_ATTR_RELNAME;
+    RelCacheTable::resetSearchIndex(INDEXCAT_RELID);
+
+    while (true)
+    {
+      // linear search on the index catalog for RelName = relName
+      recId = BlockAccess::linearSearch(INDEXCAT_RELID, indexCatRelNameConst, relNameAttr, EQ);
+      if (recId.block == -1 && recId.slot == -1)
+      {
+        break;
+      }
+
+      Attribute indexCatRecord[INDEXCAT_NO_ATTRS];
+      RecBuffer indexCatBlock(recId.block);
+      indexCatBlock.getRecord(indexCatRecord, recId.slot);
+
+      // find the attribute cache entry of the attribute the entry is on
+      AttrCacheEntry *attrEntry = attrLinkedListHead;
+      while (attrEntry != nullptr &&
+             strcmp(attrEntry->attrCatEntry.attrName, indexCatRecord[INDEXCAT_ATTR_NAME_INDEX].sVal) != 0)
+      {
+        attrEntry = attrEntry->next;
+      }
+      if (attrEntry == nullptr)
+      {
+        continue;
+      }
+
+      int indexType = (int)indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal;
+      if (indexType == INDEX_BLOOM)
+      {
+        attrEntry->attrCatEntry.bloomBlock = (int)indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal;
+      }
+      else if (indexType == INDEX_HASH)
+      {
+        attrEntry->attrCatEntry.hashBlock = (int)indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal;
+      }
+      else if (indexType == INDEX_BITMAP)
+      {
+        attrEntry->attrCatEntry.bitmapBlock = (int)indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal;
+      }
+      else if (indexType == INDEX_STATS)
+      {
+        attrEntry->attrCatEntry.statsBlock = (int)indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal;
+      }
+      else if (indexType == INDEX_INCLUDE)
+      {
+        // (the entry is on the included attribute; the index is on the attribute IndexName)
+        for (AttrCacheEntry *keyEntry = attrLinkedListHead; keyEntry != nullptr; keyEntry = keyEntry->next)
+        {
+          if (strcmp(keyEntry->attrCatEntry.attrName, indexCatRecord[INDEXCAT_INDEX_NAME_INDEX].sVal) == 0)
+          {
+            keyEntry->attrCatEntry.includeOffset = attrEntry->attrCatEntry.offset;
+          }
+        }
+      }
+      else if (indexType == INDEX_COMPOSITE)
+      {
+        /* an entry records one attribute of the key of the index (at position
+           KeyNum); find the index among those seen so far or add it */
+        int indexNum = 0;
+        while (indexNum < relCacheEntry->numCompositeIndexes &&
+               strcmp(relCacheEntry->compositeIndexes[indexNum].indexName,
+                      indexCatRecord[INDEXCAT_INDEX_NAME_INDEX].sVal) != 0)
+        {
+          indexNum++;
+        }
+        if (indexNum == MAX_COMPOSITE_INDEXES)
+        {
+          continue;
+        }
+
+        CompositeIndexInfo *index = &relCacheEntry->compositeIndexes[indexNum];
+        if (indexNum == relCacheEntry->numCompositeIndexes)
+        {
+          strcpy(index->indexName, indexCatRecord[INDEXCAT_INDEX_NAME_INDEX].sVal);
+          index->numKeys = 0;
+          index->rootBlock = (int)indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal;
+          index->dirty = false;
+          relCacheEntry->numCompositeIndexes++;
+        }
+
+        int keyNum = (int)indexCatRecord[INDEXCAT_KEY_NUM_INDEX].nVal;
+        if (keyNum >= 0 && keyNum < MAX_INDEX_KEYS)
+        {
+          index->keyOffsets[keyNum] = attrEntry->attrCatEntry.offset;
+          index->keyTypes[keyNum] = attrEntry->attrCatEntry.attrType;
+          index->numKeys = std::max(index->numKeys, keyNum + 1);
+        }
+      }
+    }
+  }
+
   // update the relIdth entry of the tableMetaInfo with free as false and
   // relName as the input.
   tableMetaInfo[relId].free = false;
@@ -388,6 +514,41 @@ int OpenRelTable::closeRel(int relId)
     // Write back to the buffer using relCatBlock.setRecord() with recId.slot
     relCatBlock.setRecord(record, recId.slot);
   }
+  /****** Writing back the root blocks of the composite indexes that have changed ******/
+  // (to their entries in the index catalog, which is closed last)
+  RelCacheEntry *cacheEntry = RelCacheTable::relCache[relId];
+  for (int i = 0; i < cacheEntry->numCompositeIndexes; i++)
+  {
+    CompositeIndexInfo *index = &cacheEntry->compositeIndexes[i];
+    if (!index->dirty || relId == INDEXCAT_RELID || tableMetaInfo[INDEXCAT_RELID].free)
+    {
+      continue;
+    }
+
+    char indexCatRelNameConst[] = INDEXCAT_ATTR_RELNAME;
+    Attribute relNameAttr;
+    strcpy(relNameAttr.sVal, cacheEntry->relCatEntry.relName);
+    RelCacheTable::resetSearchIndex(INDEXCAT_RELID);
+    while (true)
+    {
+      RecId recId = BlockAccess::linearSearch(INDEXCAT_RELID, indexCatRelNameConst, relNameAttr, EQ);
+      if (recId.block == -1 && recId.slot == -1)
+      {
+        break;
+      }
+
+      Attribute indexCatRecord[INDEXCAT_NO_ATTRS];
+      RecBuffer indexCatBlock(recId.block);
+      indexCatBlock.getRecord(indexCatRecord, recId.slot);
+      if ((int)indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal == INDEX_COMPOSITE &&
+          strcmp(indexCatRecord[INDEXCAT_INDEX_NAME_INDEX].sVal, index->indexName) == 0)
+      {
+        indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal = index->rootBlock;
+        indexCatBlock.setRecord(indexCatRecord, recId.slot);
+      }
+    }
+  }
+
   /****** Releasing the Attribute Cache entry of the relation ******/
 
   // free the memory allocated in the relation and attribute caches which was
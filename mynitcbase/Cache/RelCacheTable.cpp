@@ -134,4 +134,127 @@ void RelCacheTable::relCatEntryToRecord(RelCatEntry *relCatEntry, union Attribut
   record[RELCAT_FIRST_BLOCK_INDEX].nVal = relCatEntry->firstBlk;
   record[RELCAT_LAST_BLOCK_INDEX].nVal = relCatEntry->lastBlk;
   record[RELCAT_NO_SLOTS_PER_BLOCK_INDEX].nVal = relCatEntry->numSlotsPerBlk;
-}
\ No newline at end of file
+}
+
+/*
+Get the composite index named indexName on the relation with rel-id `relId`
+(E_NOINDEX if the relation has no such index)
+NOTE: this function expects the caller to allocate memory for `*indexBuf`
+*/
+int RelCacheTable::getCompositeIndex(int relId, char indexName[ATTR_SIZE], CompositeIndexInfo *indexBuf)
+{
+  if (relId < 0 || relId >= MAX_OPEN)
+  {
+    return E_OUTOFBOUND;
+  }
+
+  if (relCache[relId] == nullptr)
+  {
+    return E_RELNOTOPEN;
+  }
+
+  for (int i = 0; i < relCache[relId]->numCompositeIndexes; i++)
+  {
+    if (strcmp(relCache[relId]->compositeIndexes[i].indexName, indexName) == 0)
+    {
+      *indexBuf = relCache[relId]->compositeIndexes[i];
+      return SUCCESS;
+    }
+  }
+
+  return E_NOINDEX;
+}
+
+/*
+Get the indexNum'th composite index on the relation with rel-id `relId`
+(E_OUTOFBOUND once indexNum reaches the number of composite indexes)
+NOTE: this function expects the caller to allocate memory for `*indexBuf`
+*/
+int RelCacheTable::getCompositeIndex(int relId, int indexNum, CompositeIndexInfo *indexBuf)
+{
+  if (relId < 0 || relId >= MAX_OPEN)
+  {
+    return E_OUTOFBOUND;
+  }
+
+  if (relCache[relId] == nullptr)
+  {
+    return E_RELNOTOPEN;
+  }
+
+  if (indexNum < 0 || indexNum >= relCache[relId]->numCompositeIndexes)
+  {
+    return E_OUTOFBOUND;
+  }
+
+  *indexBuf = relCache[relId]->compositeIndexes[indexNum];
+  return SUCCESS;
+}
+
+/*
+Sets the composite index of the relation with the name in indexBuf (adding it
+if the relation has no index of that name) and marks it dirty.
+Returns E_CACHEFULL if the relation already has MAX_COMPOSITE_INDEXES indexes.
+*/
+int RelCacheTable::setCompositeIndex(int relId, CompositeIndexInfo *indexBuf)
+{
+  if (relId < 0 || relId >= MAX_OPEN)
+  {
+    return E_OUTOFBOUND;
+  }
+
+  if (relCache[relId] == nullptr)
+  {
+    return E_RELNOTOPEN;
+  }
+
+  RelCacheEntry *entry = relCache[relId];
+  int indexNum = 0;
+  while (indexNum < entry->numCompositeIndexes &&
+         strcmp(entry->compositeIndexes[indexNum].indexName, indexBuf->indexName) != 0)
+  {
+    indexNum++;
+  }
+
+  if (indexNum == entry->numCompositeIndexes)
+  {
+    if (indexNum == MAX_COMPOSITE_INDEXES)
+    {
+      return E_CACHEFULL;
+    }
+    entry->numCompositeIndexes++;
+  }
+
+  entry->compositeIndexes[indexNum] = *indexBuf;
+  entry->compositeIndexes[indexNum].dirty = true;
+
+  return SUCCESS;
+}
+
+// removes the composite index named indexName from the relation with rel-id `relId`
+int RelCacheTable::removeCompositeIndex(int relId, char indexName[ATTR_SIZE])
+{
+  if (relId < 0 || relId >= MAX_OPEN)
+  {
+    return E_OUTOFBOUND;
+  }
+
+  if (relCache[relId] == nullptr)
+  {
+    return E_RELNOTOPEN;
+  }
+
+  RelCacheEntry *entry = relCache[relId];
+  for (int i = 0; i < entry->numCompositeIndexes; i++)
+  {
+    if (strcmp(entry->compositeIndexes[i].indexName, indexName) == 0)
+    {
+      // (move the last index into its place)
+      entry->compositeIndexes[i] = entry->compositeIndexes[entry->numCompositeIndexes - 1];
+      entry->numCompositeIndexes--;
+      return SUCCESS;
+    }
+  }
+
+  return E_NOINDEX;
+}
@@ -15,11 +15,23 @@ typedef struct RelCatEntry {
 
 } RelCatEntry;
 
+// A composite index on the relation (from the index catalog)
+typedef struct CompositeIndexInfo {
+  char indexName[ATTR_SIZE];
+  int numKeys;
+  int keyOffsets[MAX_INDEX_KEYS];  // offsets of the key attributes, in key order
+  int keyTypes[MAX_INDEX_KEYS];
+  int rootBlock;
+  bool dirty;  // (set if rootBlock has changed since the index catalog was read)
+} CompositeIndexInfo;
+
 typedef struct RelCacheEntry {
   RelCatEntry relCatEntry;
   bool dirty;
   RecId recId;
   RecId searchIndex;
+  int numCompositeIndexes;
+  CompositeIndexInfo compositeIndexes[MAX_COMPOSITE_INDEXES];
 
 } RelCacheEntry;
 
@@ -33,6 +45,10 @@ class RelCacheTable {
   static int getSearchIndex(int relId, RecId *searchIndex);
   static int setSearchIndex(int relId, RecId *searchIndex);
   static int resetSearchIndex(int relId);
+  static int getCompositeIndex(int relId, char indexName[ATTR_SIZE], CompositeIndexInfo *indexBuf);
+  static int getCompositeIndex(int relId, int indexNum, CompositeIndexInfo *indexBuf);
+  static int setCompositeIndex(int relId, CompositeIndexInfo *indexBuf);
+  static int removeCompositeIndex(int relId, char indexName[ATTR_SIZE]);
 
  private:
   // field
@@ -0,0 +1,1043 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/*
+FUNCTION bench_kernels:
+micro-benchmark of the predicate kernels (see PredicateKernels::benchmark()).
+*/
+int Benchmarks::benchKernels(char argv[][ATTR_SIZE]) {
+  PredicateKernels::benchmark();
+  return SUCCESS;
+}
+
+/*
+FUNCTION bench_search <relation> <attribute> <EQ|LE|LT|GE|GT|NE> <value>:
+times searches of an open relation through BlockAccess::search() (i.e. the
+linear search, or the B+ tree, hash or bitmap index search if the attribute has
+an index and BlockAccess::planSearch() picks it), each one repeated until no
+more records satisfy the condition.
+*/
+int Benchmarks::benchSearch(char argv[][ATTR_SIZE]) {
+  const int iterations = 20;
+  const char *opNames[] = {"EQ", "LE", "LT", "GE", "GT", "NE"};
+
+  int relId = OpenRelTable::getRelId(argv[1]);
+  if (relId < 0) {
+    return E_RELNOTOPEN;
+  }
+
+  AttrCatEntry attrCatEntry;
+  int ret = AttrCacheTable::getAttrCatEntry(relId, argv[2], &attrCatEntry);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  int op = -1;
+  for (int i = 0; i < 6; i++) {
+    if (strcmp(argv[3], opNames[i]) == 0) {
+      op = i;
+    }
+  }
+  if (op == -1) {
+    return E_INVALID;
+  }
+
+  Attribute attrVal;
+  if (attrCatEntry.attrType == NUMBER) {
+    char *end;
+    attrVal.nVal = strtod(argv[4], &end);
+    if (*end != '\0') {
+      return E_ATTRTYPEMISMATCH;
+    }
+  } else {
+    strcpy(attrVal.sVal, argv[4]);
+  }
+
+  RelCatEntry relCatEntry;
+  RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+  Attribute record[relCatEntry.numAttrs];
+
+  const char *methodNames[] = {"linear search", "B+ tree search", "hash index search", "bitmap index search"};
+  AccessPlan plan;
+  BlockAccess::planSearch(relId, argv[2], attrVal, op, &plan);
+
+  int numFound = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    RelCacheTable::resetSearchIndex(relId);
+    AttrCacheTable::resetSearchIndex(relId, argv[2]);
+
+    numFound = 0;
+    while (BlockAccess::search(relId, record, argv[2], attrVal, op) == SUCCESS) {
+      numFound++;
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double ms = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+  printf("%s.%s %s %s: %d records found, %.3f ms per search (%s)\n", argv[1], argv[2], argv[3], argv[4],
+         numFound, ms, methodNames[plan.method]);
+
+  return SUCCESS;
+}
+
+/*
+FUNCTION bench_sort <relation> <attribute> <memory blocks>:
+times an external sort of all the records of an open relation on an attribute
+with the given memory budget, and checks the order of the output.
+*/
+int Benchmarks::benchSort(char argv[][ATTR_SIZE]) {
+  int relId = OpenRelTable::getRelId(argv[1]);
+  if (relId < 0) {
+    return E_RELNOTOPEN;
+  }
+
+  AttrCatEntry attrCatEntry;
+  int ret = AttrCacheTable::getAttrCatEntry(relId, argv[2], &attrCatEntry);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  char *end;
+  int memoryBlocks = strtol(argv[3], &end, 10);
+  if (*end != '\0') {
+    return E_INVALID;
+  }
+
+  RelCatEntry relCatEntry;
+  RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+  int numAttrs = relCatEntry.numAttrs;
+
+  auto start = std::chrono::steady_clock::now();
+
+  SortState sortState;
+  ret = ExternalSort::sortBegin(&sortState, numAttrs, attrCatEntry.offset, attrCatEntry.attrType, memoryBlocks);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  ScanCursor cursor;
+  BlockAccess::openScan(&cursor, relId, nullptr, Attribute(), EQ);
+  Attribute records[relCatEntry.numSlotsPerBlk * numAttrs];
+  int numRecords, numInput = 0;
+  while (ret == SUCCESS && BlockAccess::scanNext(&cursor, records, nullptr, &numRecords) == SUCCESS) {
+    for (int i = 0; i < numRecords && ret == SUCCESS; i++) {
+      ret = ExternalSort::sortAdd(&sortState, records + i * numAttrs);
+      numInput++;
+    }
+  }
+  if (ret == SUCCESS) {
+    ret = ExternalSort::sortEnd(&sortState);
+  }
+  if (ret != SUCCESS) {
+    ExternalSort::sortClose(&sortState);
+    return ret;
+  }
+
+  // read the output, checking that the keys are in order
+  Attribute record[numAttrs], prevRecord[numAttrs];
+  int numOutput = 0;
+  bool sorted = true;
+  while (ExternalSort::sortNext(&sortState, record) == SUCCESS) {
+    if (numOutput > 0 &&
+        compareAttrs(prevRecord[attrCatEntry.offset], record[attrCatEntry.offset], attrCatEntry.attrType) > 0) {
+      sorted = false;
+    }
+    memcpy(prevRecord, record, sizeof(record));
+    numOutput++;
+  }
+  ExternalSort::sortClose(&sortState);
+
+  auto stop = std::chrono::steady_clock::now();
+  double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+
+  printf("sorted %d records (%d blocks of input) with %d blocks of memory in %.3f ms\n", numOutput,
+         (numInput + sortState.recordsPerBlock - 1) / sortState.recordsPerBlock, memoryBlocks, ms);
+  printf("  %d initial runs, %d merge passes before the final merge, %d blocks written, %d blocks read, %s\n",
+         sortState.initialRuns, sortState.mergePasses, sortState.blocksWritten, sortState.blocksRead,
+         sorted && numOutput == numInput ? "output in order" : "OUTPUT NOT IN ORDER");
+
+  return SUCCESS;
+}
+
+/*
+FUNCTION bench_lookup <relation> <attribute> <fill factor>:
+rebuilds the index on an attribute of an open relation with the given fill
+factor (a lower fill factor gives a deeper tree), and times point lookups
+(BPlusTree::bPlusSearch() with EQ) of values of the attribute picked at random.
+*/
+int Benchmarks::benchLookup(char argv[][ATTR_SIZE]) {
+  const int numLookups = 200000;
+
+  int relId = OpenRelTable::getRelId(argv[1]);
+  if (relId < 0) {
+    return E_RELNOTOPEN;
+  }
+
+  char *end;
+  int fillFactor = strtol(argv[3], &end, 10);
+  if (*end != '\0') {
+    return E_INVALID;
+  }
+
+  // rebuild the index with the fill factor
+  int ret = Schema::dropIndex(argv[1], argv[2]);
+  if (ret != SUCCESS && ret != E_NOINDEX) {
+    return ret;
+  }
+  ret = BPlusTree::bPlusCreate(relId, argv[2], fillFactor);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  AttrCatEntry attrCatEntry;
+  AttrCacheTable::getAttrCatEntry(relId, argv[2], &attrCatEntry);
+
+  // depth of the tree (number of levels including the leaves)
+  int depth = 1;
+  int block = attrCatEntry.rootBlock;
+  while (StaticBuffer::getStaticBlockType(block) == IND_INTERNAL) {
+    block = IndInternal(block).getChild(0);
+    depth++;
+  }
+
+  // the values looked up are picked from the records of the relation
+  RelCatEntry relCatEntry;
+  RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+  std::vector<Attribute> values;
+  ScanCursor cursor;
+  BlockAccess::openScan(&cursor, relId, nullptr, Attribute(), EQ);
+  Attribute records[relCatEntry.numSlotsPerBlk * relCatEntry.numAttrs];
+  int numRecords;
+  while (BlockAccess::scanNext(&cursor, records, nullptr, &numRecords) == SUCCESS) {
+    for (int i = 0; i < numRecords; i++) {
+      values.push_back(records[i * relCatEntry.numAttrs + attrCatEntry.offset]);
+    }
+  }
+  if (values.empty()) {
+    return E_NOTFOUND;
+  }
+
+  unsigned int seed = 12345;
+  int numFound = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numLookups; i++) {
+    seed = seed * 1103515245 + 12345;
+    Attribute value = values[(seed >> 8) % values.size()];
+
+    AttrCacheTable::resetSearchIndex(relId, argv[2]);
+    RecId recId = BPlusTree::bPlusSearch(relId, argv[2], value, EQ);
+    if (recId.block != -1) {
+      numFound++;
+    }
+  }
+  auto stop = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(stop - start).count();
+
+  printf("%s.%s, fill factor %d, depth %d: %d of %d lookups found, %.0f lookups per second\n", argv[1], argv[2],
+         fillFactor, depth, numFound, numLookups, numLookups / seconds);
+
+  return SUCCESS;
+}
+
+/*
+FUNCTION bench_descent <relation> <attribute> <scanned relation>:
+times point lookups (BPlusTree::bPlusSearch() with EQ) in the B+ tree of an
+attribute of an open relation, each one after a scan of all the records of
+another open relation, which evicts the blocks of the B+ tree from the buffer.
+Only the lookups are timed; with the index node cache enabled (see FUNCTION
+index_cache), the upper levels of the tree are not read again after the scans.
+*/
+int Benchmarks::benchDescent(char argv[][ATTR_SIZE]) {
+  const int numLookups = 2000;
+
+  int relId = OpenRelTable::getRelId(argv[1]);
+  int scanRelId = OpenRelTable::getRelId(argv[3]);
+  if (relId < 0 || scanRelId < 0) {
+    return E_RELNOTOPEN;
+  }
+
+  AttrCatEntry attrCatEntry;
+  int ret = AttrCacheTable::getAttrCatEntry(relId, argv[2], &attrCatEntry);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  if (attrCatEntry.rootBlock == -1) {
+    return E_NOINDEX;
+  }
+
+  // depth of the tree (number of levels including the leaves)
+  int depth = 1;
+  int block = attrCatEntry.rootBlock;
+  while (StaticBuffer::getStaticBlockType(block) == IND_INTERNAL) {
+    block = IndInternal(block).getChild(0);
+    depth++;
+  }
+
+  // the values looked up are picked from the records of the relation
+  RelCatEntry relCatEntry;
+  RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+  std::vector<Attribute> values;
+  ScanCursor cursor;
+  BlockAccess::openScan(&cursor, relId, nullptr, Attribute(), EQ);
+  Attribute records[relCatEntry.numSlotsPerBlk * relCatEntry.numAttrs];
+  int numRecords;
+  while (BlockAccess::scanNext(&cursor, records, nullptr, &numRecords) == SUCCESS) {
+    for (int i = 0; i < numRecords; i++) {
+      values.push_back(records[i * relCatEntry.numAttrs + attrCatEntry.offset]);
+    }
+  }
+  if (values.empty()) {
+    return E_NOTFOUND;
+  }
+
+  RelCatEntry scanRelCatEntry;
+  RelCacheTable::getRelCatEntry(scanRelId, &scanRelCatEntry);
+  Attribute scanRecords[scanRelCatEntry.numSlotsPerBlk * scanRelCatEntry.numAttrs];
+
+  unsigned int seed = 12345;
+  int numFound = 0;
+  double seconds = 0;
+  for (int i = 0; i < numLookups; i++) {
+    ScanCursor scanCursor;
+    BlockAccess::openScan(&scanCursor, scanRelId, nullptr, Attribute(), EQ);
+    while (BlockAccess::scanNext(&scanCursor, scanRecords, nullptr, &numRecords) == SUCCESS) {
+    }
+
+    seed = seed * 1103515245 + 12345;
+    Attribute value = values[(seed >> 8) % values.size()];
+
+    auto start = std::chrono::steady_clock::now();
+    AttrCacheTable::resetSearchIndex(relId, argv[2]);
+    RecId recId = BPlusTree::bPlusSearch(relId, argv[2], value, EQ);
+    auto stop = std::chrono::steady_clock::now();
+    seconds += std::chrono::duration<double>(stop - start).count();
+
+    if (recId.block != -1) {
+      numFound++;
+    }
+  }
+
+  printf("%s.%s, depth %d, after scans of %s: %d of %d lookups found, %.2f us per lookup (index node cache %s)\n",
+         argv[1], argv[2], depth, argv[3], numFound, numLookups, seconds * 1e6 / numLookups,
+         NodeCache::isEnabled() ? "on" : "off");
+
+  return SUCCESS;
+}
+
+/*
+FUNCTION bench_threads <relation> <attribute> <threads>:
+times point lookups (BPlusTree::bPlusLookup()) in the B+ tree of an attribute
+of an open relation by 1, 2, 4, ... up to `threads` threads at once, first
+alone and then along with a thread inserting copies of the records of the
+relation (whose entries split the nodes of the tree under the lookups). The
+values looked up are picked at random from the relation, so every lookup has
+to find its value.
+NOTE: the copies of the records inserted are left in the relation.
+*/
+int Benchmarks::benchThreads(char argv[][ATTR_SIZE]) {
+  const int lookupsPerThread = 20000;
+
+  int relId = OpenRelTable::getRelId(argv[1]);
+  if (relId < 0) {
+    return E_RELNOTOPEN;
+  }
+
+  char *end;
+  int maxThreads = strtol(argv[3], &end, 10);
+  if (*end != '\0' || maxThreads < 1) {
+    return E_INVALID;
+  }
+
+  AttrCatEntry attrCatEntry;
+  int ret = AttrCacheTable::getAttrCatEntry(relId, argv[2], &attrCatEntry);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  if (attrCatEntry.rootBlock == -1) {
+    return E_NOINDEX;
+  }
+
+  // the records of the relation (their values of the attribute are looked up,
+  // and they are inserted again by the writer)
+  RelCatEntry relCatEntry;
+  RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+  int numAttrs = relCatEntry.numAttrs;
+  std::vector<Attribute> records;
+  ScanCursor cursor;
+  BlockAccess::openScan(&cursor, relId, nullptr, Attribute(), EQ);
+  Attribute blockRecords[relCatEntry.numSlotsPerBlk * numAttrs];
+  int numRecords;
+  while (BlockAccess::scanNext(&cursor, blockRecords, nullptr, &numRecords) == SUCCESS) {
+    records.insert(records.end(), blockRecords, blockRecords + numRecords * numAttrs);
+  }
+  numRecords = records.size() / numAttrs;
+  if (numRecords == 0) {
+    return E_NOTFOUND;
+  }
+
+  printf("%s.%s: %d lookups per thread, %u hardware threads\n", argv[1], argv[2], lookupsPerThread,
+         std::thread::hardware_concurrency());
+
+  for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+    for (int withWriter = 0; withWriter <= 1; withWriter++) {
+      std::atomic<int> numFound(0);
+      std::atomic<bool> readersDone(false);
+      int numInserted = 0;
+
+      auto reader = [&](unsigned int seed) {
+        int found = 0;
+        for (int i = 0; i < lookupsPerThread; i++) {
+          seed = seed * 1103515245 + 12345;
+          Attribute value = records[((seed >> 8) % numRecords) * numAttrs + attrCatEntry.offset];
+
+          RecId recId;
+          if (BPlusTree::bPlusLookup(relId, argv[2], value, &recId) == SUCCESS) {
+            found++;
+          }
+        }
+        numFound += found;
+      };
+
+      // (the writer inserts the records again, one at a time, until the readers are done)
+      auto writer = [&]() {
+        while (!readersDone) {
+          Attribute record[numAttrs];
+          memcpy(record, &records[(numInserted % numRecords) * numAttrs], sizeof(record));
+          if (BlockAccess::insert(relId, record) != SUCCESS) {
+            break;
+          }
+          numInserted++;
+        }
+      };
+
+      auto start = std::chrono::steady_clock::now();
+      std::thread writerThread;
+      if (withWriter) {
+        writerThread = std::thread(writer);
+      }
+      std::vector<std::thread> readerThreads;
+      for (int t = 0; t < numThreads; t++) {
+        readerThreads.push_back(std::thread(reader, 12345 + t));
+      }
+      for (std::thread &thread : readerThreads) {
+        thread.join();
+      }
+      auto stop = std::chrono::steady_clock::now();
+      readersDone = true;
+      if (withWriter) {
+        writerThread.join();
+      }
+
+      double seconds = std::chrono::duration<double>(stop - start).count();
+      int numLookups = numThreads * lookupsPerThread;
+      printf("  %d reader threads%s: %d of %d lookups found, %.0f lookups per second", numThreads,
+             withWriter ? " and a writer" : "", numFound.load(), numLookups, numLookups / seconds);
+      if (withWriter) {
+        printf(", %d records inserted (%.0f per second)", numInserted, numInserted / seconds);
+      }
+      printf("\n");
+    }
+  }
+
+  return SUCCESS;
+}
+
+/*
+FUNCTION bench_keysearch <relation> <attribute>:
+times the searches of the keys of the leaves of the B+ tree of an attribute of
+an open relation by each of the methods of IndBuffer::setSearchMethod(): first
+the searches alone (IndLeaf::searchBlock() on copies of the leaves in memory,
+for keys of the leaves), then point lookups (BPlusTree::bPlusSearch() with EQ)
+through the buffer. The method in use before is restored afterwards.
+*/
+int Benchmarks::benchKeySearch(char argv[][ATTR_SIZE]) {
+  const int numSearches = 200000;
+  const int numLookups = 20000;
+  const char *methodNames[] = {"linear", "binary", "interpolation"};
+
+  int relId = OpenRelTable::getRelId(argv[1]);
+  if (relId < 0) {
+    return E_RELNOTOPEN;
+  }
+
+  AttrCatEntry attrCatEntry;
+  int ret = AttrCacheTable::getAttrCatEntry(relId, argv[2], &attrCatEntry);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  if (attrCatEntry.rootBlock == -1) {
+    return E_NOINDEX;
+  }
+
+  // copy the leaves of the tree, from the leftmost one along the chain of leaves
+  int block = attrCatEntry.rootBlock;
+  while (StaticBuffer::getStaticBlockType(block) == IND_INTERNAL) {
+    block = IndInternal(block).getChild(0);
+  }
+  std::vector<unsigned char> leaves;
+  std::vector<Attribute> keys;
+  std::vector<int> firstKeys;  // index in keys of the first key of each leaf
+  int numLeaves = 0;
+  while (block != -1) {
+    firstKeys.push_back(keys.size());
+    leaves.resize((numLeaves + 1) * BLOCK_SIZE);
+    unsigned char *leaf = &leaves[numLeaves * BLOCK_SIZE];
+    StaticBuffer::readBlock(block, leaf);
+    numLeaves++;
+
+    struct HeadInfo *head = (struct HeadInfo *)leaf;
+    Index entries[MAX_KEYS_LEAF_PACKED];
+    IndLeaf::getBlockEntries(leaf, entries, 0, head->numEntries);
+    for (int i = 0; i < head->numEntries; i++) {
+      keys.push_back(entries[i].attrVal);
+    }
+    block = head->rblock;
+  }
+
+  // the searches pick a leaf, and a key of it, at random
+  std::vector<int> searchLeaves(numSearches);
+  std::vector<Attribute> searchKeys(numSearches);
+  unsigned int seed = 12345;
+  for (int i = 0; i < numSearches; i++) {
+    seed = seed * 1103515245 + 12345;
+    int leafNum = (seed >> 8) % numLeaves;
+    struct HeadInfo *head = (struct HeadInfo *)&leaves[leafNum * BLOCK_SIZE];
+    seed = seed * 1103515245 + 12345;
+    searchLeaves[i] = leafNum;
+    searchKeys[i] = keys[firstKeys[leafNum] + (seed >> 8) % head->numEntries];
+  }
+
+  printf("%s.%s: %d leaves, %.1f entries per leaf\n", argv[1], argv[2], numLeaves, (double)keys.size() / numLeaves);
+
+  int method = IndBuffer::getSearchMethod();
+  for (int m = NODE_SEARCH_LINEAR; m <= NODE_SEARCH_INTERPOLATION; m++) {
+    IndBuffer::setSearchMethod(m);
+
+    // (the sum of the positions found is the same for all the methods)
+    long long positions = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numSearches; i++) {
+      positions += IndLeaf::searchBlock(&leaves[searchLeaves[i] * BLOCK_SIZE], searchKeys[i],
+                                        attrCatEntry.attrType, false);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double searchSeconds = std::chrono::duration<double>(stop - start).count();
+
+    int numFound = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numLookups; i++) {
+      AttrCacheTable::resetSearchIndex(relId, argv[2]);
+      RecId recId = BPlusTree::bPlusSearch(relId, argv[2], searchKeys[i], EQ);
+      if (recId.block != -1) {
+        numFound++;
+      }
+    }
+    stop = std::chrono::steady_clock::now();
+    double lookupSeconds = std::chrono::duration<double>(stop - start).count();
+
+    printf("  %-13s: %.1f ns per leaf search (positions %lld), %d of %d lookups found, %.2f us per lookup\n",
+           methodNames[m], searchSeconds * 1e9 / numSearches, positions, numFound, numLookups,
+           lookupSeconds * 1e6 / numLookups);
+  }
+  IndBuffer::setSearchMethod(method);
+
+  return SUCCESS;
+}
+
+/*
+FUNCTION index_cache <on|off>:
+turns the index node cache (see Buffer/NodeCache.h) on or off.
+*/
+int Benchmarks::indexCache(char argv[][ATTR_SIZE]) {
+  if (strcmp(argv[1], "on") != 0 && strcmp(argv[1], "off") != 0) {
+    return E_INVALID;
+  }
+  NodeCache::setEnabled(strcmp(argv[1], "on") == 0);
+  return SUCCESS;
+}
+
+/*
+FUNCTION bench_range <relation> <attribute> <low> <high>:
+times range scans of the B+ tree of an attribute of an open relation
+(BPlusTree::rangeOpen() and rangeNext()) for the entries between low and high
+(inclusive), without reading the records.
+*/
+int Benchmarks::benchRange(char argv[][ATTR_SIZE]) {
+  const int numScans = 200;
+
+  int relId = OpenRelTable::getRelId(argv[1]);
+  if (relId < 0) {
+    return E_RELNOTOPEN;
+  }
+
+  AttrCatEntry attrCatEntry;
+  int ret = AttrCacheTable::getAttrCatEntry(relId, argv[2], &attrCatEntry);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  Attribute bounds[2];
+  for (int i = 0; i < 2; i++) {
+    if (attrCatEntry.attrType == NUMBER) {
+      char *end;
+      bounds[i].nVal = strtod(argv[3 + i], &end);
+      if (*end != '\0') {
+        return E_ATTRTYPEMISMATCH;
+      }
+    } else {
+      strcpy(bounds[i].sVal, argv[3 + i]);
+    }
+  }
+
+  int numEntries = 0, numLeaves = 0;
+  Index entries[MAX_KEYS_LEAF_PACKED];
+  auto start = std::chrono::steady_clock::now();
+  for (int scan = 0; scan < numScans; scan++) {
+    IndexRangeCursor cursor;
+    ret = BPlusTree::rangeOpen(&cursor, relId, argv[2], &bounds[0], true, &bounds[1], true);
+    if (ret != SUCCESS) {
+      return ret;
+    }
+
+    int count;
+    numEntries = numLeaves = 0;
+    while (BPlusTree::rangeNext(&cursor, entries, &count) == SUCCESS) {
+      numEntries += count;
+      numLeaves++;
+    }
+  }
+  auto stop = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(stop - start).count();
+
+  printf("%s.%s between %s and %s: %d entries from %d leaves per scan, %.0f entries per second\n", argv[1], argv[2],
+         argv[3], argv[4], numEntries, numLeaves, (double)numEntries * numScans / seconds);
+
+  return SUCCESS;
+}
+
+/*
+FUNCTION index_info <relation> <attribute or composite index>:
+checks that the B+ tree of an open relation is well formed (see
+BPlusTree::bPlusCheck()) and prints its height, number of nodes and entries,
+and the occupancy of its emptiest nodes.
+*/
+int Benchmarks::indexInfo(char argv[][ATTR_SIZE]) {
+  int relId = OpenRelTable::getRelId(argv[1]);
+  if (relId < 0) {
+    return E_RELNOTOPEN;
+  }
+
+  IndexStats stats;
+  int ret = BPlusTree::bPlusCheck(relId, argv[2], &stats);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  printf("%s.%s: height %d, %d internal nodes, %d leaves, %d entries (%.1f per leaf)\n", argv[1], argv[2],
+         stats.height, stats.numInternal, stats.numLeaves, stats.numEntries,
+         (double)stats.numEntries / stats.numLeaves);
+  // (the root may have any number of entries)
+  if (stats.height > 1) {
+    printf("  %.1f keys per internal node, fewest entries of a leaf %d (of %d)",
+           (double)stats.numInternalKeys / stats.numInternal, stats.minLeafEntries, stats.leafCapacity);
+    // (the number of keys that fit in a prefix compressed node depends on the keys)
+    if (stats.numInternal > 1) {
+      printf(", fewest keys of an internal node %d", stats.minInternalKeys);
+    }
+    printf("\n");
+  }
+
+  return SUCCESS;
+}
+
+/*
+FUNCTION check_index <relation> <attribute or composite index> <entries> <leaves>:
+checks that the B+ tree of an open relation is well formed (see
+BPlusTree::bPlusCheck()) and has the given numbers of entries and of leaves, and
+fails (so that a batch stops) if it does not.
+*/
+int Benchmarks::checkIndex(char argv[][ATTR_SIZE]) {
+  int relId = OpenRelTable::getRelId(argv[1]);
+  if (relId < 0) {
+    return E_RELNOTOPEN;
+  }
+
+  char *end;
+  int numEntries = strtol(argv[3], &end, 10);
+  if (*end != '\0') {
+    return E_INVALID;
+  }
+  int numLeaves = strtol(argv[4], &end, 10);
+  if (*end != '\0') {
+    return E_INVALID;
+  }
+
+  IndexStats stats;
+  int ret = BPlusTree::bPlusCheck(relId, argv[2], &stats);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  if (stats.numEntries != numEntries || stats.numLeaves != numLeaves) {
+    printf("%s.%s: %d entries in %d leaves, expected %d entries in %d leaves\n", argv[1], argv[2],
+           stats.numEntries, stats.numLeaves, numEntries, numLeaves);
+    return FAILURE;
+  }
+
+  printf("%s.%s: %d entries in %d leaves, as expected\n", argv[1], argv[2], stats.numEntries, stats.numLeaves);
+  return SUCCESS;
+}
+
+// compares two records of numAttrs attributes of the given types, attribute by attribute
+static int compareRecords(const Attribute *record1, const Attribute *record2, int numAttrs, const int attrTypes[]) {
+  for (int attrOffset = 0; attrOffset < numAttrs; attrOffset++) {
+    int cmpVal = compareAttrs(record1[attrOffset], record2[attrOffset], attrTypes[attrOffset]);
+    if (cmpVal != 0) {
+      return cmpVal;
+    }
+  }
+  return 0;
+}
+
+// the records of an open relation (of the given attribute types), sorted (see compareRecords())
+static std::vector<std::vector<Attribute>> sortedRecords(int relId, int numAttrs, const int attrTypes[]) {
+  std::vector<std::vector<Attribute>> records;
+  std::vector<Attribute> record(numAttrs);
+  RelCacheTable::resetSearchIndex(relId);
+  while (BlockAccess::project(relId, record.data()) == SUCCESS) {
+    records.push_back(record);
+  }
+
+  std::sort(records.begin(), records.end(),
+            [numAttrs, attrTypes](const std::vector<Attribute> &record1, const std::vector<Attribute> &record2) {
+              return compareRecords(record1.data(), record2.data(), numAttrs, attrTypes) < 0;
+            });
+  return records;
+}
+
+/*
+FUNCTION check_same <relation1> <relation2>:
+checks that two open relations (of the same attributes) have the same records,
+in any order, and fails (so that a batch stops) if they do not; e.g. the
+results of a selection through an index and through a scan.
+*/
+int Benchmarks::checkSame(char argv[][ATTR_SIZE]) {
+  int relId1 = OpenRelTable::getRelId(argv[1]);
+  int relId2 = OpenRelTable::getRelId(argv[2]);
+  if (relId1 < 0 || relId2 < 0) {
+    return E_RELNOTOPEN;
+  }
+
+  RelCatEntry relCatEntry1, relCatEntry2;
+  RelCacheTable::getRelCatEntry(relId1, &relCatEntry1);
+  RelCacheTable::getRelCatEntry(relId2, &relCatEntry2);
+  int numAttrs = relCatEntry1.numAttrs;
+  if (relCatEntry2.numAttrs != numAttrs) {
+    return E_NATTRMISMATCH;
+  }
+
+  int attrTypes[numAttrs];
+  for (int attrOffset = 0; attrOffset < numAttrs; attrOffset++) {
+    AttrCatEntry attrCatEntry1, attrCatEntry2;
+    AttrCacheTable::getAttrCatEntry(relId1, attrOffset, &attrCatEntry1);
+    AttrCacheTable::getAttrCatEntry(relId2, attrOffset, &attrCatEntry2);
+    if (attrCatEntry1.attrType != attrCatEntry2.attrType) {
+      return E_ATTRTYPEMISMATCH;
+    }
+    attrTypes[attrOffset] = attrCatEntry1.attrType;
+  }
+
+  std::vector<std::vector<Attribute>> records1 = sortedRecords(relId1, numAttrs, attrTypes);
+  std::vector<std::vector<Attribute>> records2 = sortedRecords(relId2, numAttrs, attrTypes);
+
+  // (the number of records, in order, before the first one that differs)
+  size_t numSame = 0;
+  while (numSame < records1.size() && numSame < records2.size() &&
+         compareRecords(records1[numSame].data(), records2[numSame].data(), numAttrs, attrTypes) == 0) {
+    numSame++;
+  }
+
+  if (numSame != records1.size() || numSame != records2.size()) {
+    printf("%s (%zu records) and %s (%zu records) differ after %zu records in order\n", argv[1], records1.size(),
+           argv[2], records2.size(), numSame);
+    return FAILURE;
+  }
+
+  printf("%s and %s: the same %zu records\n", argv[1], argv[2], records1.size());
+  return SUCCESS;
+}
+
+/*
+FUNCTION access_plan <cost|index>:
+has the access paths chosen by their cost, or the B+ tree whenever there is one
+(see BlockAccess::setCostBased()).
+*/
+int Benchmarks::accessPlan(char argv[][ATTR_SIZE]) {
+  if (strcmp(argv[1], "cost") != 0 && strcmp(argv[1], "index") != 0) {
+    return E_INVALID;
+  }
+  BlockAccess::setCostBased(strcmp(argv[1], "cost") == 0);
+  return SUCCESS;
+}
+
+/*
+FUNCTION estimate <relation> <attribute> <EQ|LE|LT|GE|GT|NE> <value>:
+compares the number of records of an open relation satisfying the condition
+estimated from the statistics of the attribute (see Statistics::estimateSelect())
+with the number actually found.
+*/
+int Benchmarks::estimate(char argv[][ATTR_SIZE]) {
+  const char *opNames[] = {"EQ", "LE", "LT", "GE", "GT", "NE"};
+
+  int relId = OpenRelTable::getRelId(argv[1]);
+  if (relId < 0) {
+    return E_RELNOTOPEN;
+  }
+
+  AttrCatEntry attrCatEntry;
+  int ret = AttrCacheTable::getAttrCatEntry(relId, argv[2], &attrCatEntry);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  int op = -1;
+  for (int i = 0; i < 6; i++) {
+    if (strcmp(argv[3], opNames[i]) == 0) {
+      op = i;
+    }
+  }
+  if (op == -1) {
+    return E_INVALID;
+  }
+
+  Attribute attrVal;
+  if (attrCatEntry.attrType == NUMBER) {
+    char *end;
+    attrVal.nVal = strtod(argv[4], &end);
+    if (*end != '\0') {
+      return E_ATTRTYPEMISMATCH;
+    }
+  } else {
+    strcpy(attrVal.sVal, argv[4]);
+  }
+
+  double estimated;
+  ret = Statistics::estimateSelect(relId, argv[2], op, attrVal, &estimated);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  RelCatEntry relCatEntry;
+  RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+  Attribute record[relCatEntry.numAttrs];
+
+  RelCacheTable::resetSearchIndex(relId);
+  AttrCacheTable::resetSearchIndex(relId, argv[2]);
+  int numFound = 0;
+  while (BlockAccess::search(relId, record, argv[2], attrVal, op) == SUCCESS) {
+    numFound++;
+  }
+
+  printf("%s.%s %s %s: %.1f records estimated, %d found\n", argv[1], argv[2], argv[3], argv[4], estimated,
+         numFound);
+
+  return SUCCESS;
+}
+
+// the values of an attribute of all the records of an open relation, sorted
+static std::vector<Attribute> sortedValues(int relId, int attrOffset, int attrType) {
+  RelCatEntry relCatEntry;
+  RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+  Attribute record[relCatEntry.numAttrs];
+
+  std::vector<Attribute> values;
+  RelCacheTable::resetSearchIndex(relId);
+  while (BlockAccess::project(relId, record) == SUCCESS) {
+    values.push_back(record[attrOffset]);
+  }
+
+  std::sort(values.begin(), values.end(), [attrType](const Attribute &attr1, const Attribute &attr2) {
+    return compareAttrs(attr1, attr2, attrType) < 0;
+  });
+  return values;
+}
+
+/*
+FUNCTION estimate_join <relation1> <attribute1> <relation2> <attribute2>:
+compares the number of records of the equi-join of two open relations estimated
+from the statistics of the attributes (see Statistics::estimateJoin()) with the
+actual number (counted by merging the sorted values of the attributes).
+*/
+int Benchmarks::estimateJoin(char argv[][ATTR_SIZE]) {
+  int relId1 = OpenRelTable::getRelId(argv[1]);
+  int relId2 = OpenRelTable::getRelId(argv[3]);
+  if (relId1 < 0 || relId2 < 0) {
+    return E_RELNOTOPEN;
+  }
+
+  AttrCatEntry attrCatEntry1, attrCatEntry2;
+  int ret = AttrCacheTable::getAttrCatEntry(relId1, argv[2], &attrCatEntry1);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  ret = AttrCacheTable::getAttrCatEntry(relId2, argv[4], &attrCatEntry2);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  if (attrCatEntry1.attrType != attrCatEntry2.attrType) {
+    return E_ATTRTYPEMISMATCH;
+  }
+
+  double estimated;
+  ret = Statistics::estimateJoin(relId1, argv[2], relId2, argv[4], &estimated);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  int attrType = attrCatEntry1.attrType;
+  std::vector<Attribute> values1 = sortedValues(relId1, attrCatEntry1.offset, attrType);
+  std::vector<Attribute> values2 = sortedValues(relId2, attrCatEntry2.offset, attrType);
+
+  // (each run of equal values of the first relation matches the run of the second)
+  long long numJoined = 0;
+  size_t i = 0, j = 0;
+  while (i < values1.size() && j < values2.size()) {
+    int cmpVal = compareAttrs(values1[i], values2[j], attrType);
+    if (cmpVal < 0) {
+      i++;
+    } else if (cmpVal > 0) {
+      j++;
+    } else {
+      size_t run1 = i, run2 = j;
+      while (run1 < values1.size() && compareAttrs(values1[run1], values1[i], attrType) == 0) {
+        run1++;
+      }
+      while (run2 < values2.size() && compareAttrs(values2[run2], values2[j], attrType) == 0) {
+        run2++;
+      }
+      numJoined += (long long)(run1 - i) * (run2 - j);
+      i = run1;
+      j = run2;
+    }
+  }
+
+  printf("%s.%s = %s.%s: %.1f records estimated, %lld found\n", argv[1], argv[2], argv[3], argv[4], estimated,
+         numJoined);
+
+  return SUCCESS;
+}
+
+/*
+FUNCTION bench_order <relation> <attribute> <ASC|DESC>:
+times reading all the records of an open relation in the order of an attribute
+through its B+ tree (the leaves in order, and the record of every entry; see
+BlockAccess::openOrderedScan()) and through a scan of the relation sorted by
+ExternalSort, as for ORDER BY, and checks the order of both outputs.
+*/
+int Benchmarks::benchOrder(char argv[][ATTR_SIZE]) {
+  int relId = OpenRelTable::getRelId(argv[1]);
+  if (relId < 0) {
+    return E_RELNOTOPEN;
+  }
+
+  AttrCatEntry attrCatEntry;
+  int ret = AttrCacheTable::getAttrCatEntry(relId, argv[2], &attrCatEntry);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  if (strcmp(argv[3], "ASC") != 0 && strcmp(argv[3], "DESC") != 0) {
+    return E_INVALID;
+  }
+  bool descending = strcmp(argv[3], "DESC") == 0;
+
+  RelCatEntry relCatEntry;
+  RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+  int numAttrs = relCatEntry.numAttrs;
+  int offset = attrCatEntry.offset;
+
+  // (a record is in order if its key is not beyond that of the previous record)
+  Attribute prevKey;
+  auto inOrder = [&](Attribute key, int count) {
+    int cmpVal = compareAttrs(prevKey, key, attrCatEntry.attrType);
+    prevKey = key;
+    return count == 0 || (descending ? cmpVal >= 0 : cmpVal <= 0);
+  };
+
+  /*** the records in the order of the leaves of the B+ tree ***/
+  if (attrCatEntry.rootBlock != -1) {
+    auto start = std::chrono::steady_clock::now();
+
+    RangeScanCursor cursor;
+    ret = BlockAccess::openOrderedScan(&cursor, relId, argv[2], descending, nullptr, true, nullptr, true);
+    if (ret != SUCCESS) {
+      return ret;
+    }
+
+    Attribute records[std::max(relCatEntry.numSlotsPerBlk, MAX_KEYS_LEAF_PACKED) * numAttrs];
+    int numRecords, numOutput = 0;
+    bool sorted = true;
+    while (BlockAccess::rangeScanNext(&cursor, records, nullptr, &numRecords) == SUCCESS) {
+      for (int i = 0; i < numRecords; i++) {
+        sorted = inOrder(records[i * numAttrs + offset], numOutput) && sorted;
+        numOutput++;
+      }
+    }
+
+    auto stop = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+    printf("%s.%s %s through the B+ tree: %d records in %.3f ms, %s\n", argv[1], argv[2], argv[3], numOutput, ms,
+           sorted && numOutput == relCatEntry.numRecs ? "output in order" : "OUTPUT NOT IN ORDER");
+  }
+
+  /*** the records of a scan, sorted ***/
+  auto start = std::chrono::steady_clock::now();
+
+  SortState sortState;
+  ret = ExternalSort::sortBegin(&sortState, numAttrs, offset, attrCatEntry.attrType, SORT_MEMORY_BLOCKS, descending);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  ScanCursor cursor;
+  BlockAccess::openScan(&cursor, relId, nullptr, Attribute(), EQ);
+  Attribute records[relCatEntry.numSlotsPerBlk * numAttrs];
+  int numRecords;
+  while (ret == SUCCESS && BlockAccess::scanNext(&cursor, records, nullptr, &numRecords) == SUCCESS) {
+    for (int i = 0; i < numRecords && ret == SUCCESS; i++) {
+      ret = ExternalSort::sortAdd(&sortState, records + i * numAttrs);
+    }
+  }
+  if (ret == SUCCESS) {
+    ret = ExternalSort::sortEnd(&sortState);
+  }
+  if (ret != SUCCESS) {
+    ExternalSort::sortClose(&sortState);
+    return ret;
+  }
+
+  Attribute record[numAttrs];
+  int numOutput = 0;
+  bool sorted = true;
+  while (ExternalSort::sortNext(&sortState, record) == SUCCESS) {
+    sorted = inOrder(record[offset], numOutput) && sorted;
+    numOutput++;
+  }
+  ExternalSort::sortClose(&sortState);
+
+  auto stop = std::chrono::steady_clock::now();
+  double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+  printf("%s.%s %s by a scan and a sort: %d records in %.3f ms (%d blocks of runs written), %s\n", argv[1], argv[2],
+         argv[3], numOutput, ms, sortState.blocksWritten,
+         sorted && numOutput == relCatEntry.numRecs ? "output in order" : "OUTPUT NOT IN ORDER");
+
+  return SUCCESS;
+}
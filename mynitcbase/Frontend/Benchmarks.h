@@ -0,0 +1,35 @@
+#ifndef FRONTEND_BENCHMARKS_H
+#define FRONTEND_BENCHMARKS_H
+
+#include "../Algebra/Algebra.h"
+#include "../Buffer/NodeCache.h"
+#include "../Schema/Schema.h"
+#include "../Sort/ExternalSort.h"
+#include "../define/constants.h"
+
+/*
+The benchmarks and diagnostics run with FUNCTION <name> <arguments> (see
+Frontend::custom_function()). Each one gets the tokens of the command in argv,
+argv[0] being its name, and returns SUCCESS or an error code.
+*/
+class Benchmarks {
+ public:
+  static int benchKernels(char argv[][ATTR_SIZE]);
+  static int benchSearch(char argv[][ATTR_SIZE]);
+  static int benchSort(char argv[][ATTR_SIZE]);
+  static int benchLookup(char argv[][ATTR_SIZE]);
+  static int benchDescent(char argv[][ATTR_SIZE]);
+  static int benchThreads(char argv[][ATTR_SIZE]);
+  static int benchKeySearch(char argv[][ATTR_SIZE]);
+  static int indexCache(char argv[][ATTR_SIZE]);
+  static int benchRange(char argv[][ATTR_SIZE]);
+  static int indexInfo(char argv[][ATTR_SIZE]);
+  static int checkIndex(char argv[][ATTR_SIZE]);
+  static int checkSame(char argv[][ATTR_SIZE]);
+  static int accessPlan(char argv[][ATTR_SIZE]);
+  static int estimate(char argv[][ATTR_SIZE]);
+  static int benchOrder(char argv[][ATTR_SIZE]);
+  static int estimateJoin(char argv[][ATTR_SIZE]);
+};
+
+#endif  // FRONTEND_BENCHMARKS_H
@@ -1,5 +1,7 @@
 #include "Frontend.h"
 
+#include "Benchmarks.h"
+
 #include <cstring>
 #include <iostream>
 
@@ -49,6 +51,10 @@ int Frontend::create_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE]) {
   return Schema::createIndex(relname, attrname);
 }
 
+int Frontend::create_covering_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE], char include_attr[ATTR_SIZE]) {
+  return Schema::createCoveringIndex(relname, attrname, include_attr);
+}
+
 int Frontend::drop_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE]) {
   // Schema::dropIndex
   // return SUCCESS; 
@@ -57,12 +63,111 @@ int Frontend::drop_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE]) {
   return Schema::dropIndex(relname, attrname);
 }
 
+int Frontend::create_composite_index(char relname[ATTR_SIZE], char indexname[ATTR_SIZE], int attr_count,
+                                     char attr_list[][ATTR_SIZE]) {
+  return Schema::createCompositeIndex(relname, indexname, attr_count, attr_list);
+}
+
+int Frontend::drop_composite_index(char relname[ATTR_SIZE], char indexname[ATTR_SIZE]) {
+  return Schema::dropCompositeIndex(relname, indexname);
+}
+
+int Frontend::create_bloom_filter(char relname[ATTR_SIZE], char attrname[ATTR_SIZE], BloomFilterInfo *info) {
+  // Schema::createBloomFilter, then report the size of the filter
+  int ret = Schema::createBloomFilter(relname, attrname);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  return Schema::getBloomFilterInfo(relname, attrname, info);
+}
+
+int Frontend::drop_bloom_filter(char relname[ATTR_SIZE], char attrname[ATTR_SIZE]) {
+  // Schema::dropBloomFilter
+  return Schema::dropBloomFilter(relname, attrname);
+}
+
+int Frontend::create_hash_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE], HashIndexInfo *info) {
+  // Schema::createHashIndex, then report the size of the index
+  int ret = Schema::createHashIndex(relname, attrname);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  return Schema::getHashIndexInfo(relname, attrname, info);
+}
+
+int Frontend::drop_hash_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE]) {
+  // Schema::dropHashIndex
+  return Schema::dropHashIndex(relname, attrname);
+}
+
+int Frontend::create_bitmap_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE], BitmapIndexInfo *info) {
+  // Schema::createBitmapIndex, then report the size of the index
+  int ret = Schema::createBitmapIndex(relname, attrname);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  return Schema::getBitmapIndexInfo(relname, attrname, info);
+}
+
+int Frontend::drop_bitmap_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE]) {
+  // Schema::dropBitmapIndex
+  return Schema::dropBitmapIndex(relname, attrname);
+}
+
+int Frontend::reindex(char relname[ATTR_SIZE], char attrname[ATTR_SIZE], IndexStats *before, IndexStats *after) {
+  // Schema::rebuildIndex, reporting the shape of the index before and after
+  int ret = Schema::getIndexStats(relname, attrname, before);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  ret = Schema::rebuildIndex(relname, attrname);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  return Schema::getIndexStats(relname, attrname, after);
+}
+
+int Frontend::analyze(char relname[ATTR_SIZE], std::vector<AttrStats> &stats) {
+  // Schema::analyzeRel, then report the statistics of every attribute
+  int ret = Schema::analyzeRel(relname);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  int relId = OpenRelTable::getRelId(relname);
+  RelCatEntry relCatEntry;
+  RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+  stats.resize(relCatEntry.numAttrs);
+  for (int attr = 0; attr < relCatEntry.numAttrs; attr++) {
+    AttrCatEntry attrCatEntry;
+    AttrCacheTable::getAttrCatEntry(relId, attr, &attrCatEntry);
+    ret = Schema::getAttrStats(relname, attrCatEntry.attrName, &stats[attr]);
+    if (ret != SUCCESS) {
+      return ret;
+    }
+  }
+  return SUCCESS;
+}
+
 int Frontend::insert_into_table_values(char relname[ATTR_SIZE], int attr_count, char attr_values[][ATTR_SIZE]) {
   // Algebra::insert
   // return SUCCESS;
   return Algebra::insert(relname, attr_count, attr_values);
 }
 
+int Frontend::insert_into_table_rows(char relname[ATTR_SIZE], int row_count, int attr_count,
+                                     char attr_values[][ATTR_SIZE], int *num_inserted) {
+  // Algebra::insertRecords
+  return Algebra::insertRecords(relname, row_count, attr_count, attr_values, num_inserted);
+}
+
+int Frontend::delete_from_table_where(char relname[ATTR_SIZE], char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE],
+                                      int *num_deleted) {
+  // Algebra::deleteRecords
+  return Algebra::deleteRecords(relname, attribute, op, value, num_deleted);
+}
+
 int Frontend::select_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE]) {
   // Algebra::project
   // return SUCCESS;
@@ -95,6 +200,18 @@ int Frontend::select_attrlist_from_table_where(char relname_source[ATTR_SIZE], c
   // Algebra::select + Algebra::project??
   // return SUCCESS;
 
+  // if the B+ tree on attribute covers attr_list, select from its leaves alone
+  // (the condition is a range with one bound, or with both for =)
+  if (op != NE) {
+    char *lower = (op == GT || op == GE || op == EQ) ? value : nullptr;
+    char *upper = (op == LT || op == LE || op == EQ) ? value : nullptr;
+    int response = Algebra::selectIndexOnly(relname_source, relname_target, attr_count, attr_list, attribute,
+                                            lower, op != GT, upper, op != LT);
+    if (response != E_NOINDEX) {
+      return response;
+    }
+  }
+
   // Call select() method of the Algebra Layer with correct arguments to
   // create a temporary target relation with name ".temp" (use constant TEMP)
   char tempStr[] = TEMP;
@@ -132,6 +249,121 @@ int Frontend::select_attrlist_from_table_where(char relname_source[ATTR_SIZE], c
   return response;
 }
 
+int Frontend::select_from_table_where_order_by(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                               char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE],
+                                               char order_attribute[ATTR_SIZE], bool descending) {
+  // Algebra::selectOrdered (attribute is nullptr if there is no condition)
+  return Algebra::selectOrdered(relname_source, relname_target, attribute, op, value, order_attribute, descending);
+}
+
+int Frontend::select_attrlist_from_table_where_order_by(char relname_source[ATTR_SIZE],
+                                                        char relname_target[ATTR_SIZE], int attr_count,
+                                                        char attr_list[][ATTR_SIZE], char attribute[ATTR_SIZE],
+                                                        int op, char value[ATTR_SIZE],
+                                                        char order_attribute[ATTR_SIZE], bool descending) {
+  // select the records in order into TEMP, and project the attributes of attr_list
+  // from it (project() keeps the order of the records of TEMP)
+  char tempStr[] = TEMP;
+  int response = Algebra::selectOrdered(relname_source, tempStr, attribute, op, value, order_attribute, descending);
+  if (response != SUCCESS) {
+    return response;
+  }
+
+  int tempRelId = OpenRelTable::openRel(tempStr);
+  if (tempRelId < 0) {
+    Schema::deleteRel(tempStr);
+    return tempRelId;
+  }
+
+  response = Algebra::project(tempStr, relname_target, attr_count, attr_list);
+
+  OpenRelTable::closeRel(tempRelId);
+  Schema::deleteRel(tempStr);
+
+  return response;
+}
+
+int Frontend::select_min_max_from_table(char relname_source[ATTR_SIZE], char attribute[ATTR_SIZE], bool max,
+                                        Attribute *value, int *attr_type) {
+  // Algebra::minMax
+  return Algebra::minMax(relname_source, attribute, max, value, attr_type);
+}
+
+int Frontend::explain_select_from_table_where(char relname_source[ATTR_SIZE], char attribute[ATTR_SIZE], int op,
+                                              char value[ATTR_SIZE], AccessPlan *plan) {
+  // Algebra::explainSelect
+  return Algebra::explainSelect(relname_source, attribute, op, value, nullptr, plan);
+}
+
+int Frontend::explain_select_from_table_where_between(char relname_source[ATTR_SIZE], char attribute[ATTR_SIZE],
+                                                      char lower[ATTR_SIZE], char upper[ATTR_SIZE],
+                                                      AccessPlan *plan) {
+  // Algebra::explainSelect, for the range
+  return Algebra::explainSelect(relname_source, attribute, -1, lower, upper, plan);
+}
+
+int Frontend::select_from_table_where_between(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                              char attribute[ATTR_SIZE], char lower[ATTR_SIZE], char upper[ATTR_SIZE]) {
+  return Algebra::selectRange(relname_source, relname_target, attribute, lower, upper);
+}
+
+int Frontend::select_from_table_where_prefix(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                             char eq_attribute[ATTR_SIZE], char eq_value[ATTR_SIZE],
+                                             char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE]) {
+  // the condition on attribute is a range with one bound (or with both, for =)
+  char *lower = (op == GT || op == GE || op == EQ) ? value : nullptr;
+  char *upper = (op == LT || op == LE || op == EQ) ? value : nullptr;
+  return Algebra::selectPrefixRange(relname_source, relname_target, eq_attribute, eq_value, attribute,
+                                    lower, op != GT, upper, op != LT);
+}
+
+int Frontend::select_from_table_where_prefix_between(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                                     char eq_attribute[ATTR_SIZE], char eq_value[ATTR_SIZE],
+                                                     char attribute[ATTR_SIZE], char lower[ATTR_SIZE],
+                                                     char upper[ATTR_SIZE]) {
+  return Algebra::selectPrefixRange(relname_source, relname_target, eq_attribute, eq_value, attribute,
+                                    lower, true, upper, true);
+}
+
+int Frontend::select_from_table_where_equalities(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                                 int term_count, char attributes[][ATTR_SIZE],
+                                                 char values[][ATTR_SIZE], bool disjunction) {
+  // Algebra::selectEqualities
+  return Algebra::selectEqualities(relname_source, relname_target, term_count, attributes, values, disjunction);
+}
+
+int Frontend::select_attrlist_from_table_where_between(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                                       int attr_count, char attr_list[][ATTR_SIZE],
+                                                       char attribute[ATTR_SIZE], char lower[ATTR_SIZE],
+                                                       char upper[ATTR_SIZE]) {
+  // (as in select_attrlist_from_table_where(), a covering B+ tree is read alone)
+  int response = Algebra::selectIndexOnly(relname_source, relname_target, attr_count, attr_list, attribute,
+                                          lower, true, upper, true);
+  if (response != E_NOINDEX) {
+    return response;
+  }
+
+  // select the range into TEMP, and project the attributes of attr_list from it
+  char tempStr[] = TEMP;
+  response = Algebra::selectRange(relname_source, tempStr, attribute, lower, upper);
+  if (response != SUCCESS) {
+    return response;
+  }
+
+  int tempRelId = OpenRelTable::openRel(tempStr);
+  if (tempRelId < 0) {
+    Schema::deleteRel(tempStr);
+    return tempRelId;
+  }
+
+  response = Algebra::project(tempStr, relname_target, attr_count, attr_list);
+
+  OpenRelTable::closeRel(tempRelId);
+  Schema::deleteRel(tempStr);
+
+  return response;
+}
+
 int Frontend::select_from_join_where(char relname_source_one[ATTR_SIZE], char relname_source_two[ATTR_SIZE],
                                      char relname_target[ATTR_SIZE],
                                      char join_attr_one[ATTR_SIZE], char join_attr_two[ATTR_SIZE]) {
@@ -203,10 +435,43 @@ int Frontend::select_attrlist_from_join_where(char relname_source_one[ATTR_SIZE]
   return response;
 }
 
+// the FUNCTIONs run by custom_function(): name, number of tokens (the name included), and harness
+struct CustomFunction {
+  const char *name;
+  int argc;
+  int (*function)(char argv[][ATTR_SIZE]);
+};
+
+static const CustomFunction customFunctions[] = {
+    {"bench_kernels", 1, Benchmarks::benchKernels},
+    {"bench_search", 5, Benchmarks::benchSearch},
+    {"bench_sort", 4, Benchmarks::benchSort},
+    {"bench_lookup", 4, Benchmarks::benchLookup},
+    {"bench_descent", 4, Benchmarks::benchDescent},
+    {"bench_threads", 4, Benchmarks::benchThreads},
+    {"bench_keysearch", 3, Benchmarks::benchKeySearch},
+    {"index_cache", 2, Benchmarks::indexCache},
+    {"bench_range", 5, Benchmarks::benchRange},
+    {"index_info", 3, Benchmarks::indexInfo},
+    {"check_index", 5, Benchmarks::checkIndex},
+    {"check_same", 3, Benchmarks::checkSame},
+    {"access_plan", 2, Benchmarks::accessPlan},
+    {"estimate", 5, Benchmarks::estimate},
+    {"bench_order", 4, Benchmarks::benchOrder},
+    {"estimate_join", 5, Benchmarks::estimateJoin},
+};
+
 int Frontend::custom_function(int argc, char argv[][ATTR_SIZE]) {
   // argc gives the size of the argv array
   // argv stores every token delimited by space and comma
 
   // implement whatever you desire
+  // (the benchmarks and diagnostics are in Frontend/Benchmarks.cpp)
+  for (const CustomFunction &customFunction : customFunctions) {
+    if (argc == customFunction.argc && strcmp(argv[0], customFunction.name) == 0) {
+      return customFunction.function(argv);
+    }
+  }
+
   return SUCCESS;
-}
\ No newline at end of file
+}
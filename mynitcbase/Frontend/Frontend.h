@@ -18,8 +18,31 @@ class Frontend {
 
   static int create_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE]);
 
+  static int create_covering_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE], char include_attr[ATTR_SIZE]);
+
   static int drop_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE]);
 
+  static int create_composite_index(char relname[ATTR_SIZE], char indexname[ATTR_SIZE], int attr_count,
+                                    char attr_list[][ATTR_SIZE]);
+
+  static int drop_composite_index(char relname[ATTR_SIZE], char indexname[ATTR_SIZE]);
+
+  static int create_bloom_filter(char relname[ATTR_SIZE], char attrname[ATTR_SIZE], BloomFilterInfo *info);
+
+  static int drop_bloom_filter(char relname[ATTR_SIZE], char attrname[ATTR_SIZE]);
+
+  static int create_hash_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE], HashIndexInfo *info);
+
+  static int drop_hash_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE]);
+
+  static int create_bitmap_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE], BitmapIndexInfo *info);
+
+  static int drop_bitmap_index(char relname[ATTR_SIZE], char attrname[ATTR_SIZE]);
+
+  static int reindex(char relname[ATTR_SIZE], char attrname[ATTR_SIZE], IndexStats *before, IndexStats *after);
+
+  static int analyze(char relname[ATTR_SIZE], std::vector<AttrStats> &stats);
+
   static int alter_table_rename(char relname_from[ATTR_SIZE], char relname_to[ATTR_SIZE]);
 
   static int alter_table_rename_column(char relname[ATTR_SIZE], char attrname_from[16], char attrname_to[16]);
@@ -27,6 +50,12 @@ class Frontend {
   // DML
   static int insert_into_table_values(char relname[ATTR_SIZE], int attr_count, char attr_values[][ATTR_SIZE]);
 
+  static int insert_into_table_rows(char relname[ATTR_SIZE], int row_count, int attr_count,
+                                    char attr_values[][ATTR_SIZE], int *num_inserted);
+
+  static int delete_from_table_where(char relname[ATTR_SIZE], char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE],
+                                     int *num_deleted);
+
   static int select_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE]);
 
   static int select_attrlist_from_table(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
@@ -39,6 +68,46 @@ class Frontend {
                                               int attr_count, char attr_list[][ATTR_SIZE],
                                               char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE]);
 
+  static int select_from_table_where_order_by(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                              char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE],
+                                              char order_attribute[ATTR_SIZE], bool descending);
+
+  static int select_attrlist_from_table_where_order_by(char relname_source[ATTR_SIZE],
+                                                       char relname_target[ATTR_SIZE], int attr_count,
+                                                       char attr_list[][ATTR_SIZE], char attribute[ATTR_SIZE], int op,
+                                                       char value[ATTR_SIZE], char order_attribute[ATTR_SIZE],
+                                                       bool descending);
+
+  static int select_min_max_from_table(char relname_source[ATTR_SIZE], char attribute[ATTR_SIZE], bool max,
+                                       union Attribute *value, int *attr_type);
+
+  static int explain_select_from_table_where(char relname_source[ATTR_SIZE], char attribute[ATTR_SIZE], int op,
+                                             char value[ATTR_SIZE], AccessPlan *plan);
+
+  static int explain_select_from_table_where_between(char relname_source[ATTR_SIZE], char attribute[ATTR_SIZE],
+                                                     char lower[ATTR_SIZE], char upper[ATTR_SIZE], AccessPlan *plan);
+
+  static int select_from_table_where_between(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                             char attribute[ATTR_SIZE], char lower[ATTR_SIZE], char upper[ATTR_SIZE]);
+
+  static int select_attrlist_from_table_where_between(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                                      int attr_count, char attr_list[][ATTR_SIZE],
+                                                      char attribute[ATTR_SIZE], char lower[ATTR_SIZE],
+                                                      char upper[ATTR_SIZE]);
+
+  static int select_from_table_where_prefix(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                            char eq_attribute[ATTR_SIZE], char eq_value[ATTR_SIZE],
+                                            char attribute[ATTR_SIZE], int op, char value[ATTR_SIZE]);
+
+  static int select_from_table_where_prefix_between(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                                    char eq_attribute[ATTR_SIZE], char eq_value[ATTR_SIZE],
+                                                    char attribute[ATTR_SIZE], char lower[ATTR_SIZE],
+                                                    char upper[ATTR_SIZE]);
+
+  static int select_from_table_where_equalities(char relname_source[ATTR_SIZE], char relname_target[ATTR_SIZE],
+                                                int term_count, char attributes[][ATTR_SIZE],
+                                                char values[][ATTR_SIZE], bool disjunction);
+
   static int select_from_join_where(char relname_source_one[ATTR_SIZE], char relname_source_two[ATTR_SIZE],
                                     char relname_target[ATTR_SIZE],
                                     char join_attr_one[ATTR_SIZE], char join_attr_two[ATTR_SIZE]);
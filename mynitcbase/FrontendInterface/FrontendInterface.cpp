@@ -1,4 +1,5 @@
 // clang-format off
+#include <chrono>
 #include <cstring>
 #include <string>
 #include <sstream>
@@ -22,6 +23,8 @@ void attrToTruncatedArray(string nameString, char *nameArray);
 
 void printErrorMsg(int error);
 
+void printPlan(AccessPlan *plan);
+
 void printHelp();
 
 // extract tokens delimited by whitespace and comma
@@ -77,6 +80,23 @@ int RegexHandler::runHandler() {
   return SUCCESS;  // error messages if any will be printed in recursive call to handle
 }
 
+int RegexHandler::timeHandler() {
+  // (copy the command, the nested call to handle overwrites the match)
+  string command = m[1];
+
+  auto start = chrono::steady_clock::now();
+  int ret = this->handle(command);
+  auto end = chrono::steady_clock::now();
+
+  double elapsed = chrono::duration<double, milli>(end - start).count();
+  printf("Time taken: %.3f ms\n", elapsed);
+
+  if (ret == EXIT) {
+    return EXIT;
+  }
+  return SUCCESS;  // error messages if any will be printed in recursive call to handle
+}
+
 int RegexHandler::openHandler() {
   char relName[ATTR_SIZE];
   attrToTruncatedArray(m[1], relName);
@@ -156,6 +176,20 @@ int RegexHandler::createIndexHandler() {
   return ret;
 }
 
+int RegexHandler::createCoveringIndexHandler() {
+  char relName[ATTR_SIZE], attrName[ATTR_SIZE], includeName[ATTR_SIZE];
+  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(m[2], attrName);
+  attrToTruncatedArray(m[3], includeName);
+
+  int ret = Frontend::create_covering_index(relName, attrName, includeName);
+  if (ret == SUCCESS) {
+    cout << "Index created successfully\n";
+  }
+
+  return ret;
+}
+
 int RegexHandler::dropIndexHandler() {
   char relName[ATTR_SIZE], attrName[ATTR_SIZE];
   attrToTruncatedArray(m[1], relName);
@@ -169,6 +203,175 @@ int RegexHandler::dropIndexHandler() {
   return ret;
 }
 
+int RegexHandler::createCompositeIndexHandler() {
+  char indexName[ATTR_SIZE], relName[ATTR_SIZE];
+  attrToTruncatedArray(m[1], indexName);
+  attrToTruncatedArray(m[2], relName);
+
+  vector<string> attrTokens = extractTokens(m[3]);
+
+  int attrCount = attrTokens.size();
+  char attrNames[attrCount][ATTR_SIZE];
+  for (int i = 0; i < attrCount; i++) {
+    attrToTruncatedArray(attrTokens[i], attrNames[i]);
+  }
+
+  int ret = Frontend::create_composite_index(relName, indexName, attrCount, attrNames);
+  if (ret == SUCCESS) {
+    cout << "Index created successfully\n";
+  }
+
+  return ret;
+}
+
+int RegexHandler::dropCompositeIndexHandler() {
+  char indexName[ATTR_SIZE], relName[ATTR_SIZE];
+  attrToTruncatedArray(m[1], indexName);
+  attrToTruncatedArray(m[2], relName);
+
+  int ret = Frontend::drop_composite_index(relName, indexName);
+  if (ret == SUCCESS) {
+    cout << "Index deleted successfully\n";
+  }
+
+  return ret;
+}
+
+int RegexHandler::createBloomHandler() {
+  char relName[ATTR_SIZE], attrName[ATTR_SIZE];
+  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(m[2], attrName);
+
+  BloomFilterInfo info;
+  int ret = Frontend::create_bloom_filter(relName, attrName, &info);
+  if (ret == SUCCESS) {
+    cout << "Bloom filter created successfully\n";
+    printf("Blocks: %d, Bits: %d, Hashes: %d, Keys: %d, Bits set: %.1f%%, Estimated false positive rate: %.4f%%\n",
+           info.numBlocks, info.numBits, info.numHashes, info.numKeys,
+           100.0 * info.numSetBits / info.numBits, 100.0 * info.falsePositiveRate);
+  }
+
+  return ret;
+}
+
+int RegexHandler::dropBloomHandler() {
+  char relName[ATTR_SIZE], attrName[ATTR_SIZE];
+  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(m[2], attrName);
+
+  int ret = Frontend::drop_bloom_filter(relName, attrName);
+  if (ret == SUCCESS) {
+    cout << "Bloom filter deleted successfully\n";
+  }
+
+  return ret;
+}
+
+int RegexHandler::createHashIndexHandler() {
+  char relName[ATTR_SIZE], attrName[ATTR_SIZE];
+  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(m[2], attrName);
+
+  HashIndexInfo info;
+  int ret = Frontend::create_hash_index(relName, attrName, &info);
+  if (ret == SUCCESS) {
+    cout << "Index created successfully\n";
+    printf("Global depth: %d, Directory blocks: %d, Buckets: %d, Overflow blocks: %d, Entries: %d, Longest bucket: %d blocks\n",
+           info.globalDepth, info.numDirBlocks, info.numBuckets, info.numOverflowBlocks, info.numEntries,
+           info.maxChainLength);
+  }
+
+  return ret;
+}
+
+int RegexHandler::dropHashIndexHandler() {
+  char relName[ATTR_SIZE], attrName[ATTR_SIZE];
+  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(m[2], attrName);
+
+  int ret = Frontend::drop_hash_index(relName, attrName);
+  if (ret == SUCCESS) {
+    cout << "Index deleted successfully\n";
+  }
+
+  return ret;
+}
+
+int RegexHandler::createBitmapIndexHandler() {
+  char relName[ATTR_SIZE], attrName[ATTR_SIZE];
+  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(m[2], attrName);
+
+  BitmapIndexInfo info;
+  int ret = Frontend::create_bitmap_index(relName, attrName, &info);
+  if (ret == SUCCESS) {
+    cout << "Index created successfully\n";
+    printf("Values: %d, Directory blocks: %d, Bitmap blocks: %d, Block entries: %d, Records: %d\n",
+           info.numValues, info.numDirBlocks, info.numBitmapBlocks, info.numEntries, info.numRecords);
+  }
+
+  return ret;
+}
+
+int RegexHandler::dropBitmapIndexHandler() {
+  char relName[ATTR_SIZE], attrName[ATTR_SIZE];
+  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(m[2], attrName);
+
+  int ret = Frontend::drop_bitmap_index(relName, attrName);
+  if (ret == SUCCESS) {
+    cout << "Index deleted successfully\n";
+  }
+
+  return ret;
+}
+
+int RegexHandler::reindexHandler() {
+  char relName[ATTR_SIZE], attrName[ATTR_SIZE];
+  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(m[2], attrName);
+
+  IndexStats stats[2];
+  int ret = Frontend::reindex(relName, attrName, &stats[0], &stats[1]);
+  if (ret == SUCCESS) {
+    cout << "Index rebuilt successfully\n";
+    for (int i = 0; i < 2; i++) {
+      // (a leaf is contiguous if it is in the block after the previous leaf of the leaf list)
+      int contiguous = stats[i].numLeaves - stats[i].numLeafRuns;
+      printf("%s: height %d, %d internal nodes, %d leaves %.1f%% full, %.1f%% of the leaves contiguous\n",
+             i == 0 ? "Before" : "After", stats[i].height, stats[i].numInternal, stats[i].numLeaves,
+             100.0 * stats[i].numEntries / (stats[i].numLeaves * stats[i].leafCapacity),
+             stats[i].numLeaves > 1 ? 100.0 * contiguous / (stats[i].numLeaves - 1) : 100.0);
+    }
+  }
+
+  return ret;
+}
+
+int RegexHandler::analyzeHandler() {
+  char relName[ATTR_SIZE];
+  attrToTruncatedArray(m[1], relName);
+
+  std::vector<AttrStats> stats;
+  int ret = Frontend::analyze(relName, stats);
+  if (ret == SUCCESS) {
+    cout << "Relation analyzed successfully\n";
+    for (AttrStats &attrStats : stats) {
+      if (attrStats.attrType == NUMBER) {
+        printf("%s: %.0f records, %.0f distinct values, min %g, max %g, %d buckets\n", attrStats.attrName,
+               attrStats.numRecords, attrStats.numDistinct, attrStats.minVal.nVal, attrStats.maxVal.nVal,
+               attrStats.numBuckets);
+      } else {
+        printf("%s: %.0f records, %.0f distinct values, min %s, max %s, %d buckets\n", attrStats.attrName,
+               attrStats.numRecords, attrStats.numDistinct, attrStats.minVal.sVal, attrStats.maxVal.sVal,
+               attrStats.numBuckets);
+      }
+    }
+  }
+
+  return ret;
+}
+
 int RegexHandler::renameTableHandler() {
   char oldRelName[ATTR_SIZE];
   char newRelName[ATTR_SIZE];
@@ -235,46 +438,64 @@ int RegexHandler::insertFromFileHandler() {
   string errorMsg("");
   string fileLine;
 
+  // the rows read and not inserted yet (ATTR_SIZE characters per value); they are
+  // inserted INSERT_BATCH_RECORDS at a time, so that the indexes are updated in bulk
+  vector<char> rows;
+  int numRows = 0;
+
   int retVal = SUCCESS;
   int columnCount = -1, lineNumber = 1;
-  while (getline(file, fileLine)) {
-    vector<string> row;
+  bool moreLines = true;
+  while (retVal == SUCCESS && moreLines) {
+    moreLines = static_cast<bool>(getline(file, fileLine));
 
-    stringstream lineStream(fileLine);
-
-    string item;
-    while (getline(lineStream, item, ',')) {
-      if (item.size() == 0) {
-        errorMsg += "Null values not allowed in attribute values\n";
-        retVal = FAILURE;
-        break;
+    vector<string> row;
+    if (moreLines) {
+      stringstream lineStream(fileLine);
+
+      string item;
+      while (getline(lineStream, item, ',')) {
+        if (item.size() == 0) {
+          errorMsg += "Null values not allowed in attribute values\n";
+          retVal = FAILURE;
+          break;
+        }
+        row.push_back(item);
       }
-      row.push_back(item);
-    }
-    if (retVal == FAILURE) {
-      break;
     }
 
-    if (columnCount == -1) {
-      columnCount = row.size();
-    } else if (columnCount != row.size()) {
-      errorMsg += "Mismatch in number of attributes\n";
-      retVal = FAILURE;
-      break;
+    if (moreLines && retVal == SUCCESS) {
+      if (columnCount == -1) {
+        columnCount = row.size();
+      } else if (columnCount != row.size()) {
+        errorMsg += "Mismatch in number of attributes\n";
+        retVal = FAILURE;
+      }
     }
 
-    char rowArray[columnCount][ATTR_SIZE];
-    for (int i = 0; i < columnCount; ++i) {
-      attrToTruncatedArray(row[i], rowArray[i]);
+    if (moreLines && retVal == SUCCESS) {
+      rows.resize((numRows + 1) * columnCount * ATTR_SIZE);
+      char(*rowArray)[ATTR_SIZE] = (char(*)[ATTR_SIZE])rows.data() + numRows * columnCount;
+      for (int i = 0; i < columnCount; ++i) {
+        attrToTruncatedArray(row[i], rowArray[i]);
+      }
+      numRows++;
     }
 
-    retVal = Frontend::insert_into_table_values(relName, columnCount, rowArray);
+    // insert the rows read once there are enough of them, at the end of the file,
+    // and before a line that could not be read
+    if (numRows == INSERT_BATCH_RECORDS || (numRows > 0 && (!moreLines || retVal != SUCCESS))) {
+      int numInserted;
+      int ret = Frontend::insert_into_table_rows(relName, numRows, columnCount, (char(*)[ATTR_SIZE])rows.data(),
+                                                 &numInserted);
+      lineNumber += numInserted;
+      if (ret != SUCCESS) {
+        retVal = ret;
+      }
 
-    if (retVal != SUCCESS) {
-      break;
+      rows.clear();
+      numRows = 0;
     }
-
-    lineNumber++;
   }
 
   file.close();
@@ -295,6 +516,24 @@ int RegexHandler::insertFromFileHandler() {
   return retVal;
 }
 
+int RegexHandler::deleteFromWhereHandler() {
+  char relName[ATTR_SIZE];
+  char attribute[ATTR_SIZE];
+  char valueStr[ATTR_SIZE];
+  attrToTruncatedArray(m[1], relName);
+  attrToTruncatedArray(m[2], attribute);
+  int op = getOperator(m[3]);
+  attrToTruncatedArray(m[4], valueStr);
+
+  int numDeleted;
+  int ret = Frontend::delete_from_table_where(relName, attribute, op, valueStr, &numDeleted);
+  if (ret == SUCCESS) {
+    cout << numDeleted << " rows deleted successfully" << endl;
+  }
+
+  return ret;
+}
+
 int RegexHandler::selectFromHandler() {
   char sourceRelName[ATTR_SIZE];
   char targetRelName[ATTR_SIZE];
@@ -379,6 +618,242 @@ int RegexHandler::selectAttrFromWhereHandler() {
   return ret;
 }
 
+int RegexHandler::selectFromWhereBetweenHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  char attribute[ATTR_SIZE];
+  char lowerStr[ATTR_SIZE];
+  char upperStr[ATTR_SIZE];
+  attrToTruncatedArray(m[1], sourceRelName);
+  attrToTruncatedArray(m[2], targetRelName);
+  attrToTruncatedArray(m[3], attribute);
+  attrToTruncatedArray(m[4], lowerStr);
+  attrToTruncatedArray(m[5], upperStr);
+
+  int ret = Frontend::select_from_table_where_between(sourceRelName, targetRelName, attribute, lowerStr, upperStr);
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+int RegexHandler::selectAttrFromWhereBetweenHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  char attribute[ATTR_SIZE];
+  char lowerStr[ATTR_SIZE];
+  char upperStr[ATTR_SIZE];
+
+  attrToTruncatedArray(m[2], sourceRelName);
+  attrToTruncatedArray(m[3], targetRelName);
+  attrToTruncatedArray(m[4], attribute);
+  attrToTruncatedArray(m[5], lowerStr);
+  attrToTruncatedArray(m[6], upperStr);
+
+  vector<string> attrTokens = extractTokens(m[1]);
+
+  int attrCount = attrTokens.size();
+  char attrNames[attrCount][ATTR_SIZE];
+  for (int i = 0; i < attrCount; i++) {
+    attrToTruncatedArray(attrTokens[i], attrNames[i]);
+  }
+
+  int ret = Frontend::select_attrlist_from_table_where_between(sourceRelName, targetRelName, attrCount, attrNames,
+                                                               attribute, lowerStr, upperStr);
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+int RegexHandler::selectFromWherePrefixHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  char eqAttribute[ATTR_SIZE];
+  char eqValue[ATTR_SIZE];
+  char attribute[ATTR_SIZE];
+  char value[ATTR_SIZE];
+  attrToTruncatedArray(m[1], sourceRelName);
+  attrToTruncatedArray(m[2], targetRelName);
+  attrToTruncatedArray(m[3], eqAttribute);
+  attrToTruncatedArray(m[4], eqValue);
+  attrToTruncatedArray(m[5], attribute);
+  int op = getOperator(m[6]);
+  attrToTruncatedArray(m[7], value);
+
+  int ret = Frontend::select_from_table_where_prefix(sourceRelName, targetRelName, eqAttribute, eqValue, attribute,
+                                                     op, value);
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+int RegexHandler::selectFromWherePrefixBetweenHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  char eqAttribute[ATTR_SIZE];
+  char eqValue[ATTR_SIZE];
+  char attribute[ATTR_SIZE];
+  char lowerStr[ATTR_SIZE];
+  char upperStr[ATTR_SIZE];
+  attrToTruncatedArray(m[1], sourceRelName);
+  attrToTruncatedArray(m[2], targetRelName);
+  attrToTruncatedArray(m[3], eqAttribute);
+  attrToTruncatedArray(m[4], eqValue);
+  attrToTruncatedArray(m[5], attribute);
+  attrToTruncatedArray(m[6], lowerStr);
+  attrToTruncatedArray(m[7], upperStr);
+
+  int ret = Frontend::select_from_table_where_prefix_between(sourceRelName, targetRelName, eqAttribute, eqValue,
+                                                             attribute, lowerStr, upperStr);
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+int RegexHandler::selectFromWhereEqualitiesHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  attrToTruncatedArray(m[1], sourceRelName);
+  attrToTruncatedArray(m[2], targetRelName);
+
+  // the terms `attribute = value` of the condition, all joined by AND or all by OR
+  string condition = m[3];
+  bool disjunction = regex_search(condition, regex("\\s+OR\\s+", regex_constants::icase));
+
+  regex termRegex("([#A-Za-z0-9_-]+)\\s*=\\s*([0-9]+\\.[0-9]+|[A-Za-z0-9_-]+)");
+  vector<smatch> terms(sregex_iterator(condition.begin(), condition.end(), termRegex), sregex_iterator());
+  int termCount = terms.size();
+  char attributes[termCount][ATTR_SIZE];
+  char values[termCount][ATTR_SIZE];
+  for (int i = 0; i < termCount; i++) {
+    attrToTruncatedArray(terms[i][1], attributes[i]);
+    attrToTruncatedArray(terms[i][2], values[i]);
+  }
+
+  int ret = Frontend::select_from_table_where_equalities(sourceRelName, targetRelName, termCount, attributes, values,
+                                                         disjunction);
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+int RegexHandler::selectOrderByHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char targetRelName[ATTR_SIZE];
+  char attribute[ATTR_SIZE];
+  char valueStr[ATTR_SIZE];
+  char orderAttribute[ATTR_SIZE];
+  attrToTruncatedArray(m[2], sourceRelName);
+  attrToTruncatedArray(m[3], targetRelName);
+  attrToTruncatedArray(m[7], orderAttribute);
+
+  // (the WHERE clause is optional, and the order ascending unless DESC is given)
+  bool hasCondition = m[4].matched;
+  int op = EQ;
+  if (hasCondition) {
+    attrToTruncatedArray(m[4], attribute);
+    op = getOperator(m[5]);
+    attrToTruncatedArray(m[6], valueStr);
+  }
+  bool descending = m[8].matched && toupper(m[8].str()[0]) == 'D';
+
+  int ret;
+  if (m[1] == "*") {
+    ret = Frontend::select_from_table_where_order_by(sourceRelName, targetRelName,
+                                                     hasCondition ? attribute : nullptr, op, valueStr,
+                                                     orderAttribute, descending);
+  } else {
+    vector<string> attrTokens = extractTokens(m[1]);
+
+    int attrCount = attrTokens.size();
+    char attrNames[attrCount][ATTR_SIZE];
+    for (int i = 0; i < attrCount; i++) {
+      attrToTruncatedArray(attrTokens[i], attrNames[i]);
+    }
+
+    ret = Frontend::select_attrlist_from_table_where_order_by(sourceRelName, targetRelName, attrCount, attrNames,
+                                                              hasCondition ? attribute : nullptr, op, valueStr,
+                                                              orderAttribute, descending);
+  }
+  if (ret == SUCCESS) {
+    cout << "Selected successfully into " << targetRelName << endl;
+  }
+
+  return ret;
+}
+
+int RegexHandler::selectMinMaxHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char attribute[ATTR_SIZE];
+  attrToTruncatedArray(m[2], attribute);
+  attrToTruncatedArray(m[3], sourceRelName);
+  bool max = toupper(m[1].str()[1]) == 'A';
+  const char *name = max ? "MAX" : "MIN";
+
+  Attribute value;
+  int attrType;
+  int ret = Frontend::select_min_max_from_table(sourceRelName, attribute, max, &value, &attrType);
+  if (ret == E_NOTFOUND) {
+    printf("%s(%s) of %s: no records\n", name, attribute, sourceRelName);
+    return SUCCESS;
+  }
+  if (ret == SUCCESS) {
+    if (attrType == NUMBER) {
+      printf("%s(%s) = %.15g\n", name, attribute, value.nVal);
+    } else {
+      printf("%s(%s) = %s\n", name, attribute, value.sVal);
+    }
+  }
+
+  return ret;
+}
+
+int RegexHandler::explainSelectWhereHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char attribute[ATTR_SIZE];
+  char valueStr[ATTR_SIZE];
+  attrToTruncatedArray(m[2], sourceRelName);
+  attrToTruncatedArray(m[4], attribute);
+  int op = getOperator(m[5]);
+  attrToTruncatedArray(m[6], valueStr);
+
+  AccessPlan plan;
+  int ret = Frontend::explain_select_from_table_where(sourceRelName, attribute, op, valueStr, &plan);
+  if (ret == SUCCESS) {
+    printPlan(&plan);
+  }
+
+  return ret;
+}
+
+int RegexHandler::explainSelectWhereBetweenHandler() {
+  char sourceRelName[ATTR_SIZE];
+  char attribute[ATTR_SIZE];
+  char lowerStr[ATTR_SIZE];
+  char upperStr[ATTR_SIZE];
+  attrToTruncatedArray(m[2], sourceRelName);
+  attrToTruncatedArray(m[4], attribute);
+  attrToTruncatedArray(m[5], lowerStr);
+  attrToTruncatedArray(m[6], upperStr);
+
+  AccessPlan plan;
+  int ret = Frontend::explain_select_from_table_where_between(sourceRelName, attribute, lowerStr, upperStr, &plan);
+  if (ret == SUCCESS) {
+    printPlan(&plan);
+  }
+
+  return ret;
+}
+
 int RegexHandler::selectFromJoinHandler() {
   char sourceRelOneName[ATTR_SIZE];
   char sourceRelTwoName[ATTR_SIZE];
@@ -537,6 +1012,20 @@ void attrToTruncatedArray(string nameString, char *nameArray) {
   }
 }
 
+// prints the access path chosen for a selection, and the costs (see BlockAccess::costPlan()) it was chosen on
+void printPlan(AccessPlan *plan) {
+  const char *methodNames[] = {"linear search", "B+ tree search", "hash index search", "bitmap index search"};
+  printf("Plan: %s\n", methodNames[plan->method]);
+  printf("Estimated records: %.1f (%s)\n", plan->numRecords,
+         plan->fromStats ? "from the statistics" : "default selectivity, the attribute is not analyzed");
+  if (plan->indexCost < 0) {
+    printf("Cost: linear search %.0f, no B+ tree\n", plan->linearCost);
+  } else {
+    printf("Cost: linear search %.0f, B+ tree search %.0f (height %d, about %.0f leaves)\n",
+           plan->linearCost, plan->indexCost, plan->indexHeight, plan->numLeaves);
+  }
+}
+
 void printErrorMsg(int error) {
   if (error == FAILURE)
     cout << "Error: Command Failed" << endl;
@@ -582,6 +1071,8 @@ void printErrorMsg(int error) {
     cout << "Error: This operation is not permitted" << endl;
   else if (error == E_INDEX_BLOCKS_RELEASED)
     cout << "Warning: Operation succeeded, but some indexes had to be dropped" << endl;
+  else if (error == E_NOSTATS)
+    cout << "Error: No statistics (run ANALYZE on the relation)" << endl;
 }
 
 void printHelp() {
@@ -590,18 +1081,39 @@ void printHelp() {
   printf("OPEN TABLE tablename;\n\t-open the relation \n\n");
   printf("CLOSE TABLE tablename;\n\t-close the relation \n \n");
   printf("CREATE INDEX ON tablename.attributename;\n\t-create an index on a given attribute. \n\n");
+  printf("CREATE INDEX ON tablename.attributename INCLUDE (attr2);\n\t-create an index that also carries the NUMBER attribute attr2, so that selections of just the two attributes are answered from the index. \n\n");
   printf("DROP INDEX ON tablename.attributename; \n\t-delete the index. \n\n");
+  printf("CREATE INDEX indexname ON tablename(attr1, attr2, ...);\n\t-create a composite index on the given attributes (2 to %d), ordered by attr1, then attr2, ... \n\n", MAX_INDEX_KEYS);
+  printf("DROP INDEX indexname ON tablename; \n\t-delete the composite index. \n\n");
+  printf("CREATE BLOOM FILTER ON tablename.attributename;\n\t-create (or rebuild) a bloom filter on a given attribute, used to skip equality searches for absent values. \n\n");
+  printf("DROP BLOOM FILTER ON tablename.attributename; \n\t-delete the bloom filter. \n\n");
+  printf("CREATE INDEX ON tablename.attributename USING HASH;\n\t-create a hash index on a given attribute, used for equality searches and joins on the attribute. \n\n");
+  printf("DROP INDEX ON tablename.attributename USING HASH; \n\t-delete the hash index. \n\n");
+  printf("CREATE INDEX ON tablename.attributename USING BITMAP;\n\t-create a bitmap index on a given attribute with few distinct values, used for equality searches and for conditions of several equalities. \n\n");
+  printf("DROP INDEX ON tablename.attributename USING BITMAP; \n\t-delete the bitmap index. \n\n");
+  printf("REINDEX tablename.attributename; \n\t-rebuild the index (or the composite index of that name) into full leaves in consecutive blocks. \n\n");
+  printf("ANALYZE tablename; \n\t-collect the statistics of the attributes of the relation (distinct values, smallest and largest value, histogram), used to estimate the records found by selections and joins. \n\n");
   printf("ALTER TABLE RENAME tablename TO new_tablename;\n\t-rename an existing relation to a given new name. \n\n");
   printf("ALTER TABLE RENAME tablename COLUMN column_name TO new_column_name;\n\t-rename an attribute of an existing relation.\n\n");
   printf("INSERT INTO tablename VALUES ( value1,value2,value3,... );\n\t-insert a single record into the given relation. \n\n");
   printf("INSERT INTO tablename VALUES FROM filepath; \n\t-insert multiple records from a csv file \n\n");
+  printf("DELETE FROM tablename WHERE attrname OP value; \n\t-delete the records that satisfy the condition, and their entries from the indexes of the relation\n\n");
   printf("SELECT * FROM source_relation INTO target_relation; \n\t-creates a relation with the same attributes and records as of source relation\n\n");
   printf("SELECT Attribute1,Attribute2,....FROM source_relation INTO target_relation; \n\t-creates a relation with attributes specified and all records\n\n");
   printf("SELECT * FROM source_relation INTO target_relation WHERE attrname OP value; \n\t-retrieve records based on a condition and insert them into a target relation\n\n");
   printf("SELECT Attribute1,Attribute2,....FROM source_relation INTO target_relation;\n\t-creates a relation with the attributes specified and inserts those records which satisfy the given condition.\n\n");
+  printf("SELECT * FROM source_relation INTO target_relation WHERE attrname BETWEEN value1 AND value2; \n\t-retrieve records whose attribute value lies between value1 and value2 (both inclusive) and insert them into a target relation\n\n");
+  printf("SELECT * FROM source_relation INTO target_relation WHERE attr1 = value1 AND attr2 OP value2; \n\t-retrieve records that satisfy both conditions (OP is one of <, <=, >, >=, =), using a composite index on (attr1, attr2, ...) if there is one\n\n");
+  printf("SELECT * FROM source_relation INTO target_relation WHERE attr1 = value1 AND attr2 BETWEEN value2 AND value3; \n\t-retrieve records with attr1 = value1 whose attr2 lies between value2 and value3 (both inclusive), using a composite index on (attr1, attr2, ...) if there is one\n\n");
+  printf("SELECT * FROM source_relation INTO target_relation WHERE attr1 = value1 AND attr2 = value2 AND ...; \n\t-retrieve records that satisfy every equality (or, with OR in place of AND, any of them; at most %d), using the bitmap indexes on the attributes if there are any\n\n", MAX_SELECT_TERMS);
+  printf("SELECT Attribute1,Attribute2,....FROM source_relation INTO target_relation WHERE attrname BETWEEN value1 AND value2; \n\t-creates a relation with the attributes specified and inserts those records whose attribute value lies between value1 and value2.\n\n");
+  printf("SELECT ... INTO target_relation [WHERE attrname OP value] ORDER BY attrname [ASC|DESC]; \n\t-creates a relation with the selected records in ascending (or descending) order of the attribute, read in order from its B+ tree if it has one, else sorted\n\n");
+  printf("SELECT MIN(attrname) FROM source_relation; \n\t-print the smallest value of the attribute (MAX for the largest), from the first (last) entry of its B+ tree if it has one, else with a scan of the relation\n\n");
+  printf("EXPLAIN SELECT ... WHERE attrname OP value; \n\t-show the access path (linear search or index) the selection would use, the records it is expected to find and the cost of each path, without running it (also for WHERE attrname BETWEEN value1 AND value2)\n\n");
   printf("SELECT * FROM source_relation1 JOIN source_relation2 INTO target_relation WHERE source_relation1.attribute1 = source_relation2.attribute2; \n\t-creates a new relation with by equi-join of both the source relations\n\n");
   printf("SELECT Attribute1,Attribute2,.. FROM source_relation1 JOIN source_relation2 INTO target_relation WHERE source_relation1.attribute1 = source_relation2.attribute2; \n\t-creates a new relation by equi-join of both the source relations with the attributes specified \n\n");
   printf("echo <any message> \n\t  -echo back the given string. \n\n");
   printf("run <filename> \n\t  -run commands from an input file in sequence. \n\n");
+  printf("time <command> \n\t  -run the command and print the time it took. \n\n");
   printf("exit \n\t-Exit the interface\n");
 }
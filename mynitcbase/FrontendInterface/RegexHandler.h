@@ -10,6 +10,7 @@
 #define EXIT_CMD "\\s*EXIT\\s*;?"
 #define RUN_CMD "\\s*RUN\\s+([a-zA-Z0-9_/.-]+)\\s*;?"
 #define ECHO_CMD "\\s*ECHO\\s*([a-zA-Z0-9 _,()'?:+*.-]*)\\s*;?"
+#define TIME_CMD "\\s*TIME\\s+(.+)"
 
 /* DDL Commands*/
 #define CREATE_TABLE_CMD "\\s*CREATE\\s+TABLE\\s+([A-Za-z0-9_-]+)\\s*\\(\\s*((?:[#A-Za-z0-9_-]+\\s+(?:STR|NUM)\\s*,\\s*)*(?:[#A-Za-z0-9_-]+\\s+(?:STR|NUM)))\\s*\\)\\s*;?"
@@ -17,7 +18,18 @@
 #define OPEN_TABLE_CMD "\\s*OPEN\\s+TABLE\\s+([A-Za-z0-9_-]+)\\s*;?"
 #define CLOSE_TABLE_CMD "\\s*CLOSE\\s+TABLE\\s+([A-Za-z0-9_-]+)\\s*;?"
 #define CREATE_INDEX_CMD "\\s*CREATE\\s+INDEX\\s+ON\\s+([A-Za-z0-9_-]+)\\s*\\.\\s*([#A-Za-z0-9_-]+)\\s*;?"
+#define CREATE_COVERING_INDEX_CMD "\\s*CREATE\\s+INDEX\\s+ON\\s+([A-Za-z0-9_-]+)\\s*\\.\\s*([#A-Za-z0-9_-]+)\\s+INCLUDE\\s*\\(\\s*([#A-Za-z0-9_-]+)\\s*\\)\\s*;?"
 #define DROP_INDEX_CMD "\\s*DROP\\s+INDEX\\s+ON\\s+([A-Za-z0-9_-]+)\\s*\\.\\s*([#A-Za-z0-9_-]+)\\s*;?"
+#define CREATE_COMPOSITE_INDEX_CMD "\\s*CREATE\\s+INDEX\\s+([#A-Za-z0-9_-]+)\\s+ON\\s+([A-Za-z0-9_-]+)\\s*\\(\\s*((?:[#A-Za-z0-9_-]+\\s*,\\s*)+(?:[#A-Za-z0-9_-]+))\\s*\\)\\s*;?"
+#define DROP_COMPOSITE_INDEX_CMD "\\s*DROP\\s+INDEX\\s+([#A-Za-z0-9_-]+)\\s+ON\\s+([A-Za-z0-9_-]+)\\s*;?"
+#define CREATE_BLOOM_CMD "\\s*CREATE\\s+BLOOM\\s+FILTER\\s+ON\\s+([A-Za-z0-9_-]+)\\s*\\.\\s*([#A-Za-z0-9_-]+)\\s*;?"
+#define CREATE_HASH_INDEX_CMD "\\s*CREATE\\s+INDEX\\s+ON\\s+([A-Za-z0-9_-]+)\\s*\\.\\s*([#A-Za-z0-9_-]+)\\s+USING\\s+HASH\\s*;?"
+#define DROP_HASH_INDEX_CMD "\\s*DROP\\s+INDEX\\s+ON\\s+([A-Za-z0-9_-]+)\\s*\\.\\s*([#A-Za-z0-9_-]+)\\s+USING\\s+HASH\\s*;?"
+#define CREATE_BITMAP_INDEX_CMD "\\s*CREATE\\s+INDEX\\s+ON\\s+([A-Za-z0-9_-]+)\\s*\\.\\s*([#A-Za-z0-9_-]+)\\s+USING\\s+BITMAP\\s*;?"
+#define DROP_BITMAP_INDEX_CMD "\\s*DROP\\s+INDEX\\s+ON\\s+([A-Za-z0-9_-]+)\\s*\\.\\s*([#A-Za-z0-9_-]+)\\s+USING\\s+BITMAP\\s*;?"
+#define DROP_BLOOM_CMD "\\s*DROP\\s+BLOOM\\s+FILTER\\s+ON\\s+([A-Za-z0-9_-]+)\\s*\\.\\s*([#A-Za-z0-9_-]+)\\s*;?"
+#define REINDEX_CMD "\\s*REINDEX\\s+([A-Za-z0-9_-]+)\\s*\\.\\s*([#A-Za-z0-9_-]+)\\s*;?"
+#define ANALYZE_CMD "\\s*ANALYZE\\s+([A-Za-z0-9_-]+)\\s*;?"
 #define RENAME_TABLE_CMD "\\s*ALTER\\s+TABLE\\s+RENAME\\s+([a-zA-Z0-9_-]+)\\s+TO\\s+([a-zA-Z0-9_-]+)\\s*;?"
 #define RENAME_COLUMN_CMD "\\s*ALTER\\s+TABLE\\s+RENAME\\s+([a-zA-Z0-9_-]+)\\s+COLUMN\\s+([#a-zA-Z0-9_-]+)\\s+TO\\s+([#a-zA-Z0-9_-]+)\\s*;?"
 
@@ -26,9 +38,20 @@
 #define SELECT_ATTR_FROM_CMD "\\s*SELECT\\s+((?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s*;?"
 #define SELECT_FROM_WHERE_CMD "\\s*SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([#A-Za-z0-9_-]+)\\s*(<|<=|>|>=|=|!=)\\s*([A-Za-z0-9_-]+|([0-9]+(\\.)[0-9]+))\\s*;?"
 #define SELECT_ATTR_FROM_WHERE_CMD "\\s*SELECT\\s+((?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([#A-Za-z0-9_-]+)\\s*(<|<=|>|>=|=|!=)\\s*([A-Za-z0-9_-]+|([0-9]+(\\.)[0-9]+))\\s*;?"
+#define SELECT_FROM_WHERE_BETWEEN_CMD "\\s*SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([#A-Za-z0-9_-]+)\\s+BETWEEN\\s+([A-Za-z0-9_-]+|[0-9]+\\.[0-9]+)\\s+AND\\s+([A-Za-z0-9_-]+|[0-9]+\\.[0-9]+)\\s*;?"
+#define SELECT_ATTR_FROM_WHERE_BETWEEN_CMD "\\s*SELECT\\s+((?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([#A-Za-z0-9_-]+)\\s+BETWEEN\\s+([A-Za-z0-9_-]+|[0-9]+\\.[0-9]+)\\s+AND\\s+([A-Za-z0-9_-]+|[0-9]+\\.[0-9]+)\\s*;?"
+#define SELECT_FROM_WHERE_PREFIX_CMD "\\s*SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([#A-Za-z0-9_-]+)\\s*=\\s*([0-9]+\\.[0-9]+|[A-Za-z0-9_-]+)\\s+AND\\s+([#A-Za-z0-9_-]+)\\s*(<|<=|>|>=|=)\\s*([0-9]+\\.[0-9]+|[A-Za-z0-9_-]+)\\s*;?"
+#define SELECT_FROM_WHERE_PREFIX_BETWEEN_CMD "\\s*SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([#A-Za-z0-9_-]+)\\s*=\\s*([0-9]+\\.[0-9]+|[A-Za-z0-9_-]+)\\s+AND\\s+([#A-Za-z0-9_-]+)\\s+BETWEEN\\s+([0-9]+\\.[0-9]+|[A-Za-z0-9_-]+)\\s+AND\\s+([0-9]+\\.[0-9]+|[A-Za-z0-9_-]+)\\s*;?"
+#define EQUALITY_TERM "[#A-Za-z0-9_-]+\\s*=\\s*(?:[0-9]+\\.[0-9]+|[A-Za-z0-9_-]+)"
+#define SELECT_FROM_WHERE_EQUALITIES_CMD "\\s*SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+(" EQUALITY_TERM "(?:\\s+AND\\s+" EQUALITY_TERM ")+|" EQUALITY_TERM "(?:\\s+OR\\s+" EQUALITY_TERM ")+)\\s*;?"
+#define SELECT_ORDER_BY_CMD "\\s*SELECT\\s+(\\*|(?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)(?:\\s+WHERE\\s+([#A-Za-z0-9_-]+)\\s*(<|<=|>|>=|=|!=)\\s*([0-9]+\\.[0-9]+|[A-Za-z0-9_-]+))?\\s+ORDER\\s+BY\\s+([#A-Za-z0-9_-]+)(?:\\s+(ASC|DESC))?\\s*;?"
+#define SELECT_MIN_MAX_CMD "\\s*SELECT\\s+(MIN|MAX)\\s*\\(\\s*([#A-Za-z0-9_-]+)\\s*\\)\\s+FROM\\s+([A-Za-z0-9_-]+)\\s*;?"
+#define EXPLAIN_SELECT_WHERE_CMD "\\s*EXPLAIN\\s+SELECT\\s+(\\*|(?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([#A-Za-z0-9_-]+)\\s*(<|<=|>|>=|=|!=)\\s*([A-Za-z0-9_-]+|([0-9]+(\\.)[0-9]+))\\s*;?"
+#define EXPLAIN_SELECT_WHERE_BETWEEN_CMD "\\s*EXPLAIN\\s+SELECT\\s+(\\*|(?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([#A-Za-z0-9_-]+)\\s+BETWEEN\\s+([A-Za-z0-9_-]+|[0-9]+\\.[0-9]+)\\s+AND\\s+([A-Za-z0-9_-]+|[0-9]+\\.[0-9]+)\\s*;?"
 #define SELECT_FROM_JOIN_CMD "\\s*SELECT\\s+\\*\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+JOIN\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*\\=\\s*([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*;?"
 #define SELECT_ATTR_FROM_JOIN_CMD "\\s*SELECT\\s+((?:[#A-Za-z0-9_-]+\\s*,\\s*)*(?:[#A-Za-z0-9_-]+))\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+JOIN\\s+([A-Za-z0-9_-]+)\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*\\=\\s*([A-Za-z0-9_-]+)\\s*\\.([#A-Za-z0-9_-]+)\\s*;?"
 #define INSERT_SINGLE_CMD "\\s*INSERT\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+VALUES\\s*\\(\\s*((?:(?:[A-Za-z0-9_-]+|[0-9]+\\.[0-9]+)\\s*,\\s*)*(?:[A-Za-z0-9_-]+|[0-9]+\\.[0-9]+))\\s*\\)\\s*;?"
+#define DELETE_FROM_WHERE_CMD "\\s*DELETE\\s+FROM\\s+([A-Za-z0-9_-]+)\\s+WHERE\\s+([#A-Za-z0-9_-]+)\\s*(<|<=|>|>=|=|!=)\\s*([0-9]+\\.[0-9]+|[A-Za-z0-9_-]+)\\s*;?"
 #define INSERT_MULTIPLE_CMD "\\s*INSERT\\s+INTO\\s+([A-Za-z0-9_-]+)\\s+VALUES\\s+FROM\\s+([a-zA-Z0-9_-]+\\.csv)\\s*;?"
 #define CUSTOM_CMD "\\s*FUNCTION\\s+([A-Za-z,#0-9\\s()_-]+)\\s*;?"
 
@@ -44,20 +67,42 @@ class RegexHandler {
       {REGEX(EXIT_CMD), &RegexHandler::exitHandler},
       {REGEX(ECHO_CMD), &RegexHandler::echoHandler},
       {REGEX(RUN_CMD), &RegexHandler::runHandler},
+      {REGEX(TIME_CMD), &RegexHandler::timeHandler},
       {REGEX(OPEN_TABLE_CMD), &RegexHandler::openHandler},
       {REGEX(CLOSE_TABLE_CMD), &RegexHandler::closeHandler},
       {REGEX(CREATE_TABLE_CMD), &RegexHandler::createTableHandler},
       {REGEX(DROP_TABLE_CMD), &RegexHandler::dropTableHandler},
       {REGEX(CREATE_INDEX_CMD), &RegexHandler::createIndexHandler},
+      {REGEX(CREATE_COVERING_INDEX_CMD), &RegexHandler::createCoveringIndexHandler},
       {REGEX(DROP_INDEX_CMD), &RegexHandler::dropIndexHandler},
+      {REGEX(CREATE_COMPOSITE_INDEX_CMD), &RegexHandler::createCompositeIndexHandler},
+      {REGEX(DROP_COMPOSITE_INDEX_CMD), &RegexHandler::dropCompositeIndexHandler},
+      {REGEX(CREATE_BLOOM_CMD), &RegexHandler::createBloomHandler},
+      {REGEX(DROP_BLOOM_CMD), &RegexHandler::dropBloomHandler},
+      {REGEX(CREATE_HASH_INDEX_CMD), &RegexHandler::createHashIndexHandler},
+      {REGEX(DROP_HASH_INDEX_CMD), &RegexHandler::dropHashIndexHandler},
+      {REGEX(CREATE_BITMAP_INDEX_CMD), &RegexHandler::createBitmapIndexHandler},
+      {REGEX(DROP_BITMAP_INDEX_CMD), &RegexHandler::dropBitmapIndexHandler},
+      {REGEX(REINDEX_CMD), &RegexHandler::reindexHandler},
+      {REGEX(ANALYZE_CMD), &RegexHandler::analyzeHandler},
       {REGEX(RENAME_TABLE_CMD), &RegexHandler::renameTableHandler},
       {REGEX(RENAME_COLUMN_CMD), &RegexHandler::renameColumnHandler},
       {REGEX(INSERT_SINGLE_CMD), &RegexHandler::insertSingleHandler},
       {REGEX(INSERT_MULTIPLE_CMD), &RegexHandler::insertFromFileHandler},
+      {REGEX(DELETE_FROM_WHERE_CMD), &RegexHandler::deleteFromWhereHandler},
       {REGEX(SELECT_FROM_CMD), &RegexHandler::selectFromHandler},
       {REGEX(SELECT_FROM_WHERE_CMD), &RegexHandler::selectFromWhereHandler},
       {REGEX(SELECT_ATTR_FROM_CMD), &RegexHandler::selectAttrFromHandler},
       {REGEX(SELECT_ATTR_FROM_WHERE_CMD), &RegexHandler::selectAttrFromWhereHandler},
+      {REGEX(SELECT_FROM_WHERE_BETWEEN_CMD), &RegexHandler::selectFromWhereBetweenHandler},
+      {REGEX(SELECT_ATTR_FROM_WHERE_BETWEEN_CMD), &RegexHandler::selectAttrFromWhereBetweenHandler},
+      {REGEX(SELECT_FROM_WHERE_PREFIX_CMD), &RegexHandler::selectFromWherePrefixHandler},
+      {REGEX(SELECT_FROM_WHERE_PREFIX_BETWEEN_CMD), &RegexHandler::selectFromWherePrefixBetweenHandler},
+      {REGEX(SELECT_FROM_WHERE_EQUALITIES_CMD), &RegexHandler::selectFromWhereEqualitiesHandler},
+      {REGEX(SELECT_ORDER_BY_CMD), &RegexHandler::selectOrderByHandler},
+      {REGEX(SELECT_MIN_MAX_CMD), &RegexHandler::selectMinMaxHandler},
+      {REGEX(EXPLAIN_SELECT_WHERE_CMD), &RegexHandler::explainSelectWhereHandler},
+      {REGEX(EXPLAIN_SELECT_WHERE_BETWEEN_CMD), &RegexHandler::explainSelectWhereBetweenHandler},
       {REGEX(SELECT_FROM_JOIN_CMD), &RegexHandler::selectFromJoinHandler},
       {REGEX(SELECT_ATTR_FROM_JOIN_CMD), &RegexHandler::selectAttrFromJoinHandler},
       {REGEX(CUSTOM_CMD), &RegexHandler::customFunctionHandler},
@@ -72,20 +117,42 @@ class RegexHandler {
   int exitHandler();
   int echoHandler();
   int runHandler();
+  int timeHandler();
   int openHandler();
   int closeHandler();
   int createTableHandler();
   int dropTableHandler();
   int createIndexHandler();
   int dropIndexHandler();
+  int createCoveringIndexHandler();
+  int createCompositeIndexHandler();
+  int dropCompositeIndexHandler();
+  int createBloomHandler();
+  int dropBloomHandler();
+  int createHashIndexHandler();
+  int dropHashIndexHandler();
+  int createBitmapIndexHandler();
+  int dropBitmapIndexHandler();
+  int reindexHandler();
+  int analyzeHandler();
   int renameTableHandler();
   int renameColumnHandler();
   int insertSingleHandler();
   int insertFromFileHandler();
+  int deleteFromWhereHandler();
   int selectFromHandler();
   int selectFromWhereHandler();
   int selectAttrFromHandler();
   int selectAttrFromWhereHandler();
+  int selectFromWhereBetweenHandler();
+  int selectAttrFromWhereBetweenHandler();
+  int selectFromWherePrefixHandler();
+  int selectFromWherePrefixBetweenHandler();
+  int selectFromWhereEqualitiesHandler();
+  int selectOrderByHandler();
+  int selectMinMaxHandler();
+  int explainSelectWhereHandler();
+  int explainSelectWhereBetweenHandler();
   int selectFromJoinHandler();
   int selectAttrFromJoinHandler();
   int customFunctionHandler();
@@ -0,0 +1,700 @@
+#include "HashIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// the directory entry of a hash (its low `depth` bits)
+static int dirIndexOf(uint64_t hash, int depth) {
+    return (int)(hash & ((1ULL << depth) - 1));
+}
+
+/*
+Returns the first block of the bucket at entry dirIndex of the directory of the
+hash index rooted at headBlockNum
+*/
+int HashIndex::getBucket(int headBlockNum, int dirIndex) {
+    HashBuffer headBuffer(headBlockNum);
+    int32_t dirBlock;
+    int response = headBuffer.getBlockNums(&dirBlock, dirIndex / HASH_BLOCK_NUMS, 1);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    HashBuffer dirBuffer(dirBlock);
+    int32_t bucketNum;
+    response = dirBuffer.getBlockNums(&bucketNum, dirIndex % HASH_BLOCK_NUMS, 1);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    return bucketNum;
+}
+
+int HashIndex::setBucket(int headBlockNum, int dirIndex, int bucketNum) {
+    HashBuffer headBuffer(headBlockNum);
+    int32_t dirBlock;
+    int response = headBuffer.getBlockNums(&dirBlock, dirIndex / HASH_BLOCK_NUMS, 1);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    HashBuffer dirBuffer(dirBlock);
+    int32_t bucket = bucketNum;
+    return dirBuffer.setBlockNums(&bucket, dirIndex % HASH_BLOCK_NUMS, 1);
+}
+
+/*
+Doubles the directory: entry i + 2^globalDepth gets the bucket of entry i, and
+the global depth is incremented. Directory blocks are allocated as needed.
+*/
+int HashIndex::doubleDirectory(int headBlockNum) {
+    HashBuffer headBuffer(headBlockNum);
+    HeadInfo head;
+    headBuffer.getHeader(&head);
+
+    int size = 1 << head.numAttrs;
+    int numDirBlocks = (2 * size + HASH_BLOCK_NUMS - 1) / HASH_BLOCK_NUMS;
+
+    // read the directory
+    int32_t dirBlocks[HASH_BLOCK_NUMS];
+    headBuffer.getBlockNums(dirBlocks, 0, head.numSlots);
+
+    std::vector<int32_t> directory(2 * size);
+    for (int i = 0; i < head.numSlots; i++) {
+        int count = std::min(HASH_BLOCK_NUMS, size - i * HASH_BLOCK_NUMS);
+        HashBuffer dirBuffer(dirBlocks[i]);
+        dirBuffer.getBlockNums(directory.data() + i * HASH_BLOCK_NUMS, 0, count);
+    }
+
+    // get free blocks for the new half of the directory (if it does not fit in the blocks it has)
+    for (int i = head.numSlots; i < numDirBlocks; i++) {
+        HashBuffer dirBuffer;
+        dirBlocks[i] = dirBuffer.getBlockNum();
+        if (dirBlocks[i] == E_DISKFULL) {
+            for (int j = head.numSlots; j < i; j++) {
+                HashBuffer allocatedBuffer(dirBlocks[j]);
+                allocatedBuffer.releaseBlock();
+            }
+            return E_DISKFULL;
+        }
+
+        HeadInfo dirHead;
+        dirBuffer.getHeader(&dirHead);
+        dirHead.pblock = headBlockNum;
+        dirBuffer.setHeader(&dirHead);
+    }
+
+    std::copy(directory.begin(), directory.begin() + size, directory.begin() + size);
+
+    // write the directory back (numEntries of a directory block is the number of entries in it)
+    for (int i = 0; i < numDirBlocks; i++) {
+        int count = std::min(HASH_BLOCK_NUMS, 2 * size - i * HASH_BLOCK_NUMS);
+        HashBuffer dirBuffer(dirBlocks[i]);
+        dirBuffer.setBlockNums(directory.data() + i * HASH_BLOCK_NUMS, 0, count);
+
+        HeadInfo dirHead;
+        dirBuffer.getHeader(&dirHead);
+        dirHead.numEntries = count;
+        dirBuffer.setHeader(&dirHead);
+    }
+
+    headBuffer.setBlockNums(dirBlocks, 0, numDirBlocks);
+    head.numAttrs++;
+    head.numSlots = numDirBlocks;
+    return headBuffer.setHeader(&head);
+}
+
+/*
+Stores `entries` in the bucket starting at block bucketNum (of the given local
+depth), in its first block and as many overflow blocks as needed. The bucket
+must not have overflow blocks (see splitBucket()).
+*/
+int HashIndex::writeBucket(int bucketNum, int localDepth, std::vector<Index> &entries) {
+    int numEntries = entries.size();
+    int block = bucketNum;
+    int written = 0;
+
+    while (true) {
+        int count = std::min(HASH_BUCKET_ENTRIES, numEntries - written);
+
+        HashBuffer bucketBuffer(block);
+        HeadInfo bucketHead;
+        bucketBuffer.getHeader(&bucketHead);
+        bucketHead.numEntries = count;
+        bucketHead.numAttrs = localDepth;
+        bucketHead.rblock = -1;
+        if (count > 0) {
+            bucketBuffer.setEntries(entries.data() + written, 0, count);
+        }
+        written += count;
+
+        if (written == numEntries) {
+            return bucketBuffer.setHeader(&bucketHead);
+        }
+
+        // chain an overflow block for the rest of the entries
+        HashBuffer overflowBuffer;
+        int overflowBlock = overflowBuffer.getBlockNum();
+        if (overflowBlock == E_DISKFULL) {
+            bucketBuffer.setHeader(&bucketHead);
+            return E_DISKFULL;
+        }
+
+        bucketHead.rblock = overflowBlock;
+        bucketBuffer.setHeader(&bucketHead);
+        block = overflowBlock;
+    }
+}
+
+// releases the block `block` and the overflow blocks chained after it (rblock)
+static void releaseChain(int block) {
+    while (block != -1) {
+        HashBuffer blockBuffer(block);
+        HeadInfo blockHead;
+        blockBuffer.getHeader(&blockHead);
+        blockBuffer.releaseBlock();
+        block = blockHead.rblock;
+    }
+}
+
+/*
+Splits the bucket of the values with the given hash in two on the bit at its
+local depth, doubling the directory first if its local depth is the global depth.
+The entries of the bucket with the bit set go to a new bucket, and the directory
+entries of the bucket with the bit set are pointed at it.
+The new bucket is written first, so if the disk is full the bucket is left as
+it was (the blocks got for the new bucket are released, and E_DISKFULL is
+returned); its overflow blocks are then released and its own entries written
+back, needing at most as many blocks.
+*/
+int HashIndex::splitBucket(int headBlockNum, uint64_t hash, int attrType) {
+    HashBuffer headBuffer(headBlockNum);
+    HeadInfo head;
+    headBuffer.getHeader(&head);
+
+    int bucketNum = HashIndex::getBucket(headBlockNum, dirIndexOf(hash, head.numAttrs));
+
+    HashBuffer bucketBuffer(bucketNum);
+    HeadInfo bucketHead;
+    bucketBuffer.getHeader(&bucketHead);
+    int localDepth = bucketHead.numAttrs;
+
+    if (localDepth == head.numAttrs) {
+        int response = HashIndex::doubleDirectory(headBlockNum);
+        if (response != SUCCESS) {
+            return response;
+        }
+        headBuffer.getHeader(&head);
+    }
+
+    // get a free block for the new bucket before anything is changed
+    HashBuffer newBuffer;
+    int newBucketNum = newBuffer.getBlockNum();
+    if (newBucketNum == E_DISKFULL) {
+        return E_DISKFULL;
+    }
+
+    // read every entry of the bucket
+    std::vector<Index> lowEntries, highEntries;
+    int block = bucketNum;
+    while (block != -1) {
+        HashBuffer blockBuffer(block);
+        HeadInfo blockHead;
+        blockBuffer.getHeader(&blockHead);
+
+        Index entries[HASH_BUCKET_ENTRIES];
+        blockBuffer.getEntries(entries, 0, blockHead.numEntries);
+        for (int i = 0; i < blockHead.numEntries; i++) {
+            if ((hashAttr(entries[i].attrVal, attrType) >> localDepth) & 1) {
+                highEntries.push_back(entries[i]);
+            } else {
+                lowEntries.push_back(entries[i]);
+            }
+        }
+        block = blockHead.rblock;
+    }
+
+    // (the new bucket is not in the directory yet, so hashDestroy() would not find its blocks)
+    int response = HashIndex::writeBucket(newBucketNum, localDepth + 1, highEntries);
+    if (response != SUCCESS) {
+        releaseChain(newBucketNum);
+        return response;
+    }
+
+    // (the entries left need no more blocks than the overflow blocks released)
+    releaseChain(bucketHead.rblock);
+    response = HashIndex::writeBucket(bucketNum, localDepth + 1, lowEntries);
+    if (response != SUCCESS) {
+        releaseChain(newBucketNum);
+        return response;
+    }
+
+    // the entries of the bucket are every 2^localDepth'th one from the lowest;
+    // those with the bit at localDepth set now point to the new bucket
+    int first = dirIndexOf(hash, localDepth) | (1 << localDepth);
+    for (int dirIndex = first; dirIndex < (1 << head.numAttrs); dirIndex += 1 << (localDepth + 1)) {
+        HashIndex::setBucket(headBlockNum, dirIndex, newBucketNum);
+    }
+
+    return SUCCESS;
+}
+
+/*
+Adds the entry to the bucket starting at block bucketNum: to its first block if
+that has room, else to its first overflow block, chaining a new overflow block
+after the first block if that is full too.
+*/
+int HashIndex::addToBucket(int bucketNum, Index *entry) {
+    HashBuffer bucketBuffer(bucketNum);
+    HeadInfo bucketHead;
+    bucketBuffer.getHeader(&bucketHead);
+
+    int block = bucketNum;
+    if (bucketHead.numEntries == HASH_BUCKET_ENTRIES && bucketHead.rblock != -1) {
+        block = bucketHead.rblock;
+    }
+
+    HashBuffer blockBuffer(block);
+    HeadInfo blockHead;
+    blockBuffer.getHeader(&blockHead);
+
+    if (blockHead.numEntries == HASH_BUCKET_ENTRIES) {
+        HashBuffer overflowBuffer;
+        block = overflowBuffer.getBlockNum();
+        if (block == E_DISKFULL) {
+            return E_DISKFULL;
+        }
+
+        overflowBuffer.getHeader(&blockHead);
+        blockHead.numAttrs = bucketHead.numAttrs;
+        blockHead.rblock = bucketHead.rblock;
+        overflowBuffer.setHeader(&blockHead);
+
+        bucketHead.rblock = block;
+        bucketBuffer.setHeader(&bucketHead);
+    }
+
+    HashBuffer targetBuffer(block);
+    targetBuffer.getHeader(&blockHead);
+    targetBuffer.setEntries(entry, blockHead.numEntries, 1);
+    blockHead.numEntries++;
+    return targetBuffer.setHeader(&blockHead);
+}
+
+int HashIndex::hashCreate(int relId, char attrName[ATTR_SIZE]) {
+
+    // (the catalogs are always searched in full)
+    if (relId == RELCAT_RELID || relId == ATTRCAT_RELID || relId == INDEXCAT_RELID) {
+        return E_NOTPERMITTED;
+    }
+
+    // get the attribute catalog entry of attribute `attrName`
+    // using AttrCacheTable::getAttrCatEntry()
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    // an index already exists for the attribute
+    if (attrCatEntry.hashBlock != -1) {
+        return SUCCESS;
+    }
+
+    RelCatEntry relCatEntry;
+    response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    // get free blocks for the head block, the directory and its one bucket
+    HashBuffer headBuffer;
+    int headBlock = headBuffer.getBlockNum();
+    if (headBlock == E_DISKFULL) {
+        return E_DISKFULL;
+    }
+
+    HashBuffer dirBuffer;
+    int32_t dirBlock = dirBuffer.getBlockNum();
+    if (dirBlock == E_DISKFULL) {
+        headBuffer.releaseBlock();
+        return E_DISKFULL;
+    }
+
+    HashBuffer bucketBuffer;
+    int32_t bucketBlock = bucketBuffer.getBlockNum();
+    if (bucketBlock == E_DISKFULL) {
+        dirBuffer.releaseBlock();
+        headBuffer.releaseBlock();
+        return E_DISKFULL;
+    }
+
+    // (a directory of global depth 0: its one entry is a bucket of local depth 0)
+    HeadInfo head;
+    bucketBuffer.getHeader(&head);
+    head.numEntries = 0;
+    head.numAttrs = 0;
+    bucketBuffer.setHeader(&head);
+
+    dirBuffer.getHeader(&head);
+    head.pblock = headBlock;
+    head.numEntries = 1;
+    dirBuffer.setHeader(&head);
+    dirBuffer.setBlockNums(&bucketBlock, 0, 1);
+
+    headBuffer.getHeader(&head);
+    head.numEntries = 0;
+    head.numAttrs = 0;
+    head.numSlots = 1;
+    headBuffer.setHeader(&head);
+    headBuffer.setBlockNums(&dirBlock, 0, 1);
+
+    // update the hashBlock field of the attribute cache entry
+    attrCatEntry.hashBlock = headBlock;
+    response = AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    /***** Traverse all the blocks in the relation and insert every value into the index *****/
+    int block = relCatEntry.firstBlk;
+    while (block != -1) {
+        RecBuffer recBuffer(block);
+
+        HeadInfo recHead;
+        recBuffer.getHeader(&recHead);
+
+        unsigned char slotMap[recHead.numSlots];
+        recBuffer.getSlotMap(slotMap);
+
+        for (int slot = 0; slot < recHead.numSlots; slot++) {
+            if (slotMap[slot] == SLOT_UNOCCUPIED) {
+                continue;
+            }
+
+            Attribute record[relCatEntry.numAttrs];
+            recBuffer.getRecord(record, slot);
+
+            RecId recId = {block, slot};
+            // (if the disk is full, hashInsert() destroys the index)
+            response = HashIndex::hashInsert(relId, attrName, record[attrCatEntry.offset], recId);
+            if (response != SUCCESS) {
+                return response;
+            }
+        }
+
+        block = recHead.rblock;
+    }
+
+    return SUCCESS;
+}
+
+/*
+Inserts the entry (attrVal, recId) into the hash index on the attribute. If the
+disk is full, the index is destroyed and E_DISKFULL is returned (the caller
+removes its index catalog entry).
+*/
+int HashIndex::hashInsert(int relId, char attrName[ATTR_SIZE], Attribute attrVal, RecId recId) {
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    // the attribute does not have a hash index
+    if (attrCatEntry.hashBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    int headBlock = attrCatEntry.hashBlock;
+    uint64_t hash = hashAttr(attrVal, attrCatEntry.attrType);
+
+    Index entry;
+    entry.attrVal = attrVal;
+    entry.block = recId.block;
+    entry.slot = recId.slot;
+    memset(entry.included, 0, sizeof(entry.included));
+
+    HashBuffer headBuffer(headBlock);
+    HeadInfo head;
+    int bucketNum;
+    while (true) {
+        headBuffer.getHeader(&head);
+        bucketNum = HashIndex::getBucket(headBlock, dirIndexOf(hash, head.numAttrs));
+
+        HashBuffer bucketBuffer(bucketNum);
+        HeadInfo bucketHead;
+        bucketBuffer.getHeader(&bucketHead);
+
+        // the first block of the bucket has room
+        if (bucketHead.numEntries < HASH_BUCKET_ENTRIES || bucketHead.numAttrs == HASH_MAX_DEPTH) {
+            break;
+        }
+
+        /* the bucket is split unless every value in its first block has the hash
+           of attrVal (no split could separate them, so it overflows instead) */
+        Index entries[HASH_BUCKET_ENTRIES];
+        bucketBuffer.getEntries(entries, 0, HASH_BUCKET_ENTRIES);
+        bool separable = false;
+        for (int i = 0; i < HASH_BUCKET_ENTRIES && !separable; i++) {
+            separable = hashAttr(entries[i].attrVal, attrCatEntry.attrType) != hash;
+        }
+        if (!separable) {
+            break;
+        }
+
+        response = HashIndex::splitBucket(headBlock, hash, attrCatEntry.attrType);
+        if (response != SUCCESS) {
+            break;
+        }
+    }
+
+    if (response == SUCCESS) {
+        response = HashIndex::addToBucket(bucketNum, &entry);
+    }
+
+    if (response == E_DISKFULL) {
+        // destroy the index and update the attribute cache entry
+        HashIndex::hashDestroy(headBlock);
+        attrCatEntry.hashBlock = -1;
+        AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+        return E_DISKFULL;
+    }
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    // increment the number of entries in the index
+    head.numEntries++;
+    return headBuffer.setHeader(&head);
+}
+
+/*
+Returns the record id of the next record whose value of the attribute equals
+attrVal, continuing from the search index of the attribute (as
+BPlusTree::bPlusSearch() does for EQ). Returns {-1, -1} if there is none.
+*/
+RecId HashIndex::hashSearch(int relId, char attrName[ATTR_SIZE], Attribute attrVal) {
+    IndexId searchIndex;
+    int response = AttrCacheTable::getSearchIndex(relId, attrName, &searchIndex);
+    if (response != SUCCESS) {
+        printf("failed to get search index for %s\n", attrName);
+        exit(1);
+    }
+
+    AttrCatEntry attrCatEntry;
+    response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        printf("failed to get attrCatEntry for %s\n", attrName);
+        exit(1);
+    }
+
+    if (attrCatEntry.hashBlock == -1) {
+        return RecId{-1, -1};
+    }
+
+    int block, index;
+    if (searchIndex.block == -1 || searchIndex.index == -1) {
+        // (search is done for the first time: start from the bucket of the value)
+        HashBuffer headBuffer(attrCatEntry.hashBlock);
+        HeadInfo head;
+        headBuffer.getHeader(&head);
+
+        uint64_t hash = hashAttr(attrVal, attrCatEntry.attrType);
+        block = HashIndex::getBucket(attrCatEntry.hashBlock, dirIndexOf(hash, head.numAttrs));
+        index = 0;
+    } else {
+        // (the search is resumed from the entry after the one found last)
+        block = searchIndex.block;
+        index = searchIndex.index + 1;
+    }
+
+    // look for the value in the blocks of the bucket
+    while (block != -1) {
+        HashBuffer bucketBuffer(block);
+        int entryNum = bucketBuffer.findEntry(attrVal, attrCatEntry.attrType, index);
+        if (entryNum >= 0) {
+            Index entry;
+            bucketBuffer.getEntries(&entry, entryNum, 1);
+
+            searchIndex = IndexId{block, entryNum};
+            AttrCacheTable::setSearchIndex(relId, attrName, &searchIndex);
+
+            return RecId{entry.block, entry.slot};
+        }
+
+        HeadInfo bucketHead;
+        bucketBuffer.getHeader(&bucketHead);
+        block = bucketHead.rblock;
+        index = 0;
+    }
+
+    return RecId{-1, -1};
+}
+
+/*
+Removes the entry (attrVal, recId) from the hash index on the attribute. The
+last entry of its block takes its place, and an overflow block that becomes
+empty is released.
+NOTE: buckets are not merged (nor the directory halved) when they empty.
+*/
+int HashIndex::hashDelete(int relId, char attrName[ATTR_SIZE], Attribute attrVal, RecId recId) {
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    if (attrCatEntry.hashBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    HashBuffer headBuffer(attrCatEntry.hashBlock);
+    HeadInfo head;
+    headBuffer.getHeader(&head);
+
+    uint64_t hash = hashAttr(attrVal, attrCatEntry.attrType);
+    int prevBlock = -1;
+    int block = HashIndex::getBucket(attrCatEntry.hashBlock, dirIndexOf(hash, head.numAttrs));
+
+    while (block != -1) {
+        HashBuffer blockBuffer(block);
+        HeadInfo blockHead;
+        blockBuffer.getHeader(&blockHead);
+
+        Index entries[HASH_BUCKET_ENTRIES];
+        blockBuffer.getEntries(entries, 0, blockHead.numEntries);
+        for (int i = 0; i < blockHead.numEntries; i++) {
+            if (entries[i].block != recId.block || entries[i].slot != recId.slot) {
+                continue;
+            }
+
+            // move the last entry of the block into the place of the entry
+            blockHead.numEntries--;
+            if (i != blockHead.numEntries) {
+                blockBuffer.setEntries(&entries[blockHead.numEntries], i, 1);
+            }
+            blockBuffer.setHeader(&blockHead);
+
+            // (the first block of a bucket is kept even if it is empty)
+            if (blockHead.numEntries == 0 && prevBlock != -1) {
+                HashBuffer prevBuffer(prevBlock);
+                HeadInfo prevHead;
+                prevBuffer.getHeader(&prevHead);
+                prevHead.rblock = blockHead.rblock;
+                prevBuffer.setHeader(&prevHead);
+
+                blockBuffer.releaseBlock();
+            }
+
+            head.numEntries--;
+            return headBuffer.setHeader(&head);
+        }
+
+        prevBlock = block;
+        block = blockHead.rblock;
+    }
+
+    return E_NOTFOUND;
+}
+
+int HashIndex::hashDestroy(int headBlockNum) {
+    /*headBlockNum lies outside the valid range [0,DISK_BLOCKS-1]*/
+    if (headBlockNum < 0 || headBlockNum >= DISK_BLOCKS) {
+        return E_OUTOFBOUND;
+    }
+
+    if (StaticBuffer::getStaticBlockType(headBlockNum) != HASH_INDEX) {
+        return E_INVALIDBLOCK;
+    }
+
+    HashBuffer headBuffer(headBlockNum);
+    HeadInfo head;
+    headBuffer.getHeader(&head);
+
+    /* find every bucket once: a bucket of local depth d is found at its
+       directory entry below 2^d (the first of its entries). The buckets are
+       found before any is released (a released block is not read again). */
+    std::vector<int> buckets;
+    int size = 1 << head.numAttrs;
+    for (int dirIndex = 0; dirIndex < size; dirIndex++) {
+        int bucketNum = HashIndex::getBucket(headBlockNum, dirIndex);
+
+        HashBuffer bucketBuffer(bucketNum);
+        HeadInfo bucketHead;
+        bucketBuffer.getHeader(&bucketHead);
+        if (dirIndex < (1 << bucketHead.numAttrs)) {
+            buckets.push_back(bucketNum);
+        }
+    }
+
+    // release the blocks of every bucket
+    for (int bucketNum : buckets) {
+        releaseChain(bucketNum);
+    }
+
+    // release the directory blocks and then the head block
+    int32_t dirBlocks[HASH_BLOCK_NUMS];
+    headBuffer.getBlockNums(dirBlocks, 0, head.numSlots);
+    for (int i = 0; i < head.numSlots; i++) {
+        HashBuffer dirBuffer(dirBlocks[i]);
+        dirBuffer.releaseBlock();
+    }
+
+    headBuffer.releaseBlock();
+
+    return SUCCESS;
+}
+
+/*
+Fills `info` with the size of the hash index rooted at headBlockNum
+*/
+int HashIndex::hashInfo(int headBlockNum, HashIndexInfo *info) {
+    if (headBlockNum < 0 || headBlockNum >= DISK_BLOCKS) {
+        return E_OUTOFBOUND;
+    }
+
+    if (StaticBuffer::getStaticBlockType(headBlockNum) != HASH_INDEX) {
+        return E_INVALIDBLOCK;
+    }
+
+    HashBuffer headBuffer(headBlockNum);
+    HeadInfo head;
+    headBuffer.getHeader(&head);
+
+    info->globalDepth = head.numAttrs;
+    info->numDirBlocks = head.numSlots;
+    info->numBuckets = 0;
+    info->numOverflowBlocks = 0;
+    info->numEntries = head.numEntries;
+    info->maxChainLength = 0;
+
+    int size = 1 << head.numAttrs;
+    for (int dirIndex = 0; dirIndex < size; dirIndex++) {
+        int block = HashIndex::getBucket(headBlockNum, dirIndex);
+
+        HashBuffer bucketBuffer(block);
+        HeadInfo bucketHead;
+        bucketBuffer.getHeader(&bucketHead);
+        if (dirIndex >= (1 << bucketHead.numAttrs)) {
+            continue;
+        }
+
+        int chainLength = 0;
+        while (block != -1) {
+            HashBuffer blockBuffer(block);
+            HeadInfo blockHead;
+            blockBuffer.getHeader(&blockHead);
+            chainLength++;
+            block = blockHead.rblock;
+        }
+
+        info->numBuckets++;
+        info->numOverflowBlocks += chainLength - 1;
+        info->maxChainLength = std::max(info->maxChainLength, chainLength);
+    }
+
+    return SUCCESS;
+}
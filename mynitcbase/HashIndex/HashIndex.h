@@ -0,0 +1,51 @@
+#ifndef NITCBASE_HASHINDEX_H
+#define NITCBASE_HASHINDEX_H
+
+#include <vector>
+
+#include "../Buffer/BlockBuffer.h"
+#include "../Buffer/StaticBuffer.h"
+#include "../Cache/AttrCacheTable.h"
+#include "../Cache/RelCacheTable.h"
+#include "../define/constants.h"
+#include "../define/id.h"
+
+typedef struct HashIndexInfo {
+  int globalDepth;        // the directory has 2^globalDepth entries
+  int numDirBlocks;       // number of directory blocks
+  int numBuckets;         // number of buckets (a bucket may have many directory entries)
+  int numOverflowBlocks;  // number of blocks chained after the first block of a bucket
+  int numEntries;         // number of entries in the index
+  int maxChainLength;     // number of blocks of the longest bucket
+} HashIndexInfo;
+
+/*
+An extendible hash index on an attribute. The head block holds the global depth
+(numAttrs), the number of entries (numEntries) and the block numbers of the
+directory blocks (numSlots of them). Entry i of the directory is the first block
+of the bucket holding the values whose hash has i in its low globalDepth bits.
+A bucket of local depth d (numAttrs of its first block) has 2^(globalDepth - d)
+directory entries. A full bucket is split in two, doubling the directory if its
+local depth is the global depth; a bucket that can not be split (its values
+share their hash, or it is at HASH_MAX_DEPTH) gets overflow blocks chained after
+its first block (rblock).
+*/
+class HashIndex {
+ private:
+  static int getBucket(int headBlockNum, int dirIndex);
+  static int setBucket(int headBlockNum, int dirIndex, int bucketNum);
+  static int doubleDirectory(int headBlockNum);
+  static int splitBucket(int headBlockNum, uint64_t hash, int attrType);
+  static int writeBucket(int bucketNum, int localDepth, std::vector<Index> &entries);
+  static int addToBucket(int bucketNum, Index *entry);
+
+ public:
+  static int hashCreate(int relId, char attrName[ATTR_SIZE]);
+  static int hashInsert(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, RecId recId);
+  static RecId hashSearch(int relId, char attrName[ATTR_SIZE], union Attribute attrVal);
+  static int hashDelete(int relId, char attrName[ATTR_SIZE], union Attribute attrVal, RecId recId);
+  static int hashDestroy(int headBlockNum);
+  static int hashInfo(int headBlockNum, HashIndexInfo *info);
+};
+
+#endif  // NITCBASE_HASHINDEX_H
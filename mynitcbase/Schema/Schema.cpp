@@ -283,8 +283,18 @@ int Schema::dropIndex(char *relName, char *attrName) {
         return E_NOINDEX;
     }
 
-    // destroy the bplus tree rooted at rootBlock using BPlusTree::bPlusDestroy()
-    BPlusTree::bPlusDestroy(rootBlock);
+    // unlink the tree from the attribute and release its blocks using
+    // BPlusTree::bPlusDrop() (in one write, for readers in other threads)
+    BPlusTree::bPlusDrop(relId, attrName);
+
+    // the included attribute goes with the tree (the index catalog is open whenever it exists)
+    if (attrCatEntry.includeOffset != -1) {
+        RecId indexCatRecId = Schema::findIndexCatEntry(relName, attrName, INDEX_INCLUDE);
+        if (indexCatRecId.block != -1) {
+            BlockAccess::deleteRecord(INDEXCAT_RELID, indexCatRecId);
+        }
+        attrCatEntry.includeOffset = -1;
+    }
 
     // set rootBlock = -1 in the attribute cache entry of the attribute using
     // AttrCacheTable::setAttrCatEntry()
@@ -292,4 +302,732 @@ int Schema::dropIndex(char *relName, char *attrName) {
     AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
 
     return SUCCESS;
-}
\ No newline at end of file
+}
+
+/*
+Creates the B+ tree on attrName with the value of the NUMBER attribute
+includeName carried in its leaf entries (in the 8 bytes an entry leaves
+unused), so that selections of just the two attributes are answered from the
+leaves (see BlockAccess::openIndexOnlyScan()). An existing tree on the
+attribute is rebuilt. The included attribute is recorded in the index catalog.
+*/
+int Schema::createCoveringIndex(char relName[ATTR_SIZE], char attrName[ATTR_SIZE], char includeName[ATTR_SIZE]) {
+    // if the relName is one of the catalogs, return E_NOTPERMITTED
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, INDEXCAT_RELNAME) == 0) {
+        return E_NOTPERMITTED;
+    }
+
+    // if relation is not open in open relation table, return E_RELNOTOPEN
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry, includeCatEntry;
+    if (AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry) != SUCCESS ||
+        AttrCacheTable::getAttrCatEntry(relId, includeName, &includeCatEntry) != SUCCESS) {
+        return E_ATTRNOTEXIST;
+    }
+    if (strcmp(attrName, includeName) == 0) {
+        return E_DUPLICATEATTR;
+    }
+
+    // (a leaf entry has room for a NUMBER, not for a STRING)
+    if (includeCatEntry.attrType != NUMBER) {
+        return E_ATTRTYPEMISMATCH;
+    }
+
+    // the included attribute is recorded in the index catalog (created on first use)
+    int response = Schema::openIndexCat();
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    // drop the existing tree on the attribute (and the attribute it includes)
+    response = Schema::dropIndex(relName, attrName);
+    if (response != SUCCESS && response != E_NOINDEX) {
+        return response;
+    }
+    // (the included attribute of a tree released when the disk was full is still recorded)
+    RecId indexCatRecId = Schema::findIndexCatEntry(relName, attrName, INDEX_INCLUDE);
+    if (indexCatRecId.block != -1) {
+        BlockAccess::deleteRecord(INDEXCAT_RELID, indexCatRecId);
+    }
+
+    Attribute indexCatRecord[INDEXCAT_NO_ATTRS];
+    strcpy(indexCatRecord[INDEXCAT_REL_NAME_INDEX].sVal, relName);
+    strcpy(indexCatRecord[INDEXCAT_INDEX_NAME_INDEX].sVal, attrName);
+    indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal = INDEX_INCLUDE;
+    strcpy(indexCatRecord[INDEXCAT_ATTR_NAME_INDEX].sVal, includeName);
+    indexCatRecord[INDEXCAT_KEY_NUM_INDEX].nVal = 0;
+    indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal = -1;
+
+    response = BlockAccess::insert(INDEXCAT_RELID, indexCatRecord);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    attrCatEntry.includeOffset = includeCatEntry.offset;
+    AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+
+    response = BPlusTree::bPlusCreate(relId, attrName);
+    if (response != SUCCESS) {
+        // (dropIndex() would find no tree; remove the included attribute here)
+        indexCatRecId = Schema::findIndexCatEntry(relName, attrName, INDEX_INCLUDE);
+        BlockAccess::deleteRecord(INDEXCAT_RELID, indexCatRecId);
+        attrCatEntry.includeOffset = -1;
+        AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+    }
+
+    return response;
+}
+/*
+Opens the index catalog, creating it if it does not exist yet.
+(the index catalog is kept open at INDEXCAT_RELID once it exists)
+*/
+int Schema::openIndexCat() {
+    char indexCatName[] = INDEXCAT_RELNAME;
+    if (OpenRelTable::getRelId(indexCatName) == INDEXCAT_RELID) {
+        return SUCCESS;
+    }
+
+    char attrNames[INDEXCAT_NO_ATTRS][ATTR_SIZE] = {
+        INDEXCAT_ATTR_RELNAME, INDEXCAT_ATTR_INDEX_NAME, INDEXCAT_ATTR_INDEX_TYPE,
+        INDEXCAT_ATTR_ATTRIBUTE_NAME, INDEXCAT_ATTR_KEY_NUM, INDEXCAT_ATTR_ROOT_BLOCK};
+    int attrTypes[INDEXCAT_NO_ATTRS] = {STRING, STRING, NUMBER, STRING, NUMBER, NUMBER};
+
+    int response = Schema::createRel(indexCatName, INDEXCAT_NO_ATTRS, attrNames, attrTypes);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    response = OpenRelTable::openRel(indexCatName);
+    if (response < 0) {
+        return response;
+    }
+
+    return SUCCESS;
+}
+
+/*
+Returns the record id of the index catalog entry for the structure of type
+indexType named indexName on the relation relName ({-1, -1} if there is none).
+NOTE: this function expects the index catalog to be open
+*/
+RecId Schema::findIndexCatEntry(char relName[ATTR_SIZE], char indexName[ATTR_SIZE], int indexType) {
+    Attribute relNameAttr;
+    strcpy(relNameAttr.sVal, relName);
+    char relNameConst[] = INDEXCAT_ATTR_RELNAME;
+
+    RelCacheTable::resetSearchIndex(INDEXCAT_RELID);
+    while (true) {
+        RecId recId = BlockAccess::linearSearch(INDEXCAT_RELID, relNameConst, relNameAttr, EQ);
+        if (recId.block == -1 && recId.slot == -1) {
+            return recId;
+        }
+
+        Attribute indexCatRecord[INDEXCAT_NO_ATTRS];
+        RecBuffer indexCatBuffer(recId.block);
+        indexCatBuffer.getRecord(indexCatRecord, recId.slot);
+
+        if (strcmp(indexCatRecord[INDEXCAT_INDEX_NAME_INDEX].sVal, indexName) == 0 &&
+            (int)indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal == indexType) {
+            return recId;
+        }
+    }
+}
+
+int Schema::createBloomFilter(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]) {
+    // if the relName is one of the catalogs, return E_NOTPERMITTED
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, INDEXCAT_RELNAME) == 0) {
+        return E_NOTPERMITTED;
+    }
+
+    // if relation is not open in open relation table, return E_RELNOTOPEN
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return E_ATTRNOTEXIST;
+    }
+
+    // the filter is recorded in the index catalog (created on first use)
+    response = Schema::openIndexCat();
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    /* if the attribute already has a filter, it is rebuilt (sized for the
+       current number of records) and its index catalog entry is updated */
+    RecId indexCatRecId = {-1, -1};
+    if (attrCatEntry.bloomBlock != -1) {
+        indexCatRecId = Schema::findIndexCatEntry(relName, attrName, INDEX_BLOOM);
+
+        BloomFilter::bloomDestroy(attrCatEntry.bloomBlock);
+        attrCatEntry.bloomBlock = -1;
+        AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+    }
+
+    response = BloomFilter::bloomCreate(relId, attrName);
+    if (response != SUCCESS) {
+        // (the old filter is gone, so is its entry)
+        if (indexCatRecId.block != -1) {
+            BlockAccess::deleteRecord(INDEXCAT_RELID, indexCatRecId);
+        }
+        return response;
+    }
+
+    AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+
+    Attribute indexCatRecord[INDEXCAT_NO_ATTRS];
+    if (indexCatRecId.block != -1) {
+        RecBuffer indexCatBuffer(indexCatRecId.block);
+        indexCatBuffer.getRecord(indexCatRecord, indexCatRecId.slot);
+        indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal = attrCatEntry.bloomBlock;
+        return indexCatBuffer.setRecord(indexCatRecord, indexCatRecId.slot);
+    }
+
+    // (a bloom filter is named after the attribute it is on)
+    strcpy(indexCatRecord[INDEXCAT_REL_NAME_INDEX].sVal, relName);
+    strcpy(indexCatRecord[INDEXCAT_INDEX_NAME_INDEX].sVal, attrName);
+    indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal = INDEX_BLOOM;
+    strcpy(indexCatRecord[INDEXCAT_ATTR_NAME_INDEX].sVal, attrName);
+    indexCatRecord[INDEXCAT_KEY_NUM_INDEX].nVal = 0;
+    indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal = attrCatEntry.bloomBlock;
+
+    response = BlockAccess::insert(INDEXCAT_RELID, indexCatRecord);
+    if (response != SUCCESS) {
+        // (a filter that is not in the index catalog would be lost on close)
+        BloomFilter::bloomDestroy(attrCatEntry.bloomBlock);
+        attrCatEntry.bloomBlock = -1;
+        AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+        return response;
+    }
+
+    return SUCCESS;
+}
+
+int Schema::dropBloomFilter(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]) {
+    // if the relName is one of the catalogs, return E_NOTPERMITTED
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, INDEXCAT_RELNAME) == 0) {
+        return E_NOTPERMITTED;
+    }
+
+    // if relation is not open in open relation table, return E_RELNOTOPEN
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return E_ATTRNOTEXIST;
+    }
+
+    /* attribute does not have a filter (bloomBlock = -1) */
+    if (attrCatEntry.bloomBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    // remove the index catalog entry of the filter and destroy the filter
+    RecId indexCatRecId = Schema::findIndexCatEntry(relName, attrName, INDEX_BLOOM);
+    if (indexCatRecId.block != -1) {
+        BlockAccess::deleteRecord(INDEXCAT_RELID, indexCatRecId);
+    }
+
+    BloomFilter::bloomDestroy(attrCatEntry.bloomBlock);
+
+    attrCatEntry.bloomBlock = -1;
+    AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+
+    return SUCCESS;
+}
+
+int Schema::getBloomFilterInfo(char relName[ATTR_SIZE], char attrName[ATTR_SIZE], BloomFilterInfo *info) {
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return E_ATTRNOTEXIST;
+    }
+
+    if (attrCatEntry.bloomBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    return BloomFilter::bloomInfo(attrCatEntry.bloomBlock, info);
+}
+
+int Schema::createHashIndex(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]) {
+    // if the relName is one of the catalogs, return E_NOTPERMITTED
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, INDEXCAT_RELNAME) == 0) {
+        return E_NOTPERMITTED;
+    }
+
+    // if relation is not open in open relation table, return E_RELNOTOPEN
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return E_ATTRNOTEXIST;
+    }
+
+    // (an index already exists for the attribute)
+    if (attrCatEntry.hashBlock != -1) {
+        return SUCCESS;
+    }
+
+    // the index is recorded in the index catalog (created on first use)
+    response = Schema::openIndexCat();
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    response = HashIndex::hashCreate(relId, attrName);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+
+    // (a hash index is named after the attribute it is on)
+    Attribute indexCatRecord[INDEXCAT_NO_ATTRS];
+    strcpy(indexCatRecord[INDEXCAT_REL_NAME_INDEX].sVal, relName);
+    strcpy(indexCatRecord[INDEXCAT_INDEX_NAME_INDEX].sVal, attrName);
+    indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal = INDEX_HASH;
+    strcpy(indexCatRecord[INDEXCAT_ATTR_NAME_INDEX].sVal, attrName);
+    indexCatRecord[INDEXCAT_KEY_NUM_INDEX].nVal = 0;
+    indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal = attrCatEntry.hashBlock;
+
+    response = BlockAccess::insert(INDEXCAT_RELID, indexCatRecord);
+    if (response != SUCCESS) {
+        // (an index that is not in the index catalog would be lost on close)
+        HashIndex::hashDestroy(attrCatEntry.hashBlock);
+        attrCatEntry.hashBlock = -1;
+        AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+        return response;
+    }
+
+    return SUCCESS;
+}
+
+int Schema::dropHashIndex(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]) {
+    // if the relName is one of the catalogs, return E_NOTPERMITTED
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, INDEXCAT_RELNAME) == 0) {
+        return E_NOTPERMITTED;
+    }
+
+    // if relation is not open in open relation table, return E_RELNOTOPEN
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return E_ATTRNOTEXIST;
+    }
+
+    /* attribute does not have a hash index (hashBlock = -1) */
+    if (attrCatEntry.hashBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    // remove the index catalog entry of the index and destroy the index
+    RecId indexCatRecId = Schema::findIndexCatEntry(relName, attrName, INDEX_HASH);
+    if (indexCatRecId.block != -1) {
+        BlockAccess::deleteRecord(INDEXCAT_RELID, indexCatRecId);
+    }
+
+    HashIndex::hashDestroy(attrCatEntry.hashBlock);
+
+    attrCatEntry.hashBlock = -1;
+    AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+
+    return SUCCESS;
+}
+
+int Schema::getHashIndexInfo(char relName[ATTR_SIZE], char attrName[ATTR_SIZE], HashIndexInfo *info) {
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return E_ATTRNOTEXIST;
+    }
+
+    if (attrCatEntry.hashBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    return HashIndex::hashInfo(attrCatEntry.hashBlock, info);
+}
+
+int Schema::createBitmapIndex(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]) {
+    // if the relName is one of the catalogs, return E_NOTPERMITTED
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, INDEXCAT_RELNAME) == 0) {
+        return E_NOTPERMITTED;
+    }
+
+    // if relation is not open in open relation table, return E_RELNOTOPEN
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return E_ATTRNOTEXIST;
+    }
+
+    // (an index already exists for the attribute)
+    if (attrCatEntry.bitmapBlock != -1) {
+        return SUCCESS;
+    }
+
+    // the index is recorded in the index catalog (created on first use)
+    response = Schema::openIndexCat();
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    response = BitmapIndex::bitmapCreate(relId, attrName);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+
+    // (a bitmap index is named after the attribute it is on)
+    Attribute indexCatRecord[INDEXCAT_NO_ATTRS];
+    strcpy(indexCatRecord[INDEXCAT_REL_NAME_INDEX].sVal, relName);
+    strcpy(indexCatRecord[INDEXCAT_INDEX_NAME_INDEX].sVal, attrName);
+    indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal = INDEX_BITMAP;
+    strcpy(indexCatRecord[INDEXCAT_ATTR_NAME_INDEX].sVal, attrName);
+    indexCatRecord[INDEXCAT_KEY_NUM_INDEX].nVal = 0;
+    indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal = attrCatEntry.bitmapBlock;
+
+    response = BlockAccess::insert(INDEXCAT_RELID, indexCatRecord);
+    if (response != SUCCESS) {
+        // (an index that is not in the index catalog would be lost on close)
+        BitmapIndex::bitmapDestroy(attrCatEntry.bitmapBlock);
+        attrCatEntry.bitmapBlock = -1;
+        AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+        return response;
+    }
+
+    return SUCCESS;
+}
+
+int Schema::dropBitmapIndex(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]) {
+    // if the relName is one of the catalogs, return E_NOTPERMITTED
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, INDEXCAT_RELNAME) == 0) {
+        return E_NOTPERMITTED;
+    }
+
+    // if relation is not open in open relation table, return E_RELNOTOPEN
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return E_ATTRNOTEXIST;
+    }
+
+    /* attribute does not have a bitmap index (bitmapBlock = -1) */
+    if (attrCatEntry.bitmapBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    // remove the index catalog entry of the index and destroy the index
+    RecId indexCatRecId = Schema::findIndexCatEntry(relName, attrName, INDEX_BITMAP);
+    if (indexCatRecId.block != -1) {
+        BlockAccess::deleteRecord(INDEXCAT_RELID, indexCatRecId);
+    }
+
+    BitmapIndex::bitmapDestroy(attrCatEntry.bitmapBlock);
+
+    attrCatEntry.bitmapBlock = -1;
+    AttrCacheTable::setAttrCatEntry(relId, attrName, &attrCatEntry);
+
+    return SUCCESS;
+}
+
+int Schema::getBitmapIndexInfo(char relName[ATTR_SIZE], char attrName[ATTR_SIZE], BitmapIndexInfo *info) {
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return E_ATTRNOTEXIST;
+    }
+
+    if (attrCatEntry.bitmapBlock == -1) {
+        return E_NOINDEX;
+    }
+
+    return BitmapIndex::bitmapInfo(attrCatEntry.bitmapBlock, info);
+}
+
+/*
+Rebuilds the B+ tree of an attribute (or the composite index attrName) of an
+open relation into densely filled leaves in consecutive blocks, replacing the
+tree in place (see BPlusTree::bPlusRebuild()).
+*/
+int Schema::rebuildIndex(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]) {
+    // if the relName is one of the catalogs, return E_NOTPERMITTED
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, INDEXCAT_RELNAME) == 0) {
+        return E_NOTPERMITTED;
+    }
+
+    // if relation is not open in open relation table, return E_RELNOTOPEN
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    return BPlusTree::bPlusRebuild(relId, attrName);
+}
+
+// gets the shape of the B+ tree of an attribute (or of the composite index attrName) of an open relation
+int Schema::getIndexStats(char relName[ATTR_SIZE], char attrName[ATTR_SIZE], IndexStats *stats) {
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    return BPlusTree::bPlusCheck(relId, attrName, stats);
+}
+
+/*
+Collects the statistics of all the attributes of an open relation (see
+Statistics::analyze()). The statistics block of an attribute analyzed for the
+first time is recorded in the index catalog; those of the attributes analyzed
+before are rewritten in place.
+*/
+int Schema::analyzeRel(char relName[ATTR_SIZE]) {
+    // if the relName is one of the catalogs, return E_NOTPERMITTED
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, INDEXCAT_RELNAME) == 0) {
+        return E_NOTPERMITTED;
+    }
+
+    // if relation is not open in open relation table, return E_RELNOTOPEN
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    // the statistics are recorded in the index catalog (created on first use)
+    int response = Schema::openIndexCat();
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+    int statsBlocks[relCatEntry.numAttrs];
+    for (int attr = 0; attr < relCatEntry.numAttrs; attr++) {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(relId, attr, &attrCatEntry);
+        statsBlocks[attr] = attrCatEntry.statsBlock;
+    }
+
+    response = Statistics::analyze(relId);
+
+    // record the new statistics blocks (even if the analysis stopped half way,
+    // so that the blocks of the attributes analyzed are not lost)
+    for (int attr = 0; attr < relCatEntry.numAttrs; attr++) {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(relId, attr, &attrCatEntry);
+        if (statsBlocks[attr] != -1 || attrCatEntry.statsBlock == -1) {
+            continue;
+        }
+
+        // (the statistics of an attribute are named after it)
+        Attribute indexCatRecord[INDEXCAT_NO_ATTRS];
+        strcpy(indexCatRecord[INDEXCAT_REL_NAME_INDEX].sVal, relName);
+        strcpy(indexCatRecord[INDEXCAT_INDEX_NAME_INDEX].sVal, attrCatEntry.attrName);
+        indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal = INDEX_STATS;
+        strcpy(indexCatRecord[INDEXCAT_ATTR_NAME_INDEX].sVal, attrCatEntry.attrName);
+        indexCatRecord[INDEXCAT_KEY_NUM_INDEX].nVal = 0;
+        indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal = attrCatEntry.statsBlock;
+
+        int insertResponse = BlockAccess::insert(INDEXCAT_RELID, indexCatRecord);
+        if (insertResponse != SUCCESS) {
+            // (statistics that are not in the index catalog would be lost on close)
+            Statistics::statsDestroy(attrCatEntry.statsBlock);
+            attrCatEntry.statsBlock = -1;
+            AttrCacheTable::setAttrCatEntry(relId, attr, &attrCatEntry);
+            if (response == SUCCESS) {
+                response = insertResponse;
+            }
+        }
+    }
+
+    return response;
+}
+
+// gets the statistics of an attribute of an open relation (E_NOSTATS if it was never analyzed)
+int Schema::getAttrStats(char relName[ATTR_SIZE], char attrName[ATTR_SIZE], AttrStats *stats) {
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    return Statistics::getStats(relId, attrName, stats);
+}
+
+/*
+Creates the composite index indexName on the relation, over the attributes
+attrNames in that order (its key compares them lexicographically). The B+ tree
+of the index is built in bulk, and the index is recorded in the index catalog
+with one entry per attribute (KeyNum giving its position in the key).
+*/
+int Schema::createCompositeIndex(char relName[ATTR_SIZE], char indexName[ATTR_SIZE], int numKeys,
+                                 char attrNames[][ATTR_SIZE]) {
+    // if the relName is one of the catalogs, return E_NOTPERMITTED
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, INDEXCAT_RELNAME) == 0) {
+        return E_NOTPERMITTED;
+    }
+
+    // if relation is not open in open relation table, return E_RELNOTOPEN
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    // (a key of one attribute is the B+ tree of the attribute)
+    if (numKeys < 2 || numKeys > MAX_INDEX_KEYS) {
+        return E_INVALID;
+    }
+
+    /* the index is looked up by name like the B+ tree of an attribute, so its
+       name can not be that of an attribute or of another composite index */
+    AttrCatEntry attrCatEntry;
+    CompositeIndexInfo compositeIndex;
+    if (AttrCacheTable::getAttrCatEntry(relId, indexName, &attrCatEntry) == SUCCESS ||
+        RelCacheTable::getCompositeIndex(relId, indexName, &compositeIndex) == SUCCESS) {
+        return E_ATTREXIST;
+    }
+
+    strcpy(compositeIndex.indexName, indexName);
+    compositeIndex.numKeys = numKeys;
+    compositeIndex.rootBlock = -1;
+    for (int keyNum = 0; keyNum < numKeys; keyNum++) {
+        if (AttrCacheTable::getAttrCatEntry(relId, attrNames[keyNum], &attrCatEntry) != SUCCESS) {
+            return E_ATTRNOTEXIST;
+        }
+        for (int i = 0; i < keyNum; i++) {
+            if (strcmp(attrNames[i], attrNames[keyNum]) == 0) {
+                return E_DUPLICATEATTR;
+            }
+        }
+        compositeIndex.keyOffsets[keyNum] = attrCatEntry.offset;
+        compositeIndex.keyTypes[keyNum] = attrCatEntry.attrType;
+    }
+
+    // the index is recorded in the index catalog (created on first use)
+    int response = Schema::openIndexCat();
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    response = RelCacheTable::setCompositeIndex(relId, &compositeIndex);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    response = BPlusTree::bPlusCreate(relId, indexName);
+    if (response != SUCCESS) {
+        RelCacheTable::removeCompositeIndex(relId, indexName);
+        return response;
+    }
+    RelCacheTable::getCompositeIndex(relId, indexName, &compositeIndex);
+
+    for (int keyNum = 0; keyNum < numKeys; keyNum++) {
+        Attribute indexCatRecord[INDEXCAT_NO_ATTRS];
+        strcpy(indexCatRecord[INDEXCAT_REL_NAME_INDEX].sVal, relName);
+        strcpy(indexCatRecord[INDEXCAT_INDEX_NAME_INDEX].sVal, indexName);
+        indexCatRecord[INDEXCAT_INDEX_TYPE_INDEX].nVal = INDEX_COMPOSITE;
+        strcpy(indexCatRecord[INDEXCAT_ATTR_NAME_INDEX].sVal, attrNames[keyNum]);
+        indexCatRecord[INDEXCAT_KEY_NUM_INDEX].nVal = keyNum;
+        indexCatRecord[INDEXCAT_ROOT_BLOCK_INDEX].nVal = compositeIndex.rootBlock;
+
+        response = BlockAccess::insert(INDEXCAT_RELID, indexCatRecord);
+        if (response != SUCCESS) {
+            // (an index that is not fully in the index catalog would be lost on close)
+            Schema::dropCompositeIndex(relName, indexName);
+            return response;
+        }
+    }
+
+    return SUCCESS;
+}
+
+int Schema::dropCompositeIndex(char relName[ATTR_SIZE], char indexName[ATTR_SIZE]) {
+    // if the relName is one of the catalogs, return E_NOTPERMITTED
+    if (strcmp(relName, RELCAT_RELNAME) == 0 || strcmp(relName, ATTRCAT_RELNAME) == 0 ||
+        strcmp(relName, INDEXCAT_RELNAME) == 0) {
+        return E_NOTPERMITTED;
+    }
+
+    // if relation is not open in open relation table, return E_RELNOTOPEN
+    int relId = OpenRelTable::getRelId(relName);
+    if (relId == E_RELNOTOPEN) {
+        return E_RELNOTOPEN;
+    }
+
+    CompositeIndexInfo compositeIndex;
+    if (RelCacheTable::getCompositeIndex(relId, indexName, &compositeIndex) != SUCCESS) {
+        return E_NOINDEX;
+    }
+
+    // remove the index catalog entries of the index (one per attribute of its key)
+    RecId indexCatRecId = Schema::findIndexCatEntry(relName, indexName, INDEX_COMPOSITE);
+    while (indexCatRecId.block != -1) {
+        BlockAccess::deleteRecord(INDEXCAT_RELID, indexCatRecId);
+        indexCatRecId = Schema::findIndexCatEntry(relName, indexName, INDEX_COMPOSITE);
+    }
+
+    if (compositeIndex.rootBlock != -1) {
+        BPlusTree::bPlusDrop(relId, indexName);
+    }
+
+    return RelCacheTable::removeCompositeIndex(relId, indexName);
+}
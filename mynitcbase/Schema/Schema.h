@@ -11,10 +11,31 @@ class Schema {
   static int deleteRel(char relName[ATTR_SIZE]);
   static int createIndex(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]);
   static int dropIndex(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]);
+  static int createCoveringIndex(char relName[ATTR_SIZE], char attrName[ATTR_SIZE], char includeName[ATTR_SIZE]);
+  static int createCompositeIndex(char relName[ATTR_SIZE], char indexName[ATTR_SIZE], int numKeys,
+                                  char attrNames[][ATTR_SIZE]);
+  static int dropCompositeIndex(char relName[ATTR_SIZE], char indexName[ATTR_SIZE]);
   static int renameRel(char oldRelName[ATTR_SIZE], char newRelName[ATTR_SIZE]);
   static int renameAttr(char relName[ATTR_SIZE], char oldAttrName[ATTR_SIZE], char newAttrName[ATTR_SIZE]);
   static int openRel(char relName[ATTR_SIZE]);
   static int closeRel(char relName[ATTR_SIZE]);
+  static int createBloomFilter(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]);
+  static int dropBloomFilter(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]);
+  static int getBloomFilterInfo(char relName[ATTR_SIZE], char attrName[ATTR_SIZE], BloomFilterInfo *info);
+  static int createHashIndex(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]);
+  static int dropHashIndex(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]);
+  static int getHashIndexInfo(char relName[ATTR_SIZE], char attrName[ATTR_SIZE], HashIndexInfo *info);
+  static int createBitmapIndex(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]);
+  static int dropBitmapIndex(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]);
+  static int getBitmapIndexInfo(char relName[ATTR_SIZE], char attrName[ATTR_SIZE], BitmapIndexInfo *info);
+  static int rebuildIndex(char relName[ATTR_SIZE], char attrName[ATTR_SIZE]);
+  static int getIndexStats(char relName[ATTR_SIZE], char attrName[ATTR_SIZE], IndexStats *stats);
+  static int analyzeRel(char relName[ATTR_SIZE]);
+  static int getAttrStats(char relName[ATTR_SIZE], char attrName[ATTR_SIZE], AttrStats *stats);
+
+ private:
+  static int openIndexCat();
+  static RecId findIndexCatEntry(char relName[ATTR_SIZE], char indexName[ATTR_SIZE], int indexType);
 };
 
 #endif  // NITCBASE_SCHEMA_H
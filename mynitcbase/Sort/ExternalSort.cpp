@@ -0,0 +1,406 @@
+#include "ExternalSort.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+int ExternalSort::sortBegin(SortState *state, int numAttrs, int keyOffset, int keyType, int memoryBlocks,
+                            bool descending) {
+    if (numAttrs <= 0 || keyOffset < 0 || keyOffset >= numAttrs || memoryBlocks < SORT_MIN_MEMORY) {
+        return E_INVALID;
+    }
+
+    // (a record must fit in a block of a run)
+    int recordsPerBlock = RunBuffer::getMaxRecords(numAttrs);
+    if (recordsPerBlock == 0) {
+        return E_INVALID;
+    }
+
+    state->numAttrs = numAttrs;
+    state->keyOffset = keyOffset;
+    state->keyType = keyType;
+    state->descending = descending;
+    state->memoryBlocks = memoryBlocks;
+    state->recordsPerBlock = recordsPerBlock;
+
+    // the memory budget is spent on the records collected before a run is written
+    state->records.assign(memoryBlocks * recordsPerBlock * numAttrs, Attribute());
+    state->numRecords = 0;
+    state->inMemory = false;
+    state->position = 0;
+
+    state->runs.clear();
+    state->cursors.clear();
+    state->heap.clear();
+
+    state->initialRuns = 0;
+    state->mergePasses = 0;
+    state->blocksWritten = 0;
+    state->blocksRead = 0;
+
+    return SUCCESS;
+}
+
+int ExternalSort::sortAdd(SortState *state, union Attribute *record) {
+    // if the memory is full, write the records collected so far as a run
+    if (state->numRecords == state->memoryBlocks * state->recordsPerBlock) {
+        int response = writeMemoryRun(state);
+        if (response != SUCCESS) {
+            return response;
+        }
+    }
+
+    memcpy(&state->records[state->numRecords * state->numAttrs], record, state->numAttrs * ATTR_SIZE);
+    state->numRecords++;
+
+    return SUCCESS;
+}
+
+int ExternalSort::sortEnd(SortState *state) {
+    // if no run was written, the whole input is in memory; sort it there
+    if (state->runs.empty()) {
+        sortInMemory(state);
+        state->inMemory = true;
+        state->position = 0;
+        return SUCCESS;
+    }
+
+    // write the records still in memory as the last run, and give up the memory
+    if (state->numRecords > 0) {
+        int response = writeMemoryRun(state);
+        if (response != SUCCESS) {
+            return response;
+        }
+    }
+    std::vector<Attribute>().swap(state->records);
+
+    // one block of memory per run being merged, and one for the merged run
+    int fanIn = state->memoryBlocks - 1;
+
+    // merge (fanIn) consecutive runs at a time into a longer run, until the
+    // remaining runs can all be merged at once by sortNext()
+    while ((int)state->runs.size() > fanIn) {
+        std::vector<SortRun> inputRuns, mergedRuns;
+        inputRuns.swap(state->runs);
+
+        for (int firstRun = 0; firstRun < (int)inputRuns.size(); firstRun += fanIn) {
+            int numRuns = std::min(fanIn, (int)inputRuns.size() - firstRun);
+
+            // (a single run left over is carried to the next pass as it is)
+            if (numRuns == 1) {
+                mergedRuns.push_back(inputRuns[firstRun]);
+                inputRuns[firstRun].firstBlock = -1;
+                continue;
+            }
+
+            RunWriter writer;
+            writerOpen(state, &writer);
+
+            // (the blocks of the merged runs are released as they are read)
+            mergeOpen(state, &inputRuns[firstRun], numRuns);
+
+            Attribute record[state->numAttrs];
+            int response = SUCCESS;
+            while (response == SUCCESS && mergeNext(state, record) == SUCCESS) {
+                response = writerAdd(state, &writer, record);
+            }
+            if (response == SUCCESS) {
+                response = writerClose(state, &writer);
+            }
+
+            mergeClose(state);
+
+            if (response != SUCCESS) {
+                // release the blocks of every run (the ones not merged yet, and the ones merged so far)
+                releaseBlocks(writer.run.firstBlock);
+                for (int runNum = 0; runNum < (int)inputRuns.size(); runNum++) {
+                    releaseBlocks(inputRuns[runNum].firstBlock);
+                }
+                for (int runNum = 0; runNum < (int)mergedRuns.size(); runNum++) {
+                    releaseBlocks(mergedRuns[runNum].firstBlock);
+                }
+                return response;
+            }
+
+            mergedRuns.push_back(writer.run);
+        }
+
+        state->runs.swap(mergedRuns);
+        state->mergePasses++;
+    }
+
+    // the final merge is done by sortNext()
+    mergeOpen(state, state->runs.data(), state->runs.size());
+    state->runs.clear();
+
+    return SUCCESS;
+}
+
+int ExternalSort::sortNext(SortState *state, union Attribute *record) {
+    // (the input was sorted in memory)
+    if (state->inMemory) {
+        if (state->position == state->numRecords) {
+            return E_NOTFOUND;
+        }
+
+        memcpy(record, &state->records[state->position * state->numAttrs], state->numAttrs * ATTR_SIZE);
+        state->position++;
+        return SUCCESS;
+    }
+
+    return mergeNext(state, record);
+}
+
+void ExternalSort::sortClose(SortState *state) {
+    // release the blocks of the runs not read yet
+    mergeClose(state);
+    for (int runNum = 0; runNum < (int)state->runs.size(); runNum++) {
+        releaseBlocks(state->runs[runNum].firstBlock);
+    }
+    state->runs.clear();
+
+    std::vector<Attribute>().swap(state->records);
+    state->numRecords = 0;
+}
+
+/*
+Compares the keys of two records (same as compareAttrs(), with the sign reversed
+in a descending sort)
+*/
+int ExternalSort::compareRecords(SortState *state, union Attribute *record1, union Attribute *record2) {
+    int cmpVal = compareAttrs(record1[state->keyOffset], record2[state->keyOffset], state->keyType);
+    return state->descending ? -cmpVal : cmpVal;
+}
+
+/*
+Sorts the records collected in memory (stable, through an array of their indices)
+*/
+void ExternalSort::sortInMemory(SortState *state) {
+    int numAttrs = state->numAttrs;
+    Attribute *records = state->records.data();
+
+    std::vector<int> order(state->numRecords);
+    for (int i = 0; i < state->numRecords; i++) {
+        order[i] = i;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [state, records, numAttrs](int index1, int index2) {
+        return compareRecords(state, records + index1 * numAttrs, records + index2 * numAttrs) < 0;
+    });
+
+    std::vector<Attribute> sorted(state->numRecords * numAttrs);
+    for (int i = 0; i < state->numRecords; i++) {
+        memcpy(&sorted[i * numAttrs], records + order[i] * numAttrs, numAttrs * ATTR_SIZE);
+    }
+    std::copy(sorted.begin(), sorted.end(), state->records.begin());
+}
+
+/*
+Sorts the records collected in memory and writes them as a run
+*/
+int ExternalSort::writeMemoryRun(SortState *state) {
+    sortInMemory(state);
+
+    RunWriter writer;
+    writerOpen(state, &writer);
+
+    int response = SUCCESS;
+    for (int i = 0; i < state->numRecords && response == SUCCESS; i++) {
+        response = writerAdd(state, &writer, &state->records[i * state->numAttrs]);
+    }
+    if (response == SUCCESS) {
+        response = writerClose(state, &writer);
+    }
+
+    if (response != SUCCESS) {
+        releaseBlocks(writer.run.firstBlock);
+        return response;
+    }
+
+    state->runs.push_back(writer.run);
+    state->initialRuns++;
+    state->numRecords = 0;
+
+    return SUCCESS;
+}
+
+void ExternalSort::writerOpen(SortState *state, RunWriter *writer) {
+    writer->run.firstBlock = -1;
+    writer->run.numRecords = 0;
+    writer->lastBlock = -1;
+    writer->count = 0;
+    writer->records.assign(state->recordsPerBlock * state->numAttrs, Attribute());
+}
+
+int ExternalSort::writerAdd(SortState *state, RunWriter *writer, union Attribute *record) {
+    if (writer->count == state->recordsPerBlock) {
+        int response = writerFlush(state, writer);
+        if (response != SUCCESS) {
+            return response;
+        }
+    }
+
+    memcpy(&writer->records[writer->count * state->numAttrs], record, state->numAttrs * ATTR_SIZE);
+    writer->count++;
+    writer->run.numRecords++;
+
+    return SUCCESS;
+}
+
+/*
+Writes the records of the writer to a new block at the end of the run
+*/
+int ExternalSort::writerFlush(SortState *state, RunWriter *writer) {
+    // get a free block using constructor 1 to allocate a new block
+    RunBuffer runBuffer;
+    int blockNum = runBuffer.getBlockNum();
+    if (blockNum < 0) {
+        return E_DISKFULL;
+    }
+
+    HeadInfo head;
+    runBuffer.getHeader(&head);
+    head.numEntries = writer->count;
+    head.numAttrs = state->numAttrs;
+    head.lblock = writer->lastBlock;
+    head.rblock = -1;
+    runBuffer.setHeader(&head);
+    runBuffer.setRecords(writer->records.data(), writer->count);
+
+    // link the previous block of the run to this one
+    if (writer->lastBlock == -1) {
+        writer->run.firstBlock = blockNum;
+    } else {
+        RunBuffer prevBuffer(writer->lastBlock);
+        HeadInfo prevHead;
+        prevBuffer.getHeader(&prevHead);
+        prevHead.rblock = blockNum;
+        prevBuffer.setHeader(&prevHead);
+    }
+
+    writer->lastBlock = blockNum;
+    writer->count = 0;
+    state->blocksWritten++;
+
+    return SUCCESS;
+}
+
+int ExternalSort::writerClose(SortState *state, RunWriter *writer) {
+    int response = SUCCESS;
+    if (writer->count > 0) {
+        response = writerFlush(state, writer);
+    }
+    std::vector<Attribute>().swap(writer->records);
+    return response;
+}
+
+/*
+A cursor comes after another in the merge if its current record is greater, or
+is equal and from a later run (which keeps the sort stable)
+*/
+bool ExternalSort::cursorAfter(SortState *state, int cursorNum1, int cursorNum2) {
+    RunCursor *cursor1 = &state->cursors[cursorNum1];
+    RunCursor *cursor2 = &state->cursors[cursorNum2];
+    int cmpVal = compareRecords(state, &cursor1->records[cursor1->position * state->numAttrs],
+                                &cursor2->records[cursor2->position * state->numAttrs]);
+    return cmpVal > 0 || (cmpVal == 0 && cursorNum1 > cursorNum2);
+}
+
+/*
+Starts merging numRuns runs (given in the order of the input): the first block
+of every run is read, and the heap is built over the runs. The blocks of the
+runs are now owned by the merge (the firstBlock field of each run is set to -1).
+*/
+void ExternalSort::mergeOpen(SortState *state, SortRun runs[], int numRuns) {
+    state->cursors.assign(numRuns, RunCursor());
+    state->heap.clear();
+
+    for (int runNum = 0; runNum < numRuns; runNum++) {
+        RunCursor *cursor = &state->cursors[runNum];
+        cursor->nextBlock = runs[runNum].firstBlock;
+        cursor->records.assign(state->recordsPerBlock * state->numAttrs, Attribute());
+        cursor->count = 0;
+        cursor->position = 0;
+        runs[runNum].firstBlock = -1;
+
+        if (cursorReadBlock(state, cursor) == SUCCESS) {
+            state->heap.push_back(runNum);
+        }
+    }
+
+    std::make_heap(state->heap.begin(), state->heap.end(),
+                   [state](int cursorNum1, int cursorNum2) { return cursorAfter(state, cursorNum1, cursorNum2); });
+}
+
+/*
+Returns the smallest of the current records of the runs being merged, and
+moves past it (E_NOTFOUND once all the runs are exhausted)
+*/
+int ExternalSort::mergeNext(SortState *state, union Attribute *record) {
+    if (state->heap.empty()) {
+        return E_NOTFOUND;
+    }
+
+    auto after = [state](int cursorNum1, int cursorNum2) { return cursorAfter(state, cursorNum1, cursorNum2); };
+
+    // take the cursor with the smallest record off the heap
+    std::pop_heap(state->heap.begin(), state->heap.end(), after);
+    int cursorNum = state->heap.back();
+    RunCursor *cursor = &state->cursors[cursorNum];
+
+    memcpy(record, &cursor->records[cursor->position * state->numAttrs], state->numAttrs * ATTR_SIZE);
+    cursor->position++;
+
+    // put it back at its next record; drop it once its run is exhausted
+    if (cursor->position == cursor->count && cursorReadBlock(state, cursor) != SUCCESS) {
+        state->heap.pop_back();
+    } else {
+        std::push_heap(state->heap.begin(), state->heap.end(), after);
+    }
+
+    return SUCCESS;
+}
+
+void ExternalSort::mergeClose(SortState *state) {
+    for (int cursorNum = 0; cursorNum < (int)state->cursors.size(); cursorNum++) {
+        releaseBlocks(state->cursors[cursorNum].nextBlock);
+    }
+    state->cursors.clear();
+    state->heap.clear();
+}
+
+/*
+Reads the next block of the run of a cursor into memory and releases the block
+(E_NOTFOUND if the run has no more blocks)
+*/
+int ExternalSort::cursorReadBlock(SortState *state, RunCursor *cursor) {
+    if (cursor->nextBlock == -1) {
+        return E_NOTFOUND;
+    }
+
+    RunBuffer runBuffer(cursor->nextBlock);
+    HeadInfo head;
+    runBuffer.getHeader(&head);
+    runBuffer.getRecords(cursor->records.data(), head.numEntries);
+
+    cursor->count = head.numEntries;
+    cursor->position = 0;
+    cursor->nextBlock = head.rblock;
+
+    runBuffer.releaseBlock();
+    state->blocksRead++;
+
+    return SUCCESS;
+}
+
+// releases the blocks of a run, from firstBlock to the end of the run
+void ExternalSort::releaseBlocks(int firstBlock) {
+    int block = firstBlock;
+    while (block != -1) {
+        RunBuffer runBuffer(block);
+        HeadInfo head;
+        runBuffer.getHeader(&head);
+        runBuffer.releaseBlock();
+        block = head.rblock;
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef NITCBASE_EXTERNALSORT_H
+#define NITCBASE_EXTERNALSORT_H
+
+#include <vector>
+
+#include "../Buffer/BlockBuffer.h"
+#include "../Buffer/StaticBuffer.h"
+#include "../define/constants.h"
+
+// A sorted run, stored in temporary blocks linked through the rblock field of their headers
+typedef struct SortRun {
+  int firstBlock;
+  int numRecords;
+} SortRun;
+
+// A run being merged (one block of it is in memory at a time)
+typedef struct RunCursor {
+  int nextBlock;  // next block of the run to be read (-1 after the last one)
+  int position;   // index of the current record in `records`
+  int count;      // number of records in `records`
+  std::vector<Attribute> records;
+} RunCursor;
+
+// A run being written (one block of it is in memory at a time)
+typedef struct RunWriter {
+  SortRun run;
+  int lastBlock;  // last block written (-1 if none)
+  int count;      // number of records in `records`
+  std::vector<Attribute> records;
+} RunWriter;
+
+// State of an external sort (see ExternalSort::sortBegin())
+typedef struct SortState {
+  int numAttrs;
+  int keyOffset;
+  int keyType;
+  bool descending;   // if true, the records are returned from the largest key down
+  int memoryBlocks;  // memory budget, in blocks worth of records
+  int recordsPerBlock;
+
+  std::vector<Attribute> records;  // the records collected in memory (the whole input if no run was written)
+  int numRecords;
+  bool inMemory;  // set by sortEnd() if no run was written
+  int position;   // next record to be returned from `records` (if inMemory)
+
+  std::vector<SortRun> runs;       // the sorted runs written and not merged yet, in the order of the input
+  std::vector<RunCursor> cursors;  // the runs being merged
+  std::vector<int> heap;           // the cursors that are not exhausted, as a heap on their current records
+
+  // statistics
+  int initialRuns;    // number of runs written from memory
+  int mergePasses;    // number of passes merging runs into longer runs (before the final merge)
+  int blocksWritten;  // blocks of runs written
+  int blocksRead;     // blocks of runs read
+} SortState;
+
+/*
+External merge sort of fixed size records (numAttrs attributes each) on one of
+their attributes. The records are collected in memory until the memory budget
+is full, then sorted and written out as a run in temporary blocks. Once the
+input ends, the runs are merged with a k-way heap, (memoryBlocks - 1) runs at a
+time, until the remaining runs can be merged while returning the records.
+An input that fits in memory is sorted without writing any block.
+
+The sort is stable: records with equal keys are returned in the order they were added
+(in a descending sort as well).
+
+Usage: sortBegin(), sortAdd() for every record, sortEnd(), sortNext() until it
+returns E_NOTFOUND, sortClose() (which releases the temporary blocks).
+*/
+class ExternalSort {
+ public:
+  static int sortBegin(SortState *state, int numAttrs, int keyOffset, int keyType,
+                       int memoryBlocks = SORT_MEMORY_BLOCKS, bool descending = false);
+  static int sortAdd(SortState *state, union Attribute *record);
+  static int sortEnd(SortState *state);
+  static int sortNext(SortState *state, union Attribute *record);
+  static void sortClose(SortState *state);
+
+ private:
+  static int compareRecords(SortState *state, union Attribute *record1, union Attribute *record2);
+  static void sortInMemory(SortState *state);
+  static int writeMemoryRun(SortState *state);
+
+  static void writerOpen(SortState *state, RunWriter *writer);
+  static int writerAdd(SortState *state, RunWriter *writer, union Attribute *record);
+  static int writerFlush(SortState *state, RunWriter *writer);
+  static int writerClose(SortState *state, RunWriter *writer);
+
+  static bool cursorAfter(SortState *state, int cursorNum1, int cursorNum2);
+  static void mergeOpen(SortState *state, SortRun runs[], int numRuns);
+  static int mergeNext(SortState *state, union Attribute *record);
+  static void mergeClose(SortState *state);
+  static int cursorReadBlock(SortState *state, RunCursor *cursor);
+
+  static void releaseBlocks(int firstBlock);
+};
+
+#endif  // NITCBASE_EXTERNALSORT_H
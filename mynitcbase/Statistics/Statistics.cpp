@@ -0,0 +1,294 @@
+#include "Statistics.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+/*
+Collects the statistics of every attribute of the relation in a single scan of
+its records, and stores them in the statistics block of the attribute (a new
+block for an attribute not analyzed before; the block of an attribute analyzed
+before is rewritten). The statsBlock field of the attribute cache entries is
+updated; recording the blocks in the index catalog is left to the caller.
+*/
+int Statistics::analyze(int relId) {
+
+    // (the catalogs are always searched in full)
+    if (relId == RELCAT_RELID || relId == ATTRCAT_RELID || relId == INDEXCAT_RELID) {
+        return E_NOTPERMITTED;
+    }
+
+    RelCatEntry relCatEntry;
+    int response = RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    /***** Collect the values of every attribute of the records in a single scan *****/
+
+    int numAttrs = relCatEntry.numAttrs;
+    std::vector<std::vector<Attribute>> values(numAttrs);
+
+    int block = relCatEntry.firstBlk;
+    while (block != -1) {
+        RecBuffer recBuffer(block);
+
+        HeadInfo headInfo;
+        unsigned char slotMap[relCatEntry.numSlotsPerBlk];
+        Attribute records[relCatEntry.numSlotsPerBlk * numAttrs];
+        response = recBuffer.getRecords(&headInfo, slotMap, records);
+        if (response != SUCCESS) {
+            printf("failed to get records of block %d\n", block);
+            exit(1);
+        }
+
+        for (int slot = 0; slot < relCatEntry.numSlotsPerBlk; slot++) {
+            if (slotMap[slot] == SLOT_OCCUPIED) {
+                for (int attr = 0; attr < numAttrs; attr++) {
+                    values[attr].push_back(records[slot * numAttrs + attr]);
+                }
+            }
+        }
+
+        block = headInfo.rblock;
+    }
+
+    /***** Store the statistics of each attribute in its block *****/
+
+    for (int attr = 0; attr < numAttrs; attr++) {
+        AttrCatEntry attrCatEntry;
+        AttrCacheTable::getAttrCatEntry(relId, attr, &attrCatEntry);
+
+        StatsEntry entries[STATS_BUCKETS + 1];
+        int numEntries;
+        buildStats(values[attr], attrCatEntry.attrType, entries, &numEntries);
+        std::vector<Attribute>().swap(values[attr]);
+
+        if (attrCatEntry.statsBlock == -1) {
+            StatsBuffer newBuffer;
+            int blockNum = newBuffer.getBlockNum();
+            if (blockNum == E_DISKFULL) {
+                // (the attributes analyzed so far keep their statistics)
+                return E_DISKFULL;
+            }
+            attrCatEntry.statsBlock = blockNum;
+            AttrCacheTable::setAttrCatEntry(relId, attr, &attrCatEntry);
+        }
+
+        StatsBuffer statsBuffer(attrCatEntry.statsBlock);
+        HeadInfo head;
+        statsBuffer.getHeader(&head);
+        head.numEntries = numEntries;
+        statsBuffer.setHeader(&head);
+        statsBuffer.setEntries(entries, 0, numEntries);
+    }
+
+    return SUCCESS;
+}
+
+/*
+Computes the statistics of the values of an attribute (sorting them): entries[0]
+is the summary (the smallest value, the number of values and of distinct
+values), followed by the buckets of the histogram. A bucket is closed once it
+holds its share of the values (1 / STATS_BUCKETS of them) and the next value is
+different, so that the values equal to its largest one are all in it (their
+number is kept with the bucket, as the largest values of the buckets are the
+most frequent ones).
+*/
+void Statistics::buildStats(std::vector<Attribute> &values, int attrType, StatsEntry entries[],
+                            int *numEntries) {
+    std::sort(values.begin(), values.end(), [attrType](const Attribute &attr1, const Attribute &attr2) {
+        return compareAttrs(attr1, attr2, attrType) < 0;
+    });
+
+    int numValues = values.size();
+    memset(entries, 0, sizeof(StatsEntry));
+    entries[0].count = numValues;
+    if (numValues > 0) {
+        entries[0].attrVal = values[0];
+    }
+
+    int bucketSize = (numValues + STATS_BUCKETS - 1) / STATS_BUCKETS;
+    int numBuckets = 0;
+    for (int first = 0; first < numValues;) {
+        int last = std::min(numValues, first + bucketSize);
+        while (last < numValues && compareAttrs(values[last], values[last - 1], attrType) == 0) {
+            last++;
+        }
+
+        StatsEntry *bucket = &entries[1 + numBuckets];
+        bucket->attrVal = values[last - 1];
+        bucket->count = last - first;
+        bucket->distinct = 1;
+        bucket->valueCount = 1;
+        for (int i = first + 1; i < last; i++) {
+            if (compareAttrs(values[i], values[i - 1], attrType) != 0) {
+                bucket->distinct++;
+                bucket->valueCount = 1;
+            } else {
+                bucket->valueCount++;
+            }
+        }
+
+        entries[0].distinct += bucket->distinct;
+        numBuckets++;
+        first = last;
+    }
+
+    *numEntries = 1 + numBuckets;
+}
+
+// gets the statistics of an attribute of an open relation (E_NOSTATS if it was not analyzed)
+int Statistics::getStats(int relId, char attrName[ATTR_SIZE], AttrStats *stats) {
+    AttrCatEntry attrCatEntry;
+    int response = AttrCacheTable::getAttrCatEntry(relId, attrName, &attrCatEntry);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    if (attrCatEntry.statsBlock == -1) {
+        return E_NOSTATS;
+    }
+
+    StatsBuffer statsBuffer(attrCatEntry.statsBlock);
+    HeadInfo head;
+    statsBuffer.getHeader(&head);
+
+    StatsEntry summary;
+    statsBuffer.getEntries(&summary, 0, 1);
+    statsBuffer.getEntries(stats->buckets, 1, head.numEntries - 1);
+
+    strcpy(stats->attrName, attrCatEntry.attrName);
+    stats->attrType = attrCatEntry.attrType;
+    stats->numRecords = summary.count;
+    stats->numDistinct = summary.distinct;
+    stats->minVal = summary.attrVal;
+    stats->numBuckets = head.numEntries - 1;
+    stats->maxVal = stats->numBuckets > 0 ? stats->buckets[stats->numBuckets - 1].attrVal : summary.attrVal;
+
+    return SUCCESS;
+}
+
+/*
+Estimates the fraction of the records of the relation whose value of the
+attribute satisfies `op attrVal`, from the statistics of the attribute. The
+records equal to attrVal are those of its bucket divided evenly between the
+distinct values of the bucket (but for the largest value of the bucket, whose
+records are counted); the records of the bucket below attrVal are a
+share of them proportional to the position of attrVal between the bounds of the
+bucket (for a NUMBER; half of them for a STRING).
+*/
+double Statistics::selectivity(AttrStats *stats, int op, Attribute attrVal) {
+    if (stats->numRecords == 0) {
+        return 0;
+    }
+
+    // number of records equal to attrVal, and below it
+    double equal = 0, below = 0;
+    for (int i = 0; i < stats->numBuckets; i++) {
+        StatsEntry *bucket = &stats->buckets[i];
+
+        int cmpUpper = compareAttrs(attrVal, bucket->attrVal, stats->attrType);
+        if (cmpUpper > 0) {
+            below += bucket->count;
+            continue;
+        }
+
+        // (attrVal is above the largest value of the previous bucket: the first bucket
+        //  starts at the smallest value of the attribute, the others just above it)
+        Attribute lower = (i == 0) ? stats->minVal : stats->buckets[i - 1].attrVal;
+        if (i == 0 && compareAttrs(attrVal, lower, stats->attrType) < 0) {
+            break;
+        }
+
+        if (cmpUpper == 0) {
+            equal = bucket->valueCount;
+            below += bucket->count - equal;
+        } else if (bucket->distinct > 1) {
+            // (the other values of the bucket share the records not of its largest value)
+            equal = (bucket->count - bucket->valueCount) / (bucket->distinct - 1);
+            double share = 0.5;
+            if (stats->attrType == NUMBER && bucket->attrVal.nVal > lower.nVal) {
+                share = (attrVal.nVal - lower.nVal) / (bucket->attrVal.nVal - lower.nVal);
+            }
+            double others = bucket->count - bucket->valueCount;
+            below += std::min(share * others, others - equal);
+        }
+        // (a bucket of a single value holds nothing below it)
+        break;
+    }
+
+    double numRecords = 0;
+    switch (op) {
+        case EQ: numRecords = equal; break;
+        case NE: numRecords = stats->numRecords - equal; break;
+        case LT: numRecords = below; break;
+        case LE: numRecords = below + equal; break;
+        case GT: numRecords = stats->numRecords - below - equal; break;
+        case GE: numRecords = stats->numRecords - below; break;
+    }
+
+    return std::max(0.0, std::min(1.0, numRecords / stats->numRecords));
+}
+
+/*
+Estimates the number of records of an open relation whose value of the
+attribute satisfies `op attrVal` (the selectivity of the condition applied to
+the current number of records of the relation).
+*/
+int Statistics::estimateSelect(int relId, char attrName[ATTR_SIZE], int op, Attribute attrVal, double *numRecords) {
+    AttrStats stats;
+    int response = Statistics::getStats(relId, attrName, &stats);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    RelCatEntry relCatEntry;
+    RelCacheTable::getRelCatEntry(relId, &relCatEntry);
+
+    *numRecords = relCatEntry.numRecs * Statistics::selectivity(&stats, op, attrVal);
+    return SUCCESS;
+}
+
+/*
+Estimates the number of records of the equi-join of two open relations on
+relation1.attrName1 = relation2.attrName2: every value of the attribute with
+fewer distinct values is taken to match the records of a value of the other,
+i.e. numRecords1 * numRecords2 / max(distinct1, distinct2).
+*/
+int Statistics::estimateJoin(int relId1, char attrName1[ATTR_SIZE], int relId2, char attrName2[ATTR_SIZE],
+                             double *numRecords) {
+    AttrStats stats1, stats2;
+    int response = Statistics::getStats(relId1, attrName1, &stats1);
+    if (response != SUCCESS) {
+        return response;
+    }
+    response = Statistics::getStats(relId2, attrName2, &stats2);
+    if (response != SUCCESS) {
+        return response;
+    }
+
+    RelCatEntry relCatEntry1, relCatEntry2;
+    RelCacheTable::getRelCatEntry(relId1, &relCatEntry1);
+    RelCacheTable::getRelCatEntry(relId2, &relCatEntry2);
+
+    double distinct = std::max(stats1.numDistinct, stats2.numDistinct);
+    *numRecords = distinct == 0 ? 0 : (double)relCatEntry1.numRecs * relCatEntry2.numRecs / distinct;
+    return SUCCESS;
+}
+
+int Statistics::statsDestroy(int blockNum) {
+    /*blockNum lies outside the valid range [0,DISK_BLOCKS-1]*/
+    if (blockNum < 0 || blockNum >= DISK_BLOCKS) {
+        return E_OUTOFBOUND;
+    }
+
+    if (StaticBuffer::getStaticBlockType(blockNum) != STATISTICS) {
+        return E_INVALIDBLOCK;
+    }
+
+    StatsBuffer statsBuffer(blockNum);
+    statsBuffer.releaseBlock();
+
+    return SUCCESS;
+}
@@ -0,0 +1,53 @@
+#ifndef NITCBASE_STATISTICS_H
+#define NITCBASE_STATISTICS_H
+
+#include <vector>
+
+#include "../Buffer/BlockBuffer.h"
+#include "../Buffer/StaticBuffer.h"
+#include "../Cache/AttrCacheTable.h"
+#include "../Cache/RelCacheTable.h"
+#include "../define/constants.h"
+#include "../define/id.h"
+
+// The statistics of an attribute (see Statistics::getStats())
+typedef struct AttrStats {
+  char attrName[ATTR_SIZE];
+  int attrType;
+  double numRecords;   // number of records of the relation when it was analyzed
+  double numDistinct;  // number of distinct values of the attribute
+  union Attribute minVal;
+  union Attribute maxVal;
+  int numBuckets;
+  struct StatsEntry buckets[STATS_BUCKETS];  // the histogram (see struct StatsEntry)
+} AttrStats;
+
+/*
+Statistics of the values of the attributes of a relation, collected by ANALYZE
+(see analyze()) and used to estimate how many records a selection or a join
+will find. For each attribute, a statistics block holds the number of records
+of the relation, the number of distinct values of the attribute, its smallest
+and largest value, and an equi-depth histogram of STATS_BUCKETS buckets: each
+bucket holds about as many records as the others, and all the records of a
+value are in one bucket, so a frequent value makes a bucket of its own (the
+records of the largest value of each bucket are counted apart). The
+block is recorded in the index catalog (index type INDEX_STATS).
+The statistics are not kept up to date by the insertions and deletions; they
+describe the relation as it was when it was last analyzed.
+*/
+class Statistics {
+ public:
+  static int analyze(int relId);
+  static int getStats(int relId, char attrName[ATTR_SIZE], AttrStats *stats);
+  static double selectivity(AttrStats *stats, int op, union Attribute attrVal);
+  static int estimateSelect(int relId, char attrName[ATTR_SIZE], int op, union Attribute attrVal,
+                            double *numRecords);
+  static int estimateJoin(int relId1, char attrName1[ATTR_SIZE], int relId2, char attrName2[ATTR_SIZE],
+                          double *numRecords);
+  static int statsDestroy(int blockNum);
+
+ private:
+  static void buildStats(std::vector<Attribute> &values, int attrType, StatsEntry entries[], int *numEntries);
+};
+
+#endif  // NITCBASE_STATISTICS_H
@@ -20,14 +20,17 @@
 #define INDEX_BLOCK_UNUSED_BYTES 8  // Size of unused field in index block (in bytes)
 #define INTERNAL_ENTRY_SIZE 24      // Size of an Internal Index Entry in the Internal Index Block (in bytes)
 #define LEAF_ENTRY_SIZE 32          // Size of an Leaf Index Entry in the Leaf Index Block (in bytes)
+#define LEAF_ENTRY_SIZE_PACKED 22   // Size of a Leaf Index Entry in a packed Leaf Index Block (key, block, 2 byte slot)
+#define ZONE_ENTRY_HEADER_SIZE 4    // Size of the record block number stored at the start of a Zone Map Entry (in bytes)
 
 #define DISK_BLOCKS 8192             // Number of block in disk
 #define BUFFER_CAPACITY 32           // Total number of blocks available in the Buffer (Capacity of the Buffer in blocks)
-#define MAX_OPEN 12                  // Maximum number of relations allowed to be open and cached in Cache Layer.
+#define MAX_OPEN 13                  // Maximum number of relations allowed to be open and cached in Cache Layer (including the catalogs).
 #define BLOCK_ALLOCATION_MAP_SIZE 4  // Number of blocks given for Block Allocation Map in the disk
 
 #define RELCAT_NO_ATTRS 6   // Number of attributes present in one entry / record of the Relation Catalog
 #define ATTRCAT_NO_ATTRS 6  // Number of attributes present in one entry / record of the Attribute Catalog
+#define INDEXCAT_NO_ATTRS 6 // Number of attributes present in one entry / record of the Index Catalog
 
 #define RELCAT_BLOCK 4   // Disk block number for the block of Relation Catalog
 #define ATTRCAT_BLOCK 5  // Disk block number for the first block of Attribute Catalog
@@ -40,6 +43,7 @@
 
 #define RELCAT_RELID 0   // Relid for Relation catalog
 #define ATTRCAT_RELID 1  // Relid for Attribute catalog
+#define INDEXCAT_RELID 2 // Relid reserved for Index catalog (open whenever the index catalog exists)
 
 #define RELCAT_SLOTNUM_FOR_RELCAT 0   // Slot number for relation catalog in relation catalog
 #define RELCAT_SLOTNUM_FOR_ATTRCAT 1  // Slot number for attribute catalog in relation catalog
@@ -49,6 +53,7 @@
 enum AttributeType {
   NUMBER = 0,  // for an integer or a floating point number
   STRING = 1,
+  COMPOSITE = 2  // key of a composite index: a byte string compared with memcmp() (see BPlusTree::makeCompositeKey())
 };
 
 enum ConditionalOperators {
@@ -65,7 +70,31 @@ enum BlockType {
   IND_INTERNAL,  // internal index block
   IND_LEAF,      // leaf index block
   UNUSED_BLK,    // unused block
-  BMAP           // block allocation map
+  BMAP,          // block allocation map
+  ZONE_MAP,      // zone map block (per record block min/max summaries)
+  BLOOM_FILTER,  // bloom filter block
+  SORT_RUN,      // block of a sorted run of the external sort (temporary)
+  HASH_INDEX,    // hash index block (head, directory or bucket)
+  BITMAP_INDEX,  // bitmap index block (value directory or bitmap)
+  STATISTICS     // statistics of an attribute (see Statistics/Statistics.h)
+};
+
+// Types of the secondary access structures recorded in the Index Catalog
+enum IndexType {
+  INDEX_BLOOM = 0,     // bloom filter on an attribute
+  INDEX_COMPOSITE = 1,  // B+ tree on an ordered list of attributes (one entry per attribute, in key order)
+  INDEX_INCLUDE = 2,    // NUMBER attribute carried in the leaf entries of the B+ tree on the attribute IndexName
+  INDEX_HASH = 3,       // extendible hash index on an attribute (equality searches only)
+  INDEX_BITMAP = 4,     // bitmap index on an attribute (a bitmap of the records per distinct value)
+  INDEX_STATS = 5       // statistics of an attribute collected by ANALYZE (RootBlock is their block)
+};
+
+// Ways of finding the records of a relation that satisfy a condition (see BlockAccess::planSearch())
+enum AccessMethod {
+  ACCESS_LINEAR = 0,  // scan of the record blocks of the relation
+  ACCESS_BPLUS = 1,   // search of the B+ tree on the attribute, reading the record of each entry found
+  ACCESS_HASH = 2,    // (equality) search of the hash index on the attribute
+  ACCESS_BITMAP = 3   // (equality) search of the bitmap index on the attribute
 };
 
 enum OpenRelationEntryStatus {
@@ -83,6 +112,16 @@ enum RelCatFieldIndex {
   RELCAT_NO_SLOTS_PER_BLOCK_INDEX = 5  // #Slots
 };
 
+// Indexes for Index Catalog Attributes
+enum IndexCatFieldIndex {
+  INDEXCAT_REL_NAME_INDEX = 0,    // Relation Name
+  INDEXCAT_INDEX_NAME_INDEX = 1,  // Index Name
+  INDEXCAT_INDEX_TYPE_INDEX = 2,  // Index Type
+  INDEXCAT_ATTR_NAME_INDEX = 3,   // Attribute Name
+  INDEXCAT_KEY_NUM_INDEX = 4,     // Position of the attribute in the key of the index
+  INDEXCAT_ROOT_BLOCK_INDEX = 5   // Root Block
+};
+
 // Indexes for Attribute Catalog Attributes
 enum AttrCatFieldIndex {
   ATTRCAT_REL_NAME_INDEX = 0,      // Relation Name
@@ -119,15 +158,85 @@ enum ReturnTypes {
   E_NOTFOUND,               // Search for requested record unsuccessful
   E_BLOCKNOTINBUFFER,       // Block not found in buffer
   E_INDEX_BLOCKS_RELEASED,  // Due to insufficient disk space, index blocks have been released from the disk
+  E_NOSTATS,                // No statistics of the attribute (see ANALYZE)
 };
 
 #define TEMP ".temp"  // Used for internal purposes
 
+// Bloom filters (blocked: all the bits of a key are in one block of the filter)
+#define BLOOM_BITS_PER_KEY 10                             // Number of bits allocated per key when sizing a filter
+#define BLOOM_MIN_KEYS 1024                               // A filter is sized for at least these many keys
+#define BLOOM_NUM_HASHES 7                                // Number of bits set per key
+#define BLOOM_BLOCK_BITS ((BLOCK_SIZE - HEADER_SIZE) * 8) // Number of bits in one block of a filter
+#define BLOOM_MAX_BLOCKS ((BLOCK_SIZE - HEADER_SIZE) / 4) // Maximum number of blocks of a filter (one head block holds their numbers)
+
+// Hash indexes (extendible hashing: a directory of 2^depth bucket numbers, indexed by the low bits of the hash)
+#define HASH_BLOCK_NUMS ((BLOCK_SIZE - HEADER_SIZE) / 4)                       // Block numbers held by a head or directory block
+#define HASH_BUCKET_ENTRIES ((BLOCK_SIZE - HEADER_SIZE) / LEAF_ENTRY_SIZE_PACKED)  // Entries held by a bucket block (key, block, 2 byte slot)
+#define HASH_MAX_DEPTH 16                                                      // Largest global depth (the directory then fills 128 blocks)
+
+// Predicate kernels (selection bitmaps over the records of a block)
+#define MAX_SLOTS_PER_BLOCK ((BLOCK_SIZE - HEADER_SIZE) / (ATTR_SIZE + 1))  // Number of slots in a block of a relation with one attribute
+#define SELECTION_BITMAP_WORDS ((MAX_SLOTS_PER_BLOCK + 63) / 64)          // Number of 64 bit words in the selection bitmap of a block
+
+// Bitmap indexes (per distinct value, a selection bitmap of every record block holding the value)
+#define BITMAP_VALUE_SIZE (ATTR_SIZE + 8)                                  // A value of a directory block (value, first bitmap block, number of records)
+#define BITMAP_DIR_VALUES ((BLOCK_SIZE - HEADER_SIZE) / BITMAP_VALUE_SIZE)  // Values held by a directory block
+#define BITMAP_ENTRY_SIZE (4 + SELECTION_BITMAP_WORDS * 8)                 // An entry of a bitmap block (record block, its selection bitmap)
+#define BITMAP_BLOCK_ENTRIES ((BLOCK_SIZE - HEADER_SIZE) / BITMAP_ENTRY_SIZE)  // Entries held by a bitmap block
+#define MAX_SELECT_TERMS 8                                                 // Most equalities joined by AND or OR in a selection
+
+// Statistics of the attributes (ANALYZE: the number of records and distinct values, and an equi-depth histogram)
+#define STATS_ENTRY_SIZE (ATTR_SIZE + 24)                                 // An entry of a statistics block (value, records, distinct values, records of the value)
+#define STATS_BLOCK_ENTRIES ((BLOCK_SIZE - HEADER_SIZE) / STATS_ENTRY_SIZE)  // Entries held by a statistics block
+#define STATS_BUCKETS 32                                                  // Most buckets of the histogram of an attribute (< STATS_BLOCK_ENTRIES)
+
+// Costs of the access paths (see BlockAccess::costPlan()), in reads of a block (of records or of an index)
+#define RECORD_COST 0.5                  // Returning a record found by a search
+#define FETCH_COST 0.35                  // Reading the record of an index entry found (a block other than the last one read)
+#define LEAF_OCCUPANCY 0.7               // Fraction of the entries of a leaf used in a B+ tree grown by insertions
+#define DEFAULT_EQ_SELECTIVITY 0.005     // Fraction of the records equal to a value (attributes not analyzed)
+#define DEFAULT_INEQ_SELECTIVITY 0.3333  // Fraction of the records below (or above) a value (attributes not analyzed)
+#define DEFAULT_RANGE_SELECTIVITY 0.005  // Fraction of the records between two values (attributes not analyzed)
+
+enum KernelLevel {
+  KERNEL_SCALAR = 0,  // portable C++
+  KERNEL_SSE42 = 1,   // 128 bit vectors (CPUs with SSE4.2)
+  KERNEL_AVX2 = 2     // 256 bit vectors (CPUs with AVX2)
+};
+
+// Searches of the keys of an index block (see IndBuffer::setSearchMethod())
+enum NodeSearchMethod {
+  NODE_SEARCH_LINEAR = 0,        // every key from the first
+  NODE_SEARCH_BINARY = 1,        // halving the range of the keys
+  NODE_SEARCH_INTERPOLATION = 2  // NUMBER keys: position predicted from the first and last key, then a bounded search
+};
+
+// External sort
+#define SORT_MEMORY_BLOCKS 256  // Default memory budget of a sort (in blocks worth of records, i.e. 512 KB)
+#define SORT_MIN_MEMORY 3       // Smallest memory budget of a sort (two runs are merged into an output block)
+
 // Global variables for B+ Tree Layer
 #define MAX_KEYS_INTERNAL 100     // Maximum number of keys allowed in an Internal Node of a B+ tree
 #define MIDDLE_INDEX_INTERNAL 50  // Index of the middle element in an Internal Node of a B+ tree
 #define MAX_KEYS_LEAF 63          // Maximum number of keys allowed in a Leaf Node of a B+ tree
 #define MIDDLE_INDEX_LEAF 31      // Index of the middle element in a Leaf Node of a B+ tree
+#define MIN_KEYS_INTERNAL 50      // Minimum number of keys in an Internal Node (other than the root) of a B+ tree
+#define MIN_KEYS_LEAF 32          // Minimum number of keys in a Leaf Node (other than the root) of a B+ tree
+#define MAX_KEYS_LEAF_PACKED 91   // Maximum number of keys allowed in a packed Leaf Node (see IndLeaf::getMaxEntries())
+#define MAX_KEYS_INTERNAL_PREFIX 335  // Most keys that fit in a prefix compressed Internal Node (see IndInternal::setNode())
+#define MIN_BYTES_INTERNAL_PREFIX 672  // Fewest bytes used by a prefix compressed Internal Node (other than the root)
+#define INDEX_FILL_FACTOR 90      // Percentage of the entries of a node used when a B+ tree is built in bulk
+#define INSERT_BATCH_RECORDS 4096  // Rows of a file inserted at a time (their index entries in one pass of each B+ tree)
+#define MAX_INDEX_KEYS 4          // Maximum number of attributes in the key of a composite index
+#define MAX_COMPOSITE_INDEXES 4   // Maximum number of composite indexes on a relation
+#define NODE_CACHE_CAPACITY 64    // Most internal nodes of B+ trees held decoded in memory (see Buffer/NodeCache.h)
+#define NODE_CACHE_LEVELS 3       // Levels of a B+ tree (from the root down) whose internal nodes are cached
+
+// Formats of the entries of an index block (stored in the numSlots field of its header)
+#define IND_FORMAT_PLAIN 0   // entries of a fixed size (sizeof(int32_t) + ATTR_SIZE, or LEAF_ENTRY_SIZE bytes apart)
+#define IND_FORMAT_PREFIX 1  // internal: STRING keys stored as suffixes of a common prefix (its length is in numAttrs)
+#define IND_FORMAT_PACKED 2  // leaf: entries without the included value (LEAF_ENTRY_SIZE_PACKED bytes apart)
 
 // Name strings for Relation Catalog and Attribute Catalog (as it is stored in the Relation catalog)
 #define RELCAT_RELNAME "RELATIONCAT"
@@ -141,6 +250,18 @@ enum ReturnTypes {
 #define RELCAT_ATTR_LAST_BLOCK "LastBlock"
 #define RELCAT_ATTR_NO_SLOTS "#Slots"
 
+// Name string for the Index Catalog (as it is stored in the Relation catalog).
+// (names starting with '.' can not be used from the frontend)
+#define INDEXCAT_RELNAME ".indexcat"
+
+// Index Catalog attribute name strings
+#define INDEXCAT_ATTR_RELNAME "RelName"
+#define INDEXCAT_ATTR_INDEX_NAME "IndexName"
+#define INDEXCAT_ATTR_INDEX_TYPE "IndexType"
+#define INDEXCAT_ATTR_ATTRIBUTE_NAME "AttributeName"
+#define INDEXCAT_ATTR_KEY_NUM "KeyNum"
+#define INDEXCAT_ATTR_ROOT_BLOCK "RootBlock"
+
 // Attribte Catalog attribute name strings
 #define ATTRCAT_ATTR_RELNAME "RelName"
 #define ATTRCAT_ATTR_ATTRIBUTE_NAME "AttributeName"